@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#ifdef ARDUINO
+#include "Arduino.h"
+#include "hal/cpu_hal.h"
+#else
+#include <chrono>
+#endif
+
+/**
+ * @file BenchHarness.h
+ * @brief Minimal timing harness for the hot-path benchmarks
+ *
+ * measure() runs a body a fixed number of iterations after a short warm-up
+ * and returns nanoseconds per iteration. Timing uses steady_clock on the
+ * host and the CPU cycle counter on the ESP32 (env:bench), so the on-target
+ * numbers have cycle resolution.
+ *
+ * report() collects timings and reportValue() other figures (for example
+ * simulator overshoot); writeResults() emits one JSON object per line
+ * ({"name", "iterations", "value", "unit", "platform"}) to a file on the
+ * host and to stdout/serial on both, so runs can be diffed between releases.
+ *
+ * Keep computed values alive with doNotOptimize(), otherwise the compiler
+ * may remove the work being measured.
+ */
+
+namespace bench {
+
+    /// One benchmark result
+    struct Result {
+        const char* name;
+        uint32_t iterations;  ///< Iterations or samples behind the value
+        double value;
+        const char* unit;     ///< "ns/op" for timings
+    };
+
+    constexpr size_t MAX_RESULTS = 32;  ///< Results kept per run
+
+    inline Result g_results[MAX_RESULTS] = {};
+    inline size_t g_result_count = 0;
+
+#ifdef ARDUINO
+    constexpr const char* PLATFORM = "esp32";
+
+    /// @return Elapsed time source in nanoseconds (cycle counter)
+    inline uint64_t nowNs() {
+        static const uint32_t mhz = getCpuFrequencyMhz();
+        static uint32_t last = 0;
+        static uint64_t high = 0;
+        uint32_t cycles = cpu_hal_get_cycle_count();
+        if (cycles < last) {
+            high += 1ULL << 32;  // 32-bit counter wrapped
+        }
+        last = cycles;
+        return (high + cycles) * 1000ULL / mhz;
+    }
+#else
+    constexpr const char* PLATFORM = "native";
+
+    /// @return Monotonic time in nanoseconds
+    inline uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+#endif
+
+    /// Prevent the compiler from discarding a computed value
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * @brief Time a body
+     * @param iterations Measured iterations (plus iterations / 10 warm-up)
+     * @param body Callable taking the iteration index
+     * @return Nanoseconds per iteration
+     */
+    template <typename Body>
+    inline double measure(uint32_t iterations, Body&& body) {
+        for (uint32_t i = 0; i < iterations / 10; i++) {
+            body(i);
+        }
+        const uint64_t start = nowNs();
+        for (uint32_t i = 0; i < iterations; i++) {
+            body(i);
+        }
+        const uint64_t elapsed = nowNs() - start;
+        return static_cast<double>(elapsed) / iterations;
+    }
+
+    /**
+     * @brief Record a result (and print it as it is produced)
+     */
+    inline void reportValue(const char* name, uint32_t iterations, double value, const char* unit) {
+        if (g_result_count < MAX_RESULTS) {
+            g_results[g_result_count++] = {name, iterations, value, unit};
+        }
+        printf("BENCH %-32s %10.3f %s (%lu iterations)\n", name, value, unit,
+               (unsigned long)iterations);
+    }
+
+    /**
+     * @brief Record a timing in nanoseconds per iteration
+     */
+    inline void report(const char* name, uint32_t iterations, double ns_per_op) {
+        reportValue(name, iterations, ns_per_op, "ns/op");
+    }
+
+    /**
+     * @brief Write all results as JSON lines
+     * @param path Output file (host only; nullptr or on target: stdout)
+     */
+    inline void writeResults(const char* path) {
+        FILE* out = stdout;
+#ifndef ARDUINO
+        if (path) {
+            out = fopen(path, "w");
+            if (!out) {
+                out = stdout;
+            }
+        }
+#else
+        (void)path;
+#endif
+        for (size_t i = 0; i < g_result_count; i++) {
+            fprintf(out, "{\"name\":\"%s\",\"iterations\":%lu,\"value\":%.4f,\"unit\":\"%s\",\"platform\":\"%s\"}\n",
+                    g_results[i].name, (unsigned long)g_results[i].iterations,
+                    g_results[i].value, g_results[i].unit, PLATFORM);
+        }
+        if (out != stdout) {
+            fclose(out);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+// Benchmarks for the control loop
+// AutomaticModeController::update and the remote button state machines
+
+#include <unity.h>
+#include "BenchHarness.h"
+#include "automatic_mode_controller.h"
+#include "util/RemoteGestures.h"
+
+namespace {
+    class BenchMotor : public IMotor {
+    public:
+        void moveUp() override { direction_ = Direction::UP; }
+        void moveDown() override { direction_ = Direction::DOWN; }
+        void stop() override { direction_ = Direction::STOPPED; }
+        bool isActive() const override { return direction_ != Direction::STOPPED; }
+        Direction getCurrentDirection() const override { return direction_; }
+        bool isMovingUp() const override { return direction_ == Direction::UP; }
+        bool isMovingDown() const override { return direction_ == Direction::DOWN; }
+
+    private:
+        Direction direction_ = Direction::STOPPED;
+    };
+
+    class BenchSensor : public ISensor {
+    public:
+        bool isActive() const override { return false; }
+        bool justActivated() override { return false; }
+        bool justDeactivated() override { return false; }
+        void update() override {}
+    };
+}
+
+void bench_auto_mode_update(void) {
+    // One 20 ms tick while deploying towards a target that is never reached
+    BenchMotor motor;
+    BenchSensor sensor;
+    AnchorWinchController winch(motor, sensor);
+    HomeSensor home(sensor);
+    AutomaticModeController controller(winch, home);
+    controller.setTolerance(0.02f);
+    controller.setStopPrediction(true);
+    controller.setCoastCoefficients(0.3f, 0.3f);
+    controller.setTargetLength(1.0e6f);
+    controller.setEnabled(true);
+
+    constexpr uint32_t iterations = 200000;
+    double ns = bench::measure(iterations, [&](uint32_t i) {
+        controller.update(i * 0.01f, 20UL + i * 20UL);
+    });
+    bench::report("auto_mode_update", iterations, ns);
+    TEST_ASSERT_TRUE(controller.isEnabled());
+}
+
+void bench_remote_debounce(void) {
+    // Per processInputs(): four buttons plus the "any button" gesture channel,
+    // with a press/release pattern that exercises debounce and double press
+    RemoteGestures remote;
+    bool emergency_stop_active = false;
+    constexpr uint32_t iterations = 200000;
+    uint32_t events = 0;
+    double ns = bench::measure(iterations, [&](uint32_t i) {
+        unsigned long now_ms = i * 5UL;
+        bool pressed = (i % 200U) < 100U;
+        for (uint8_t b = 0; b < RemoteGestures::BUTTON_COUNT; b++) {
+            remote.onEdge(b, pressed && b == (i / 200U) % RemoteGestures::BUTTON_COUNT, now_ms);
+        }
+        RemoteGesture gesture = remote.update(now_ms, emergency_stop_active);
+        if (gesture != RemoteGesture::NONE) {
+            emergency_stop_active = gesture == RemoteGesture::EMERGENCY_STOP;
+        }
+        for (uint8_t b = 0; b < RemoteGestures::BUTTON_COUNT; b++) {
+            events += remote.events(b);
+        }
+    });
+    bench::report("remote_debounce", iterations, ns);
+    TEST_ASSERT_TRUE(events > 0);
+}
@@ -0,0 +1,66 @@
+// Benchmarks for the SignalK command path
+// Table guard evaluation + handler dispatch and the control command queue
+
+#include <unity.h>
+#include "BenchHarness.h"
+#include "services/SignalKCommandTable.h"
+#include "services/ControlCommand.h"
+#include "util/MpscQueue.h"
+
+namespace {
+    uint32_t g_handled = 0;
+
+    void countHandler(SignalKService& service, float value) {
+        (void)service;
+        g_handled += value > 0.0f ? 1U : 0U;
+    }
+
+    // Same guard mix as SignalKService::COMMAND_TABLE
+    const SKCommandEntry BENCH_TABLE[] = {
+        {"navigation.anchor.resetRode", SKCommandValue::BOOL,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::TRIGGER,
+         countHandler, nullptr},
+        {"navigation.bow.ecu.emergencyStopCommand", SKCommandValue::BOOL,
+         SKCommandGuard::CONNECTED_OR_ESTOP, countHandler, nullptr},
+        {"navigation.anchor.manualControl", SKCommandValue::INT,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED, countHandler, countHandler},
+        {"navigation.anchor.targetRodeCommand", SKCommandValue::FLOAT,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED |
+             SKCommandGuard::NEEDS_AUTO_MODE, countHandler, nullptr},
+    };
+    constexpr size_t BENCH_TABLE_SIZE = sizeof(BENCH_TABLE) / sizeof(BENCH_TABLE[0]);
+}
+
+void bench_signalk_command_dispatch(void) {
+    // SignalKService::dispatchCommand() minus SensESP: guards, event log, handler, feedback
+    SignalKService& service = *reinterpret_cast<SignalKService*>(&g_handled);  // Never dereferenced
+    constexpr uint32_t iterations = 500000;
+    g_handled = 0;
+    double ns = bench::measure(iterations, [&](uint32_t i) {
+        skDispatchCommand(BENCH_TABLE, i % BENCH_TABLE_SIZE, service, 1.0f, false, true);
+    });
+    bench::report("signalk_command_dispatch", iterations, ns);
+    TEST_ASSERT_TRUE(g_handled > 0);
+}
+
+void bench_command_queue_round_trip(void) {
+    // ControlTask::submit() + drain: push 4 commands, pop and coalesce them
+    MpscQueue<ControlCommand, 16> queue;
+    constexpr uint32_t iterations = 100000;
+    size_t kept_total = 0;
+    double ns = bench::measure(iterations, [&](uint32_t i) {
+        queue.push({ControlCommandType::MANUAL_WINCH, 1.0f, CommandSource::SIGNALK, i});
+        queue.push({ControlCommandType::MANUAL_WINCH, 0.0f, CommandSource::SIGNALK, i});
+        queue.push({ControlCommandType::AUTO_MODE, 1.0f, CommandSource::SIGNALK, i});
+        queue.push({ControlCommandType::BOW_THRUSTER, -1.0f, CommandSource::REMOTE, i});
+        ControlCommand batch[16];
+        size_t count = 0;
+        while (count < 16 && queue.pop(batch[count])) {
+            count++;
+        }
+        kept_total += coalesceCommands(batch, count);
+    });
+    bench::report("command_queue_round_trip", iterations, ns);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.dropped());
+    TEST_ASSERT_EQUAL(iterations * 3 + iterations / 10 * 3, kept_total);
+}
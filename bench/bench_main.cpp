@@ -0,0 +1,63 @@
+// Hot-path benchmark runner
+// Native: pio test -e native_bench   (results in bench_output.txt)
+// ESP32:  pio test -e bench          (results as JSON lines on the serial port)
+
+#include <unity.h>
+#include <Arduino.h>
+#include "BenchHarness.h"
+
+extern void bench_pulse_ingestion(void);
+extern void bench_pulse_drain_and_motion(void);
+extern void bench_auto_mode_update(void);
+extern void bench_remote_debounce(void);
+extern void bench_signalk_command_dispatch(void);
+extern void bench_command_queue_round_trip(void);
+extern void bench_windlass_sim_cold_start(void);
+extern void bench_windlass_sim_learned(void);
+
+#ifndef ARDUINO
+// Host stand-ins for the Arduino GPIO API (unused by the benchmarked code)
+int digitalRead(uint8_t pin) { (void)pin; return LOW; }
+void digitalWrite(uint8_t pin, uint8_t val) { (void)pin; (void)val; }
+void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+#endif
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void setup() {
+#ifdef ARDUINO
+    delay(2000);  // Wait for serial monitor
+#endif
+    UNITY_BEGIN();
+
+    // Pulse path (ISR side and control-side drain)
+    RUN_TEST(bench_pulse_ingestion);
+    RUN_TEST(bench_pulse_drain_and_motion);
+
+    // Control loop
+    RUN_TEST(bench_auto_mode_update);
+    RUN_TEST(bench_remote_debounce);
+
+    // Networking -> control command path
+    RUN_TEST(bench_signalk_command_dispatch);
+    RUN_TEST(bench_command_queue_round_trip);
+
+    // Closed loop against the simulated windlass
+    RUN_TEST(bench_windlass_sim_cold_start);
+    RUN_TEST(bench_windlass_sim_learned);
+
+    bench::writeResults("bench_output.txt");
+    UNITY_END();
+}
+
+void loop() {
+    // Nothing here
+}
+
+#ifndef ARDUINO
+int main(int argc, char **argv) {
+    setup();
+    return 0;
+}
+#endif
@@ -0,0 +1,45 @@
+// Benchmarks for pulse ingestion
+// ISR-side accounting and the control-side drain into the motion estimator
+
+#include <unity.h>
+#include "BenchHarness.h"
+#include "services/StateManager.h"
+#include "chain_motion_estimator.h"
+
+void bench_pulse_ingestion(void) {
+    // Per pulse ISR work: atomic count plus timestamped edge (drained every 32)
+    StateManager state;
+    constexpr uint32_t iterations = 200000;
+    double ns = bench::measure(iterations, [&](uint32_t i) {
+        state.incrementPulse();
+        state.pushPulseEdge({i * 1000U, 1});
+        if ((i & 31U) == 31U) {
+            PulseEdge edge;
+            while (state.popPulseEdge(edge)) {
+                bench::doNotOptimize(edge);
+            }
+        }
+    });
+    bench::report("pulse_ingestion", iterations, ns);
+    TEST_ASSERT_EQUAL_UINT32(0, state.getDroppedPulseEdges());
+}
+
+void bench_pulse_drain_and_motion(void) {
+    // Per control tick: drain the counter and feed 4 edges into the estimator
+    StateManager state;
+    ChainMotionEstimator estimator;
+    constexpr uint32_t iterations = 50000;
+    uint32_t t_us = 0;
+    double ns = bench::measure(iterations, [&](uint32_t i) {
+        for (int edge = 0; edge < 4; edge++) {
+            t_us += 5000;
+            state.incrementPulse();
+            estimator.addEdge({t_us, 1}, 0.01f);
+        }
+        PulseSnapshot snapshot = state.drainPulses(i * 20UL);
+        estimator.update(t_us, 0.01f, true);
+        bench::doNotOptimize(snapshot);
+    });
+    bench::report("pulse_drain_and_motion", iterations, ns);
+    TEST_ASSERT_TRUE(estimator.getSpeed() > 0.0f);
+}
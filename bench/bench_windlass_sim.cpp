@@ -0,0 +1,56 @@
+// Closed-loop simulation of automatic mode against the windlass plant
+// Reports overshoot, time-to-target and missed stops over many cycles
+
+#include <unity.h>
+#include "BenchHarness.h"
+#include "sim/WindlassSim.h"
+
+namespace {
+    constexpr float MISS_THRESHOLD_M = 0.10f;  ///< Final error counted as a missed stop
+
+    /// Deterministic target sequence (LCG): mix of short and long moves
+    float nextTarget(uint32_t& seed) {
+        seed = seed * 1664525UL + 1013904223UL;
+        return 2.0f + static_cast<float>((seed >> 8) % 5800) / 100.0f;  // 2 .. 60 m
+    }
+
+    void runCycles(SimStats& stats, uint32_t cycles, bool learn_first) {
+        WindlassSim sim;
+        uint32_t seed = 12345;
+        if (learn_first) {
+            // Let the controller learn the coast from a few moves first
+            for (int i = 0; i < 10; i++) sim.runToTarget(nextTarget(seed));
+        }
+        for (uint32_t i = 0; i < cycles; i++) {
+            stats.add(sim.runToTarget(nextTarget(seed)), MISS_THRESHOLD_M);
+        }
+    }
+}
+
+void bench_windlass_sim_cold_start(void) {
+    // From unlearned coast coefficients (first moves after a fresh install)
+    SimStats stats;
+    runCycles(stats, 20, false);
+    bench::reportValue("sim_cold_mean_overshoot", stats.cycles, stats.meanOvershoot() * 1000.0f, "mm");
+    bench::reportValue("sim_cold_max_overshoot", stats.cycles, stats.overshoot_max_m * 1000.0f, "mm");
+    bench::reportValue("sim_cold_missed_stops", stats.cycles, stats.missed_stops, "count");
+    TEST_ASSERT_EQUAL_UINT32(20, stats.cycles);
+}
+
+void bench_windlass_sim_learned(void) {
+    // Steady state: thousands of deploy/retrieve cycles with learned coast
+    constexpr uint32_t cycles = 2000;
+    SimStats stats;
+    const uint64_t start = bench::nowNs();
+    runCycles(stats, cycles, true);
+    const double wall_ns = static_cast<double>(bench::nowNs() - start);
+
+    bench::reportValue("sim_mean_overshoot", cycles, stats.meanOvershoot() * 1000.0f, "mm");
+    bench::reportValue("sim_max_overshoot", cycles, stats.overshoot_max_m * 1000.0f, "mm");
+    bench::reportValue("sim_mean_abs_error", cycles, stats.meanAbsError() * 1000.0f, "mm");
+    bench::reportValue("sim_mean_time_to_target", cycles, stats.meanTimeMs(), "ms");
+    bench::reportValue("sim_max_time_to_target", cycles, stats.time_max_ms, "ms");
+    bench::reportValue("sim_missed_stops", cycles, stats.missed_stops, "count");
+    bench::report("sim_cycle_wall_time", cycles, wall_ns / cycles);
+    TEST_ASSERT_EQUAL_UINT32(cycles, stats.cycles);
+}
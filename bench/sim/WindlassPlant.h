@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "interfaces/IMotor.h"
+#include "interfaces/ISensor.h"
+
+/**
+ * @file WindlassPlant.h
+ * @brief Deterministic windlass, chain and sensor model for host simulation
+ *
+ * The plant sits behind the same interfaces as the ESP32 hardware:
+ * - motor(): IMotor driven by AnchorWinchController (relay on/off)
+ * - homeSwitch(): ISensor, active while the anchor is within home_zone_m
+ *
+ * Chain speed follows the relay state with first-order dynamics: spin-up
+ * towards a load-dependent speed when energised and coast-down after the
+ * relay opens. Retrieving slows down and deploying speeds up with the
+ * weight of chain out. step() returns the signed counter pulses produced
+ * (one per pitch_m of chain crossed), like the chain counter sensor.
+ *
+ * Everything is a pure function of the parameters and the step sizes, so a
+ * run is reproducible bit for bit.
+ */
+
+/// Plant parameters (defaults: 10 mm chain counter, 12 V windlass)
+struct WindlassParams {
+    float pitch_m = 0.01f;          ///< Chain per counter pulse
+    float up_speed = 0.30f;         ///< Retrieve speed with no chain out (m/s)
+    float down_speed = 0.45f;       ///< Deploy speed with no chain out (m/s)
+    float load_per_m = 0.002f;      ///< Relative speed change per meter of chain out
+    float spin_up_tau_s = 0.25f;    ///< Time constant to reach speed after the relay closes
+    float coast_tau_s = 0.35f;      ///< Time constant of the coast after the relay opens
+    float home_zone_m = 0.02f;      ///< Home switch active below this rode length
+    float max_rode_m = 100.0f;      ///< Chain on the gypsy (bitter end)
+};
+
+class WindlassPlant {
+public:
+    explicit WindlassPlant(const WindlassParams& params = WindlassParams(), float rode_m = 0.0f)
+        : params_(params), rode_m_(rode_m), home_(*this) {
+        last_pulse_index_ = pulseIndex(rode_m_);
+    }
+
+    /// @return Relay-level motor seen by AnchorWinchController
+    IMotor& motor() { return motor_; }
+
+    /// @return Home switch seen by AnchorWinchController / HomeSensor
+    ISensor& homeSwitch() { return home_; }
+
+    /**
+     * @brief Advance the plant
+     * @param dt_s Step in seconds (1 ms keeps pulse timing within one step)
+     * @return Signed counter pulses in this step (+ = chain out)
+     */
+    int32_t step(float dt_s) {
+        const float target = targetSpeed();
+        const float tau = motor_.isActive() ? params_.spin_up_tau_s : params_.coast_tau_s;
+        speed_ += (target - speed_) * (1.0f - std::exp(-dt_s / tau));
+
+        rode_m_ += speed_ * dt_s;
+        if (rode_m_ <= 0.0f) {
+            rode_m_ = 0.0f;  // Anchor in the roller: mechanical stop
+            if (speed_ < 0.0f) speed_ = 0.0f;
+        } else if (rode_m_ >= params_.max_rode_m) {
+            rode_m_ = params_.max_rode_m;
+            if (speed_ > 0.0f) speed_ = 0.0f;
+        }
+
+        const int32_t index = pulseIndex(rode_m_);
+        const int32_t pulses = index - last_pulse_index_;
+        last_pulse_index_ = index;
+        return pulses;
+    }
+
+    /// @return True chain out (m)
+    float getRode() const { return rode_m_; }
+
+    /// @return True chain speed (m/s, + = deploying)
+    float getSpeed() const { return speed_; }
+
+    /// @return true once the chain has stopped moving
+    bool isStopped() const { return !motor_.isActive() && std::fabs(speed_) < STOPPED_SPEED; }
+
+    const WindlassParams& params() const { return params_; }
+
+private:
+    static constexpr float STOPPED_SPEED = 0.001f;  ///< m/s considered at rest
+
+    class Motor : public IMotor {
+    public:
+        void moveUp() override { direction_ = Direction::UP; }
+        void moveDown() override { direction_ = Direction::DOWN; }
+        void stop() override { direction_ = Direction::STOPPED; }
+        bool isActive() const override { return direction_ != Direction::STOPPED; }
+        Direction getCurrentDirection() const override { return direction_; }
+        bool isMovingUp() const override { return direction_ == Direction::UP; }
+        bool isMovingDown() const override { return direction_ == Direction::DOWN; }
+
+    private:
+        Direction direction_ = Direction::STOPPED;
+    };
+
+    /// Same edge semantics as ESP32Sensor: each query compares with the previous one
+    class HomeSwitch : public ISensor {
+    public:
+        explicit HomeSwitch(const WindlassPlant& plant) : plant_(plant) {}
+        bool isActive() const override { return plant_.rode_m_ <= plant_.params_.home_zone_m; }
+        bool justActivated() override {
+            bool current = isActive();
+            bool activated = current && !was_active_;
+            was_active_ = current;
+            return activated;
+        }
+        bool justDeactivated() override {
+            bool current = isActive();
+            bool deactivated = !current && was_active_;
+            was_active_ = current;
+            return deactivated;
+        }
+        void update() override {}
+
+    private:
+        const WindlassPlant& plant_;
+        bool was_active_ = false;  ///< Previous active state for edge detection
+    };
+
+    WindlassParams params_;
+    float rode_m_;                   ///< Chain out
+    float speed_ = 0.0f;             ///< Chain speed (+ = deploying)
+    int32_t last_pulse_index_ = 0;   ///< Pulse grid cell of the previous step
+    Motor motor_;
+    HomeSwitch home_;
+
+    float targetSpeed() const {
+        const float load = params_.load_per_m * rode_m_;
+        if (motor_.isMovingDown()) return params_.down_speed * (1.0f + load);
+        if (motor_.isMovingUp()) return -params_.up_speed * (1.0f - load);
+        return 0.0f;
+    }
+
+    int32_t pulseIndex(float rode_m) const {
+        return static_cast<int32_t>(std::floor(rode_m / params_.pitch_m));
+    }
+};
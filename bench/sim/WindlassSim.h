@@ -0,0 +1,301 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "sim/WindlassPlant.h"
+#include "pin_config.h"
+#include "services/ControlCommand.h"
+#include "services/StateManager.h"
+#include "util/MpscQueue.h"
+#include "util/RelaySequencer.h"
+#include "chain_motion_estimator.h"
+#include "winch_controller.h"
+#include "home_sensor.h"
+#include "automatic_mode_controller.h"
+
+/**
+ * @file WindlassSim.h
+ * @brief Closed-loop run of the real controllers against WindlassPlant
+ *
+ * A virtual clock advances in 1 ms plant steps; every CONTROL_PERIOD_MS the
+ * control tick runs like ControlLoopService/PulseCounterService on the
+ * target: drain the pulses, derive the rode length, handle the home switch,
+ * then AutomaticModeController::update(). No wall-clock time passes, so
+ * thousands of deploy/retrieve cycles take seconds on the host.
+ *
+ * The controller drives the plant through SimRelayStage, the winch
+ * RelaySequencer as in ESP32Motor, so the dead time and minimum off time of
+ * PinConfig::WINCH_RELAY_TIMING shape the motion as on the boat. The thermal
+ * budget is left out (relayTiming()): the runs cycle the windlass for hours
+ * without a break, far beyond its rating.
+ *
+ * runToTarget() arms a target (as the ARM_TARGET + AUTO_MODE commands do)
+ * and runs until the chain is at rest, returning overshoot and timing.
+ * submit() queues a command like ControlTask::submit(); it is applied in
+ * the 1 ms step it arrives in, as the woken control task does.
+ */
+
+/// ESP32Motor stand-in: RelaySequencer in front of the plant relays
+class SimRelayStage : public IMotor {
+public:
+    SimRelayStage(IMotor& relays, const RelayTiming& timing) : relays_(relays), sequencer_(timing) {}
+
+    void moveUp() override { drive(sequencer_.request(RelayOutput::A, now_ms_)); }
+    void moveDown() override { drive(sequencer_.request(RelayOutput::B, now_ms_)); }
+    void stop() override { drive(sequencer_.request(RelayOutput::OFF, now_ms_)); }
+    bool isActive() const override { return sequencer_.requested() != RelayOutput::OFF; }
+    Direction getCurrentDirection() const override {
+        return isMovingUp() ? Direction::UP : (isMovingDown() ? Direction::DOWN : Direction::STOPPED);
+    }
+    bool isMovingUp() const override { return sequencer_.requested() == RelayOutput::A; }
+    bool isMovingDown() const override { return sequencer_.requested() == RelayOutput::B; }
+
+    /// Advance the clock and run a due deferred transition (the relay timer on the target)
+    void update(uint32_t now_ms, uint32_t now_us) {
+        now_ms_ = now_ms;
+        now_us_ = now_us;
+        drive(sequencer_.update(now_ms));
+    }
+
+    /// @return Time of the last relay change (virtual us)
+    uint32_t lastEdgeUs() const { return last_edge_us_; }
+
+    /// @return Relay output driven to the plant
+    RelayOutput driven() const { return sequencer_.output(); }
+
+private:
+    IMotor& relays_;
+    RelaySequencer sequencer_;
+    RelayOutput driven_ = RelayOutput::OFF;
+    uint32_t now_ms_ = 0;
+    uint32_t now_us_ = 0;
+    uint32_t last_edge_us_ = 0;
+
+    void drive(RelayOutput output) {
+        if (output == driven_) return;
+        driven_ = output;
+        last_edge_us_ = now_us_;
+        if (output == RelayOutput::A) relays_.moveUp();
+        else if (output == RelayOutput::B) relays_.moveDown();
+        else relays_.stop();
+    }
+};
+
+/// Outcome of one automatic-mode move
+struct SimCycleResult {
+    float target_m = 0.0f;        ///< Armed target
+    float final_m = 0.0f;         ///< True rode length at rest
+    float overshoot_m = 0.0f;     ///< Distance past the target in the travel direction (>= 0)
+    uint32_t time_ms = 0;         ///< Arm to chain at rest
+    bool timed_out = false;       ///< Controller never declared the target reached
+};
+
+/// Aggregate over many cycles
+struct SimStats {
+    uint32_t cycles = 0;
+    uint32_t missed_stops = 0;    ///< |final - target| above the miss threshold, or timeout
+    float overshoot_sum_m = 0.0f;
+    float overshoot_max_m = 0.0f;
+    float abs_error_sum_m = 0.0f;
+    uint64_t time_sum_ms = 0;
+    uint32_t time_max_ms = 0;
+
+    void add(const SimCycleResult& result, float miss_threshold_m) {
+        const float abs_error = std::fabs(result.final_m - result.target_m);
+        cycles++;
+        if (result.timed_out || abs_error > miss_threshold_m) missed_stops++;
+        overshoot_sum_m += result.overshoot_m;
+        if (result.overshoot_m > overshoot_max_m) overshoot_max_m = result.overshoot_m;
+        abs_error_sum_m += abs_error;
+        time_sum_ms += result.time_ms;
+        if (result.time_ms > time_max_ms) time_max_ms = result.time_ms;
+    }
+
+    float meanOvershoot() const { return cycles ? overshoot_sum_m / cycles : 0.0f; }
+    float meanAbsError() const { return cycles ? abs_error_sum_m / cycles : 0.0f; }
+    float meanTimeMs() const { return cycles ? static_cast<float>(time_sum_ms) / cycles : 0.0f; }
+};
+
+class WindlassSim {
+public:
+    static constexpr uint32_t CONTROL_PERIOD_MS = 20;  ///< Same as ControlLoopService
+    static constexpr uint32_t TIMEOUT_MS = 600000;     ///< Give up on a move after 10 min
+
+    explicit WindlassSim(const WindlassParams& params = WindlassParams())
+        : plant_(params),
+          relays_(plant_.motor(), relayTiming()),
+          winch_(relays_, plant_.homeSwitch()),
+          home_(plant_.homeSwitch()),
+          controller_(winch_, home_) {
+        state_.setMetersPerPulse(params.pitch_m);
+        controller_.setTolerance(params.pitch_m * 2.0f);  // As BoatBowControlApp
+        controller_.setStopPrediction(true);
+    }
+
+    /// Advance the virtual clock to the next control tick and run it (plant in 1 ms steps)
+    void tick() {
+        do {
+            stepMs();
+        } while (now_ms_ % CONTROL_PERIOD_MS != 0);
+        controlTick();
+    }
+
+    /// Advance the virtual clock by ms, running the control ticks that fall due
+    void runMs(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            stepMs();
+            if (now_ms_ % CONTROL_PERIOD_MS == 0) {
+                controlTick();
+            }
+        }
+    }
+
+    /**
+     * @brief Queue a command (ControlTask::submit() with a woken control task)
+     * Handled: MANUAL_WINCH, STOP_ALL
+     * @return false if the queue was full
+     */
+    bool submit(ControlCommand command) {
+        command.arrival_us = now_us_;
+        return commands_.push(command);
+    }
+
+    /// @return Arrival time of the last applied command (virtual us)
+    uint32_t lastCommandUs() const { return last_command_us_; }
+
+    /**
+     * @brief Arm a target and run until the chain is at rest
+     */
+    SimCycleResult runToTarget(float target_m) {
+        SimCycleResult result;
+        result.target_m = target_m;
+        const float start_m = plant_.getRode();
+        const bool deploying = target_m > start_m;
+        const uint32_t start_ms = now_ms_;
+
+        controller_.setTargetLength(target_m);
+        controller_.setEnabled(true);
+        while (controller_.isEnabled() && now_ms_ - start_ms < TIMEOUT_MS) {
+            tick();
+        }
+        result.timed_out = controller_.isEnabled();
+        controller_.setEnabled(false);
+        // Coast out, then wait long enough for the coast learning to settle
+        uint32_t moving_ms = now_ms_;
+        while (now_ms_ - moving_ms < SETTLE_MS) {
+            tick();
+            if (!plant_.isStopped()) moving_ms = now_ms_;
+        }
+
+        result.final_m = plant_.getRode();
+        result.time_ms = moving_ms - start_ms;
+        const float past = deploying ? result.final_m - target_m : target_m - result.final_m;
+        result.overshoot_m = past > 0.0f ? past : 0.0f;
+        return result;
+    }
+
+    /// @return Controller under test
+    AutomaticModeController& controller() { return controller_; }
+
+    /// @return Winch controller (manual commands)
+    AnchorWinchController& winch() { return winch_; }
+
+    /// @return Relay stage between the winch controller and the plant
+    const SimRelayStage& relays() const { return relays_; }
+
+    /// @return Plant (true rode and speed)
+    const WindlassPlant& plant() const { return plant_; }
+
+    /// @return Virtual time (ms)
+    uint32_t nowMs() const { return now_ms_; }
+
+    /// Winch relay timing of the hardware profile without the thermal budget
+    static constexpr RelayTiming relayTiming() {
+        return {PinConfig::WINCH_RELAY_TIMING.dead_time_ms, PinConfig::WINCH_RELAY_TIMING.min_on_ms,
+                PinConfig::WINCH_RELAY_TIMING.min_off_ms, 0, 0};
+    }
+
+private:
+    /// Rest time after a move: longer than the controller's coast settle time
+    static constexpr uint32_t SETTLE_MS = AutomaticModeController::SETTLE_TIME_MS + 2 * CONTROL_PERIOD_MS;
+
+    WindlassPlant plant_;
+    SimRelayStage relays_;
+    StateManager state_;
+    ChainMotionEstimator motion_;
+    AnchorWinchController winch_;
+    HomeSensor home_;
+    AutomaticModeController controller_;
+    MpscQueue<ControlCommand, 16> commands_;  ///< As ControlTask::COMMAND_QUEUE_SIZE
+    uint32_t now_ms_ = 0;
+    uint32_t now_us_ = 0;
+    uint32_t last_command_us_ = 0;
+    float rode_m_ = 0.0f;            ///< Counted rode length
+
+    /// One plant millisecond: pulses, relay timer, commands of a woken control task
+    void stepMs() {
+        now_us_ += 1000;
+        now_ms_ += 1;
+        const int32_t pulses = plant_.step(0.001f);
+        if (pulses != 0) {
+            state_.addPulses(pulses);
+            state_.pushPulseEdge({now_us_, pulses});
+        }
+        relays_.update(now_ms_, now_us_);
+        drainCommands();
+    }
+
+    /// ControlTask::drainCommands() + execute() for the winch commands
+    void drainCommands() {
+        ControlCommand first;
+        if (!commands_.pop(first)) {
+            return;  // Nothing submitted: the control task was not woken
+        }
+        ControlCommand batch[16];
+        batch[0] = first;
+        size_t count = 1;
+        while (count < 16 && commands_.pop(batch[count])) {
+            count++;
+        }
+        count = coalesceCommands(batch, count);
+        for (size_t i = 0; i < count; i++) {
+            const ControlCommand& command = batch[i];
+            last_command_us_ = command.arrival_us;
+            if (command.type != ControlCommandType::MANUAL_WINCH) {
+                controller_.setEnabled(false);  // STOP_ALL
+                winch_.stop();
+                continue;
+            }
+            // As ControlTask::execute(): manual control overrides automatic mode
+            const int8_t direction = command.value > 0.5f ? 1 : (command.value < -0.5f ? -1 : 0);
+            controller_.handOver(direction);
+            if (direction > 0) {
+                winch_.moveUp();
+            } else if (direction < 0) {
+                winch_.moveDown();
+            } else {
+                winch_.stop();
+            }
+        }
+    }
+
+    /// The control period: pulse drain, rode, home switch, automatic mode
+    void controlTick() {
+        // PulseCounterService::update() + drain, minus the RTOS plumbing
+        PulseEdge edge;
+        while (state_.popPulseEdge(edge)) {
+            motion_.addEdge(edge, state_.getMetersPerPulse());
+        }
+        motion_.update(now_us_, state_.getMetersPerPulse(), winch_.isActive());
+        if (home_.isHome()) {
+            if (winch_.isMovingUp()) winch_.stop();
+            if (home_.justArrived()) state_.requestPulseReset();
+        } else {
+            home_.justLeft();
+        }
+        const PulseSnapshot snapshot = state_.drainPulses(now_ms_);
+        rode_m_ = snapshot.count * state_.getMetersPerPulse();
+
+        controller_.update(rode_m_, now_ms_);
+    }
+};
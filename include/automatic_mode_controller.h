@@ -2,6 +2,7 @@
 
 #include "winch_controller.h"
 #include "home_sensor.h"
+#include "util/ScopeTarget.h"
 
 /**
  * @file automatic_mode_controller.h
@@ -15,9 +16,33 @@
  * 
  * The controller uses a simple bang-bang control strategy with configurable
  * tolerance to prevent oscillation around the target.
+ * 
+ * Stop prediction (optional): the windlass keeps coasting after the relay
+ * opens. The controller estimates chain speed from successive rode lengths
+ * and cuts the relay once the remaining distance is within the predicted
+ * coast (coast coefficient [s] x speed [m/s]). After each predicted stop it
+ * waits for the chain to settle and learns the coefficient per direction
+ * from the measured residual.
+ * 
+ * Scope mode (optional): instead of a length, a scope ratio is armed and
+ * the target follows ratio x (depth + freeboard) from the filtered depth
+ * stream (ScopeTarget), recomputed on every update while deploying. A
+ * deploy is never reversed because the depth got shallower; it stops.
  */
 class AutomaticModeController {
 public:
+    /**
+     * @brief Callback type for learned coast coefficient updates
+     * Signature: void callback(float coast_up_s, float coast_down_s)
+     */
+    using CoastLearnedCallback = void(*)(float, float);
+
+    static constexpr unsigned long SPEED_WINDOW_MS = 100;   ///< Minimum window for a speed sample
+    static constexpr unsigned long SETTLE_TIME_MS = 1000;   ///< No movement for this long = settled
+    static constexpr float MIN_LEARN_SPEED = 0.02f;         ///< Minimum cut speed (m/s) to learn from
+    static constexpr float LEARN_RATE = 0.3f;               ///< Weight of each new coast measurement
+    static constexpr float MAX_COAST_S = 3.0f;              ///< Upper bound for a coast coefficient
+
     /**
      * @brief Construct automatic mode controller
      * @param winch Reference to winch controller (dependency injection)
@@ -32,6 +57,14 @@ public:
      */
     void setEnabled(bool enabled);
 
+    /**
+     * @brief Give the winch to a manual command: disable automatic mode if enabled
+     * @param direction Commanded direction (1 up, -1 down, 0 stop)
+     * @note The winch keeps running if it already moves in the commanded
+     *       direction, so the relay is not dropped and re-energised
+     */
+    void handOver(int8_t direction);
+
     /// @return true if automatic mode is currently enabled
     bool isEnabled() const;
 
@@ -44,6 +77,29 @@ public:
     /// @return Current target length in meters (-1 if no target set)
     float getTargetLength() const;
 
+    /**
+     * @brief Arm scope mode: target = ratio x (depth + freeboard)
+     * @param ratio Rode per depth (e.g. 5 for 5:1), <= 0 turns scope mode off
+     * @note setTargetLength() turns scope mode off again
+     */
+    void setScope(float ratio);
+
+    /// @return Armed scope ratio (0 = scope mode off)
+    float getScope() const;
+
+    /**
+     * @brief Set the freeboard added to the depth in scope mode
+     * @param meters Bow roller height above the water
+     */
+    void setFreeboard(float meters);
+
+    /**
+     * @brief Feed a depth reading (filtered, see ScopeTarget)
+     * @param depth_m Depth below the surface in meters
+     * @param now_ms Reading time (millis())
+     */
+    void setDepth(float depth_m, unsigned long now_ms);
+
     /**
      * @brief Set positioning tolerance
      * @param meters Tolerance in meters (default 0.2m)
@@ -51,6 +107,37 @@ public:
      */
     void setTolerance(float meters);
 
+    /**
+     * @brief Enable or disable predictive stop with coast compensation
+     * @param enabled true to cut the relay early by the predicted coast distance
+     */
+    void setStopPrediction(bool enabled);
+
+    /// @return true if predictive stop is enabled
+    bool isStopPredictionEnabled() const;
+
+    /**
+     * @brief Set learned coast coefficients (e.g. restored from configuration)
+     * @param coast_up_s Coast time constant when retrieving (seconds)
+     * @param coast_down_s Coast time constant when deploying (seconds)
+     */
+    void setCoastCoefficients(float coast_up_s, float coast_down_s);
+
+    /// @return Coast time constant when retrieving (seconds)
+    float getCoastUp() const;
+
+    /// @return Coast time constant when deploying (seconds)
+    float getCoastDown() const;
+
+    /// @return Estimated chain speed in m/s (positive = deploying)
+    float getChainSpeed() const;
+
+    /**
+     * @brief Register callback for learned coast coefficient updates
+     * @param callback Function to call after a coefficient was re-learned
+     */
+    void onCoastLearned(CoastLearnedCallback callback);
+
     /**
      * @brief Check and clear target reached flag
      * @return true if target was reached since last check
@@ -60,14 +147,19 @@ public:
     /**
      * @brief Update winch position to reach target (call periodically)
      * @param current_length Current rode length in meters
+     * @param now_ms Timestamp of the rode length sample (millis())
      * 
      * This method implements the control loop:
      * - If target is 0.0 (auto-home): only move up, stop is handled by home sensor
-     * - If at target (within tolerance): stop winch, disable automatic mode
+     * - If at target (within tolerance, or within predicted coast): stop winch,
+     *   disable automatic mode
      * - If below target: deploy more chain (move down)
      * - If above target: retrieve chain (move up)
+     * 
+     * Also tracks chain speed and, after a predicted stop, learns the coast
+     * coefficient once the chain has settled (even while disabled).
      */
-    void update(float current_length);
+    void update(float current_length, unsigned long now_ms);
 
 private:
     AnchorWinchController& winch_;     ///< Reference to anchor winch controller
@@ -76,4 +168,29 @@ private:
     float target_length_;              ///< Target rode length in meters
     float tolerance_;                  ///< Positioning tolerance in meters
     bool target_reached_;              ///< True when target reached since last check
+
+    // Scope mode
+    ScopeTarget scope_;                ///< Depth filter and scope target
+    float freeboard_m_ = 0.0f;         ///< Added to the depth in scope mode
+
+    // Stop prediction
+    bool stop_prediction_ = false;     ///< True when predictive stop is enabled
+    float coast_up_s_ = 0.0f;          ///< Learned coast time constant when retrieving
+    float coast_down_s_ = 0.0f;        ///< Learned coast time constant when deploying
+    float speed_ = 0.0f;               ///< Filtered chain speed in m/s (+ = deploying)
+    float last_length_ = 0.0f;         ///< Rode length at previous update
+    unsigned long last_update_ms_ = 0; ///< Time of previous update (0 = no sample yet)
+    CoastLearnedCallback coast_learned_callback_ = nullptr;  ///< Coefficient update callback
+
+    // Post-stop settling (learning)
+    bool settling_ = false;            ///< True while waiting for the chain to settle after a cut
+    bool settle_deploying_ = false;    ///< Direction of motion at the cut
+    float cut_length_ = 0.0f;          ///< Rode length when the relay was cut
+    float cut_speed_ = 0.0f;           ///< |speed| when the relay was cut
+    float settle_length_ = 0.0f;       ///< Last length seen while settling
+    unsigned long settle_since_ms_ = 0;  ///< Time the length last changed while settling
+
+    void trackSpeed(float current_length, unsigned long now_ms);
+    void updateSettling(float current_length, unsigned long now_ms);
+    float predictedCoast(bool deploying) const;
 };
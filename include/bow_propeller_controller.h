@@ -18,6 +18,8 @@
  * DESIGN: Prevents simultaneous port/starboard activation through internal
  * logic (writes HIGH to both relays before activating the desired direction).
  */
+#include <cstdint>
+
 class BowPropellerMotor;
 
 class BowPropellerController {
@@ -47,6 +49,18 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Proportional thrust
+     * @param thrust -1..1: + = starboard, - = port, 0 = stop
+     */
+    void setThrust(float thrust);
+
+    /// @return Commanded thrust (-1..1)
+    float getThrustSetpoint() const;
+
+    /// @return Achieved average thrust (-1..1), see BowPropellerMotor
+    float getAchievedThrust(uint32_t now_ms);
+
     /// @return true if propeller is currently active (moving in either direction)
     bool isActive() const;
 
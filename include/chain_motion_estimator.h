@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include "services/StateManager.h"
+
+/**
+ * @file chain_motion_estimator.h
+ * @brief Period-based chain speed, acceleration and stall estimation
+ *
+ * Consumes timestamped pulse edges (PulseEdge) instead of sampled counts:
+ * - Speed = pulses x meters_per_pulse / time between edges, so resolution
+ *   does not depend on the poll rate (good at low speed)
+ * - When no edge arrives, speed is bounded by one pulse over the time since
+ *   the last edge and falls to 0 after STOP_TIMEOUT_US
+ * - Acceleration is the low-pass filtered derivative of speed
+ * - Stall = winch energised but no edge for STALL_TIMEOUT_US
+ *
+ * No allocation; all state is a handful of scalars.
+ */
+class ChainMotionEstimator {
+public:
+    static constexpr uint32_t STOP_TIMEOUT_US = 1000000;   ///< No edge for 1 s = stopped
+    static constexpr uint32_t STALL_TIMEOUT_US = 1500000;  ///< Energised without edges = stalled
+    static constexpr float SPEED_FILTER = 0.5f;            ///< Speed low-pass weight per edge
+    static constexpr float ACCEL_FILTER = 0.2f;            ///< Acceleration low-pass weight per edge
+
+    /**
+     * @brief Feed one pulse edge record
+     * @param edge Timestamped pulse record (pulses may be > 1 for hardware batches)
+     * @param meters_per_pulse Calibration factor
+     */
+    void addEdge(const PulseEdge& edge, float meters_per_pulse);
+
+    /**
+     * @brief Apply timeouts (call once per tick after feeding edges)
+     * @param now_us Current time in microseconds
+     * @param meters_per_pulse Calibration factor
+     * @param winch_active true while a winch relay is energised
+     */
+    void update(uint32_t now_us, float meters_per_pulse, bool winch_active);
+
+    /// @return Chain speed in m/s (positive = deploying, negative = retrieving)
+    float getSpeed() const { return speed_; }
+
+    /// @return Filtered chain acceleration in m/s^2
+    float getAcceleration() const { return acceleration_; }
+
+    /// @return true if the winch is energised but the chain is not moving
+    bool isStalled() const { return stalled_; }
+
+private:
+    bool has_edge_ = false;          ///< True once an edge has been seen
+    uint32_t last_edge_us_ = 0;      ///< Timestamp of the previous edge
+    int last_direction_ = 0;         ///< Sign of the previous edge (+1 out, -1 in)
+    float speed_ = 0.0f;             ///< Filtered speed in m/s
+    float acceleration_ = 0.0f;      ///< Filtered acceleration in m/s^2
+    bool was_active_ = false;        ///< Winch state at previous update
+    uint32_t active_since_us_ = 0;   ///< Time the winch was energised
+    bool stalled_ = false;           ///< Stall flag
+};
@@ -1,18 +1,43 @@
 #pragma once
 
 #include "../pin_config.h"
+#include "../util/ThrustPattern.h"
+#include "ESP32RelayPair.h"
 
 /**
  * @file ESP32BowPropellerMotor.h
  * @brief ESP32 GPIO implementation for bow propeller (thruster) control
  * 
  * Manages two independent relay outputs:
- * - GPIO 4 (PinConfig::BOW_PORT): Port thruster relay
- * - GPIO 5 (PinConfig::BOW_STARBOARD): Starboard thruster relay
+ * - PinConfig::BOW_PORT: Port thruster relay
+ * - PinConfig::BOW_STARBOARD: Starboard thruster relay
  * 
- * Both relays use active-LOW logic:
- * - Write LOW to activate relay
- * - Write HIGH to deactivate relay (safe default state)
+ * Both relays use the profile's active level (PinConfig::RELAY_ACTIVE_LOW;
+ * inactive is the safe default state).
+ *
+ * The relays are driven through ESP32RelayPair: with RELAY_USE_SEQUENCER=1
+ * a port/starboard reversal waits for the dead time and the thruster trips
+ * off after its duty budget (typical DC thrusters are rated for about
+ * 3 minutes per hour). PinConfig::BOW_RELAY_TIMING must match the
+ * installed thruster.
+ *
+ * Proportional thrust (setThrust(), -1..1) depends on PinConfig::BOW_DRIVE:
+ * - RELAY_PULSE: a ThrustPattern of on-pulses on the direction relay. Each
+ *   edge is executed by a one-shot esp_timer (hardware timer backed) armed
+ *   for the pattern's next edge, so control loop jitter does not bend the
+ *   duty cycle. The pulses go through the relay pair, so dead time, min off
+ *   and the thermal budget apply to every pulse; a thermal trip or a
+ *   supervisor relay cut ends the pattern (also at full thrust, where no
+ *   pattern timer runs), so the thruster reads as stopped until the next
+ *   command.
+ * - PWM: the direction relay stays closed and an LEDC channel drives the
+ *   speed controller input (PinConfig::BOW_PWM) with |thrust| as duty. The
+ *   thermal budget counts the relay time, i.e. as full thrust.
+ * turnPort()/turnStarboard() are full thrust (-1 / 1).
+ *
+ * getAchievedThrust() is the average over the last window measured at the
+ * relays (times the PWM duty), so it shows what the thruster really got:
+ * quantised pulses, dead time and trips included.
  * 
  * DESIGN PRINCIPLE: Dependency Inversion
  * - This concrete implementation handles hardware details
@@ -28,6 +53,9 @@ public:
         STARBOARD   ///< Turning to starboard (right)
     };
 
+    /// Contactor/thermal limits of the installed thruster (hardware profile)
+    static constexpr RelayTiming RELAY_TIMING = PinConfig::BOW_RELAY_TIMING;
+
     /**
      * @brief Initialize GPIO pins for bow propeller relays
      * Sets pins to OUTPUT mode and ensures both relays start in inactive state.
@@ -52,6 +80,30 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Proportional thrust (see file comment)
+     * @param thrust -1..1: + = starboard, - = port, 0 = stop
+     */
+    void setThrust(float thrust);
+
+    /// @return Commanded thrust (-1..1, 0 after a trip)
+    float getThrustSetpoint() const;
+
+    /**
+     * @brief Achieved average thrust (control side, once per step)
+     * @param now_ms millis()
+     * @return -1..1 over the last ACHIEVED_WINDOW_MS (+ = starboard)
+     */
+    float getAchievedThrust(uint32_t now_ms);
+
+    /// Pulse pattern of the hardware profile
+    static constexpr ThrustPatternTiming PULSE_TIMING = PinConfig::BOW_PULSE_TIMING;
+    /// Averaging window of getAchievedThrust() (one pattern period)
+    static constexpr uint32_t ACHIEVED_WINDOW_MS =
+        PinConfig::BOW_DRIVE == BowThrusterDrive::PWM ? 500 : PULSE_TIMING.period_ms;
+    static constexpr uint8_t PWM_CHANNEL = 0;          ///< LEDC channel (BowThrusterDrive::PWM)
+    static constexpr uint8_t PWM_RESOLUTION_BITS = 10;
+
     /**
      * @brief Get whether propeller is currently active
      * @return true if either port or starboard is active
@@ -76,10 +128,37 @@ public:
      */
     bool isTurningStarboard() const;
 
+    /**
+     * @brief Check whether the thruster is locked out after a thermal trip
+     * @return true while starts are refused
+     */
+    bool isThermalLockout() const { return relays_.isThermalLockout(); }
+
+    /// @return Thermal trips since boot
+    uint32_t getThermalTrips() const { return relays_.getThermalTrips(); }
+
 private:
-    bool active_ = false;                           ///< True if propeller is currently active
-    Direction current_direction_ = Direction::STOPPED;  ///< Current turning direction
+    ESP32RelayPair relays_{PinConfig::BOW_PORT, PinConfig::BOW_STARBOARD, RELAY_TIMING, "bow_relays"};
     unsigned long last_stop_log_ms_ = 0;            ///< Throttle logging
+    int8_t logged_direction_ = 0;                   ///< Direction of the last log and statistics call
+
+    ThrustPattern pattern_{PULSE_TIMING};           ///< RELAY_PULSE pattern; setpoint in PWM mode
+    esp_timer_handle_t pattern_timer_ = nullptr;    ///< Next pattern edge (RELAY_PULSE)
+    mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;  ///< Caller vs. pattern timer
+
+    // Achieved thrust window (control side)
+    uint32_t window_start_ms_ = 0;
+    uint32_t window_a_ms_ = 0;
+    uint32_t window_b_ms_ = 0;
+    float achieved_ = 0.0f;
+
+    /// Drive the output due now and arm the timer for the next edge; lock held
+    void applyPattern(uint32_t now_ms);
+
+    static void onPatternTimer(void* arg);
+
+    /// Relay pair tripped off: the commanded thrust ends (timer task)
+    static void onRelaysTripped(void* arg);
 
     /**
      * @brief Throttled logging of propeller stop events
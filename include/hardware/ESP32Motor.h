@@ -2,20 +2,47 @@
 
 #include "../interfaces/IMotor.h"
 #include "../pin_config.h"
+#include "ESP32RelayPair.h"
+#include "../util/OperationCounters.h"
 
 /**
  * @file ESP32Motor.h
  * @brief ESP32 GPIO implementation of IMotor interface
  * 
  * Concrete implementation for controlling motor relays via GPIO pins.
- * Uses active-LOW logic: write LOW to activate, HIGH to deactivate.
+ * Pins, active level and relay timing come from the hardware profile
+ * (PinConfig).
+ *
+ * The relays are driven through ESP32RelayPair: with RELAY_USE_SEQUENCER=1
+ * a reversal waits for the dead time and the motor trips off when its duty
+ * budget is used up. isActive()/getCurrentDirection() report the accepted
+ * command, so a pending start reads as running and a thermal trip as
+ * stopped. PinConfig::WINCH_RELAY_TIMING must match the installed windlass
+ * motor rating.
  * 
  * This implementation is specific to ESP32 with the pin configuration
  * defined in PinConfig. Other platforms would have different implementations
- * but all would implement the IMotor interface.
+ * but all would implement the IMotor interface. The class is final: with
+ * HARDWARE_STATIC_DISPATCH=1 the winch controller holds it by its concrete
+ * type and the calls are resolved at compile time.
  */
-class ESP32Motor : public IMotor {
+class ESP32Motor final : public IMotor {
 public:
+    /// Contactor/thermal limits of the installed windlass (hardware profile)
+    static constexpr RelayTiming RELAY_TIMING = PinConfig::WINCH_RELAY_TIMING;
+
+    /**
+     * @param pin_up Relay that retrieves (default: the primary windlass)
+     * @param pin_down Relay that deploys
+     * @param stats Run-time statistics slot (OperationMotor::COUNT = not counted)
+     * @param name Relay timer name (debugging)
+     * @param command_probes Record the command-to-relay latency (primary windlass)
+     */
+    explicit ESP32Motor(uint8_t pin_up = PinConfig::WINCH_UP, uint8_t pin_down = PinConfig::WINCH_DOWN,
+                        OperationMotor stats = OperationMotor::WINCH, const char* name = "winch_relays",
+                        bool command_probes = true)
+        : relays_(pin_up, pin_down, RELAY_TIMING, name, command_probes), stats_(stats) {}
+
     /**
      * @brief Initialize GPIO pins for motor control
      * Sets pins to OUTPUT mode and ensures motor starts in stopped state.
@@ -32,9 +59,12 @@ public:
     bool isMovingUp() const override;
     bool isMovingDown() const override;
 
+    /// @return Thermal trips since boot
+    uint32_t getThermalTrips() const { return relays_.getThermalTrips(); }
+
 private:
-    bool active_ = false;                    ///< True if motor is currently active
-    Direction current_direction_ = Direction::STOPPED;  ///< Current movement direction
+    ESP32RelayPair relays_;
+    OperationMotor stats_;                   ///< Statistics slot of this windlass
     unsigned long last_stop_log_ms_ = 0;     ///< Throttle logging
     
     /**
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../interfaces/IPulseSource.h"
+#include "../pin_config.h"
+#include "../util/WakeEdgeRecovery.h"
+
+/**
+ * @file ESP32PulseCounter.h
+ * @brief ESP32 PCNT (pulse counter peripheral) implementation of IPulseSource
+ *
+ * Counts chain counter pulses in hardware instead of one interrupt per pulse:
+ * - PinConfig::PULSE_INPUT is the count input (rising edge counts); each
+ *   windlass channel uses its own pins and PCNT unit
+ * - PinConfig::DIRECTION is the control input (count up / chain out at the
+ *   level given by PinConfig::DIRECTION_OUT_HIGH, count down / chain in at
+ *   the other)
+ * - The PCNT glitch filter rejects pulses shorter than the filter window
+ *
+ * The 16-bit hardware counter is extended in software: the unit raises an
+ * event at ±COUNTER_LIMIT, resets itself and the (tiny) event ISR folds the
+ * limit into an overflow accumulator. takeDelta() combines both.
+ *
+ * PCNT does not count in light sleep: PowerManager arms the count input as
+ * a wake source (armWake()) and reports the edge that woke the CPU
+ * (wakeEdgeFromIsr()); takeDelta() adds it back if the unit missed it.
+ *
+ * Selected at build time with PULSE_COUNTER_USE_PCNT=1 (see platformio.ini).
+ * Without it the legacy GPIO pulse ISR in BoatBowControlApp is used, which
+ * keeps the native test environment free of ESP-IDF dependencies.
+ */
+
+#ifndef PULSE_COUNTER_USE_PCNT
+#define PULSE_COUNTER_USE_PCNT 0
+#endif
+
+#if PULSE_COUNTER_USE_PCNT
+
+#include "driver/pcnt.h"
+
+class ESP32PulseCounter : public IPulseSource {
+public:
+    /// Hardware counter range before the overflow event fires
+    static constexpr int16_t COUNTER_LIMIT = 30000;
+
+    /// Glitch filter length in APB clock cycles (80 MHz, max 1023 = 12.8 us)
+    static constexpr uint16_t GLITCH_FILTER_CYCLES = 1023;
+
+    /**
+     * @param pulse_pin Count input (default: the primary windlass)
+     * @param direction_pin Direction control input
+     * @param unit PCNT unit, one per windlass channel
+     */
+    explicit ESP32PulseCounter(uint8_t pulse_pin = PinConfig::PULSE_INPUT,
+                               uint8_t direction_pin = PinConfig::DIRECTION,
+                               pcnt_unit_t unit = PCNT_UNIT_0)
+        : pulse_pin_(pulse_pin), direction_pin_(direction_pin), unit_(unit) {}
+
+    /**
+     * @brief Configure the PCNT unit, glitch filter and overflow event
+     * Must be called during setup() before takeDelta() is used.
+     */
+    void initialize();
+
+    // IPulseSource implementation
+    long takeDelta() override;
+
+    /// @return Count input pin
+    uint8_t pulsePin() const { return pulse_pin_; }
+
+    /**
+     * @brief The count input is about to be armed as a light sleep wake source
+     */
+    void armWake() { wake_recovery_.arm(readTotal()); }
+
+    /**
+     * @brief A counted (rising) edge of the armed input woke the CPU (ISR, IRAM)
+     */
+    void wakeEdgeFromIsr();
+
+private:
+    uint8_t pulse_pin_;
+    uint8_t direction_pin_;
+    pcnt_unit_t unit_;
+    volatile long overflow_ = 0;   ///< Accumulated ±COUNTER_LIMIT wraps (written by ISR)
+    long last_total_ = 0;          ///< Total count at the previous takeDelta()
+    WakeEdgeRecovery wake_recovery_;  ///< Edge lost in light sleep
+
+    /**
+     * @brief PCNT limit event handler (ISR context)
+     */
+    static void overflowISR(void* arg);
+
+    /**
+     * @brief Read overflow accumulator and hardware counter consistently
+     * @return Total pulse count since initialize()
+     */
+    long readTotal() const;
+};
+
+#endif  // PULSE_COUNTER_USE_PCNT
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include "../util/RelaySequencer.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+/**
+ * @file ESP32RelayPair.h
+ * @brief Two reversing relays driven through a RelaySequencer
+ *
+ * With RELAY_USE_SEQUENCER=1 every command passes through the sequencer, so
+ * the reversal dead-time, minimum on/off times and thermal duty budget are
+ * enforced below the controllers (a stop is always immediate). Deferred
+ * transitions are executed by a one-shot esp_timer (hardware timer backed)
+ * armed for the sequencer's next event, independent of the control loop
+ * rate. A spinlock serialises the caller and the timer task.
+ *
+ * With RELAY_USE_SEQUENCER=0 commands are written to the pins directly
+ * (legacy behaviour, other relay off first).
+ *
+ * The primary winch pair (command_probes) ends the armed command-to-relay
+ * latency measurements (PerfMonitor::arm()) when it drives a relay on, so
+ * the figure includes dead time and deferred starts.
+ *
+ * Outputs are switched with single writes to the GPIO.out set/clear
+ * registers; the pin masks are precomputed and the active level is
+ * PinConfig::RELAY_ACTIVE_LOW, resolved at compile time.
+ */
+
+#ifndef RELAY_USE_SEQUENCER
+#define RELAY_USE_SEQUENCER 0
+#endif
+
+class ESP32RelayPair {
+public:
+    /**
+     * @param pin_a Relay for RelayOutput::A (GPIO.out bank)
+     * @param pin_b Relay for RelayOutput::B (GPIO.out bank)
+     * @param timing Contactor and thermal limits of the actuator
+     * @param name Timer name (debugging)
+     * @param command_probes End the armed command-to-relay probes on a relay-on edge
+     */
+    ESP32RelayPair(uint8_t pin_a, uint8_t pin_b, const RelayTiming& timing, const char* name,
+                   bool command_probes = false);
+
+    /**
+     * @brief Configure both pins as outputs, relays off, create the timer
+     */
+    void initialize();
+
+    /**
+     * @brief Command an output (OFF applies immediately)
+     * @return Output driven after the call (may still be OFF while waiting)
+     */
+    RelayOutput request(RelayOutput output);
+
+    /// @return Accepted command (OFF after a thermal trip); a pending start counts as running
+    RelayOutput commanded() const;
+
+    /// @return Output currently driven on the pins
+    RelayOutput output() const;
+
+    /// @return true while starts are refused after a thermal trip
+    bool isThermalLockout() const;
+
+    /// @return Thermal trips since boot
+    uint32_t getThermalTrips() const;
+
+    /**
+     * @brief Time each relay was driven since boot, including a running pulse
+     * Measured at the pins (dead time, deferred starts and trips included)
+     */
+    void onTime(uint32_t& a_ms, uint32_t& b_ms) const;
+
+    /// Called when the pair trips off (timer task, lock released)
+    using TripHandler = void (*)(void* context);
+
+    /**
+     * @brief Be told of a thermal trip executed by the timer
+     * A trip inside request() shows in isThermalLockout() on return instead.
+     * Must be called during setup()
+     */
+    void setTripHandler(TripHandler handler, void* context) {
+        trip_handler_ = handler;
+        trip_context_ = context;
+    }
+
+private:
+    uint8_t pin_a_;
+    uint8_t pin_b_;
+    uint32_t mask_a_;
+    uint32_t mask_b_;
+    const char* name_;
+    bool command_probes_;
+    RelaySequencer sequencer_;
+    RelayOutput driven_ = RelayOutput::OFF;       ///< Last output written to the pins
+    uint32_t driven_since_ms_ = 0;                ///< Time driven_ was written
+    uint32_t on_a_ms_ = 0;                        ///< Completed on-time of relay A
+    uint32_t on_b_ms_ = 0;                        ///< Completed on-time of relay B
+    esp_timer_handle_t timer_ = nullptr;          ///< Deferred transition timer
+    TripHandler trip_handler_ = nullptr;          ///< Owner of the commanded output
+    void* trip_context_ = nullptr;
+    mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+
+    /// Write an output to the pins (opens the other relay first); lock held
+    void drive(RelayOutput output);
+
+    /// Re-arm the timer for the sequencer's next event; lock held
+    void armTimer(uint32_t now_ms);
+
+    static void onTimer(void* arg);
+};
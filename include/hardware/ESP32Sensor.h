@@ -3,6 +3,7 @@
 #include "Arduino.h"
 #include "../interfaces/ISensor.h"
 #include "../pin_config.h"
+#include "GpioSnapshot.h"
 
 /**
  * @file ESP32Sensor.h
@@ -11,22 +12,35 @@
  * Concrete implementation for reading sensor states via GPIO pins.
  * Handles edge detection (justActivated/justDeactivated) automatically.
  * 
- * Uses active-LOW logic by default (sensor is active when pin reads LOW).
- * This template can be instantiated with different pins.
+ * Uses active-LOW logic by default (sensor is active when pin reads LOW,
+ * input pull-up); active_low = false selects active-HIGH with a pull-down.
+ * One type serves every pin, so the home sensors of all windlass channels
+ * share a controller instantiation. The class is final, so calls through
+ * the concrete type are resolved at compile time.
+ *
+ * The level comes from the per-tick GpioSnapshot, so every query within
+ * one loop pass sees the same value.
  * 
  * Example usage:
- *   ESP32Sensor<PinConfig::ANCHOR_HOME> home_sensor;
+ *   ESP32Sensor home_sensor{PinConfig::ANCHOR_HOME, PinConfig::HOME_ACTIVE_LOW};
  */
-template <uint8_t PIN>
-class ESP32Sensor : public ISensor {
+class ESP32Sensor final : public ISensor {
 public:
+    /**
+     * @param pin GPIO number (input capable)
+     * @param active_low true if the sensor pulls the line LOW when active
+     */
+    explicit ESP32Sensor(uint8_t pin, bool active_low = true) : pin_(pin), active_low_(active_low) {}
+
     /**
      * @brief Initialize GPIO pin for sensor reading
-     * Sets pin to INPUT_PULLUP mode and reads initial state.
+     * Sets pin to INPUT_PULLUP (active-LOW) or INPUT_PULLDOWN mode and
+     * reads initial state.
      * Must be called during setup() before using sensor.
      */
     void initialize() {
-        pinMode(PIN, INPUT_PULLUP);
+        pinMode(pin_, active_low_ ? INPUT_PULLUP : INPUT_PULLDOWN);
+        GpioSnapshot::capture();
         was_active_ = readState();
     }
 
@@ -55,19 +69,23 @@ public:
         // but the state is automatically updated when querying status
     }
 
+    /// @return GPIO number
+    uint8_t pin() const { return pin_; }
+
 private:
+    uint8_t pin_;               ///< GPIO number
+    bool active_low_;           ///< Active level
     bool was_active_ = false;   ///< Previous active state for edge detection
 
     /**
-     * @brief Read the actual sensor state from GPIO
-     * @return true if sensor is active (pin reads LOW)
+     * @brief Read the sensor state from the current GPIO snapshot
+     * @return true if sensor is active (pin at its active level)
      * 
-     * ACTIVE-LOW logic: 
+     * ACTIVE-LOW logic (default): 
      * - LOW (0V) = sensor active
      * - HIGH (3.3V) = sensor inactive
      */
     bool readState() const {
-        // This sensor uses active-LOW logic (LOW = active)
-        return digitalRead(PIN) == LOW;
+        return GpioSnapshot::level(pin_) != active_low_;
     }
 };
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include "Arduino.h"
+#include "soc/gpio_struct.h"
+#include "hal/cpu_hal.h"
+
+/**
+ * @file GpioSnapshot.h
+ * @brief One consistent read of all ESP32 GPIO input levels per tick
+ *
+ * capture() copies the GPIO input registers (GPIO.in for pins 0-31,
+ * GPIO.in1 for pins 32-39) into a 64-bit mask once per main loop pass.
+ * Sensors and the remote then read their bit from the mask instead of
+ * calling digitalRead(), so all inputs are seen at the same instant and the
+ * hot loop makes two register reads instead of one HAL call per query.
+ *
+ * level<PIN>() resolves the register word and bit at compile time.
+ * readPin() reads the live register for ISR use, where a snapshot would be
+ * stale. edgeCycles() gives the cycle count of the capture in which a pin
+ * last changed (latency instrumentation).
+ *
+ * Only valid for pins configured as inputs (output-only pads read 0).
+ */
+class GpioSnapshot {
+public:
+    /**
+     * @brief Latch all input levels (call once per main loop pass)
+     */
+    static void capture() {
+        uint32_t low = GPIO.in;
+        uint32_t high = GPIO.in1.data;
+        uint32_t now = cpu_hal_get_cycle_count();
+        markChanges(low ^ low_, 0, now);
+        markChanges(high ^ high_, 32, now);
+        low_ = low;
+        high_ = high;
+        capture_cycles_ = now;
+        sequence_++;
+    }
+
+    /**
+     * @brief Level of PIN in the last snapshot
+     * @tparam PIN GPIO number (0-39)
+     * @return true if the pin read HIGH
+     */
+    template <uint8_t PIN>
+    static bool level() {
+        static_assert(PIN < 40, "ESP32 GPIO number out of range");
+        if constexpr (PIN < 32) {
+            return (low_ >> PIN) & 1U;
+        } else {
+            return (high_ >> (PIN - 32)) & 1U;
+        }
+    }
+
+    /**
+     * @brief Level of a runtime-selected pin in the last snapshot
+     * @param pin GPIO number (0-39)
+     * @return true if the pin read HIGH
+     */
+    static bool level(uint8_t pin) {
+        return pin < 32 ? (low_ >> pin) & 1U : (high_ >> (pin - 32)) & 1U;
+    }
+
+    /**
+     * @brief Live level straight from the input register (ISR-safe, IRAM)
+     * @param pin GPIO number (0-39)
+     * @return true if the pin reads HIGH now
+     */
+    static inline bool IRAM_ATTR readPin(uint8_t pin) {
+        return pin < 32 ? (GPIO.in >> pin) & 1U : (GPIO.in1.data >> (pin - 32)) & 1U;
+    }
+
+    /**
+     * @brief Cycle count of the capture in which pin last changed level
+     * @param pin GPIO number (0-39)
+     */
+    static uint32_t edgeCycles(uint8_t pin) { return edge_cycles_[pin]; }
+
+    /// @return Cycle count of the last capture
+    static uint32_t captureCycles() { return capture_cycles_; }
+
+    /// @return Number of captures so far (changes whenever the snapshot is refreshed)
+    static uint32_t sequence() { return sequence_; }
+
+private:
+    static inline uint32_t low_ = 0;       ///< Pins 0-31
+    static inline uint32_t high_ = 0;      ///< Pins 32-39
+    static inline uint32_t sequence_ = 0;  ///< Capture counter
+    static inline uint32_t capture_cycles_ = 0;  ///< Cycle count of the last capture
+    static inline uint32_t edge_cycles_[40] = {};  ///< Capture cycle count of each pin's last change
+
+    static void markChanges(uint32_t changed, uint8_t base, uint32_t now) {
+        while (changed) {
+            edge_cycles_[base + __builtin_ctz(changed)] = now;
+            changed &= changed - 1;  // Only changed bits are visited
+        }
+    }
+};
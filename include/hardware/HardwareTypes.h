@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * @file HardwareTypes.h
+ * @brief Motor and sensor types the controllers are instantiated with
+ *
+ * With HARDWARE_STATIC_DISPATCH=1 (device builds) the controllers hold the
+ * ESP32 drivers by their concrete, final types (pins from the hardware
+ * profile, one type for every windlass channel): motor and sensor calls are resolved at compile time and the relay
+ * writes inline into the controller. With 0 (native tests, benchmarks and
+ * the simulator) they hold the IMotor / ISensor interfaces so mocks can be
+ * injected.
+ */
+
+#ifndef HARDWARE_STATIC_DISPATCH
+#define HARDWARE_STATIC_DISPATCH 0
+#endif
+
+#if HARDWARE_STATIC_DISPATCH
+#include "ESP32Motor.h"
+#include "ESP32Sensor.h"
+
+using WinchMotor = ESP32Motor;
+using HomeSensorInput = ESP32Sensor;
+#else
+#include "../interfaces/IMotor.h"
+#include "../interfaces/ISensor.h"
+
+using WinchMotor = IMotor;
+using HomeSensorInput = ISensor;
+#endif
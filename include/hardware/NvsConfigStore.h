@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Preferences.h>
+#include "../interfaces/IConfigStore.h"
+
+/**
+ * @file NvsConfigStore.h
+ * @brief NVS (Preferences) backend for the runtime configuration record
+ *
+ * The record is one blob "runtime" in the "config" namespace: a single
+ * NVS lookup at boot instead of mounting SPIFFS, hashing paths and parsing
+ * JSON. NVS writes are atomic per key, so a power loss leaves either the
+ * old or the new record.
+ */
+class NvsConfigStore : public IConfigStore {
+public:
+    /**
+     * @brief Open the NVS namespace
+     * @return false if NVS is not available
+     */
+    bool initialize();
+
+    bool read(RuntimeConfig& config) override;
+    bool write(const RuntimeConfig& config) override;
+
+private:
+    Preferences preferences_;  ///< NVS handle
+    bool ready_ = false;       ///< Namespace opened
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Preferences.h>
+#include "../interfaces/IRodeStore.h"
+
+/**
+ * @file NvsRodeStore.h
+ * @brief NVS (Preferences) backend for the rode counter journal
+ *
+ * Each journal slot is a 16-byte blob "s0".."s7" in the "rode" namespace.
+ * NVS is itself log-structured and wear-levelled across its pages; the
+ * journal ring keeps successive writes on different keys on top of that.
+ *
+ * Networking side only: NVS writes block for milliseconds.
+ */
+class NvsRodeStore : public IRodeStore {
+public:
+    /**
+     * @brief Open the NVS namespace
+     * @return false if NVS is not available (journal disabled)
+     */
+    bool initialize();
+
+    bool readSlot(size_t slot, RodeRecord& record) override;
+    bool writeSlot(size_t slot, const RodeRecord& record) override;
+
+private:
+    Preferences preferences_;  ///< NVS handle
+    bool ready_ = false;       ///< Namespace opened
+
+    static void slotKey(size_t slot, char (&key)[4]);
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Preferences.h>
+#include "../interfaces/IStatsStore.h"
+
+/**
+ * @file NvsStatsStore.h
+ * @brief NVS (Preferences) backend for the lifetime operation statistics
+ *
+ * The record is one blob "lifetime" in the "stats" namespace. NVS writes
+ * are atomic per key, so a power loss leaves either the old or the new
+ * record.
+ *
+ * Networking side only: NVS writes block for milliseconds.
+ */
+class NvsStatsStore : public IStatsStore {
+public:
+    /**
+     * @brief Open the NVS namespace
+     * @return false if NVS is not available (statistics kept per session only)
+     */
+    bool initialize();
+
+    bool read(OperationStatsRecord& record) override;
+    bool write(const OperationStatsRecord& record) override;
+
+private:
+    Preferences preferences_;  ///< NVS handle
+    bool ready_ = false;       ///< Namespace opened
+};
@@ -1,45 +1,53 @@
 #pragma once
 
-#include "interfaces/ISensor.h"
+#include "hardware/HardwareTypes.h"
 
 /**
  * @file home_sensor.h
  * @brief Semantic wrapper for home position sensor
  * 
  * This class provides business-logic semantics around a generic sensor.
- * It depends on ISensor interface, allowing any sensor implementation.
+ * It is parameterised on the sensor type; HomeSensor is the instantiation
+ * of this build (HardwareTypes.h), allowing any sensor implementation.
  * 
  * DESIGN PRINCIPLE: Composition over Inheritance
- * - Uses ISensor for hardware abstraction
+ * - Uses ISensor (or a concrete driver) for hardware abstraction
  * - Provides domain-specific methods (isHome, justArrived, justLeft)
  * - Testable with mock sensors
  */
-class HomeSensor {
+template <typename Sensor>
+class BasicHomeSensor {
 public:
     /**
      * @brief Construct home sensor wrapper
      * @param sensor Reference to sensor implementation (e.g., ESP32Sensor<PIN>)
      */
-    HomeSensor(ISensor& sensor) : sensor_(sensor) {}
+    BasicHomeSensor(Sensor& sensor) : sensor_(sensor) {}
 
     /**
      * @brief Check if anchor is currently at home position
      * @return true if anchor is at home
      */
-    bool isHome() const;
+    bool isHome() const { return sensor_.isActive(); }
 
     /**
      * @brief Detect if anchor just arrived at home
      * @return true if anchor just transitioned to home position
      */
-    bool justArrived();
+    bool justArrived() { return sensor_.justActivated(); }
 
     /**
      * @brief Detect if anchor just left home position
      * @return true if anchor just left home position
      */
-    bool justLeft();
+    bool justLeft() { return sensor_.justDeactivated(); }
 
 private:
-    ISensor& sensor_;  ///< Underlying sensor implementation
+    Sensor& sensor_;  ///< Underlying sensor implementation
 };
+
+#if !HARDWARE_STATIC_DISPATCH
+extern template class BasicHomeSensor<ISensor>;  // home_sensor.cpp
+#endif
+
+using HomeSensor = BasicHomeSensor<HomeSensorInput>;
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file IConfigStore.h
+ * @brief Abstract storage for the binary runtime configuration record
+ *
+ * The values the firmware needs at runtime are kept as one fixed-size
+ * record, read once at boot. The ESP32 implementation (NvsConfigStore)
+ * keeps it as a single NVS blob; SensESP's JSON files remain only as the
+ * web UI representation.
+ *
+ * DESIGN PRINCIPLE: Dependency Inversion
+ * - ConfigBlob depends on this abstraction
+ * - NVS backend implements it
+ * - Enables testing versioning and CRC checks with an in-memory store
+ */
+
+/**
+ * @brief Runtime configuration record (plain aggregate, stored as raw bytes)
+ */
+struct RuntimeConfig {
+    uint32_t magic;          ///< RUNTIME_CONFIG_MAGIC when written by this firmware
+    uint16_t version;        ///< RUNTIME_CONFIG_VERSION of the layout
+    uint16_t flags;          ///< RuntimeConfigFlag bits
+    float meters_per_pulse;  ///< Chain counter calibration
+    float coast_up_s;        ///< Learned coast when retrieving (s per m/s)
+    float coast_down_s;      ///< Learned coast when deploying (s per m/s)
+    float rode_deadband;     ///< Rode change (m) that triggers a SignalK update
+    float freeboard_m;       ///< Bow roller height added to the depth in scope mode
+    uint32_t crc;            ///< CRC-32 over the fields above
+};
+
+class IConfigStore {
+public:
+    virtual ~IConfigStore() = default;
+
+    /**
+     * @brief Read the record
+     * @return false if it was never written or cannot be read
+     */
+    virtual bool read(RuntimeConfig& config) = 0;
+
+    /**
+     * @brief Replace the record
+     * @return false if the write failed
+     */
+    virtual bool write(const RuntimeConfig& config) = 0;
+};
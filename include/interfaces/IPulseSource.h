@@ -0,0 +1,25 @@
+#pragma once
+
+/**
+ * @file IPulseSource.h
+ * @brief Abstract interface for chain counter pulse sources
+ *
+ * A pulse source accumulates signed chain counter pulses between polls.
+ * Concrete implementations (e.g., ESP32PulseCounter using the PCNT peripheral)
+ * handle the hardware details; PulseCounterService only sees the delta.
+ *
+ * DESIGN PRINCIPLE: Dependency Inversion
+ * - PulseCounterService depends on this abstraction
+ * - Hardware counters implement this abstraction
+ * - Enables testing with mock pulse sources without hardware
+ */
+class IPulseSource {
+public:
+    virtual ~IPulseSource() = default;
+
+    /**
+     * @brief Take the pulses accumulated since the previous call
+     * @return Signed pulse delta (positive = chain out, negative = chain in)
+     */
+    virtual long takeDelta() = 0;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file IRodeStore.h
+ * @brief Abstract slot storage for the rode counter journal
+ *
+ * The journal writes fixed-size records into a small ring of slots; a
+ * store only has to read and write a slot by index. The ESP32
+ * implementation (NvsRodeStore) keeps each slot as an NVS blob.
+ *
+ * DESIGN PRINCIPLE: Dependency Inversion
+ * - RodeJournal depends on this abstraction
+ * - Flash/NVS backends implement it
+ * - Enables testing the journal with an in-memory store
+ */
+
+/**
+ * @brief One persisted rode counter record
+ * Plain aggregate (no initializers) so it can live in RTC_NOINIT memory.
+ */
+struct RodeRecord {
+    uint32_t magic;        ///< RODE_RECORD_MAGIC when written by this firmware
+    uint32_t sequence;     ///< Monotonic write counter (newest wins)
+    int32_t pulse_count;   ///< Counter value
+    uint32_t crc;          ///< CRC-32 over the fields above
+};
+
+class IRodeStore {
+public:
+    virtual ~IRodeStore() = default;
+
+    /**
+     * @brief Read a slot
+     * @return false if the slot was never written or cannot be read
+     */
+    virtual bool readSlot(size_t slot, RodeRecord& record) = 0;
+
+    /**
+     * @brief Write a slot
+     * @return false if the write failed
+     */
+    virtual bool writeSlot(size_t slot, const RodeRecord& record) = 0;
+};
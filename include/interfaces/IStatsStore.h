@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file IStatsStore.h
+ * @brief Abstract storage for the lifetime operation statistics record
+ *
+ * The lifetime totals (chain moved, run time, starts, emergency stops) are
+ * one fixed-size record, read once at boot and rewritten in batches by
+ * OperationStatsService. The ESP32 implementation (NvsStatsStore) keeps it
+ * as a single NVS blob.
+ *
+ * DESIGN PRINCIPLE: Dependency Inversion
+ * - OperationStatsService depends on this abstraction
+ * - NVS backend implements it
+ * - Enables testing the record checks with an in-memory store
+ */
+
+/// Operation counters (record layout: append only, bump OPERATION_STATS_VERSION otherwise)
+enum class OperationStat : uint8_t {
+    DEPLOYED_PULSES,    ///< Chain paid out (pulses)
+    RETRIEVED_PULSES,   ///< Chain hauled in (pulses)
+    WINCH_UP_MS,        ///< Winch run time retrieving
+    WINCH_DOWN_MS,      ///< Winch run time deploying
+    WINCH_UP_STARTS,    ///< Winch starts retrieving (contactor closes)
+    WINCH_DOWN_STARTS,  ///< Winch starts deploying
+    BOW_MS,             ///< Thruster on-time, both directions
+    BOW_STARTS,         ///< Thruster starts, both directions
+    ESTOP_SIGNALK,      ///< Emergency stops from SignalK
+    ESTOP_REMOTE,       ///< Emergency stops from the physical remote
+    ESTOP_LOCAL,        ///< Emergency stops from the firmware or web UI
+    ESTOP_DIRECT,       ///< Emergency stops from the direct helm link
+    COUNT
+};
+
+constexpr size_t OPERATION_STAT_COUNT = static_cast<size_t>(OperationStat::COUNT);
+
+/**
+ * @brief Lifetime statistics record (plain aggregate, stored as raw bytes)
+ */
+struct OperationStatsRecord {
+    uint32_t magic;                          ///< OPERATION_STATS_MAGIC when written by this firmware
+    uint16_t version;                        ///< OPERATION_STATS_VERSION of the layout
+    uint16_t reserved;                       ///< 0
+    uint32_t values[OPERATION_STAT_COUNT];   ///< Lifetime totals in OperationStat order
+    uint32_t crc;                            ///< CRC-32 over the fields above
+};
+
+class IStatsStore {
+public:
+    virtual ~IStatsStore() = default;
+
+    /**
+     * @brief Read the record
+     * @return false if it was never written or cannot be read
+     */
+    virtual bool read(OperationStatsRecord& record) = 0;
+
+    /**
+     * @brief Replace the record
+     * @return false if the write failed
+     */
+    virtual bool write(const OperationStatsRecord& record) = 0;
+};
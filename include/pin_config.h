@@ -1,37 +1,108 @@
 #pragma once
 
 #include <cstdint>
+#include "util/RelaySequencer.h"
+#include "util/ThrustPattern.h"
 
 /**
  * @file pin_config.h
- * @brief Centralized GPIO pin configuration for the anchor chain counter system
- * 
- * All hardware pin assignments are defined here as constexpr constants.
- * This makes it easy to reconfigure for different hardware setups.
+ * @brief Compile-time hardware profiles for the anchor chain counter system
+ *
+ * A hardware profile holds everything that differs between boards and
+ * installations: GPIO assignments, active levels, the pulse direction
+ * polarity and the relay timing of the installed motors. All members are
+ * constexpr, so drivers specialise on them at compile time (no runtime
+ * lookup, no branches on active level).
+ *
+ * Each PlatformIO env selects its profile with HARDWARE_PROFILE;
+ * PinConfig is the selected profile. To support a new board, derive a
+ * profile from an existing one, override what differs and add its id.
  */
 
-// GPIO Pin Configuration
-struct PinConfig {
+#define HARDWARE_PROFILE_DEVKIT_V4 0  ///< AZ-Delivery ESP-32 Dev Kit C V4
+#define HARDWARE_PROFILE_MINIKIT 1    ///< MH ET LIVE ESP32MiniKit
+
+#ifndef HARDWARE_PROFILE
+#define HARDWARE_PROFILE HARDWARE_PROFILE_DEVKIT_V4
+#endif
+
+/// How the bow thruster produces a proportional setpoint
+enum class BowThrusterDrive : uint8_t {
+    RELAY_PULSE,  ///< Contactors only: low-frequency pulse-width pattern (BOW_PULSE_TIMING)
+    PWM,          ///< Speed controller: PWM on BOW_PWM, direction on the contactors
+};
+
+/// Pins of an additional windlass channel (polarities and timing as the primary windlass)
+struct WindlassChannelPins {
+    const char* name;     ///< SignalK path segment: navigation.anchor.<name>.*
+    uint8_t pulse_input;  ///< Chain counter pulses
+    uint8_t direction;    ///< Direction sensing
+    uint8_t anchor_home;  ///< Home position sensor
+    uint8_t winch_up;     ///< Relay - retrieve chain
+    uint8_t winch_down;   ///< Relay - deploy chain
+};
+
+/// AZ-Delivery ESP-32 Dev Kit C V4 wiring (reference installation)
+struct DevKitV4Profile {
     // Sensor inputs
     static constexpr uint8_t PULSE_INPUT = 25;  ///< Pulse input from chain counter sensor
-    static constexpr uint8_t DIRECTION = 26;    ///< Direction sensing (HIGH = chain out, LOW = chain in)
-    static constexpr uint8_t ANCHOR_HOME = 33;  ///< Anchor home position sensor (LOW = at home)
-    
-    // Winch outputs (active-LOW: write LOW to activate, HIGH to deactivate)
+    static constexpr uint8_t DIRECTION = 26;    ///< Direction sensing (polarity: DIRECTION_OUT_HIGH)
+    static constexpr uint8_t ANCHOR_HOME = 33;  ///< Anchor home position sensor
+    static constexpr bool DIRECTION_OUT_HIGH = true;  ///< DIRECTION HIGH = chain out, LOW = chain in
+    static constexpr bool HOME_ACTIVE_LOW = true;     ///< Home sensor pulls LOW at home (input pull-up)
+
+    // Winch outputs
     static constexpr uint8_t WINCH_UP = 27;     ///< Winch control - UP (retrieve chain)
     static constexpr uint8_t WINCH_DOWN = 14;   ///< Winch control - DOWN (deploy chain)
-    
+
     // Remote control inputs
     static constexpr uint8_t REMOTE_UP = 12;    ///< Physical remote UP button (active HIGH)
     static constexpr uint8_t REMOTE_DOWN = 13;  ///< Physical remote DOWN button (active HIGH)
     static constexpr uint8_t REMOTE_FUNC3 = 15; ///< Physical remote button - Bow PORT thruster (active HIGH)
     static constexpr uint8_t REMOTE_FUNC4 = 16; ///< Physical remote button - Bow STARBOARD thruster (active HIGH)
-    
-    // Bow propeller relays (active-LOW: write LOW to activate, HIGH to deactivate)
+
+    // Bow propeller relays
     static constexpr uint8_t BOW_PORT = 4;      ///< Bow propeller port (left) thruster relay
     static constexpr uint8_t BOW_STARBOARD = 5; ///< Bow propeller starboard (right) thruster relay
-    
+
+    /// All relays: write LOW to activate, HIGH to deactivate (safe default on boot)
+    static constexpr bool RELAY_ACTIVE_LOW = true;
+
+    /// Windlass contactor/thermal limits: 250 ms reversal dead time, 100 ms min off, 10 min per hour
+    static constexpr RelayTiming WINCH_RELAY_TIMING = {250, 0, 100, 3600000UL, 600000UL};
+
+    /// Thruster contactor/thermal limits: 500 ms reversal dead time, 300 ms min off, 3 min per hour
+    static constexpr RelayTiming BOW_RELAY_TIMING = {500, 0, 300, 3600000UL, 180000UL};
+
+    /// Proportional thrust: pulsed contactors (no speed controller installed)
+    static constexpr BowThrusterDrive BOW_DRIVE = BowThrusterDrive::RELAY_PULSE;
+    /// 2 s pattern, 250 ms shortest pulse, off-time at least the relay min off
+    static constexpr ThrustPatternTiming BOW_PULSE_TIMING = {2000, 250, BOW_RELAY_TIMING.min_off_ms};
+    static constexpr uint8_t BOW_PWM = 17;                 ///< Speed controller input (BowThrusterDrive::PWM)
+    static constexpr uint32_t BOW_PWM_FREQUENCY_HZ = 1000; ///< Speed controller PWM frequency
+
+    /// Additional windlasses (channel 1, 2, ...), used up to WINDLASS_CHANNELS - 1
+    static constexpr WindlassChannelPins EXTRA_WINDLASSES[] = {
+        {"stern", 32, 23, 21, 18, 19},  ///< Stern kedge
+    };
+
     // Legacy aliases for backward compatibility
     static constexpr uint8_t REMOTE_OUT1 = BOW_PORT;       ///< Alias for BOW_PORT
     static constexpr uint8_t REMOTE_OUT2 = BOW_STARBOARD;  ///< Alias for BOW_STARBOARD
 };
+
+/// MH ET LIVE ESP32MiniKit: wired like the Dev Kit V4 (override members that differ)
+struct MiniKitProfile : DevKitV4Profile {};
+
+#if HARDWARE_PROFILE == HARDWARE_PROFILE_DEVKIT_V4
+using PinConfig = DevKitV4Profile;
+#elif HARDWARE_PROFILE == HARDWARE_PROFILE_MINIKIT
+using PinConfig = MiniKitProfile;
+#else
+#error "Unknown HARDWARE_PROFILE"
+#endif
+
+// Relays are switched through the GPIO.out set/clear registers
+static_assert(PinConfig::WINCH_UP < 32 && PinConfig::WINCH_DOWN < 32 &&
+                  PinConfig::BOW_PORT < 32 && PinConfig::BOW_STARBOARD < 32,
+              "Relay pins must be in the GPIO.out bank");
@@ -7,6 +7,8 @@
 #include "bow_propeller_controller.h"
 #include "services/StateManager.h"
 #include "sensesp/signalk/signalk_output.h"
+#include "util/RemoteGestures.h"
+#include "util/RemoteTiming.h"
 
 using namespace sensesp;
 
@@ -27,7 +29,23 @@ using namespace sensesp;
  * - GPIO 16 (REMOTE_FUNC4): Bow propeller STARBOARD
  * 
  * Hardware: Remote buttons are active-HIGH (read HIGH when pressed)
+ *
+ * Input modes (selected at build time with REMOTE_USE_INTERRUPTS):
+ * - 1: CHANGE interrupts on all four inputs post timestamped edges to a
+ *   static FreeRTOS queue; waitForInput() blocks on that queue, and no GPIO
+ *   is polled
+ * - 0: inputs are sampled from the per-tick GpioSnapshot on every
+ *   processInputs() call
+ *
+ * Both modes feed the same RemoteGestures: a ButtonDebouncer per input,
+ * plus a fifth "any button" channel that drives the double-press emergency
+ * stop and the long-press clear, so receiver noise cannot trigger either.
  */
+
+#ifndef REMOTE_USE_INTERRUPTS
+#define REMOTE_USE_INTERRUPTS 0
+#endif
+
 class RemoteControl {
 public:
     /**
@@ -42,12 +60,33 @@ public:
                   AutomaticModeController* auto_mode_controller = nullptr,
                   SKOutputFloat* auto_mode_output_ptr = nullptr);
 
+    static constexpr uint8_t BUTTON_COUNT = RemoteGestures::BUTTON_COUNT;  ///< UP, DOWN, FUNC3, FUNC4
+    static constexpr unsigned long DEBOUNCE_MS = RemoteTiming::DEBOUNCE_MS;          ///< Button debounce window
+    static constexpr unsigned long DOUBLE_PRESS_MS = RemoteTiming::DOUBLE_PRESS_MS;  ///< Double-press gap for emergency stop
+    static constexpr unsigned long LONG_PRESS_MS = RemoteTiming::LONG_PRESS_MS;      ///< Long-press to clear emergency stop
+
     /**
      * @brief Initialize remote control GPIO pins
      * Sets all remote input pins to INPUT mode and output pins to OUTPUT (inactive HIGH)
+     * and, in interrupt mode, creates the edge queue and attaches the ISRs
      */
     void initialize();
 
+    /**
+     * @brief Block until a button edge arrives or a debounce/gesture deadline is due
+     * @param max_wait_ms Upper bound on the wait (keeps the event loop serviced)
+     * @return true if the wait was handled (interrupt mode); false in polling
+     *         mode, where it returns immediately and the caller decides how to sleep
+     */
+    bool waitForInput(unsigned long max_wait_ms);
+
+    /**
+     * @brief End a running waitForInput() (any task, not from an ISR)
+     * @return true if handled (interrupt mode); false in polling mode, where
+     *         the caller wakes the waiting task itself
+     */
+    bool wake();
+
     /**
      * @brief Process remote control inputs (call every loop iteration)
      * @return true if remote is actively controlling the winch, false if not
@@ -85,9 +124,19 @@ private:
     SKOutputFloat* auto_mode_output_ptr_;  ///< Pointer to auto mode SignalK output
     BowPropellerController* bow_propeller_controller_;  ///< Pointer to bow propeller controller
     bool remote_active_ = false;  ///< True if remote is currently controlling the winch
-    bool prev_button_active_ = false;  ///< Previous combined button state for edge detection
-    unsigned long last_press_ms_ = 0;  ///< Time of last button press
-    unsigned long press_start_ms_ = 0;  ///< Time when current press started
-    bool long_press_fired_ = false;  ///< True if long-press action already triggered
+    bool remote_bow_active_ = false;  ///< True if remote is currently controlling the bow thruster
+    RemoteGestures gestures_;  ///< Debounced inputs and emergency stop gestures
+
+    /**
+     * @brief Feed raw edges into the debouncers (queue drain or GPIO sampling)
+     * @param now_ms Current time
+     */
+    void collectEdges(unsigned long now_ms);
+
+    /**
+     * @brief Sample all inputs from the GpioSnapshot
+     * @param now_ms Time stamped on any change
+     */
+    void sampleInputs(unsigned long now_ms);
 };
 
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include "services/StateManager.h"
+#include "util/AnchorWatch.h"
+
+/**
+ * @file AnchorWatchService.h
+ * @brief Local anchor watch: drag alarm from position, depth and rode
+ *
+ * Listens to navigation.position and environment.depth.belowSurface and
+ * feeds every position fix, together with the rode from the control-side
+ * StateSnapshot, into an AnchorWatch:
+ * - Anchor down: first fix after the rode exceeds the depth plus bow height
+ *   (ANCHOR_DOWN_RODE_M without a depth), the fix is the drop point
+ * - Anchor up: rode below ANCHOR_UP_RODE_M
+ *
+ * Publishes navigation.anchor.currentRadius (distance from the anchor),
+ * navigation.anchor.maxRadius (allowed radius) and
+ * navigation.anchor.swingRadius (largest distance over the history), and
+ * raises notifications.anchor.drag from the ECU itself. The alarm is
+ * re-sent every NOTIFICATION_REPEAT_MS while active, so a server that
+ * restarts picks it up again.
+ *
+ * Runs on the networking side (SignalK listeners on the event loop); the
+ * history is a fixed array inside the service, nothing grows at runtime.
+ */
+class AnchorWatchService {
+public:
+    static constexpr size_t HISTORY_SAMPLES = 256;              ///< About 4 min of 1 Hz fixes
+    static constexpr float ANCHOR_DOWN_RODE_M = 5.0f;           ///< Rode that means "down" without a depth
+    static constexpr float ANCHOR_UP_RODE_M = 2.0f;             ///< Rode that means "up"
+    static constexpr unsigned long DEPTH_STALE_MS = 30000;      ///< Depth older than this is unknown
+    static constexpr unsigned long NOTIFICATION_REPEAT_MS = 10000;  ///< Alarm re-send period
+
+    explicit AnchorWatchService(StateManager& state_manager);
+
+    /**
+     * @brief Create the SignalK listeners and outputs
+     * Must be called during setup() after sensesp_app is created
+     */
+    void initialize();
+
+    /**
+     * @brief Process a position fix (event loop)
+     */
+    void onPosition(double latitude, double longitude);
+
+    /**
+     * @brief Store a depth reading (event loop)
+     */
+    void onDepth(float depth_m);
+
+    /// @return The watch (tests, status)
+    const AnchorWatch<HISTORY_SAMPLES>& getWatch() const { return watch_; }
+
+private:
+    StateManager& state_manager_;
+    AnchorWatch<HISTORY_SAMPLES> watch_;
+    float depth_m_ = -1.0f;                 ///< Last depth (< 0 = none yet)
+    unsigned long depth_ms_ = 0;            ///< Time of the last depth
+    unsigned long last_notification_ms_ = 0;
+
+    float currentDepth(unsigned long now_ms) const;
+    void publishNotification(unsigned long now_ms);
+};
@@ -2,10 +2,24 @@
 
 #include "StateManager.h"
 #include "PulseCounterService.h"
+#include "RodePersistenceService.h"
+#include "ControlLoopService.h"
+#include "ControlTask.h"
+#include "EventLogger.h"
+#include "PerfMonitor.h"
+#include "Supervisor.h"
+#include "OperationStatsService.h"
+#include "PowerManager.h"
+#include "WindlassChannels.h"
+#include "TraceRecorder.h"
 #include "EmergencyStopService.h"
+#include "NetworkScheduler.h"
 #include "hardware/ESP32Motor.h"
 #include "hardware/ESP32Sensor.h"
 #include "hardware/ESP32BowPropellerMotor.h"
+#include "hardware/ESP32PulseCounter.h"
+#include "hardware/NvsRodeStore.h"
+#include "hardware/NvsStatsStore.h"
 #include "winch_controller.h"
 #include "bow_propeller_controller.h"
 #include "home_sensor.h"
@@ -15,6 +29,8 @@
 
 // Forward declaration to avoid including SignalKService.h which pulls in sensesp_app_builder.h
 class SignalKService;
+class AnchorWatchService;
+class DirectCommandService;
 
 /**
  * @file BoatBowControlApp.h
@@ -27,27 +43,50 @@ class SignalKService;
  * 
  * Follows the orchestrator pattern to encapsulate system complexity and provide
  * a simple interface for setup and operation.
+ *
+ * Staged boot (see BootMetrics):
+ * - Stage 0, initializeControl(): safe outputs, control side up and (with
+ *   CONTROL_USE_TASKS=1) the control task running - within milliseconds
+ * - Stage 1, initializeNetworking() / startSignalK() / startNetworkTask():
+ *   SensESP, WiFi and SignalK, while the control task already serves the
+ *   remote and the emergency stop at higher priority
  */
 class BoatBowControlApp {
 public:
     /**
      * @brief Construct the application without initializing
-     * Call initialize() afterwards in setup()
+     * Call initializeControl() afterwards in setup()
      */
     BoatBowControlApp();
 
     /**
-     * @brief Initialize all hardware and services
-     * Must be called during Arduino setup()
-     * Initializes (in order):
-     *   1. Hardware (GPIO, pins)
+     * @brief Boot stage 0: hardware and the control side
+     * Must be called first in Arduino setup(), before SensESP is created.
+     * Does not use the SensESP event loop. Initializes (in order):
+     *   1. Hardware (GPIO, pins) - all outputs inactive
      *   2. Controllers (AnchorWinchController, HomeSensor, AutomaticModeController, RemoteControl, BowPropeller)
-     *   3. Services (EmergencyStopService, PulseCounterService)
-     *   4. Pulse counter ISR
-     * 
-     * Call startSignalK() after SensESP app initialization
+     *   3. Control services (EmergencyStopService, PulseCounterService, OperationStatsService,
+     *      RodePersistenceService, ControlLoopService, ControlTask)
+     *   4. Pulse source (PCNT hardware counter, or pulse ISR fallback)
+     *   5. Home sensor edge interrupt (immediate WINCH_UP cut)
+     *   6. Rode counter restore (RTC memory, else NVS journal; unverified)
+     *   7. Idle power mode (light sleep wake inputs, see PowerManager)
+     *   8. Supervisor deadline timer and task watchdog
+     *   9. Control task start (CONTROL_USE_TASKS=1; otherwise control runs
+     *      from loop() once setup() returns)
      */
-    void initialize();
+    void initializeControl();
+
+    /**
+     * @brief Boot stage 1: services that need the SensESP event loop
+     * Call after the SensESP app is created and before sensesp_app->start():
+     * rode journal flush, event log drain, PerfMonitor, Supervisor
+     * statistics, operation statistics, the power mode, SignalKService and
+     * the anchor watch,
+     * all periodic work registered with the NetworkScheduler.
+     * Call startSignalK() after sensesp_app->start()
+     */
+    void initializeNetworking();
 
     /**
      * @brief Start SignalK integration
@@ -56,12 +95,45 @@ public:
      */
     void startSignalK();
 
+    /**
+     * @brief Open the direct helm command link (DIRECT_COMMAND_USE_UDP=1)
+     * Call after sensesp_app->start() (WiFi must be up)
+     * @param key SIPHASH_KEY_SIZE byte pairing key shared with the helm controller
+     */
+    void startDirectLink(const uint8_t* key);
+
+    /**
+     * @brief Start the networking task
+     * Call at the end of setup(). With CONTROL_USE_TASKS=1 the SensESP event
+     * loop runs in a task on core 0 (the ControlTask was already started on
+     * core 1 by initializeControl()); otherwise this does nothing and
+     * processInputs() drives both.
+     */
+    void startNetworkTask();
+
+    /// Longest the main loop blocks waiting for remote input before ticking the event loop
+    static constexpr unsigned long INPUT_WAIT_MS = 5;
+
+    static constexpr uint32_t NETWORK_STACK_SIZE = 8192;  ///< Event loop task stack (bytes)
+    static constexpr uint8_t NETWORK_PRIORITY = 1;        ///< Event loop task priority
+    static constexpr uint8_t NETWORK_CORE = 0;            ///< Core shared with WiFi/LwIP
+
     /**
      * @brief Process inputs during main loop
-     * Call once per loop iteration
+     * Call once per loop iteration. Without tasks: runs one control step
+     * (waiting up to INPUT_WAIT_MS for remote edges) and ticks the event loop.
+     * With tasks: both run in their own tasks and loop() just sleeps.
      */
     void processInputs();
 
+    /**
+     * @brief Apply the chain counter calibration
+     * @param meters_per_pulse Meters of chain per pulse (from SensESP ConfigItem)
+     * Updates the state manager and the automatic mode tolerance (2 pulses),
+     * so the tolerance always follows the loaded calibration.
+     */
+    void setMetersPerPulse(float meters_per_pulse);
+
     // ========== Accessor Methods ==========
     /**
      * @brief Get the central state manager
@@ -103,6 +175,62 @@ public:
      */
     PulseCounterService* getPulseCounterService() { return pulse_counter_service_; }
 
+    /**
+     * @brief Get the rode counter persistence (RTC + NVS journal)
+     */
+    RodePersistenceService* getRodePersistence() { return rode_persistence_; }
+
+    /**
+     * @brief Get the fixed-rate control loop service
+     */
+    ControlLoopService* getControlLoopService() { return control_loop_service_; }
+
+    /**
+     * @brief Get the control side (command queue and state snapshot)
+     */
+    ControlTask* getControlTask() { return control_task_; }
+
+    /**
+     * @brief Get the latency instrumentation monitor
+     */
+    PerfMonitor* getPerfMonitor() { return perf_monitor_; }
+
+    /**
+     * @brief Get the fail-safe supervisor (deadline statistics)
+     */
+    Supervisor* getSupervisor() { return supervisor_; }
+
+    /**
+     * @brief Get the session and lifetime operation statistics
+     */
+    OperationStatsService* getOperationStats() { return operation_stats_; }
+
+    /**
+     * @brief Get the idle power mode (WiFi power save, idle statistics)
+     */
+    PowerManager* getPowerManager() { return power_manager_; }
+
+    /**
+     * @brief Get the additional windlass channels (nullptr with WINDLASS_CHANNELS=1)
+     */
+    WindlassChannels* getWindlassChannels() { return windlass_channels_; }
+
+    /**
+     * @brief Get the scheduler of the periodic networking-side work
+     * Register tasks before sensesp_app->start()
+     */
+    NetworkScheduler& getScheduler() { return scheduler_; }
+
+    /**
+     * @brief Get the local anchor watch (drag alarm)
+     */
+    AnchorWatchService* getAnchorWatch() { return anchor_watch_; }
+
+    /**
+     * @brief Get the direct helm command link (nullptr until startDirectLink())
+     */
+    DirectCommandService* getDirectLink() { return direct_link_; }
+
     /**
      * @brief Get the SignalK service
      */
@@ -119,8 +247,13 @@ private:
 
     // ========== Hardware Abstraction Layer ==========
     ESP32Motor motor_;
-    ESP32Sensor<PinConfig::ANCHOR_HOME> home_sensor_impl_;
+    ESP32Sensor home_sensor_impl_;
     BowPropellerMotor bow_propeller_motor_;
+#if PULSE_COUNTER_USE_PCNT
+    ESP32PulseCounter pulse_counter_hw_;
+#endif
+    NvsRodeStore rode_store_;
+    NvsStatsStore stats_store_;
 
     // ========== Business Logic Controllers ==========
     AnchorWinchController winch_controller_;
@@ -132,11 +265,28 @@ private:
     // ========== Services ==========
     EmergencyStopService* emergency_stop_service_ = nullptr;
     PulseCounterService* pulse_counter_service_ = nullptr;
+    RodePersistenceService* rode_persistence_ = nullptr;
+    ControlLoopService* control_loop_service_ = nullptr;
+    ControlTask* control_task_ = nullptr;
+    EventLogger* event_logger_ = nullptr;
+    PerfMonitor* perf_monitor_ = nullptr;
+    Supervisor* supervisor_ = nullptr;
+    OperationStatsService* operation_stats_ = nullptr;
+    PowerManager* power_manager_ = nullptr;
+    WindlassChannels* windlass_channels_ = nullptr;
+    TraceRecorder* trace_recorder_ = nullptr;
     SignalKService* signalk_service_ = nullptr;
+    AnchorWatchService* anchor_watch_ = nullptr;
+    DirectCommandService* direct_link_ = nullptr;
+    NetworkScheduler scheduler_{NETWORK_MINOR_FRAME_MS, clockUs};
 
     // ========== Helper Methods ==========
     void initializeHardware();
     void initializeControllers();
     void initializeServices();
-    void attachPulseISR();
+    void initializePulseSource();
+    void initializeHomeInterrupt();
+    static void networkTaskEntry(void* arg);
+    static uint32_t clockUs();
+    void publishSchedulerStats();
 };
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "esp_timer.h"
+
+/**
+ * @file BootMetrics.h
+ * @brief Timestamps of the staged startup (milliseconds since reset)
+ *
+ * Startup runs in stages so the remote and emergency stop work before the
+ * network exists:
+ * - SAFE_OUTPUTS: relays and thruster outputs driven inactive
+ * - FIRST_CONTROL: first control step ran (remote and home sensor live)
+ * - NETWORK_STARTED: SensESP app started (WiFi, web UI)
+ * - SIGNALK_READY: first SignalK server connection
+ *
+ * mark() keeps the first time a stage is reached, so it may be called on
+ * every pass; it is lock-free and safe from any task.
+ */
+class BootMetrics {
+public:
+    /// Startup milestones in boot order
+    enum class Stage : uint8_t {
+        SAFE_OUTPUTS,
+        FIRST_CONTROL,
+        NETWORK_STARTED,
+        SIGNALK_READY,
+        COUNT
+    };
+
+    /**
+     * @brief Record that a stage was reached (first call wins)
+     */
+    static void mark(Stage stage) {
+        uint32_t expected = 0;
+        uint32_t now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000) + 1;  // 0 = not reached
+        reached_ms_[index(stage)].compare_exchange_strong(expected, now_ms, std::memory_order_relaxed);
+    }
+
+    /// @return true once the stage has been marked
+    static bool reached(Stage stage) {
+        return reached_ms_[index(stage)].load(std::memory_order_relaxed) != 0;
+    }
+
+    /// @return Milliseconds from reset to the stage (0 if not reached)
+    static uint32_t ms(Stage stage) {
+        uint32_t value = reached_ms_[index(stage)].load(std::memory_order_relaxed);
+        return value ? value - 1 : 0;
+    }
+
+private:
+    static constexpr uint8_t STAGE_COUNT = static_cast<uint8_t>(Stage::COUNT);
+
+    static inline std::atomic<uint32_t> reached_ms_[STAGE_COUNT] = {};  ///< ms + 1, 0 = not reached
+
+    static constexpr uint8_t index(Stage stage) { return static_cast<uint8_t>(stage); }
+};
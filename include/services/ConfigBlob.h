@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "interfaces/IConfigStore.h"
+#include "util/Crc32.h"
+
+/**
+ * @file ConfigBlob.h
+ * @brief Versioned, CRC-checked runtime configuration record
+ *
+ * load() does a single store read at boot and rejects a record with the
+ * wrong magic, layout version or CRC (the caller then falls back to the
+ * compiled-in defaults or the web UI JSON values and saves a fresh record).
+ * save() skips the write when nothing changed, so it can be called
+ * periodically without wearing the flash.
+ *
+ * Changing the RuntimeConfig layout requires bumping RUNTIME_CONFIG_VERSION.
+ *
+ * Networking side only: store writes block for milliseconds.
+ */
+
+constexpr uint32_t RUNTIME_CONFIG_MAGIC = 0x43464742UL;  ///< "CFGB"
+constexpr uint16_t RUNTIME_CONFIG_VERSION = 2;            ///< RuntimeConfig layout
+
+/// RuntimeConfig::flags bits
+namespace RuntimeConfigFlag {
+    constexpr uint16_t AP_PASSWORD_CHECKED = 1 << 0;  ///< Default AP password already replaced
+}
+
+/// @return Record with magic, version and CRC filled in
+inline RuntimeConfig makeRuntimeConfig(float meters_per_pulse, float coast_up_s,
+                                       float coast_down_s, float rode_deadband,
+                                       float freeboard_m, uint16_t flags) {
+    RuntimeConfig config = {};
+    config.magic = RUNTIME_CONFIG_MAGIC;
+    config.version = RUNTIME_CONFIG_VERSION;
+    config.flags = flags;
+    config.meters_per_pulse = meters_per_pulse;
+    config.coast_up_s = coast_up_s;
+    config.coast_down_s = coast_down_s;
+    config.rode_deadband = rode_deadband;
+    config.freeboard_m = freeboard_m;
+    config.crc = crc32(&config, offsetof(RuntimeConfig, crc));
+    return config;
+}
+
+/// @return true if the record has this firmware's magic and layout and a matching CRC
+inline bool isValidRuntimeConfig(const RuntimeConfig& config) {
+    return config.magic == RUNTIME_CONFIG_MAGIC &&
+           config.version == RUNTIME_CONFIG_VERSION &&
+           config.crc == crc32(&config, offsetof(RuntimeConfig, crc));
+}
+
+class ConfigBlob {
+public:
+    explicit ConfigBlob(IConfigStore& store) : store_(store) {}
+
+    /**
+     * @brief Read the record (boot, one store read)
+     * @param config Receives the record if valid
+     * @return false if missing, corrupt or from another layout version
+     */
+    bool load(RuntimeConfig& config) {
+        RuntimeConfig stored = {};
+        if (!store_.read(stored) || !isValidRuntimeConfig(stored)) {
+            return false;
+        }
+        config = stored;
+        last_ = stored;
+        has_last_ = true;
+        return true;
+    }
+
+    /**
+     * @brief Write the record if it differs from the last one loaded or saved
+     * @param config Record made with makeRuntimeConfig()
+     * @return true if the store was written
+     */
+    bool save(const RuntimeConfig& config) {
+        if (has_last_ && memcmp(&last_, &config, sizeof(config)) == 0) {
+            return false;
+        }
+        if (!store_.write(config)) {
+            return false;
+        }
+        last_ = config;
+        has_last_ = true;
+        writes_++;
+        return true;
+    }
+
+    /// @return Records written since boot
+    uint32_t getWrites() const { return writes_; }
+
+private:
+    IConfigStore& store_;        ///< Backend
+    RuntimeConfig last_ = {};    ///< Last record loaded or written
+    bool has_last_ = false;      ///< last_ is valid
+    uint32_t writes_ = 0;        ///< Records written
+};
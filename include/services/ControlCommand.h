@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file ControlCommand.h
+ * @brief Commands crossing from the networking side to the control side
+ *
+ * Each command carries its source and the time it was queued, so the
+ * control side can attribute it and measure its queueing delay.
+ *
+ * Motion commands (MANUAL_WINCH, BOW_THRUSTER, BOW_THRUST) may carry a lease: the
+ * control side stops that motion lease_ms after the command arrived unless
+ * a repeat renewed it (hold-to-run). Without a lease they latch.
+ *
+ * Commands that arrive within one control step are coalesced with
+ * coalesceCommands(): only the last command per actuator survives, and the
+ * survivors keep their arrival order (arm-then-enable stays arm-then-enable).
+ * STOP_ALL acts on every actuator and is never coalesced: it is sent once
+ * per lost connection, so a keep-alive in the same step must not drop it.
+ *
+ * Winch commands (MANUAL_WINCH, AUTO_MODE, ARM_TARGET, HOME, RESET_RODE)
+ * carry a windlass channel: 0 is the primary windlass, 1.. the additional
+ * channels (WindlassChannels). Every channel has its own actuators.
+ */
+
+/// Command kinds (values are also the wire format of the direct helm link: append only)
+enum class ControlCommandType : uint8_t {
+    MANUAL_WINCH,    ///< value: 1 = up, -1 = down, 0 = stop (disables auto mode)
+    BOW_THRUSTER,    ///< value: 1 = starboard, -1 = port, 0 = stop
+    AUTO_MODE,       ///< value > 0.5 enables, otherwise disables
+    ARM_TARGET,      ///< value: target rode in meters (>= 0)
+    HOME,            ///< Arm target 0 m (auto-home)
+    RESET_RODE,      ///< Zero the pulse counter
+    EMERGENCY_STOP,  ///< value > 0.5 activates, otherwise clears
+    STOP_ALL,        ///< Connection lost: disable auto mode, stop the winch and the thruster
+    ARM_SCOPE,       ///< value: scope ratio (>= 1), target follows the depth
+    DEPTH,           ///< value: depth below the surface in meters (scope mode input)
+    BOW_THRUST,      ///< value: proportional thrust -1..1 (+ = starboard), 0 = stop
+};
+
+/// Where a command came from
+enum class CommandSource : uint8_t {
+    SIGNALK,  ///< SignalK websocket listener
+    REMOTE,   ///< Physical remote
+    LOCAL,    ///< Firmware internal (connection monitor, web UI)
+    DIRECT,   ///< Paired helm controller over the direct UDP link
+};
+
+/// What a command acts on; coalescing keeps one command per actuator
+enum class CommandActuator : uint8_t {
+    WINCH,           ///< MANUAL_WINCH
+    BOW,             ///< BOW_THRUSTER, BOW_THRUST
+    AUTO_MODE,       ///< AUTO_MODE
+    TARGET,          ///< ARM_TARGET, HOME, ARM_SCOPE
+    RODE,            ///< RESET_RODE
+    EMERGENCY_STOP,  ///< EMERGENCY_STOP
+    DEPTH,           ///< DEPTH
+    ALL,             ///< STOP_ALL (never coalesced)
+    COUNT = ALL      ///< Actuators that coalesce
+};
+
+/// Largest batch coalesceCommands() handles (>= command queue capacity)
+constexpr size_t COMMAND_BATCH_MAX = 32;
+
+/// Windlass channels coalesceCommands() tells apart (primary included)
+constexpr size_t COMMAND_CHANNEL_MAX = 4;
+
+/// One queued command
+struct ControlCommand {
+    ControlCommandType type = ControlCommandType::STOP_ALL;
+    float value = 0.0f;
+    CommandSource source = CommandSource::LOCAL;
+    uint32_t arrival_us = 0;  ///< Set by ControlTask::submit()
+    uint16_t lease_ms = 0;    ///< Motion validity window from arrival_us (0 = latched)
+    uint8_t channel = 0;      ///< Windlass channel (0 = primary)
+};
+
+/// @return Actuator a command type acts on
+inline CommandActuator commandActuator(ControlCommandType type) {
+    switch (type) {
+    case ControlCommandType::MANUAL_WINCH:
+        return CommandActuator::WINCH;
+    case ControlCommandType::BOW_THRUSTER:
+    case ControlCommandType::BOW_THRUST:
+        return CommandActuator::BOW;
+    case ControlCommandType::AUTO_MODE:
+        return CommandActuator::AUTO_MODE;
+    case ControlCommandType::ARM_TARGET:
+    case ControlCommandType::HOME:
+    case ControlCommandType::ARM_SCOPE:
+        return CommandActuator::TARGET;
+    case ControlCommandType::RESET_RODE:
+        return CommandActuator::RODE;
+    case ControlCommandType::EMERGENCY_STOP:
+        return CommandActuator::EMERGENCY_STOP;
+    case ControlCommandType::DEPTH:
+        return CommandActuator::DEPTH;
+    case ControlCommandType::STOP_ALL:
+        return CommandActuator::ALL;
+    }
+    return CommandActuator::WINCH;
+}
+
+/// @return Short lowercase name of a source (used as emergency stop reason)
+inline const char* commandSourceName(CommandSource source) {
+    switch (source) {
+    case CommandSource::SIGNALK: return "signalk";
+    case CommandSource::REMOTE: return "remote";
+    case CommandSource::LOCAL: return "local";
+    case CommandSource::DIRECT: return "direct";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Keep only the last command per actuator and channel, in arrival order
+ * STOP_ALL is always kept.
+ * @param commands Batch in arrival order (compacted in place)
+ * @param count Number of commands in the batch
+ * @return Number of commands left
+ */
+inline size_t coalesceCommands(ControlCommand* commands, size_t count) {
+    constexpr size_t actuator_count = static_cast<size_t>(CommandActuator::COUNT);
+    bool seen[actuator_count * COMMAND_CHANNEL_MAX] = {};
+    bool keep_flags[COMMAND_BATCH_MAX] = {};
+    if (count > COMMAND_BATCH_MAX) {
+        count = COMMAND_BATCH_MAX;
+    }
+
+    // Walk backwards: the first command seen per actuator is the last one sent
+    for (size_t i = count; i-- > 0;) {
+        const CommandActuator target = commandActuator(commands[i].type);
+        if (target == CommandActuator::ALL) {
+            keep_flags[i] = true;
+            continue;
+        }
+        size_t channel = commands[i].channel < COMMAND_CHANNEL_MAX ? commands[i].channel : 0;
+        size_t actuator = channel * actuator_count + static_cast<size_t>(target);
+        keep_flags[i] = !seen[actuator];
+        seen[actuator] = true;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (keep_flags[i]) {
+            commands[kept++] = commands[i];
+        }
+    }
+    return kept;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "services/StateManager.h"
+#include "services/PulseCounterService.h"
+#include "automatic_mode_controller.h"
+
+/**
+ * @brief Timing statistics for the fixed-rate control loop
+ */
+struct ControlLoopStats {
+    unsigned long ticks = 0;             ///< Number of control ticks executed
+    unsigned long deadline_misses = 0;   ///< Ticks that started late or overran the period
+    unsigned long last_jitter_us = 0;    ///< |actual interval - period| of the last tick
+    unsigned long max_jitter_us = 0;     ///< Worst interval jitter seen
+    unsigned long last_exec_us = 0;      ///< Execution time of the last tick
+    unsigned long max_exec_us = 0;       ///< Worst execution time seen
+};
+
+/**
+ * @file ControlLoopService.h
+ * @brief Fixed-rate closed-loop scheduler for the anchor windlass
+ *
+ * Each tick:
+ * - Drains the pulse accumulator (PulseCounterService::update)
+ * - Runs AutomaticModeController::update with the fresh rode length
+ * so the controller acts on the motor in the same tick the count is read.
+ * The overshoot past target is therefore bounded by one control period at
+ * full chain speed instead of the old 100 ms pulse poll.
+ *
+ * Records interval jitter and deadline misses (tick started more than half
+ * a period late, or execution took longer than one period).
+ *
+ * Scheduled by ControlTask, which calls tick() every period from the
+ * control task (or from loop() when tasks are disabled).
+ *
+ * DESIGN PRINCIPLE: Single Responsibility
+ * - Only responsible for scheduling the control path and measuring timing
+ * - Control decisions stay in PulseCounterService / AutomaticModeController
+ */
+class ControlLoopService {
+public:
+    /**
+     * @brief Construct control loop service
+     * @param state_manager Reference to state manager
+     * @param pulse_counter_service Reference to pulse counter service
+     * @param auto_mode_controller Reference to automatic mode controller
+     * @param period_ms Control period in milliseconds (default 20 ms = 50 Hz)
+     */
+    ControlLoopService(StateManager& state_manager,
+                       PulseCounterService& pulse_counter_service,
+                       AutomaticModeController& auto_mode_controller,
+                       unsigned int period_ms = 20)
+        : state_manager_(state_manager),
+          pulse_counter_service_(pulse_counter_service),
+          auto_mode_controller_(auto_mode_controller),
+          period_ms_(period_ms) {}
+
+    /**
+     * @brief Execute one control tick (called every period by ControlTask)
+     * @param now_us Tick start time in microseconds (micros())
+     */
+    void tick(unsigned long now_us);
+
+    /// @return Control period in milliseconds
+    unsigned int getPeriodMs() const { return period_ms_; }
+
+    /// @return Timing statistics collected so far
+    const ControlLoopStats& getStats() const { return stats_; }
+
+private:
+    StateManager& state_manager_;                  ///< State holder
+    PulseCounterService& pulse_counter_service_;   ///< Pulse drain + home handling
+    AutomaticModeController& auto_mode_controller_;  ///< Closed-loop positioning
+    unsigned int period_ms_;                       ///< Control period in milliseconds
+    unsigned long last_tick_us_ = 0;               ///< Start time of the previous tick
+    ControlLoopStats stats_;                       ///< Jitter / deadline statistics
+};
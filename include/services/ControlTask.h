@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include "services/StateManager.h"
+#include "services/ControlLoopService.h"
+#include "services/PulseCounterService.h"
+#include "services/EmergencyStopService.h"
+#include "winch_controller.h"
+#include "bow_propeller_controller.h"
+#include "automatic_mode_controller.h"
+#include "remote_control.h"
+#include "services/ControlCommand.h"
+#include "services/WindlassChannels.h"
+#include "util/CommandLease.h"
+#include "util/MpscQueue.h"
+
+/**
+ * @file ControlTask.h
+ * @brief Real-time control side: sensors, remote, control loop and actuators
+ *
+ * Owns everything that touches the motors. The networking side (SensESP
+ * event loop, SignalK) never calls a controller directly:
+ * - Commands go in through submit() into a lock-free MPSC command queue
+ *   (any task may submit) that the control side drains at the start of
+ *   every step; a drained batch is coalesced to the last command per
+ *   actuator, and each applied command's queueing delay is recorded under
+ *   PerfProbe::COMMAND_QUEUE_DELAY. submit() wakes the control task, so a
+ *   command is applied at once instead of at the next control period
+ * - State comes back through StateManager::publishSnapshot(), a seqlock
+ *   refreshed after every step
+ *
+ * Commands for an additional windlass channel (ControlCommand::channel != 0)
+ * go to WindlassChannels, which runs its pass right after the control loop
+ * tick.
+ *
+ * Leased motion commands (hold-to-run) are expired here, on the control
+ * clock, at most one control period after the lease ran out.
+ *
+ * After every step the PowerManager is told whether anything is active
+ * (motion, automatic mode, a lease, chain pulses, an applied command), so
+ * the ECU can enter its idle power mode while at anchor.
+ *
+ * Every step checks in with the Supervisor and feeds the task watchdog; a
+ * relay cut-off by the supervisor is synced into the controllers at the
+ * start of the next step.
+ *
+ * Threading model (CONTROL_USE_TASKS=1, see platformio.ini):
+ * - Control task pinned to CONTROL_CORE at CONTROL_PRIORITY: blocks on the
+ *   remote edge queue until the next control period or button deadline
+ * - SensESP event loop in its own task on the other core
+ *   (BoatBowControlApp::startNetworkTask)
+ * The control task starts before SensESP is created (staged boot, see
+ * BoatBowControlApp::initializeControl), so nothing here may use the
+ * SensESP event loop.
+ * With CONTROL_USE_TASKS=0 the same step runs from Arduino loop() via
+ * runOnce().
+ *
+ * DESIGN PRINCIPLE: Single Writer
+ * - Only the control side mutates controllers and motor outputs
+ * - The networking side only reads the published snapshot
+ */
+
+#ifndef CONTROL_USE_TASKS
+#define CONTROL_USE_TASKS 0
+#endif
+
+#if CONTROL_USE_TASKS
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+class ControlTask {
+public:
+    static constexpr uint8_t CONTROL_CORE = 1;          ///< Core for the control task
+    static constexpr uint8_t CONTROL_PRIORITY = 10;     ///< Above loopTask (1) and the event loop task
+    static constexpr uint32_t CONTROL_STACK_SIZE = 4096;  ///< Bytes
+    static constexpr size_t COMMAND_QUEUE_SIZE = 16;    ///< Pending commands (power of two)
+    static_assert(COMMAND_QUEUE_SIZE <= COMMAND_BATCH_MAX, "Drained batch must fit coalesceCommands()");
+
+    /**
+     * @brief Construct the control side
+     * @param remote_control Physical remote (can be nullptr)
+     * @param bow_propeller_controller Bow thruster (can be nullptr)
+     */
+    ControlTask(StateManager& state_manager,
+                AnchorWinchController& winch_controller,
+                ControlLoopService& control_loop,
+                PulseCounterService& pulse_counter_service,
+                AutomaticModeController* auto_mode_controller,
+                EmergencyStopService* emergency_stop_service,
+                RemoteControl* remote_control,
+                BowPropellerController* bow_propeller_controller);
+
+    /**
+     * @brief Attach the additional windlass channels (before start())
+     */
+    void setWindlassChannels(WindlassChannels* windlass_channels) { windlass_channels_ = windlass_channels; }
+
+    /**
+     * @brief Hand a command to the control side (any task, not from an ISR)
+     * Stamps arrival_us and wakes the control task, which applies the
+     * command in an extra step (the control loop keeps its period).
+     * @return false if the command queue was full and the command was dropped
+     */
+    bool submit(ControlCommand command);
+
+    /**
+     * @brief Start the pinned control task (CONTROL_USE_TASKS=1 only)
+     */
+    void start();
+
+    /**
+     * @brief Wait for input up to max_wait_ms (bounded by the next control
+     * period) and run one step; used from loop() when tasks are disabled
+     */
+    void runOnce(unsigned long max_wait_ms);
+
+    /// @return Commands dropped because the queue was full
+    uint32_t getDroppedCommands() const { return commands_.dropped(); }
+
+    /// @return Commands superseded by a later command for the same actuator
+    uint32_t getCoalescedCommands() const { return coalesced_commands_; }
+
+private:
+    StateManager& state_manager_;
+    AnchorWinchController& winch_controller_;
+    ControlLoopService& control_loop_;
+    PulseCounterService& pulse_counter_service_;
+    AutomaticModeController* auto_mode_controller_;
+    EmergencyStopService* emergency_stop_service_;
+    RemoteControl* remote_control_;
+    BowPropellerController* bow_propeller_controller_;
+    WindlassChannels* windlass_channels_ = nullptr;
+
+    MpscQueue<ControlCommand, COMMAND_QUEUE_SIZE> commands_;  ///< Networking -> control
+    uint32_t coalesced_commands_ = 0;  ///< Superseded commands (control side)
+    unsigned long next_tick_us_ = 0;   ///< Due time of the next control tick
+    uint32_t snapshot_sequence_ = 0;   ///< Sequence for published snapshots
+    bool first_step_done_ = false;     ///< BootMetrics FIRST_CONTROL marked
+    long last_pulse_count_ = 0;        ///< Pulse count of the previous step (idle detection)
+    CommandLease winch_lease_;         ///< Hold-to-run window of the last winch command
+    CommandLease bow_lease_;           ///< Hold-to-run window of the last thruster command
+#if CONTROL_USE_TASKS
+    TaskHandle_t task_ = nullptr;      ///< Control task, set by start()
+#endif
+
+    static void taskEntry(void* arg);
+
+    /// Wake the control task from another task (no-op on the control side itself)
+    void wake();
+
+    /// Capture inputs, drain commands, run the remote and (when due) the control loop, publish
+    void step();
+    /// @return Commands applied
+    size_t drainCommands();
+    void execute(const ControlCommand& command);
+    void stopAfterTrip();
+    void expireLeases(uint32_t now_us);
+    void publishSnapshot();
+    bool isActive() const;
+    unsigned long msUntilTick(unsigned long now_us) const;
+};
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "services/ControlCommand.h"
+#include "services/SignalKCommandTable.h"
+#include "util/SipHash.h"
+
+/**
+ * @file DirectCommandFrame.h
+ * @brief Authenticated command frames of the direct helm link
+ *
+ * A paired helm controller sends 32-byte UDP frames straight to the ECU
+ * (DirectCommandService), bypassing the SignalK server. Layout, little
+ * endian:
+ *
+ *   0  u16 magic "DB"     2  u8 version    3  u8 kind (command / ack)
+ *   4  u32 ECU nonce      8  u32 sequence  12 u32 sender time (ms)
+ *   16 u8 command type    17 u8 status     18 u16 last round trip (ms)
+ *   20 f32 value          24 u64 SipHash-2-4 tag over bytes 0..23
+ *
+ * Replay protection: the ECU picks a random nonce at boot and only accepts
+ * frames carrying it, with a sequence above the last accepted one. A frame
+ * with another nonce is answered with an ack holding the current nonce
+ * (status NONCE), after which the helm resends. Captured frames are
+ * therefore useless after the next accepted frame and after an ECU reboot.
+ *
+ * The ack echoes sequence and sender time so the helm measures the round
+ * trip; it reports the last one in its next frame and the ECU publishes it.
+ */
+
+constexpr uint16_t DIRECT_FRAME_MAGIC = 0x4244;  ///< "DB"
+constexpr uint8_t DIRECT_FRAME_VERSION = 1;
+constexpr size_t DIRECT_FRAME_SIZE = 32;
+constexpr size_t DIRECT_FRAME_TAG_OFFSET = 24;   ///< Authenticated bytes before the tag
+constexpr uint16_t DIRECT_RTT_UNKNOWN = 0xFFFF;  ///< No round trip measured yet
+
+/// Frame kinds
+enum class DirectFrameKind : uint8_t {
+    COMMAND = 1,  ///< Helm -> ECU
+    ACK = 2,      ///< ECU -> helm
+};
+
+/// Ack status (and receive verdict)
+enum class DirectFrameStatus : uint8_t {
+    ACCEPTED = 0,  ///< Submitted to the control side
+    BLOCKED = 1,   ///< Authentic, refused by a guard (emergency stop, unsupported command)
+    NONCE = 2,     ///< Stale or missing nonce: resend with the nonce of this ack
+    REPLAY = 3,    ///< Sequence not above the last accepted one (not acked)
+    INVALID = 4,   ///< Wrong size, magic, version or tag (not acked)
+};
+
+/// Decoded frame
+struct DirectFrame {
+    DirectFrameKind kind = DirectFrameKind::COMMAND;
+    uint32_t nonce = 0;
+    uint32_t sequence = 0;
+    uint32_t sender_ms = 0;
+    uint8_t command = 0;    ///< ControlCommandType
+    uint8_t status = 0;     ///< DirectFrameStatus (acks)
+    uint16_t rtt_ms = DIRECT_RTT_UNKNOWN;
+    float value = 0.0f;
+};
+
+namespace detail {
+    inline void putU16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+    inline void putU32(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; i++) p[i] = (v >> (8 * i)) & 0xFF;
+    }
+    inline uint16_t getU16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+    inline uint32_t getU32(const uint8_t* p) {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    /// Tag compare in constant time: no early exit tells an attacker how many bytes matched
+    inline bool tagEqual(uint64_t tag, const uint8_t* received) {
+        uint8_t diff = 0;
+        for (int i = 0; i < 8; i++) {
+            diff |= static_cast<uint8_t>(tag >> (8 * i)) ^ received[i];
+        }
+        return diff == 0;
+    }
+}
+
+/**
+ * @brief Serialise and sign a frame
+ * @param out DIRECT_FRAME_SIZE bytes
+ */
+inline void encodeDirectFrame(const DirectFrame& frame, const uint8_t* key, uint8_t* out) {
+    using namespace detail;
+    putU16(out, DIRECT_FRAME_MAGIC);
+    out[2] = DIRECT_FRAME_VERSION;
+    out[3] = static_cast<uint8_t>(frame.kind);
+    putU32(out + 4, frame.nonce);
+    putU32(out + 8, frame.sequence);
+    putU32(out + 12, frame.sender_ms);
+    out[16] = frame.command;
+    out[17] = frame.status;
+    putU16(out + 18, frame.rtt_ms);
+    uint32_t bits;
+    memcpy(&bits, &frame.value, sizeof(bits));
+    putU32(out + 20, bits);
+    uint64_t tag = sipHash24(key, out, DIRECT_FRAME_TAG_OFFSET);
+    putU32(out + 24, static_cast<uint32_t>(tag));
+    putU32(out + 28, static_cast<uint32_t>(tag >> 32));
+}
+
+/**
+ * @brief Check and parse a received frame
+ * @return ACCEPTED if authentic (frame filled in), else INVALID
+ */
+inline DirectFrameStatus decodeDirectFrame(const uint8_t* data, size_t length, const uint8_t* key,
+                                           DirectFrame& frame) {
+    using namespace detail;
+    if (length != DIRECT_FRAME_SIZE || getU16(data) != DIRECT_FRAME_MAGIC ||
+        data[2] != DIRECT_FRAME_VERSION) {
+        return DirectFrameStatus::INVALID;
+    }
+    uint64_t tag = sipHash24(key, data, DIRECT_FRAME_TAG_OFFSET);
+    if (!tagEqual(tag, data + DIRECT_FRAME_TAG_OFFSET)) {
+        return DirectFrameStatus::INVALID;
+    }
+    frame.kind = static_cast<DirectFrameKind>(data[3]);
+    frame.nonce = getU32(data + 4);
+    frame.sequence = getU32(data + 8);
+    frame.sender_ms = getU32(data + 12);
+    frame.command = data[16];
+    frame.status = data[17];
+    frame.rtt_ms = getU16(data + 18);
+    uint32_t bits = getU32(data + 20);
+    memcpy(&frame.value, &bits, sizeof(frame.value));
+    return DirectFrameStatus::ACCEPTED;
+}
+
+/**
+ * @brief Parse a pairing key from hex (DIRECT_COMMAND_KEY in secrets.h)
+ * @param hex 2 * SIPHASH_KEY_SIZE hex digits
+ * @param key Receives SIPHASH_KEY_SIZE bytes
+ * @return false if the string is not exactly that many hex digits
+ */
+inline bool parseDirectKey(const char* hex, uint8_t* key) {
+    auto nibble = [](char c) -> int {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+    for (size_t i = 0; i < SIPHASH_KEY_SIZE; i++) {
+        int high = nibble(hex[2 * i]);
+        int low = high < 0 ? -1 : nibble(hex[2 * i + 1]);
+        if (low < 0) {
+            return false;
+        }
+        key[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return hex[2 * SIPHASH_KEY_SIZE] == '\0';
+}
+
+/**
+ * @brief Nonce and sequence check of authentic command frames
+ */
+class DirectReplayGuard {
+public:
+    explicit DirectReplayGuard(uint32_t nonce) : nonce_(nonce) {}
+
+    /// Start a new session (boot): frames must carry nonce, any sequence
+    void reset(uint32_t nonce) {
+        nonce_ = nonce;
+        has_sequence_ = false;
+    }
+
+    /// @return ACCEPTED (sequence recorded), NONCE or REPLAY
+    DirectFrameStatus check(const DirectFrame& frame) {
+        if (frame.nonce != nonce_) {
+            return DirectFrameStatus::NONCE;
+        }
+        if (has_sequence_ && static_cast<int32_t>(frame.sequence - last_sequence_) <= 0) {
+            return DirectFrameStatus::REPLAY;
+        }
+        last_sequence_ = frame.sequence;
+        has_sequence_ = true;
+        return DirectFrameStatus::ACCEPTED;
+    }
+
+    /// @return Nonce frames must carry
+    uint32_t nonce() const { return nonce_; }
+
+private:
+    uint32_t nonce_;
+    uint32_t last_sequence_ = 0;
+    bool has_sequence_ = false;
+};
+
+/**
+ * @brief Guards of a command received over the direct link
+ *
+ * Same SKCommandGuard flags as the SignalK command table, minus the
+ * connection requirement (the frame itself proves the link). Commands that
+ * only make sense from a chart plotter (reset, depth) are not accepted.
+ *
+ * @param guards Receives the guard flags
+ * @return false if the command type is not accepted over the link
+ */
+inline bool directCommandGuards(uint8_t command, uint8_t& guards) {
+    using namespace SKCommandGuard;
+    switch (static_cast<ControlCommandType>(command)) {
+    case ControlCommandType::MANUAL_WINCH:
+    case ControlCommandType::BOW_THRUSTER:
+    case ControlCommandType::AUTO_MODE:
+    case ControlCommandType::ARM_TARGET:
+    case ControlCommandType::ARM_SCOPE:
+        guards = NO_EMERGENCY_STOP;
+        return true;
+    case ControlCommandType::HOME:
+        guards = NO_EMERGENCY_STOP | TRIGGER;
+        return true;
+    case ControlCommandType::EMERGENCY_STOP:
+        guards = NONE;
+        return true;
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "services/ControlTask.h"
+#include "services/DirectCommandFrame.h"
+#include "services/NetworkScheduler.h"
+#include "services/StateManager.h"
+
+/**
+ * @file DirectCommandService.h
+ * @brief Low-latency command link from a paired helm controller (UDP)
+ *
+ * Receives DirectCommandFrame frames on DIRECT_COMMAND_PORT, independent of
+ * the SignalK server and of its 5 s reconnect hold-off. Authentic frames
+ * (SipHash tag with the pairing key, current nonce, rising sequence) go
+ * through the same guard evaluation as SignalK commands
+ * (skCommandAllowed()) and into the same ControlTask::submit() queue, with
+ * CommandSource::DIRECT.
+ *
+ * Motion commands are hold-to-run, like the physical remote: the helm
+ * repeats a winch or thruster command while the button is held. Each is
+ * submitted with a DIRECT_HOLD_TIMEOUT_MS command lease, so the control
+ * task stops that actuator on its own clock when no repeat arrived
+ * (button released, helm or WiFi gone), even if the networking side
+ * stalls.
+ *
+ * Latency, both paths (electrical.bow.ecu.perf.*):
+ * - commandToRelay / directCommandToRelay: command received -> relay
+ * - directRoundTrip: helm-measured round trip, reported in its next frame
+ *
+ * Frames arrive on the AsyncUDP task; the status items run on the
+ * NetworkScheduler. Shared state is atomic.
+ *
+ * With DIRECT_COMMAND_USE_UDP=0, or without a DIRECT_COMMAND_KEY in
+ * secrets.h, the link is not opened.
+ */
+
+#ifndef DIRECT_COMMAND_USE_UDP
+#define DIRECT_COMMAND_USE_UDP 0
+#endif
+
+class DirectCommandService {
+public:
+    static constexpr uint16_t DIRECT_COMMAND_PORT = 50210;      ///< UDP listen port
+    static constexpr uint16_t DIRECT_HOLD_TIMEOUT_MS = 500;     ///< Motion lease: stops without a repeat
+    static constexpr unsigned long STATUS_INTERVAL_MS = 1000;   ///< Status page refresh period
+    static constexpr uint32_t STATUS_BUDGET_US = 1000;          ///< Scheduler overrun threshold
+
+    /**
+     * @param key SIPHASH_KEY_SIZE byte pairing key (copied)
+     */
+    DirectCommandService(StateManager& state_manager, ControlTask& control_task, const uint8_t* key);
+
+    /**
+     * @brief Open the UDP port and schedule the status refresh
+     * Must be called during setup() after WiFi is started by SensESP
+     */
+    void initialize(NetworkScheduler& scheduler);
+
+    /**
+     * @brief Handle one received datagram (AsyncUDP task)
+     * @param reply Receives the ack to send back
+     * @return true if reply should be sent
+     */
+    bool receive(const uint8_t* data, size_t length, uint8_t* reply);
+
+    /**
+     * @brief Refresh the status page
+     */
+    void publishStatus();
+
+    /// @return Frames submitted to the control side
+    uint32_t getAccepted() const { return accepted_.load(std::memory_order_relaxed); }
+
+    /// @return Authentic frames refused by a guard
+    uint32_t getBlocked() const { return blocked_.load(std::memory_order_relaxed); }
+
+    /// @return Frames dropped as invalid, replayed or with a stale nonce
+    uint32_t getRejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+private:
+    StateManager& state_manager_;
+    ControlTask& control_task_;
+    uint8_t key_[SIPHASH_KEY_SIZE];
+    DirectReplayGuard replay_guard_;
+
+    std::atomic<uint32_t> accepted_{0};
+    std::atomic<uint32_t> blocked_{0};
+    std::atomic<uint32_t> rejected_{0};
+
+    void encodeAck(const DirectFrame& frame, DirectFrameStatus status, uint8_t* reply) const;
+};
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include "services/NetworkScheduler.h"
+#include "util/EventLog.h"
+#include "sensesp/system/local_debug.h"
+
+#if defined(ARDUINO)
+#include "esp_timer.h"
+#endif
+
+/**
+ * @file EventLogger.h
+ * @brief Deferred, coalescing debug log for the control path
+ *
+ * Control-side code logs with EventLogger::log(LogEvent, a, b): the event
+ * id and two numeric arguments go into a RAM EventLog as a 16-byte binary
+ * record. The EventLogger instance (created with the networking services)
+ * drains the log on the SensESP event loop, formats each record from its
+ * LOG_EVENT_FORMATS row and prints it with debugD, so printf and serial
+ * latency never sit in a relay-switching path. The last line and the log
+ * counters are also shown on the web UI status page.
+ *
+ * Repeated identical events are merged into one line with a repeat count.
+ * Overflowed records are counted, not blocked on.
+ *
+ * With LOG_USE_EVENT_LOG=0 log() formats and prints immediately (the old
+ * inline debugD behaviour).
+ */
+
+#ifndef LOG_USE_EVENT_LOG
+#define LOG_USE_EVENT_LOG 0
+#endif
+
+/// Events logged from the control path (index into LOG_EVENT_FORMATS)
+enum class LogEvent : uint16_t {
+    MOTOR_UP,              ///< Winch UP relay commanded
+    MOTOR_DOWN,            ///< Winch DOWN relay commanded
+    MOTOR_STOP,            ///< Winch relays released
+    BOW_PORT,              ///< Thruster port relay commanded
+    BOW_STARBOARD,         ///< Thruster starboard relay commanded
+    BOW_STOP,              ///< Thruster relays released
+    RELAY_THERMAL_TRIP,    ///< a: relay pin A; duty budget used up
+    HOME_BLOCKS_UP,        ///< Retrieve refused, anchor already home
+    HOME_STOPPED,          ///< Winch stopped at home
+    HOME_COUNTER_RESET,    ///< Counter reset on home arrival
+    AUTO_HOME_DONE,        ///< Auto mode reached home and disabled
+    AUTO_TARGET_REACHED,   ///< a: rode length (float)
+    COAST_LEARNED_UP,      ///< a: coast metres, b: learned seconds (floats)
+    COAST_LEARNED_DOWN,    ///< a: coast metres, b: learned seconds (floats)
+    PULSE_STATUS,          ///< a: pulse count, b: rode metres (float)
+    COMMAND_QUEUE_FULL,    ///< Control command dropped
+    AUTO_MODE_SET,         ///< a: 1 enabled, 0 disabled
+    HOME_COMMAND_BLOCKED,  ///< Home command refused, manual control active
+    TARGET_ARMED,          ///< a: target, b: current rode (floats)
+    TARGET_NEEDS_ENABLE,   ///< Target armed while auto mode was disabled
+    RESET_COMMAND,         ///< Counter reset command
+    SIGNALK_COMMAND,       ///< a: command table index, b: value (float)
+    SCOPE_ARMED,           ///< a: scope ratio, b: current target (floats)
+    DIRECT_COMMAND,        ///< a: command type, b: value (float)
+    SUPERVISOR_TRIP,       ///< a: trips since boot; relays were cut on a missed deadline
+    COMMAND_LEASE_EXPIRED, ///< a: CommandActuator stopped (no keep-alive within the lease)
+    CHANNEL_HOME_STOPPED,  ///< a: windlass channel; winch stopped at home
+    CHANNEL_HOME_RESET,    ///< a: windlass channel; counter reset on home arrival
+    POWER_IDLE_ENTERED,    ///< a: idle entries since boot
+    POWER_IDLE_EXITED,     ///< Activity: back to full power
+    COUNT
+};
+
+/// How a record argument is formatted
+enum class LogArg : uint8_t {
+    NONE,
+    INT,    ///< int32_t
+    FLOAT,  ///< float bits
+};
+
+/// Text and argument types of one event
+struct LogEventFormat {
+    const char* text;  ///< printf format for the used arguments
+    LogArg a;
+    LogArg b;
+};
+
+/// Formats in LogEvent order
+constexpr LogEventFormat LOG_EVENT_FORMATS[] = {
+    {"Motor UP activated", LogArg::NONE, LogArg::NONE},
+    {"Motor DOWN activated", LogArg::NONE, LogArg::NONE},
+    {"Motor stopped", LogArg::NONE, LogArg::NONE},
+    {"Bow propeller turning PORT", LogArg::NONE, LogArg::NONE},
+    {"Bow propeller turning STARBOARD", LogArg::NONE, LogArg::NONE},
+    {"Bow propeller stopped", LogArg::NONE, LogArg::NONE},
+    {"Relay pair GPIO %ld: duty budget used up - thermal trip", LogArg::INT, LogArg::NONE},
+    {"Anchor already home - cannot retrieve further", LogArg::NONE, LogArg::NONE},
+    {"Anchor home reached - stopped", LogArg::NONE, LogArg::NONE},
+    {"Anchor at home - counter reset", LogArg::NONE, LogArg::NONE},
+    {"Auto-home reached - automatic mode disabled", LogArg::NONE, LogArg::NONE},
+    {"Target %.2f m reached - automatic mode disabled", LogArg::FLOAT, LogArg::NONE},
+    {"Coast learned (up): %.3f m -> %.2f s", LogArg::FLOAT, LogArg::FLOAT},
+    {"Coast learned (down): %.3f m -> %.2f s", LogArg::FLOAT, LogArg::FLOAT},
+    {"Pulses: %ld, Chain: %.2f m", LogArg::INT, LogArg::FLOAT},
+    {"Control command queue full - command dropped", LogArg::NONE, LogArg::NONE},
+    {"Automatic mode %ld (1 = enabled)", LogArg::INT, LogArg::NONE},
+    {"Home command blocked - manual control active", LogArg::NONE, LogArg::NONE},
+    {"Target armed: %.2f m (current: %.2f m)", LogArg::FLOAT, LogArg::FLOAT},
+    {"Auto mode disabled - target armed requires re-enable", LogArg::NONE, LogArg::NONE},
+    {"Reset command triggered", LogArg::NONE, LogArg::NONE},
+    {"SignalK command #%ld = %.2f", LogArg::INT, LogArg::FLOAT},
+    {"Scope armed: %.1f:1 (target %.2f m)", LogArg::FLOAT, LogArg::FLOAT},
+    {"Direct command %ld = %.2f", LogArg::INT, LogArg::FLOAT},
+    {"Supervisor cut the relays - deadline missed (trip %ld)", LogArg::INT, LogArg::NONE},
+    {"Command lease expired - actuator %ld stopped", LogArg::INT, LogArg::NONE},
+    {"Windlass channel %ld: anchor home reached - stopped", LogArg::INT, LogArg::NONE},
+    {"Windlass channel %ld: anchor at home - counter reset", LogArg::INT, LogArg::NONE},
+    {"Idle power mode entered (%ld since boot)", LogArg::INT, LogArg::NONE},
+    {"Idle power mode left - activity", LogArg::NONE, LogArg::NONE},
+};
+static_assert(sizeof(LOG_EVENT_FORMATS) / sizeof(LOG_EVENT_FORMATS[0]) ==
+                  static_cast<size_t>(LogEvent::COUNT),
+              "LOG_EVENT_FORMATS must have one row per LogEvent");
+
+class EventLogger {
+public:
+    static constexpr size_t CAPACITY = 128;                      ///< Records buffered (2 KB)
+    static constexpr unsigned long DRAIN_INTERVAL_MS = 100;      ///< Event loop drain period
+    static constexpr uint32_t DRAIN_BUDGET_US = 5000;            ///< Scheduler overrun threshold
+    static constexpr uint8_t DRAIN_BATCH = 16;                   ///< Records formatted per drain
+
+    /**
+     * @brief Log an event with up to two numeric arguments (any task, ISR-safe)
+     * Integral arguments are stored as int32_t, floating point as float.
+     */
+    template <typename A = int32_t, typename B = int32_t>
+    static void log(LogEvent event, A a = 0, B b = 0) {
+#if LOG_USE_EVENT_LOG
+        log_.record(static_cast<uint16_t>(event), toArg(a), toArg(b), nowMs());
+#else
+        EventRecord record;
+        record.id = static_cast<uint16_t>(event);
+        record.a = toArg(a);
+        record.b = toArg(b);
+        char text[96];
+        format(record, text, sizeof(text));
+        debugD("%s", text);
+#endif
+    }
+
+    /**
+     * @brief Format a record as text
+     * @return Characters written (excluding the terminator)
+     */
+    static int format(const EventRecord& record, char* text, size_t size) {
+        if (record.id >= static_cast<uint16_t>(LogEvent::COUNT)) {
+            return snprintf(text, size, "Unknown event %u", static_cast<unsigned>(record.id));
+        }
+        const LogEventFormat& row = LOG_EVENT_FORMATS[record.id];
+        int length = formatArgs(row, record, text, size);
+        if (record.repeats > 0 && length >= 0 && static_cast<size_t>(length) < size) {
+            length += snprintf(text + length, size - length, " (x%u)",
+                               static_cast<unsigned>(record.repeats) + 1);
+        }
+        return length;
+    }
+
+    /// @return The binary log (drained by the instance; tests)
+    static EventLog<CAPACITY>& buffer() { return log_; }
+
+    /**
+     * @brief Create the status page items and schedule the drain
+     * Must be called during setup() after sensesp_app is created
+     */
+    void initialize(NetworkScheduler& scheduler);
+
+    /**
+     * @brief Format and print up to DRAIN_BATCH pending records
+     */
+    void drain();
+
+private:
+    static inline EventLog<CAPACITY> log_;  ///< Shared binary log
+
+    template <typename T>
+    static uint32_t toArg(T value) {
+        if constexpr (std::is_floating_point<T>::value) {
+            float f = static_cast<float>(value);
+            uint32_t bits;
+            memcpy(&bits, &f, sizeof(bits));
+            return bits;
+        } else {
+            return static_cast<uint32_t>(static_cast<int32_t>(value));
+        }
+    }
+
+    static float argFloat(uint32_t bits) {
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    static double argValue(LogArg kind, uint32_t bits) {
+        return kind == LogArg::FLOAT ? argFloat(bits) : static_cast<double>(static_cast<int32_t>(bits));
+    }
+
+    static int formatArgs(const LogEventFormat& row, const EventRecord& record, char* text, size_t size) {
+        // printf needs the promoted type of each argument, so branch on the kinds
+        if (row.a == LogArg::NONE) {
+            return snprintf(text, size, "%s", row.text);
+        }
+        if (row.b == LogArg::NONE) {
+            return row.a == LogArg::FLOAT
+                       ? snprintf(text, size, row.text, argValue(row.a, record.a))
+                       : snprintf(text, size, row.text, static_cast<long>(static_cast<int32_t>(record.a)));
+        }
+        if (row.a == LogArg::FLOAT && row.b == LogArg::FLOAT) {
+            return snprintf(text, size, row.text, argValue(row.a, record.a), argValue(row.b, record.b));
+        }
+        if (row.a == LogArg::INT && row.b == LogArg::FLOAT) {
+            return snprintf(text, size, row.text, static_cast<long>(static_cast<int32_t>(record.a)),
+                            argValue(row.b, record.b));
+        }
+        if (row.a == LogArg::FLOAT) {
+            return snprintf(text, size, row.text, argValue(row.a, record.a),
+                            static_cast<long>(static_cast<int32_t>(record.b)));
+        }
+        return snprintf(text, size, row.text, static_cast<long>(static_cast<int32_t>(record.a)),
+                        static_cast<long>(static_cast<int32_t>(record.b)));
+    }
+
+    static uint32_t nowMs() {
+#if defined(ARDUINO)
+        return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+#else
+        return 0;
+#endif
+    }
+};
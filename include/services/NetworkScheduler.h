@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include "util/FrameScheduler.h"
+
+/**
+ * @file NetworkScheduler.h
+ * @brief Frame scheduler for the periodic work of the networking side
+ *
+ * All periodic event loop work (telemetry, connection monitoring, log
+ * drain, journal flush, config save, perf publishing) is registered with
+ * one NetworkScheduler owned by BoatBowControlApp and driven by a single
+ * event loop timer every NETWORK_MINOR_FRAME_MS. Tasks of equal rate get
+ * different phases, and per-task run time, overruns and late runs are on
+ * the status page ("Scheduler" group).
+ *
+ * The control side keeps its own fixed period in ControlTask (core 1); it
+ * does not depend on this scheduler.
+ */
+
+constexpr uint32_t NETWORK_MINOR_FRAME_MS = 25;  ///< Minor frame (40 Hz)
+constexpr size_t NETWORK_SCHEDULER_TASKS = 14;   ///< Task slots
+
+using NetworkScheduler = FrameScheduler<NETWORK_SCHEDULER_TASKS>;
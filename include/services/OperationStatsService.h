@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include "Arduino.h"
+#include "interfaces/IStatsStore.h"
+#include "services/ControlCommand.h"
+#include "services/NetworkScheduler.h"
+#include "services/StateManager.h"
+#include "util/OperationCounters.h"
+
+/**
+ * @file OperationStatsService.h
+ * @brief Per-session and lifetime operation statistics for maintenance planning
+ *
+ * Counts chain paid out and hauled in, winch run time and starts per
+ * direction, thruster on-time and starts, and emergency stops per source.
+ * The counting calls are static, like PerfMonitor, so the motor drivers
+ * (ESP32Motor, BowPropellerMotor), the pulse drain and the emergency stop
+ * count directly on the control path: one relaxed atomic add, no
+ * allocation, no storage access.
+ *
+ * Session counters start at 0 at boot. Lifetime totals are the record
+ * restored from the store plus the session; SAVE_INTERVAL_MS after a change
+ * (NetworkScheduler task) the lifetime record is written in one batch and
+ * both summaries are published as JSON objects:
+ * - electrical.bow.ecu.statistics.session
+ * - electrical.bow.ecu.statistics.lifetime
+ * Chain is reported in metres at the current calibration, times in seconds.
+ * A run's time is added when the run ends.
+ *
+ * DESIGN PRINCIPLE: Single Writer
+ * - Control side: motion(), addPulses(), emergencyStop()
+ * - Networking side: restore() at boot, flush() (only user of the store)
+ */
+class OperationStatsService {
+public:
+    static constexpr unsigned long SAVE_INTERVAL_MS = 60000;  ///< Batch write and publish period
+    static constexpr uint32_t SAVE_BUDGET_US = 30000;         ///< Scheduler overrun threshold (NVS write)
+
+    /// Report the commanded direction of a motor (control side)
+    static void motion(OperationMotor motor, int8_t direction) {
+        session_.motion(motor, direction, millis());
+    }
+
+    /// Count chain movement from a pulse drain (control side)
+    static void addPulses(long delta_pulses) { session_.addPulses(delta_pulses); }
+
+    /// Count an emergency stop activation
+    static void emergencyStop(CommandSource source);
+
+    /// @return Counters since boot
+    static const OperationCounters& session() { return session_; }
+
+    OperationStatsService(IStatsStore& store, StateManager& state_manager)
+        : store_(store), state_manager_(state_manager) {}
+
+    /**
+     * @brief Load the lifetime totals (boot, one store read)
+     * @return false if no valid record was found (lifetime starts at 0)
+     */
+    bool restore();
+
+    /**
+     * @brief Create SignalK outputs and status page items, schedule the batch save
+     * Must be called during setup() after sensesp_app is created
+     */
+    void initialize(NetworkScheduler& scheduler);
+
+    /**
+     * @brief Save the lifetime record and publish the summaries if anything changed
+     */
+    void flush();
+
+    /// @return Lifetime value of a counter
+    uint32_t getLifetime(OperationStat stat) const {
+        return lifetime_base_[static_cast<size_t>(stat)] + session_.get(stat);
+    }
+
+    /// @return Records written since boot
+    uint32_t getWrites() const { return writes_; }
+
+private:
+    static inline OperationCounters session_;
+
+    IStatsStore& store_;
+    StateManager& state_manager_;
+    uint32_t lifetime_base_[OPERATION_STAT_COUNT] = {};  ///< Restored at boot
+    uint32_t last_flushed_[OPERATION_STAT_COUNT] = {};   ///< Session counters at the last flush
+    bool published_ = false;                             ///< Summaries sent at least once
+    uint32_t writes_ = 0;
+
+    void publish(const uint32_t (&values)[OPERATION_STAT_COUNT], bool lifetime);
+};
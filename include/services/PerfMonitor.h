@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "Arduino.h"
+#include "hal/cpu_hal.h"
+#include "services/NetworkScheduler.h"
+#include "util/LatencyHistogram.h"
+
+/**
+ * @file PerfMonitor.h
+ * @brief Hot-path latency instrumentation published over SignalK and the web UI
+ *
+ * Probes measure with the CPU cycle counter and feed a LatencyHistogram per
+ * probe; nothing is allocated after setup and record() is ISR-safe.
+ *
+ * Two measurement styles:
+ * - PerfSpan: RAII span around a block (ISR duration, event loop tick)
+ * - begin()/end(): latency between two code points (home sensor edge to
+ *   winch stop); end() only records if a begin() is pending
+ * - begin()/arm()/endArmed(): command to relay edge. The receiving side
+ *   begins on a motion command, the control side arms the measurement
+ *   once it applied that command and a relay edge is due (cancel()
+ *   otherwise), and the winch relay pair ends it when it actually drives
+ *   the relay. Motion from other sources never closes a measurement.
+ *
+ * Every PUBLISH_INTERVAL_MS (NetworkScheduler task) the monitor publishes min/p50/p99/max (seconds)
+ * under electrical.bow.ecu.perf.<probe>.* and updates a status page item
+ * per probe, then starts a fresh window.
+ *
+ * The cycle counter is per core, so PerfSpan and record() must start and
+ * finish on the same core. begin()/end() pairs use micros() instead and may
+ * cross cores (SignalK on core 0, relay switch on the control core).
+ */
+
+/// Instrumented code paths
+enum class PerfProbe : uint8_t {
+    PULSE_ISR,         ///< Pulse ISR (legacy GPIO) or PCNT overflow ISR duration
+    REMOTE_ISR,        ///< Remote button edge ISR duration
+    EVENT_LOOP_TICK,   ///< event_loop()->tick() duration
+    COMMAND_TO_RELAY,  ///< SignalK manual motion command received -> winch relay driven
+    COMMAND_QUEUE_DELAY, ///< Command submitted -> applied by the control side
+    HOME_ISR_TO_RELAY, ///< Home ISR entry -> WINCH_UP relay cut by register write
+    HOME_TO_STOP,      ///< Home sensor edge (ISR, else GPIO snapshot) -> winch state stopped
+    DIRECT_COMMAND_TO_RELAY, ///< Direct link winch motion command received -> winch relay driven
+    DIRECT_ROUND_TRIP, ///< Helm-measured round trip of the direct link (reported by the helm)
+    COUNT
+};
+
+class PerfMonitor {
+public:
+    static constexpr unsigned long PUBLISH_INTERVAL_MS = 10000;  ///< Statistics window
+    static constexpr uint32_t PUBLISH_BUDGET_US = 10000;        ///< Scheduler overrun threshold
+
+    /// @return Current CPU cycle count (IRAM-safe)
+    static inline uint32_t IRAM_ATTR cycles() { return cpu_hal_get_cycle_count(); }
+
+    /**
+     * @brief Record a duration that started at start_cycles and ends now
+     */
+    static inline void IRAM_ATTR record(PerfProbe probe, uint32_t start_cycles) {
+        histograms_[index(probe)].record((cycles() - start_cycles) / cycles_per_us_);
+    }
+
+    /**
+     * @brief Record a duration measured elsewhere (microseconds)
+     */
+    static inline void recordUs(PerfProbe probe, uint32_t duration_us) {
+        histograms_[index(probe)].record(duration_us);
+    }
+
+    /**
+     * @brief Mark the start of a cross-module latency measurement (any core)
+     */
+    static void begin(PerfProbe probe) {
+        uint8_t i = index(probe);
+        pending_start_us_[i] = micros();
+        pending_[i].store(PENDING, std::memory_order_release);
+    }
+
+    /**
+     * @brief Finish a latency measurement started with begin() (no-op if none pending)
+     */
+    static void end(PerfProbe probe) {
+        uint8_t i = index(probe);
+        if (pending_[i].exchange(IDLE, std::memory_order_acquire) != IDLE) {
+            recordUs(probe, micros() - pending_start_us_[i]);
+        }
+    }
+
+    /**
+     * @brief Hand a begun measurement to the next endArmed() (no-op if none pending)
+     */
+    static void arm(PerfProbe probe) {
+        uint8_t expected = PENDING;
+        pending_[index(probe)].compare_exchange_strong(expected, ARMED, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Finish an armed measurement (no-op if none armed; may run under a spinlock)
+     */
+    static void endArmed(PerfProbe probe) {
+        uint8_t i = index(probe);
+        uint8_t expected = ARMED;
+        if (pending_[i].compare_exchange_strong(expected, IDLE, std::memory_order_acquire)) {
+            recordUs(probe, micros() - pending_start_us_[i]);
+        }
+    }
+
+    /**
+     * @brief Drop a begun or armed measurement (command stopped, rejected or without an edge)
+     */
+    static void cancel(PerfProbe probe) {
+        pending_[index(probe)].store(IDLE, std::memory_order_relaxed);
+    }
+
+    /// @return Histogram for a probe (current window)
+    static const LatencyHistogram& histogram(PerfProbe probe) { return histograms_[index(probe)]; }
+
+    /**
+     * @brief Create SignalK outputs and status page items, schedule publishing
+     * Must be called during setup() after sensesp_app is created
+     */
+    void initialize(NetworkScheduler& scheduler);
+
+    /**
+     * @brief Publish the current window and reset the histograms
+     */
+    void publish();
+
+private:
+    static constexpr uint8_t PROBE_COUNT = static_cast<uint8_t>(PerfProbe::COUNT);
+
+    static inline LatencyHistogram histograms_[PROBE_COUNT];  ///< One window per probe
+    static constexpr uint8_t IDLE = 0;     ///< No measurement outstanding
+    static constexpr uint8_t PENDING = 1;  ///< begin() called
+    static constexpr uint8_t ARMED = 2;    ///< arm() called, waiting for endArmed()
+
+    static inline uint32_t pending_start_us_[PROBE_COUNT] = {};  ///< begin() timestamps (micros)
+    static inline std::atomic<uint8_t> pending_[PROBE_COUNT] = {};  ///< IDLE, PENDING or ARMED
+    static inline uint32_t cycles_per_us_ = 240;              ///< CPU MHz (set in initialize)
+
+    static constexpr uint8_t index(PerfProbe probe) { return static_cast<uint8_t>(probe); }
+};
+
+/**
+ * @brief Records the duration of its scope into a probe
+ *
+ * Example:
+ *   { PerfSpan span(PerfProbe::EVENT_LOOP_TICK); event_loop()->tick(); }
+ */
+class PerfSpan {
+public:
+    explicit PerfSpan(PerfProbe probe) : probe_(probe), start_(PerfMonitor::cycles()) {}
+    ~PerfSpan() { PerfMonitor::record(probe_, start_); }
+
+private:
+    PerfProbe probe_;  ///< Probe to record into
+    uint32_t start_;   ///< Start cycle count
+};
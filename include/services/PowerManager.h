@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "Arduino.h"
+#include "services/NetworkScheduler.h"
+#include "util/IdleTracker.h"
+
+class ESP32PulseCounter;
+
+/**
+ * @file PowerManager.h
+ * @brief Idle power mode: light sleep between control ticks, WiFi modem sleep
+ *
+ * At anchor for days on the house battery nothing moves, yet the ECU kept
+ * the CPU and the radio fully awake. The control side reports every step
+ * whether anything is active (winch, thruster, automatic mode, a command
+ * lease, chain pulses, a command just applied); after IDLE_ENTRY_MS
+ * without activity the ECU is idle:
+ * - the power management lock that keeps the CPU out of light sleep is
+ *   released, so FreeRTOS enters automatic light sleep whenever every
+ *   task waits (between control ticks, event loop passes and beacons)
+ * - the remote inputs, the home sensors and the pulse inputs are armed as
+ *   GPIO wake sources on the level opposite to their current one, so any
+ *   change wakes the CPU within about a millisecond
+ * - WiFi goes to modem sleep (DTIM), the event loop task yields for
+ *   IDLE_EVENT_LOOP_DELAY_MS instead of one tick
+ * Any activity leaves idle at once: the lock is taken again, WiFi power
+ * save is turned off (low command latency while moving) and the inputs
+ * are back to their edge interrupts.
+ *
+ * A GPIO ISR of an armed pin calls wakeFromIsr() first: wake sources are
+ * level triggered, so the edge interrupts are restored before the level
+ * could fire again. Inputs are re-armed on every idle step that follows
+ * their level.
+ *
+ * The CPU frequency is not scaled (minimum = maximum), so the cycle
+ * counter timing of PerfMonitor stays valid. Light sleep needs a framework
+ * built with CONFIG_PM_ENABLE and tickless idle; without it only modem
+ * sleep and the slower event loop apply (status page "Power" group).
+ *
+ * The PCNT pulse counter does not count during light sleep. PCNT pulse
+ * inputs (addPulseInput()) get an interrupt only while armed: a wake from
+ * one holds the no-light-sleep lock at once and counts as activity, so
+ * the ECU stays awake while the chain moves (until the count has been
+ * quiet for IDLE_ENTRY_MS). The counted edge that woke the CPU is added
+ * back by the counter (WakeEdgeRecovery).
+ *
+ * With POWER_USE_IDLE_SLEEP=0 idle is only tracked for the statistics.
+ */
+
+#ifndef POWER_USE_IDLE_SLEEP
+#define POWER_USE_IDLE_SLEEP 0
+#endif
+
+class PowerManager {
+public:
+    static constexpr uint32_t IDLE_ENTRY_MS = 3000;            ///< Quiet time before idle
+    static constexpr uint32_t IDLE_EVENT_LOOP_DELAY_MS = 10;   ///< Event loop yield while idle
+    static constexpr unsigned long PUBLISH_INTERVAL_MS = 250;  ///< WiFi mode and status refresh
+    static constexpr uint32_t PUBLISH_BUDGET_US = 3000;        ///< Scheduler overrun threshold
+
+    /**
+     * @brief Configure power management and the wake sources, start active
+     * Must be called during setup() after the inputs are configured, before
+     * the control task starts
+     */
+    static void start();
+
+    /**
+     * @brief Register a PCNT pulse input as a wake source
+     * Must be called during setup() after counter.initialize(), before start()
+     */
+    static void addPulseInput(ESP32PulseCounter& counter);
+
+    /**
+     * @brief Account one control step (control side)
+     * @param active Something is active (see file comment)
+     * @param now_ms millis()
+     */
+    static void update(bool active, uint32_t now_ms);
+
+    /// @return true while in the idle power mode (any task)
+    static bool isIdle() { return idle_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Restore the edge interrupts of the armed inputs (GPIO ISRs, IRAM)
+     * Call first in every ISR of a wake source input
+     */
+    static void IRAM_ATTR wakeFromIsr();
+
+    /**
+     * @brief Create the status page items, schedule publish()
+     * Must be called during setup() after sensesp_app is created
+     */
+    void initialize(NetworkScheduler& scheduler);
+
+    /**
+     * @brief Follow the power mode with WiFi power save, refresh the status
+     */
+    void publish();
+
+private:
+    static inline IdleTracker tracker_{IDLE_ENTRY_MS};     ///< Control side
+    static inline std::atomic<bool> idle_{false};
+    static inline std::atomic<uint32_t> idle_ms_{0};       ///< tracker_ total for the status
+    static inline std::atomic<uint32_t> idle_entries_{0};
+    static inline bool light_sleep_ = false;               ///< Automatic light sleep configured
+
+    bool wifi_power_save_ = false;  ///< Applied WiFi mode (networking side)
+
+    static void enterIdle();
+    static void exitIdle();
+    static void armWakeSources();
+};
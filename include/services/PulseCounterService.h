@@ -3,15 +3,22 @@
 #include "services/StateManager.h"
 #include "winch_controller.h"
 #include "home_sensor.h"
+#include "interfaces/IPulseSource.h"
+#include "chain_motion_estimator.h"
+#include "services/RodePersistenceService.h"
+#include "util/SettleDetector.h"
 
 /**
  * @file PulseCounterService.h
  * @brief Service for managing pulse counting and rode length calculation
  * 
  * This service handles:
- * - Reading pulse count from ISR
+ * - Reading pulse count from ISR or a hardware pulse source (PCNT)
  * - Converting pulses to rode length
+ * - Estimating chain speed / acceleration / stall from pulse edge timestamps
  * - Detecting when anchor reaches home
+ * - Restoring the counter after a reset and keeping it persisted
+ *   (RodePersistenceService: RTC every tick, journal once the count settled)
  * - Updating state through StateManager
  * 
  * DESIGN PRINCIPLE: Single Responsibility
@@ -21,33 +28,49 @@
  */
 class PulseCounterService {
 public:
+    static constexpr uint32_t JOURNAL_SETTLE_MS = 1000;  ///< Count unchanged (winch off) before journaling
+
     /**
      * @brief Construct pulse counter service
      * @param state_manager Reference to state manager (for state updates)
      * @param winch_controller Reference to anchor winch controller
      * @param home_sensor Reference to home sensor
-     * @param read_delay_ms Delay between pulse count reads (milliseconds)
      */
     PulseCounterService(StateManager& state_manager,
                         AnchorWinchController& winch_controller,
-                        HomeSensor& home_sensor,
-                        unsigned int read_delay_ms = 100)
+                        HomeSensor& home_sensor)
         : state_manager_(state_manager),
           winch_controller_(winch_controller),
-          home_sensor_(home_sensor),
-          read_delay_ms_(read_delay_ms) {}
+          home_sensor_(home_sensor) {}
 
     /**
-     * @brief Initialize the pulse counter service
-     * Must be called from setup() to set up the recurring update task
+     * @brief Update pulse count and rode length (call periodically)
+     * Handles home sensor logic and auto-home mode.
+     * Driven by ControlLoopService at the control rate.
      */
-    void initialize();
+    void update();
 
     /**
-     * @brief Update pulse count and rode length (call periodically)
-     * Handles home sensor logic and auto-home mode
+     * @brief Set a hardware pulse source polled on every update()
+     * @param pulse_source Pointer to pulse source (nullptr = counts come from the pulse ISR)
      */
-    void update();
+    void setPulseSource(IPulseSource* pulse_source) {
+        pulse_source_ = pulse_source;
+    }
+
+    /**
+     * @brief Set the persistence layer for the counter
+     * @param persistence RTC/journal persistence (nullptr = not persisted)
+     */
+    void setPersistence(RodePersistenceService* persistence) {
+        persistence_ = persistence;
+    }
+
+    /**
+     * @brief Restore the counter from RTC memory or the journal (boot only)
+     * The value stays unverified until the next home event.
+     */
+    void restoreCounter();
 
     /**
      * @brief Get current rode length
@@ -57,10 +80,23 @@ public:
         return state_manager_.getRodeLength();
     }
 
+    /// @return Chain speed in m/s (positive = deploying, negative = retrieving)
+    float getChainSpeed() const { return motion_.getSpeed(); }
+
+    /// @return Filtered chain acceleration in m/s^2
+    float getChainAcceleration() const { return motion_.getAcceleration(); }
+
+    /// @return true if the winch is energised but no pulses arrive
+    bool isChainStalled() const { return motion_.isStalled(); }
+
 private:
     StateManager& state_manager_;             ///< State holder (reads/writes state)
     AnchorWinchController& winch_controller_;       ///< Anchor winch controller (to stop on home)
     HomeSensor& home_sensor_;                 ///< Home sensor (to detect arrival)
-    unsigned int read_delay_ms_;                      ///< Update interval in milliseconds
+    IPulseSource* pulse_source_ = nullptr;    ///< Hardware pulse source (nullptr = ISR counting)
+    ChainMotionEstimator motion_;             ///< Speed / acceleration / stall from edges
+    RodePersistenceService* persistence_ = nullptr;  ///< Counter persistence (optional)
+    SettleDetector journal_settle_{JOURNAL_SETTLE_MS};  ///< Settled count to journal
+    uint32_t journaled_epoch_ = 0;            ///< Reset epoch of the last journal request
     unsigned long last_debug_ms_ = 0;         ///< Throttle debug output
 };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "interfaces/IRodeStore.h"
+#include "util/Crc32.h"
+
+/**
+ * @file RodeJournal.h
+ * @brief Append-only, wear-spreading journal of the rode counter
+ *
+ * Each append writes the next slot of a small ring (sequence % SLOTS) with
+ * a fresh sequence number and CRC; nothing is ever rewritten in place, so
+ * flash wear is spread over all slots and a write torn by a power loss only
+ * loses that one record. restore() picks the valid record with the newest
+ * sequence (wrap-safe comparison).
+ *
+ * Appends are rare (once per settled stop) and must not run on the control
+ * side: flash writes stall the CPU for milliseconds.
+ */
+
+constexpr uint32_t RODE_RECORD_MAGIC = 0x524F4445UL;  ///< "RODE"
+
+/// @return Record with magic and CRC filled in
+inline RodeRecord makeRodeRecord(uint32_t sequence, int32_t pulse_count) {
+    RodeRecord record = {};
+    record.magic = RODE_RECORD_MAGIC;
+    record.sequence = sequence;
+    record.pulse_count = pulse_count;
+    record.crc = crc32(&record, offsetof(RodeRecord, crc));
+    return record;
+}
+
+/// @return true if record has the magic and a matching CRC
+inline bool isValidRodeRecord(const RodeRecord& record) {
+    return record.magic == RODE_RECORD_MAGIC &&
+           record.crc == crc32(&record, offsetof(RodeRecord, crc));
+}
+
+class RodeJournal {
+public:
+    static constexpr size_t SLOTS = 8;  ///< Ring size (records kept)
+
+    explicit RodeJournal(IRodeStore& store) : store_(store) {}
+
+    /**
+     * @brief Find the newest valid record
+     * @param pulse_count Receives the journaled count
+     * @return false if no valid record exists
+     */
+    bool restore(int32_t& pulse_count) {
+        bool found = false;
+        RodeRecord newest = {};
+        for (size_t slot = 0; slot < SLOTS; slot++) {
+            RodeRecord record = {};
+            if (!store_.readSlot(slot, record) || !isValidRodeRecord(record)) {
+                continue;
+            }
+            if (!found || static_cast<int32_t>(record.sequence - newest.sequence) > 0) {
+                newest = record;
+                found = true;
+            }
+        }
+        if (found) {
+            sequence_ = newest.sequence;
+            last_count_ = newest.pulse_count;
+            has_last_ = true;
+            pulse_count = newest.pulse_count;
+        }
+        return found;
+    }
+
+    /**
+     * @brief Append a record unless it repeats the last journaled count
+     * @return true if a record was written
+     */
+    bool append(int32_t pulse_count) {
+        if (has_last_ && pulse_count == last_count_) {
+            return false;
+        }
+        uint32_t sequence = sequence_ + 1;
+        if (!store_.writeSlot(sequence % SLOTS, makeRodeRecord(sequence, pulse_count))) {
+            return false;
+        }
+        sequence_ = sequence;
+        last_count_ = pulse_count;
+        has_last_ = true;
+        return true;
+    }
+
+private:
+    IRodeStore& store_;        ///< Slot storage
+    uint32_t sequence_ = 0;    ///< Sequence of the newest record
+    int32_t last_count_ = 0;   ///< Count of the newest record
+    bool has_last_ = false;    ///< True once a record was read or written
+};
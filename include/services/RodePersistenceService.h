@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "interfaces/IRodeStore.h"
+#include "services/NetworkScheduler.h"
+#include "services/RodeJournal.h"
+
+/**
+ * @file RodePersistenceService.h
+ * @brief Keeps the rode counter across resets (RTC memory + NVS journal)
+ *
+ * Two layers:
+ * - RTC slow memory (RTC_NOINIT): the live count, rewritten by the control
+ *   side whenever it changes. Survives soft resets, panics, watchdog and
+ *   OTA reboots; a RAM store, so it costs nothing on the control path.
+ * - NVS journal (RodeJournal): one record each time the count settles
+ *   with the winch off (after the coast, or chain moved by hand), flagged
+ *   by the control side and written by the networking side, off the
+ *   control path.
+ *   Survives power loss.
+ *
+ * restore() prefers a valid RTC record (not after a power-on reset), then
+ * the journal. Any restored value is unverified until the anchor is seen
+ * at home again (StateManager::isRodeVerified()).
+ *
+ * DESIGN PRINCIPLE: Single Writer
+ * - Control side: updateLive(), requestJournal()
+ * - Networking side: flush() (only user of the store after boot)
+ */
+class RodePersistenceService {
+public:
+    static constexpr unsigned long FLUSH_INTERVAL_MS = 500;  ///< Journal poll period
+    static constexpr uint32_t FLUSH_BUDGET_US = 30000;      ///< Scheduler overrun threshold (NVS write)
+
+    /// Where restore() found the counter
+    enum class RestoreSource : uint8_t {
+        NONE,     ///< Nothing valid: counter starts at 0
+        RTC,      ///< RTC memory (soft reset)
+        JOURNAL,  ///< NVS journal (power loss)
+    };
+
+    explicit RodePersistenceService(IRodeStore& store) : journal_(store) {}
+
+    /**
+     * @brief Schedule the journal flush on the networking side
+     * Must be called during setup()
+     */
+    void initialize(NetworkScheduler& scheduler);
+
+    /**
+     * @brief Find the counter that was live before the reset (boot only)
+     * @param pulse_count Receives the restored count (0 if none)
+     * @return Source of the value
+     */
+    RestoreSource restore(int32_t& pulse_count);
+
+    /**
+     * @brief Mirror the live count into RTC memory (control side, every tick)
+     */
+    void updateLive(int32_t pulse_count);
+
+    /**
+     * @brief Ask for a journal record (control side, count settled or reset)
+     */
+    void requestJournal(int32_t pulse_count);
+
+    /**
+     * @brief Write a requested journal record (networking side)
+     */
+    void flush();
+
+    /// @return Journal records written since boot
+    uint32_t getJournalWrites() const { return journal_writes_; }
+
+private:
+    RodeJournal journal_;                      ///< NVS journal (networking side after boot)
+    bool has_live_ = false;                    ///< RTC record written since boot
+    int32_t live_count_ = 0;                   ///< Last count mirrored to RTC
+    std::atomic<int32_t> pending_count_{0};    ///< Count to journal
+    std::atomic<bool> journal_pending_{false}; ///< Set by requestJournal()
+    uint32_t journal_writes_ = 0;              ///< Records written
+
+    static const char* sourceName(RestoreSource source);
+};
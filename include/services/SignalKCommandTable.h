@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "services/EventLogger.h"
+
+/**
+ * @file SignalKCommandTable.h
+ * @brief Compile-time routing table for incoming SignalK commands
+ *
+ * Each command path is one constant entry {path, value type, guard flags,
+ * handler, feedback}. SignalKService creates one listener per entry bound to
+ * the entry index, so an incoming value reaches its handler with a single
+ * table lookup - no per-command lambda or std::function.
+ *
+ * Guards common to many commands (emergency stop, connection stable) are
+ * evaluated once in skDispatchCommand() from the flags, not repeated in
+ * every handler. SignalKService::dispatchCommand() passes its state in, so
+ * host tests run the same dispatch path.
+ *
+ * DESIGN PRINCIPLE: The table is constant data (flash); adding a command is
+ * adding a row, and dispatch cost does not grow with the number of paths.
+ */
+
+class SignalKService;
+
+/// Value type of a command path (selects the SensESP listener)
+enum class SKCommandValue : uint8_t {
+    BOOL,
+    INT,
+    FLOAT,
+};
+
+/// Guard and requirement flags for a command entry
+namespace SKCommandGuard {
+    constexpr uint8_t NONE = 0;
+    constexpr uint8_t NO_EMERGENCY_STOP = 1 << 0;   ///< Blocked while the emergency stop is latched
+    constexpr uint8_t CONNECTED = 1 << 1;           ///< Blocked until the connection is stable
+    constexpr uint8_t CONNECTED_OR_ESTOP = 1 << 2;  ///< Blocked until stable, unless an emergency stop is latched
+    constexpr uint8_t TRIGGER = 1 << 3;             ///< Only a true value (> 0.5) acts
+    constexpr uint8_t NEEDS_AUTO_MODE = 1 << 4;     ///< Route only if automatic mode exists
+    constexpr uint8_t NEEDS_BOW = 1 << 5;           ///< Route only if the bow thruster exists
+    constexpr uint8_t QUIET = 1 << 6;               ///< Not event-logged (sensor streams)
+}
+
+/// Handler for an accepted command (or feedback for every received value)
+using SKCommandHandler = void (*)(SignalKService& service, float value);
+
+/// One row of the command table
+struct SKCommandEntry {
+    const char* path;           ///< SignalK path listened to
+    SKCommandValue type;        ///< Listener value type
+    uint8_t guards;             ///< SKCommandGuard flags
+    SKCommandHandler handler;   ///< Called when the guards pass
+    SKCommandHandler feedback;  ///< Called after every value with the accepted value (0 if blocked), or nullptr
+};
+
+/**
+ * @brief Evaluate the runtime guards of an entry
+ * @param guards SKCommandGuard flags
+ * @param value Received value (bool/int converted to float)
+ * @param emergency_stop_active Emergency stop latched
+ * @param commands_allowed Connection stable
+ * @return true if the handler should run
+ */
+inline bool skCommandAllowed(uint8_t guards, float value, bool emergency_stop_active,
+                             bool commands_allowed) {
+    if ((guards & SKCommandGuard::NO_EMERGENCY_STOP) && emergency_stop_active) {
+        return false;
+    }
+    if ((guards & SKCommandGuard::CONNECTED) && !commands_allowed) {
+        return false;
+    }
+    if ((guards & SKCommandGuard::CONNECTED_OR_ESTOP) && !commands_allowed &&
+        !emergency_stop_active) {
+        return false;
+    }
+    if ((guards & SKCommandGuard::TRIGGER) && value <= 0.5f) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Dispatch a received value: guards, event log, handler, feedback
+ * @param table Command table
+ * @param index Row of the received path
+ * @param service Passed to the handler and feedback
+ * @param value Received value (bool/int converted to float)
+ * @param emergency_stop_active Emergency stop latched
+ * @param commands_allowed Connection stable
+ * @return true if the guards passed and the handler ran
+ */
+inline bool skDispatchCommand(const SKCommandEntry* table, size_t index, SignalKService& service,
+                              float value, bool emergency_stop_active, bool commands_allowed) {
+    const SKCommandEntry& entry = table[index];
+    const bool allowed = skCommandAllowed(entry.guards, value, emergency_stop_active, commands_allowed);
+    if (allowed) {
+        if (!(entry.guards & SKCommandGuard::QUIET)) {
+            EventLogger::log(LogEvent::SIGNALK_COMMAND, index, value);
+        }
+        entry.handler(service, value);
+    }
+    if (entry.feedback) {
+        entry.feedback(service, allowed ? value : 0.0f);
+    }
+    return allowed;
+}
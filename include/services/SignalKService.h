@@ -9,6 +9,11 @@
 #include "automatic_mode_controller.h"
 #include "sensesp/signalk/signalk_output.h"
 #include "sensesp/system/observablevalue.h"
+#include "StatusPublisher.h"
+#include "ControlTask.h"
+#include "NetworkScheduler.h"
+#include "SignalKCommandTable.h"
+#include "util/AdaptiveEmitter.h"
 
 using namespace sensesp;
 
@@ -17,12 +22,19 @@ using namespace sensesp;
  * @brief Manages all SignalK listeners and outputs for the anchor chain counter
  * 
  * Encapsulates the creation and management of:
- * - All SignalK value listeners (remote commands)
- * - All SignalK outputs (status updates)
+ * - All SignalK value listeners (remote commands), routed through the
+ *   constant COMMAND_TABLE with centrally evaluated guards
+ * - All SignalK outputs (status updates, batched per event-loop tick)
  * - Connection state monitoring
  */
 class SignalKService {
 public:
+    // SignalK outputs created in initialize(); every one is batched through the publisher
+    static constexpr size_t FLOAT_OUTPUTS = 9;  ///< SKOutputFloat
+    static constexpr size_t BOOL_OUTPUTS = 5;   ///< SKOutputBool
+    static constexpr size_t INT_OUTPUTS = 3;    ///< SKOutputInt
+    static constexpr size_t STATUS_OUTPUTS = FLOAT_OUTPUTS + BOOL_OUTPUTS + INT_OUTPUTS;
+
     /**
      * @brief Construct the SignalK service
      * @param state_manager Reference to central state manager
@@ -31,6 +43,7 @@ public:
      * @param auto_mode_controller Pointer to automatic mode controller
      * @param emergency_stop_service Pointer to emergency stop service
      * @param pulse_counter_service Pointer to pulse counter service
+     * @param control_task Control side that executes all actuating commands
      * @param bow_propeller_controller Pointer to bow propeller controller (can be nullptr)
      */
     SignalKService(StateManager& state_manager,
@@ -39,31 +52,67 @@ public:
                    AutomaticModeController* auto_mode_controller,
                    EmergencyStopService* emergency_stop_service,
                    PulseCounterService* pulse_counter_service,
+                   ControlTask& control_task,
                    BowPropellerController* bow_propeller_controller = nullptr);
 
     /**
      * @brief Initialize all SignalK listeners and outputs
      * Must be called during setup() after all hardware has been initialized
+     * @param scheduler Runs the status sampling and connection monitoring
      */
-    void initialize();
+    void initialize(NetworkScheduler& scheduler);
 
     /**
-     * @brief Update rode length output periodically
-     * Called from main's periodic task (every 1000ms)
+     * @brief Emit status outputs that changed or are due for a heartbeat
+     * Sampled every 100 ms from the control-side StateSnapshot (commands are
+     * never echoed; status always reflects what the control side did). Each
+     * output goes through an AdaptiveEmitter so
+     * values are sent on change (beyond deadband) at up to 10 Hz while the
+     * winch or thruster runs, and as a slow heartbeat while idle.
      */
-    void updateRodeLength();
+    void updateStatusOutputs();
 
     /**
-     * @brief Start connection monitoring
+     * @brief Set the rode length change deadband
+     * @param meters Minimum rode change that triggers an emission
+     */
+    void setRodeDeadband(float meters) { rode_emitter_.setDeadband(meters); }
+
+    /**
+     * @brief Start connection monitoring (scheduled every CONNECTION_CHECK_MS)
      * Must be called after SensESP app initialization
      */
     void startConnectionMonitoring();
 
+    /**
+     * @brief Track connect/disconnect and the 5 s stabilisation delay
+     */
+    void monitorConnection();
+
+    static constexpr unsigned long STATUS_INTERVAL_MS = 100;   ///< Status sampling period
+    static constexpr uint32_t STATUS_BUDGET_US = 3000;         ///< Scheduler overrun threshold
+    static constexpr unsigned long CONNECTION_CHECK_MS = 100;  ///< Connection monitoring period
+    static constexpr uint32_t CONNECTION_BUDGET_US = 1000;     ///< Scheduler overrun threshold
+    static constexpr uint16_t COMMAND_LEASE_MS = 300;          ///< Hold-to-run window of the *Lease paths
+
+    /**
+     * @brief Route a received command value through the command table
+     * Evaluates the entry's guards once, then runs its handler and feedback.
+     * @param index Entry in COMMAND_TABLE
+     * @param value Received value (bool/int converted to float)
+     */
+    void dispatchCommand(size_t index, float value);
+
     /**
      * @brief Get the emergency stop status value (for manual updates)
      */
     ObservableValue<bool>* getEmergencyStopStatus() { return emergency_stop_status_value_; }
 
+    /**
+     * @brief Get the status publisher (batching statistics)
+     */
+    const StatusPublisher& getStatusPublisher() const { return status_publisher_; }
+
 private:
     // ========== Dependencies ==========
     StateManager& state_manager_;
@@ -72,21 +121,64 @@ private:
     AutomaticModeController* auto_mode_controller_;
     EmergencyStopService* emergency_stop_service_;
     PulseCounterService* pulse_counter_service_;
+    ControlTask& control_task_;
     BowPropellerController* bow_propeller_controller_;
 
     // ========== SignalK Outputs ==========
-    SKOutputFloat* rode_output_ = nullptr;
-    SKOutputBool* reset_output_ = nullptr;
+    // Status outputs are batched through status_publisher_ (one delta per tick)
+    StaticStatusPublisher<STATUS_OUTPUTS> status_publisher_;
+    BatchedOutput<float>* rode_output_ = nullptr;
+    BatchedOutput<float>* chain_speed_output_ = nullptr;
+    BatchedOutput<float>* chain_acceleration_output_ = nullptr;
+    BatchedOutput<bool>* chain_stalled_output_ = nullptr;
+    BatchedOutput<bool>* rode_verified_output_ = nullptr;
+    BatchedOutput<bool>* reset_output_ = nullptr;
     ObservableValue<bool>* emergency_stop_status_value_ = nullptr;
-    SKOutputInt* manual_control_output_ = nullptr;
-    SKOutputFloat* auto_mode_output_ = nullptr;
-    SKOutputFloat* target_output_ = nullptr;
-    SKOutputBool* home_command_output_ = nullptr;
-    SKOutputInt* bow_propeller_command_output_ = nullptr;
-    SKOutputInt* bow_propeller_status_output_ = nullptr;
+    BatchedOutput<int>* manual_control_output_ = nullptr;
+    BatchedOutput<float>* auto_mode_output_ = nullptr;
+    BatchedOutput<float>* target_output_ = nullptr;
+    BatchedOutput<float>* scope_output_ = nullptr;
+    BatchedOutput<bool>* home_command_output_ = nullptr;
+    BatchedOutput<int>* bow_propeller_command_output_ = nullptr;
+    BatchedOutput<int>* bow_propeller_status_output_ = nullptr;
+    BatchedOutput<float>* bow_thrust_output_ = nullptr;       ///< Achieved average thrust (%)
+    BatchedOutput<float>* boot_control_output_ = nullptr;  ///< Reset -> first control step (s)
+    BatchedOutput<float>* boot_signalk_output_ = nullptr;  ///< Reset -> first SignalK connection (s)
+
+    // ========== Adaptive Emission ==========
+    AdaptiveEmitter<float> rode_emitter_{0.05f};
+    AdaptiveEmitter<float> chain_speed_emitter_{0.02f};
+    AdaptiveEmitter<float> chain_acceleration_emitter_{0.05f};
+    AdaptiveEmitter<bool> chain_stalled_emitter_;
+    AdaptiveEmitter<bool> rode_verified_emitter_;
+    AdaptiveEmitter<int> manual_control_emitter_;
+    AdaptiveEmitter<int> bow_propeller_status_emitter_;
+    AdaptiveEmitter<float> bow_thrust_emitter_{0.02f};
+    AdaptiveEmitter<float> auto_mode_emitter_;
+    AdaptiveEmitter<float> target_emitter_;
+    AdaptiveEmitter<float> scope_emitter_;
+    AdaptiveEmitter<bool> emergency_stop_emitter_;
 
     // ========== Connection Monitoring ==========
     unsigned long connection_stable_time_ = 0;
+    bool was_connected_ = false;               ///< Connection state at the last check
+    NetworkScheduler* scheduler_ = nullptr;    ///< Set in initialize()
+
+    // ========== Command Table ==========
+    static const SKCommandEntry COMMAND_TABLE[];  ///< One row per command path
+    static const size_t COMMAND_COUNT;            ///< Rows in COMMAND_TABLE
+
+    template <ControlCommandType TYPE, uint16_t LEASE_MS = 0>
+    static void submitCommand(SignalKService& service, float value);
+    template <uint16_t LEASE_MS>
+    static void submitManualWinch(SignalKService& service, float value);
+    template <uint16_t LEASE_MS>
+    static void submitBowThrust(SignalKService& service, float value);
+    template <BatchedOutput<bool>* SignalKService::*MEMBER>
+    static void clearTrigger(SignalKService& service, float value);
+    template <BatchedOutput<int>* SignalKService::*MEMBER>
+    static void echoCommand(SignalKService& service, float value);
+    bool isRouted(const SKCommandEntry& entry) const;
 
     // ========== Helper Methods ==========
     void setupRodeLengthOutput();
@@ -95,4 +187,7 @@ private:
     void setupAutoModeBindings();
     void setupHomeCommandBindings();
     void setupBowPropellerBindings();
+    void setupBootMetricsOutputs();
+    void publishBootMetrics();
+    void setupCommandRoutes();
 };
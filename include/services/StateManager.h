@@ -1,5 +1,53 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include "util/SpscRingBuffer.h"
+#include "util/Seqlock.h"
+
+/**
+ * @brief Consistent view of the pulse counter after one drain
+ */
+struct PulseSnapshot {
+    long count = 0;                  ///< Pulse count after the drain
+    long delta = 0;                  ///< Pulses applied since the previous drain (0 on reset)
+    unsigned long timestamp_ms = 0;  ///< Time of the drain (millis())
+    uint32_t epoch = 0;              ///< Reset epoch the count belongs to
+};
+
+/**
+ * @brief Timestamped pulse edge record for speed estimation
+ */
+struct PulseEdge {
+    uint32_t timestamp_us = 0;       ///< Edge time (esp_timer_get_time())
+    int32_t pulses = 0;              ///< Signed pulses (±1 per ISR edge, batch for PCNT polls)
+};
+
+/**
+ * @brief Control-side state published for the networking side
+ *
+ * Written as one unit by the control task after every step and read as one
+ * unit by any task (seqlock), so readers never mix fields from different
+ * steps. Directions: winch 1 = up, -1 = down; bow 1 = starboard, -1 = port.
+ */
+struct StateSnapshot {
+    uint32_t sequence = 0;             ///< Incremented on every publish
+    unsigned long timestamp_ms = 0;    ///< Time of the publish (millis())
+    int32_t pulse_count = 0;           ///< Pulse counter after the last drain
+    float rode_length = 0.0f;          ///< Deployed chain in meters
+    float chain_speed = 0.0f;          ///< m/s (+ = deploying)
+    float chain_acceleration = 0.0f;   ///< m/s^2
+    float auto_mode_target = -1.0f;    ///< Armed target in meters (-1 = none)
+    float auto_mode_scope = 0.0f;      ///< Armed scope ratio (0 = length target)
+    float bow_thrust = 0.0f;           ///< Achieved average bow thrust (-1..1)
+    int8_t winch_direction = 0;        ///< Actual winch direction
+    int8_t bow_direction = 0;          ///< Actual bow thruster direction
+    bool chain_stalled = false;        ///< Energised without pulses
+    bool rode_verified = false;        ///< Counter confirmed by home (or reset) since boot
+    bool auto_mode_enabled = false;    ///< Automatic mode running
+    bool emergency_stop_active = false;  ///< Emergency stop latched
+};
+
 /**
  * @file StateManager.h
  * @brief Central state holder for the anchor counter application
@@ -22,28 +70,128 @@ public:
     /**
      * @brief Get current pulse count
      * @return Raw pulse count (increments on chain out, decrements on chain in)
+     * @note Reflects the last drainPulses(); pulses still pending in the
+     *       accumulator are not included
      */
     long getPulseCount() const { return pulse_count_; }
     
     /**
-     * @brief Set pulse count
+     * @brief Set pulse count directly
      * @param count New pulse count value
+     * @note Main loop only. Use requestPulseReset() to zero the counter
+     *       while the pulse ISR may be running.
      */
     void setPulseCount(long count) { pulse_count_ = count; }
     
     /**
      * @brief Increment pulse count (chain deploying)
+     * @note ISR-safe: a single relaxed atomic add
      */
-    void incrementPulse() { pulse_count_++; }
+    void incrementPulse() { pending_pulses_.fetch_add(1, std::memory_order_relaxed); }
     
     /**
      * @brief Decrement pulse count (chain retrieving)
+     * @note ISR-safe: a single relaxed atomic add. Clamping at 0 happens in drainPulses()
      */
-    void decrementPulse() {
-        pulse_count_--;
-        if (pulse_count_ < 0) {
+    void decrementPulse() { pending_pulses_.fetch_add(-1, std::memory_order_relaxed); }
+    
+    /**
+     * @brief Apply a signed pulse delta from a hardware pulse source
+     * @param delta Pulses since last poll (positive = chain out, negative = chain in)
+     * @note ISR-safe; clamping at 0 happens in drainPulses()
+     */
+    void addPulses(long delta) { pending_pulses_.fetch_add(delta, std::memory_order_relaxed); }
+    
+    /**
+     * @brief Request the pulse counter to be zeroed (reset command, anchor home)
+     * 
+     * Bumps the reset epoch instead of overwriting the count, so it can never
+     * race with an ISR read-modify-write. The next drainPulses() discards the
+     * pending pulses and starts the new epoch at 0.
+     */
+    void requestPulseReset() { reset_epoch_.fetch_add(1, std::memory_order_release); }
+    
+    /**
+     * @brief Drain the pulse accumulator into the count (main loop only)
+     * @param now_ms Timestamp to record in the snapshot (millis())
+     * @return Snapshot with the new count and the delta applied this tick
+     */
+    PulseSnapshot drainPulses(unsigned long now_ms) {
+        long pending = pending_pulses_.exchange(0, std::memory_order_acquire);
+        uint32_t epoch = reset_epoch_.load(std::memory_order_acquire);
+        long previous = pulse_count_;
+        
+        if (epoch != applied_epoch_) {
+            // Reset requested: everything counted before the drain belongs to the old epoch
+            applied_epoch_ = epoch;
+            previous = 0;
             pulse_count_ = 0;
+        } else {
+            pulse_count_ += pending;
+            if (pulse_count_ < 0) {
+                pulse_count_ = 0;
+            }
         }
+        
+        pulse_snapshot_.count = pulse_count_;
+        pulse_snapshot_.delta = pulse_count_ - previous;
+        pulse_snapshot_.timestamp_ms = now_ms;
+        pulse_snapshot_.epoch = applied_epoch_;
+        return pulse_snapshot_;
+    }
+    
+    /**
+     * @brief Get the snapshot produced by the last drainPulses()
+     */
+    const PulseSnapshot& getPulseSnapshot() const { return pulse_snapshot_; }
+    
+    /**
+     * @brief Record a timestamped pulse edge (single producer: ISR or PCNT poll)
+     * @return false if the edge buffer was full
+     */
+    bool pushPulseEdge(const PulseEdge& edge) { return pulse_edges_.push(edge); }
+    
+    /**
+     * @brief Take the oldest recorded pulse edge (main loop only)
+     * @return false if no edge is pending
+     */
+    bool popPulseEdge(PulseEdge& edge) { return pulse_edges_.pop(edge); }
+    
+    /// @return Number of pulse edges dropped because the buffer was full
+    uint32_t getDroppedPulseEdges() const { return pulse_edges_.dropped(); }
+    
+    /**
+     * @brief Publish the control-side snapshot (control task only)
+     */
+    void publishSnapshot(const StateSnapshot& snapshot) { state_snapshot_.write(snapshot); }
+    
+    /**
+     * @brief Read the latest complete control-side snapshot (any task, any core)
+     * Lock-free; retries internally while a publish is in progress.
+     */
+    StateSnapshot readSnapshot() const { return state_snapshot_.read(); }
+    
+    /**
+     * @brief Report a home sensor edge from the home ISR
+     * @param edge_cycles CPU cycle count at ISR entry (latency instrumentation)
+     * @note ISR-safe; a second edge before takeHomeEdge() overwrites the first
+     */
+    void postHomeEdge(uint32_t edge_cycles) {
+        home_edge_cycles_.store(edge_cycles, std::memory_order_relaxed);
+        home_edge_pending_.store(true, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Consume a pending home edge event (main loop only)
+     * @param edge_cycles Receives the cycle count posted with the edge
+     * @return true if an edge was pending
+     */
+    bool takeHomeEdge(uint32_t& edge_cycles) {
+        if (!home_edge_pending_.exchange(false, std::memory_order_acquire)) {
+            return false;
+        }
+        edge_cycles = home_edge_cycles_.load(std::memory_order_relaxed);
+        return true;
     }
     
     /**
@@ -58,6 +206,18 @@ public:
      */
     void setRodeLength(float length) { rode_length_ = length; }
     
+    /**
+     * @brief Check whether the counter is known to be correct
+     * @return false after boot (restored or assumed value) until the anchor
+     *         reaches home or the counter is explicitly reset
+     */
+    bool isRodeVerified() const { return rode_verified_; }
+    
+    /**
+     * @brief Mark the counter as verified / unverified
+     */
+    void setRodeVerified(bool verified) { rode_verified_ = verified; }
+    
     // ========== Configuration ==========
     
     /**
@@ -142,8 +302,17 @@ public:
 
 private:
     // Rope/chain state
-    long pulse_count_ = 0;                   ///< Bidirectional pulse counter
+    long pulse_count_ = 0;                   ///< Bidirectional pulse counter (main loop owned)
+    std::atomic<long> pending_pulses_{0};    ///< Pulses added by ISR/hardware since last drain
+    std::atomic<uint32_t> reset_epoch_{0};   ///< Bumped by requestPulseReset()
+    uint32_t applied_epoch_ = 0;             ///< Epoch of pulse_count_
+    PulseSnapshot pulse_snapshot_;           ///< Result of the last drainPulses()
+    SpscRingBuffer<PulseEdge, 64> pulse_edges_;  ///< Edge timestamps for speed estimation
+    std::atomic<bool> home_edge_pending_{false};  ///< Set by the home ISR
+    Seqlock<StateSnapshot> state_snapshot_;  ///< Control -> networking handoff
+    std::atomic<uint32_t> home_edge_cycles_{0};   ///< Cycle count of the last home edge
     float rode_length_ = 0.0f;               ///< Current rode length in meters
+    bool rode_verified_ = false;             ///< Counter confirmed since boot
     
     // Configuration
     float meters_per_pulse_ = 0.01f;         ///< Conversion factor: pulses to meters
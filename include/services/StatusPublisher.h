@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "sensesp/signalk/signalk_output.h"
+#include "sensesp/system/valueconsumer.h"
+#include "util/StaticArena.h"
+
+using namespace sensesp;
+
+/**
+ * @file StatusPublisher.h
+ * @brief Coalesces SignalK status changes into one delta per event-loop tick
+ *
+ * Writing an SKOutput emits immediately, so one state change (e.g. emergency
+ * stop: status + auto mode + target + winch + thruster) used to queue its
+ * values across several sends. Outputs registered here instead record the
+ * latest value and a dirty flag; flush() runs once per event-loop tick and
+ * forwards every dirty value in the same pass.
+ *
+ * SensESP's delta queue then serialises everything queued between two
+ * websocket sends into a single delta with multiple "values", so a burst of
+ * changes goes out as one frame and one JSON document.
+ *
+ * DESIGN PRINCIPLE: The pending list is a fixed array sized at compile time;
+ * nothing is allocated after setup(). Several writes to one path within a
+ * tick collapse to the last value. The owner sizes StaticStatusPublisher
+ * with the number of outputs it registers, so every output fits the
+ * wrapper arena and a tick with every output dirty is still one batch.
+ */
+
+class StatusPublisher;
+
+/**
+ * @brief Type-erased flush hook for BatchedOutput
+ */
+class BatchedOutputBase {
+public:
+    virtual ~BatchedOutputBase() = default;
+
+protected:
+    friend class StatusPublisher;
+    virtual void flush() = 0;
+    bool dirty_ = false;  ///< True while queued in the publisher
+};
+
+/**
+ * @brief ValueConsumer that defers an SKOutput write to the next flush
+ *
+ * Drop-in for an SKOutput pointer: set_input()/set() and connect_to() work
+ * the same, but the value only reaches SignalK when the publisher flushes.
+ *
+ * @tparam T Output value type
+ */
+template <typename T>
+class BatchedOutput : public ValueConsumer<T>, public BatchedOutputBase {
+public:
+    BatchedOutput(SKOutput<T>* output, StatusPublisher& publisher)
+        : output_(output), publisher_(publisher) {}
+
+    void set(const T& new_value) override;
+
+    /// @return Last value written (flushed or pending)
+    const T& get() const { return value_; }
+
+    /// @return Underlying SignalK output
+    SKOutput<T>* getOutput() { return output_; }
+
+protected:
+    void flush() override { output_->set_input(value_); }
+
+private:
+    SKOutput<T>* output_;         ///< Underlying SignalK output
+    StatusPublisher& publisher_;  ///< Owner of the pending list
+    T value_ = T();               ///< Latest value
+};
+
+/**
+ * @brief Pending list and flush of batched outputs (storage in StaticStatusPublisher)
+ */
+class StatusPublisher {
+public:
+    /**
+     * @brief Flush pending values once per event-loop tick
+     * Must be called during setup()
+     */
+    void initialize();
+
+    /**
+     * @brief Queue an output for the next flush (no-op if already queued)
+     */
+    void markDirty(BatchedOutputBase* output);
+
+    /**
+     * @brief Forward all pending values to their SKOutputs
+     */
+    void flush();
+
+    /// @return Number of flushes that sent at least one value
+    uint32_t getBatchCount() const { return batch_count_; }
+
+    /// @return Total number of values sent
+    uint32_t getValueCount() const { return value_count_; }
+
+    /// @return Number of values sent immediately because the pending list was full
+    uint32_t getOverflowCount() const { return overflow_count_; }
+
+    /// @return Outputs registered with add()
+    size_t getOutputCount() const { return output_count_; }
+
+protected:
+    /**
+     * @param pending Pending list storage (capacity entries)
+     * @param capacity Outputs the owner registers
+     */
+    StatusPublisher(BatchedOutputBase** pending, size_t capacity) : pending_(pending), capacity_(capacity) {}
+
+    /**
+     * @brief Account one registered output, report it if it exceeds the capacity
+     */
+    void countOutput();
+
+private:
+    BatchedOutputBase** pending_;  ///< Outputs dirty since the last flush
+    size_t capacity_;              ///< Entries in pending_
+    size_t pending_count_ = 0;     ///< Entries used in pending_
+    size_t output_count_ = 0;      ///< Outputs registered
+    uint32_t batch_count_ = 0;     ///< Non-empty flushes
+    uint32_t value_count_ = 0;     ///< Values sent
+    uint32_t overflow_count_ = 0;  ///< Pending list overflows
+};
+
+/**
+ * @brief StatusPublisher with storage for a fixed number of outputs
+ * @tparam CAPACITY Outputs the owner registers with add()
+ */
+template <size_t CAPACITY>
+class StaticStatusPublisher : public StatusPublisher {
+public:
+    StaticStatusPublisher() : StatusPublisher(pending_storage_, CAPACITY) {}
+
+    /**
+     * @brief Wrap an SKOutput so its writes are batched
+     * @param output SignalK output (owned by SensESP)
+     * @return Batched output (created once during setup, in the publisher's arena)
+     */
+    template <typename T>
+    BatchedOutput<T>* add(SKOutput<T>* output) {
+        countOutput();
+        return arena_.template create<BatchedOutput<T>>(output, *this);
+    }
+
+private:
+    BatchedOutputBase* pending_storage_[CAPACITY] = {};  ///< Pending list
+    // BatchedOutput<bool/int> are no larger than BatchedOutput<float>
+    StaticArena<CAPACITY * arenaBytes<BatchedOutput<float>>()> arena_;  ///< Wrapper storage
+};
+
+template <typename T>
+void BatchedOutput<T>::set(const T& new_value) {
+    value_ = new_value;
+    publisher_.markDirty(this);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "Arduino.h"
+#include "services/NetworkScheduler.h"
+#include "util/DeadlineMonitor.h"
+
+/**
+ * @file Supervisor.h
+ * @brief Fail-safe supervisor: per-task deadlines, relay cut-off and task watchdog
+ *
+ * The relays stay energised as long as the last command holds, so a stalled
+ * control path (WiFi driver blocking the loop, a deadlock) would leave the
+ * winch running. The control-side tasks check in every pass:
+ * - CONTROL_LOOP: ControlLoopService::tick() completed
+ * - REMOTE_INPUT: RemoteControl::processInputs() completed
+ * - PULSE_PROCESSING: PulseCounterService::update() completed
+ *
+ * A hardware timer interrupt checks the deadlines every CHECK_PERIOD_US.
+ * While any task is overdue it opens all four relays by register write
+ * (active-LOW: output bits set HIGH), like the home ISR, so the cut does not
+ * depend on the stalled task. On its next pass the control side sees the
+ * trip (takeTrip()), stops the winch and the thruster through their
+ * controllers (ESP32Motor::stop(), BowPropellerMotor::stop()) and drops
+ * automatic mode, so nothing restarts when it recovers.
+ *
+ * The control task feeds the ESP32 task watchdog (feedWatchdog()) only
+ * while every supervised task meets its deadline; a stall that outlasts
+ * WATCHDOG_TIMEOUT_S resets the ECU.
+ *
+ * Missed deadlines and the worst check-in interval per task are published
+ * under electrical.bow.ecu.supervisor.* and on the status page
+ * ("Supervisor" group) to size the loop budgets.
+ *
+ * With SUPERVISOR_USE_WATCHDOG=0 there is no timer interrupt, no relay cut
+ * and no watchdog; deadlines are then only evaluated for the statistics.
+ */
+
+#ifndef SUPERVISOR_USE_WATCHDOG
+#define SUPERVISOR_USE_WATCHDOG 0
+#endif
+
+/// Supervised control-side tasks
+enum class SupervisedTask : uint8_t {
+    CONTROL_LOOP,      ///< Fixed-rate control tick
+    REMOTE_INPUT,      ///< Remote button processing
+    PULSE_PROCESSING,  ///< Pulse drain and home handling
+    COUNT
+};
+
+class Supervisor {
+public:
+    static constexpr uint32_t CHECK_PERIOD_US = 10000;       ///< Timer interrupt period
+    static constexpr uint32_t CONTROL_DEADLINE_US = 200000;  ///< 10 control periods
+    static constexpr uint32_t REMOTE_DEADLINE_US = 200000;   ///< Button reaction still acceptable
+    static constexpr uint32_t PULSE_DEADLINE_US = 200000;    ///< 10 cm of chain at full speed
+    static constexpr uint32_t WATCHDOG_TIMEOUT_S = 3;        ///< Task watchdog reset
+    static constexpr uint8_t TIMER_NUMBER = 3;               ///< Hardware timer (group 1, timer 1)
+    static constexpr unsigned long PUBLISH_INTERVAL_MS = 1000;  ///< Statistics refresh
+    static constexpr uint32_t PUBLISH_BUDGET_US = 3000;      ///< Scheduler overrun threshold
+
+    /**
+     * @brief Register the supervised tasks and start the timer interrupt
+     * Must be called during setup() before the control task starts
+     */
+    static void start();
+
+    /// Task completed a pass (control side)
+    static void checkIn(SupervisedTask task) {
+        monitor_.checkIn(index(task), micros());
+    }
+
+    /**
+     * @brief Reset the task watchdog if every deadline is met
+     * Called by the task that runs the control step (subscribes it on the first call)
+     */
+    static void feedWatchdog();
+
+    /**
+     * @brief Consume a relay cut-off done by the timer interrupt (control side)
+     * @return true once per trip; the caller stops the actuators
+     */
+    static bool takeTrip() { return trip_pending_.exchange(false, std::memory_order_acquire); }
+
+    /// @return true from a relay cut-off until the control side took it (any task)
+    static bool isTripPending() { return trip_pending_.load(std::memory_order_acquire); }
+
+    /// @return Relay cut-offs since boot
+    static uint32_t getTrips() { return trips_.load(std::memory_order_relaxed); }
+
+    /// @return Missed deadlines of a task since boot
+    static uint32_t getMissed(SupervisedTask task) { return monitor_.missed(index(task)); }
+
+    /// @return Longest interval between two passes of a task (us)
+    static uint32_t getWorstInterval(SupervisedTask task) { return monitor_.worstInterval(index(task)); }
+
+    /**
+     * @brief Create SignalK outputs and status page items, schedule publishing
+     * Must be called during setup() after sensesp_app is created
+     */
+    void initialize(NetworkScheduler& scheduler);
+
+    /**
+     * @brief Publish the per-task statistics
+     */
+    void publish();
+
+private:
+    static constexpr uint8_t TASK_COUNT = static_cast<uint8_t>(SupervisedTask::COUNT);
+
+    static inline DeadlineMonitor<TASK_COUNT> monitor_;
+    static inline std::atomic<bool> trip_pending_{false};  ///< Set by the ISR, taken by the control side
+    static inline std::atomic<uint32_t> trips_{0};
+    static inline bool watchdog_subscribed_ = false;       ///< Control side only
+
+    static constexpr uint8_t index(SupervisedTask task) { return static_cast<uint8_t>(task); }
+
+    static void onTimer();
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "services/NetworkScheduler.h"
+#include "util/TraceBuffer.h"
+
+/**
+ * @file TraceRecorder.h
+ * @brief On-demand high-rate trace of a manoeuvre, streamed over UDP
+ *
+ * For offline analysis and replay against the host simulator the firmware
+ * can trace, record by record:
+ * - pulse batches at their edge time (PulseCounterService drain)
+ * - relay transitions as driven on the pins (ESP32RelayPair)
+ * - commands with source, channel and queueing delay (ControlTask)
+ * - every automatic mode step and its decision (AutomaticModeController)
+ *
+ * Records go into a RAM TraceBuffer (16 bytes each); record() is static
+ * like EventLogger::log() and returns at once when no capture is running.
+ * It never waits on the network: a full ring drops new records and counts
+ * them.
+ *
+ * Capture on demand: a host sends the datagram "TRACE START" to TRACE_PORT
+ * (tools/trace_decode.py does). The ring is cleared, a CAPTURE_START
+ * record is written and frames of up to FRAME_RECORDS records are sent to
+ * that host every STREAM_INTERVAL_MS (NetworkScheduler task). The host
+ * repeats the request as a keep-alive; after CLIENT_TIMEOUT_MS without
+ * one, or on "TRACE STOP", capture ends and the rest is flushed.
+ *
+ * Built with TRACE_CAPTURE=1 only (debug env, see platformio.ini); with 0,
+ * record() compiles to nothing and no buffer is reserved.
+ */
+
+#ifndef TRACE_CAPTURE
+#define TRACE_CAPTURE 0
+#endif
+
+#if TRACE_CAPTURE
+#include "Arduino.h"
+#endif
+
+class StateManager;
+
+class TraceRecorder {
+public:
+    static constexpr size_t CAPACITY = 2048;                 ///< Records buffered (32 KB)
+    static constexpr uint16_t TRACE_PORT = 50212;            ///< UDP request port (frames go to the requester)
+    static constexpr size_t FRAME_RECORDS = 64;              ///< Records per frame (1036 bytes)
+    static constexpr unsigned long STREAM_INTERVAL_MS = 50;  ///< Frame send period
+    static constexpr uint32_t STREAM_BUDGET_US = 5000;       ///< Scheduler overrun threshold
+    static constexpr unsigned long CLIENT_TIMEOUT_MS = 10000;  ///< Capture ends without a keep-alive
+
+    /**
+     * @brief Trace an event at the current time (any task)
+     * Integral values are stored as int32_t, floating point as float.
+     */
+    template <typename A = int32_t, typename B = int32_t>
+    static void record(TraceEvent event, uint8_t tag, uint16_t arg, A a = 0, B b = 0) {
+#if TRACE_CAPTURE
+        if (capturing_.load(std::memory_order_relaxed)) {
+            recordAt(static_cast<uint32_t>(micros()), event, tag, arg, a, b);
+        }
+#else
+        (void)event; (void)tag; (void)arg; (void)a; (void)b;
+#endif
+    }
+
+    /**
+     * @brief Trace an event that happened at timestamp_us (micros() clock)
+     */
+    template <typename A = int32_t, typename B = int32_t>
+    static void recordAt(uint32_t timestamp_us, TraceEvent event, uint8_t tag, uint16_t arg,
+                         A a = 0, B b = 0) {
+#if TRACE_CAPTURE
+        if (!capturing_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        TraceRecord record;
+        record.timestamp_us = timestamp_us;
+        record.event = static_cast<uint8_t>(event);
+        record.tag = tag;
+        record.arg = arg;
+        record.a = toBits(a);
+        record.b = toBits(b);
+        buffer_.record(record);
+#else
+        (void)timestamp_us; (void)event; (void)tag; (void)arg; (void)a; (void)b;
+#endif
+    }
+
+    /// @return true while a capture is running
+    static bool isCapturing() { return capturing_.load(std::memory_order_relaxed); }
+
+    explicit TraceRecorder(StateManager& state_manager) : state_manager_(state_manager) {}
+
+    /**
+     * @brief Open the request port, create the status item, schedule streaming
+     * Must be called during setup() after WiFi is started by SensESP
+     */
+    void initialize(NetworkScheduler& scheduler);
+
+    /**
+     * @brief Handle a request datagram (AsyncUDP task)
+     * @param address Sender IPv4 address (frames are sent there)
+     * @return true if it was a valid request
+     */
+    bool receive(const uint8_t* data, size_t length, uint32_t address, uint16_t port, uint32_t now_ms);
+
+    /**
+     * @brief Send up to one frame, end a capture whose host went silent
+     */
+    void stream();
+
+    /// @return Frames sent in the current (or last) capture
+    uint32_t getFramesSent() const { return frames_sent_; }
+
+private:
+    static inline std::atomic<bool> capturing_{false};
+#if TRACE_CAPTURE
+    static inline TraceBuffer<CAPACITY> buffer_;
+#endif
+
+    StateManager& state_manager_;               ///< Calibration for CAPTURE_START
+    std::atomic<uint32_t> client_address_{0};   ///< Requesting host (0 = none)
+    std::atomic<uint16_t> client_port_{0};
+    std::atomic<uint32_t> last_request_ms_{0};  ///< Time of the last keep-alive
+    std::atomic<bool> start_pending_{false};    ///< START received, applied by stream()
+    uint32_t frames_sent_ = 0;
+    uint32_t records_sent_ = 0;
+
+    template <typename T>
+    static uint32_t toBits(T value) {
+        if constexpr (std::is_floating_point<T>::value) {
+            float f = static_cast<float>(value);
+            uint32_t bits;
+            memcpy(&bits, &f, sizeof(bits));
+            return bits;
+        } else {
+            return static_cast<uint32_t>(static_cast<int32_t>(value));
+        }
+    }
+
+    void startCapture();
+    void updateStatus();
+};
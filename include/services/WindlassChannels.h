@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "automatic_mode_controller.h"
+#include "hardware/ESP32Motor.h"
+#include "hardware/ESP32PulseCounter.h"
+#include "hardware/ESP32Sensor.h"
+#include "home_sensor.h"
+#include "pin_config.h"
+#include "services/ControlCommand.h"
+#include "services/NetworkScheduler.h"
+#include "services/StateManager.h"
+#include "util/Seqlock.h"
+#include "winch_controller.h"
+
+/**
+ * @file WindlassChannels.h
+ * @brief Additional windlass channels (stern kedge, ...) next to the primary windlass
+ *
+ * The primary windlass (channel 0) keeps its services and the
+ * navigation.anchor.* paths. WINDLASS_CHANNELS - 1 further channels are
+ * taken from PinConfig::EXTRA_WINDLASSES; each has its own relays
+ * (ESP32Motor), home sensor, PCNT unit (channel i counts on PCNT unit i),
+ * AutomaticModeController and SignalK prefix navigation.anchor.<name>.*:
+ * - commands: manualControl, automaticModeCommand, targetRodeCommand,
+ *   homeCommand, resetRode (guards as the primary: blocked during an
+ *   emergency stop and until the connection is stable)
+ * - status: currentRode, manualControlStatus, automaticModeStatus,
+ *   targetRodeStatus, rodeVerified
+ *
+ * The per-channel state read by every pass is one compact array
+ * (WindlassChannelState, 16 bytes per channel); update() serves all
+ * channels in one loop at a fixed cost per channel, in the control tick
+ * after the primary windlass. The counts are published through a Seqlock.
+ *
+ * A channel's home sensor cuts its retrieve relay from an edge interrupt,
+ * like the primary. Channel counts are not persisted: after a reset a
+ * channel starts at 0 m, unverified, until it reaches home.
+ *
+ * DESIGN PRINCIPLE: Single Writer
+ * - Control side: initializeHardware(), execute(), update(), stopAll()
+ * - Networking side: initialize() (SignalK), publish()
+ */
+
+#ifndef WINDLASS_CHANNELS
+#define WINDLASS_CHANNELS 1
+#endif
+
+/// Additional windlass channels (beside the primary)
+constexpr size_t EXTRA_WINDLASS_CHANNELS = WINDLASS_CHANNELS - 1;
+
+static_assert(WINDLASS_CHANNELS >= 1 && WINDLASS_CHANNELS <= COMMAND_CHANNEL_MAX,
+              "WINDLASS_CHANNELS must be 1..COMMAND_CHANNEL_MAX");
+static_assert(EXTRA_WINDLASS_CHANNELS <= sizeof(PinConfig::EXTRA_WINDLASSES) / sizeof(WindlassChannelPins),
+              "Hardware profile lists fewer EXTRA_WINDLASSES than WINDLASS_CHANNELS - 1");
+
+/// @return GPIO.out mask of the additional channels' relays (Supervisor cut)
+constexpr uint32_t extraWindlassRelayMask() {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < EXTRA_WINDLASS_CHANNELS; i++) {
+        const WindlassChannelPins& pins = PinConfig::EXTRA_WINDLASSES[i];
+        if (pins.winch_up >= 32 || pins.winch_down >= 32) {
+            return 0;  // Not in the GPIO.out bank (rejected below)
+        }
+        mask |= (1UL << pins.winch_up) | (1UL << pins.winch_down);
+    }
+    return mask;
+}
+static_assert(EXTRA_WINDLASS_CHANNELS == 0 || extraWindlassRelayMask() != 0,
+              "Windlass channel relay pins must be in the GPIO.out bank");
+
+#if WINDLASS_CHANNELS > 1 && !PULSE_COUNTER_USE_PCNT
+#error "Additional windlass channels count pulses with PCNT (PULSE_COUNTER_USE_PCNT=1)"
+#endif
+
+/// Hot state of one channel (control side)
+struct WindlassChannelState {
+    int32_t pulse_count = 0;   ///< Chain pulses (0 = at home)
+    float rode_m = 0.0f;       ///< pulse_count x meters per pulse
+    float target_m = -1.0f;    ///< Automatic mode target (-1 = none)
+    int8_t direction = 0;      ///< Winch: 1 = up, -1 = down, 0 = stopped
+    uint8_t flags = 0;         ///< WindlassChannelFlag bits
+    uint16_t reserved = 0;
+};
+
+namespace WindlassChannelFlag {
+    constexpr uint8_t AUTO_MODE = 1 << 0;      ///< Automatic mode enabled
+    constexpr uint8_t AT_HOME = 1 << 1;        ///< Home sensor active
+    constexpr uint8_t RODE_VERIFIED = 1 << 2;  ///< Count confirmed at home since boot
+}
+
+/// Array size for the additional channels (no zero-length arrays)
+constexpr size_t WINDLASS_CHANNEL_SLOTS = EXTRA_WINDLASS_CHANNELS > 0 ? EXTRA_WINDLASS_CHANNELS : 1;
+
+/// State of all additional channels, contiguous (Seqlock payload)
+struct WindlassChannelStates {
+    WindlassChannelState channel[WINDLASS_CHANNEL_SLOTS];
+};
+
+class ControlTask;
+
+class WindlassChannels {
+public:
+    static constexpr size_t COUNT = EXTRA_WINDLASS_CHANNELS;
+    static constexpr size_t SLOTS = WINDLASS_CHANNEL_SLOTS;
+    static constexpr unsigned long PUBLISH_INTERVAL_MS = 200;  ///< Status refresh
+    static constexpr uint32_t PUBLISH_BUDGET_US = 3000;        ///< Scheduler overrun threshold
+
+    explicit WindlassChannels(StateManager& state_manager) : state_manager_(state_manager) {}
+
+    /**
+     * @brief Create the channel hardware and controllers, all relays off
+     * Control side, during setup() before the control task starts
+     */
+    void initializeHardware();
+
+    /**
+     * @brief Create the SignalK outputs and command listeners, schedule publish()
+     * Must be called during setup() after sensesp_app is created
+     * @param control_task Command queue of the control side
+     */
+    void initialize(NetworkScheduler& scheduler, ControlTask& control_task);
+
+    /**
+     * @brief Apply a winch command for channel 1.. (control side)
+     * @param emergency_stop Motion is refused while the emergency stop is latched
+     * @return false if the command type is not per channel (the caller applies it)
+     */
+    bool execute(const ControlCommand& command, bool emergency_stop);
+
+    /**
+     * @brief One control pass over every channel (control side)
+     * Pulse drain, home handling, automatic mode, state publication
+     */
+    void update(unsigned long now_ms);
+
+    /// @return true while a channel moves or is in automatic mode (control side)
+    bool isActive() const {
+        for (size_t i = 0; i < COUNT; i++) {
+            if (states_.channel[i].direction != 0 || (states_.channel[i].flags & WindlassChannelFlag::AUTO_MODE)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Disable automatic mode and stop every channel (connection lost, supervisor trip)
+    void stopAll();
+
+    /**
+     * @brief Guard and submit a value received on a channel command path (networking side)
+     * @param channel Windlass channel (1..)
+     * @param command Row of the channel command table (WindlassChannels.cpp)
+     */
+    void dispatch(uint8_t channel, size_t command, float value);
+
+    /// @return Consistent copy of the channel states (any task)
+    WindlassChannelStates readStates() const { return published_.read(); }
+
+    /// @return Hardware profile entry of a channel (0-based among the additional channels)
+    static const WindlassChannelPins& pins(size_t index) { return PinConfig::EXTRA_WINDLASSES[index]; }
+
+private:
+    struct Channel;
+
+    StateManager& state_manager_;
+    Channel* channels_[SLOTS] = {};
+    WindlassChannelStates states_;                 ///< Control side working copy
+    Seqlock<WindlassChannelStates> published_;     ///< Control -> networking
+    float meters_per_pulse_ = 0.0f;                ///< Calibration the tolerances were set for
+    ControlTask* control_task_ = nullptr;          ///< Set by initialize()
+    WindlassChannelStates sent_;                   ///< Last published status (networking side)
+    bool sent_valid_ = false;                      ///< sent_ holds a published status
+
+    void publish();
+};
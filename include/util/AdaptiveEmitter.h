@@ -0,0 +1,108 @@
+#pragma once
+
+#include <math.h>
+
+/**
+ * @file AdaptiveEmitter.h
+ * @brief Change-driven, rate-adaptive emission decision for status outputs
+ *
+ * Decides whether a periodically sampled value should be sent:
+ * - Immediately (rate-limited to min_interval_ms) when it moved by more
+ *   than the deadband since the last emission
+ * - As a heartbeat when unchanged: active_heartbeat_ms while an actuator
+ *   is running, idle_heartbeat_ms otherwise
+ * - Once when the actuator stops, if the value differs from the last
+ *   emission at all, so a final change inside the deadband does not wait
+ *   for the idle heartbeat
+ *
+ * Sampled every 100 ms this gives up to 10 Hz while the winch runs and one
+ * delta per idle heartbeat while lying at anchor.
+ *
+ * @tparam T Arithmetic value type (float, int, bool)
+ */
+template <typename T>
+class AdaptiveEmitter {
+public:
+    /**
+     * @brief Construct emitter
+     * @param deadband Minimum change that triggers an emission (0 = any change)
+     * @param min_interval_ms Minimum time between emissions
+     * @param active_heartbeat_ms Heartbeat while active
+     * @param idle_heartbeat_ms Heartbeat while idle
+     */
+    explicit AdaptiveEmitter(T deadband = T(),
+                             unsigned long min_interval_ms = 100,
+                             unsigned long active_heartbeat_ms = 1000,
+                             unsigned long idle_heartbeat_ms = 30000)
+        : deadband_(deadband),
+          min_interval_ms_(min_interval_ms),
+          active_heartbeat_ms_(active_heartbeat_ms),
+          idle_heartbeat_ms_(idle_heartbeat_ms) {}
+
+    /**
+     * @brief Set the change deadband
+     * @param deadband Minimum change that triggers an emission
+     */
+    void setDeadband(T deadband) { deadband_ = deadband; }
+
+    /**
+     * @brief Decide whether to emit value now (records the emission if so)
+     * @param value Current value
+     * @param active true while an actuator is running
+     * @param now_ms Current time (millis())
+     * @return true if the caller should send value
+     */
+    bool shouldEmit(T value, bool active, unsigned long now_ms) {
+        if (was_active_ && !active) {
+            final_pending_ = true;
+        } else if (active) {
+            final_pending_ = false;
+        }
+        was_active_ = active;
+
+        if (!has_emitted_) {
+            return record(value, now_ms);
+        }
+
+        unsigned long elapsed_ms = now_ms - last_emit_ms_;
+        double diff = fabs(static_cast<double>(value) - static_cast<double>(last_value_));
+        bool changed = diff > static_cast<double>(deadband_) || (final_pending_ && diff > 0.0);
+
+        if (changed && elapsed_ms >= min_interval_ms_) {
+            return record(value, now_ms);
+        }
+        if (diff == 0.0) {
+            final_pending_ = false;
+        }
+
+        unsigned long heartbeat_ms = active ? active_heartbeat_ms_ : idle_heartbeat_ms_;
+        if (elapsed_ms >= heartbeat_ms) {
+            return record(value, now_ms);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Force the next shouldEmit() to emit (e.g. after reconnect)
+     */
+    void invalidate() { has_emitted_ = false; }
+
+private:
+    T deadband_;                        ///< Minimum change that triggers emission
+    unsigned long min_interval_ms_;     ///< Rate limit for change-driven emission
+    unsigned long active_heartbeat_ms_; ///< Heartbeat while active
+    unsigned long idle_heartbeat_ms_;   ///< Heartbeat while idle
+    bool has_emitted_ = false;          ///< False until the first emission
+    T last_value_ = T();                ///< Last emitted value
+    unsigned long last_emit_ms_ = 0;    ///< Time of the last emission
+    bool was_active_ = false;           ///< active at the previous sample
+    bool final_pending_ = false;        ///< Stopped; the final value is not sent yet
+
+    bool record(T value, unsigned long now_ms) {
+        has_emitted_ = true;
+        final_pending_ = false;
+        last_value_ = value;
+        last_emit_ms_ = now_ms;
+        return true;
+    }
+};
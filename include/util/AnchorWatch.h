@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file AnchorWatch.h
+ * @brief Incremental anchor drag detection over a fixed-point position history
+ *
+ * Once the anchor is down (drop()), every position sample is projected to a
+ * local east/north offset from the drop point and stored in a circular
+ * struct-of-arrays history:
+ * - east/north offset in decimetres (int16, +-3.2 km)
+ * - distance from the anchor in decimetres (uint16)
+ * - depth in decimetres (uint16) and sample time in seconds (uint16, wraps)
+ * 10 bytes per sample, no heap.
+ *
+ * All results are updated per sample in O(1) (amortised), never by
+ * rescanning the history:
+ * - allowed radius: horizontal reach of the rode at the current depth,
+ *   sqrt(rode^2 - (depth + bow height)^2), plus the configured margin
+ *   (boat length, GPS error)
+ * - swing radius: largest distance from the anchor within the history
+ *   window, kept with a monotonic queue of sample indices
+ * - drag alarm: distance beyond the allowed radius for alarm_samples
+ *   consecutive samples; cleared after as many samples back inside
+ *
+ * Positions are in 1e-7 degrees (the resolution of NMEA 2000 positions);
+ * the equirectangular projection is exact enough within a few km.
+ *
+ * @tparam N History length in samples, must be a power of two
+ */
+
+/// Anchor watch thresholds
+struct AnchorWatchConfig {
+    float margin_m = 15.0f;       ///< Added to the rode reach (boat length + GPS error)
+    float bow_height_m = 1.0f;    ///< Bow roller height above the water
+    uint8_t alarm_samples = 5;    ///< Consecutive samples outside (or back inside) to change state
+};
+
+/// One decoded history sample
+struct AnchorWatchSample {
+    float east_m;      ///< Offset east of the anchor
+    float north_m;     ///< Offset north of the anchor
+    float distance_m;  ///< Distance from the anchor
+    float depth_m;     ///< Depth (0 if unknown)
+    uint16_t time_s;   ///< Sample time (seconds, wraps)
+};
+
+template <size_t N>
+class AnchorWatch {
+    static_assert(N > 0 && N <= 32768 && (N & (N - 1)) == 0,
+                  "AnchorWatch history must be a power of two up to 32768");
+
+public:
+    explicit AnchorWatch(const AnchorWatchConfig& config = AnchorWatchConfig()) : config_(config) {}
+
+    /**
+     * @brief Anchor is down at this position: start watching, clear the history
+     */
+    void drop(int32_t latitude_e7, int32_t longitude_e7) {
+        anchor_lat_e7_ = latitude_e7;
+        anchor_lon_e7_ = longitude_e7;
+        float latitude_rad = latitude_e7 * 1e-7f * static_cast<float>(M_PI) / 180.0f;
+        east_m_per_unit_ = METERS_PER_DEGREE_LAT * 1e-7f * cosf(latitude_rad);
+        set_ = true;
+        head_ = 0;
+        count_ = 0;
+        queue_head_ = 0;
+        queue_tail_ = 0;
+        outside_run_ = 0;
+        inside_run_ = 0;
+        alarm_ = false;
+        distance_m_ = 0.0f;
+        swing_radius_m_ = 0.0f;
+    }
+
+    /**
+     * @brief Anchor is up: stop watching (clears the alarm)
+     */
+    void raise() {
+        set_ = false;
+        alarm_ = false;
+    }
+
+    /**
+     * @brief Add a position sample and update radius, swing and alarm
+     * @param rode_m Rode deployed
+     * @param depth_m Water depth below the surface (< 0 if unknown)
+     * @param now_s Sample time in seconds
+     * @return true if the drag alarm state changed
+     */
+    bool addSample(int32_t latitude_e7, int32_t longitude_e7, float rode_m, float depth_m, uint32_t now_s) {
+        if (!set_) {
+            return false;
+        }
+        float east_m = (longitude_e7 - anchor_lon_e7_) * east_m_per_unit_;
+        float north_m = (latitude_e7 - anchor_lat_e7_) * (METERS_PER_DEGREE_LAT * 1e-7f);
+        distance_m_ = sqrtf(east_m * east_m + north_m * north_m);
+        allowed_radius_m_ = reach(rode_m, depth_m) + config_.margin_m;
+
+        // Store the sample (the slot of the oldest sample once full)
+        uint32_t sequence = head_;
+        size_t slot = sequence & (N - 1);
+        east_dm_[slot] = toInt16(east_m * 10.0f);
+        north_dm_[slot] = toInt16(north_m * 10.0f);
+        distance_dm_[slot] = toUint16(distance_m_ * 10.0f);
+        depth_dm_[slot] = toUint16(depth_m * 10.0f);
+        time_s_[slot] = static_cast<uint16_t>(now_s);
+        head_++;
+        if (count_ < N) count_++;
+
+        updateSwing(sequence, distance_dm_[slot]);
+        return updateAlarm();
+    }
+
+    /// @return true while the anchor is down
+    bool isSet() const { return set_; }
+
+    /// @return true while the boat is outside the allowed radius (debounced)
+    bool isDragging() const { return alarm_; }
+
+    /// @return Distance from the anchor at the last sample (m)
+    float getDistance() const { return distance_m_; }
+
+    /// @return Allowed radius at the last sample (m)
+    float getAllowedRadius() const { return allowed_radius_m_; }
+
+    /// @return Largest distance from the anchor within the history window (m)
+    float getSwingRadius() const { return swing_radius_m_; }
+
+    /// @return Samples in the history
+    size_t size() const { return count_; }
+
+    /**
+     * @brief Read a stored sample
+     * @param age 0 = newest
+     * @return false if fewer than age + 1 samples are stored
+     */
+    bool sample(size_t age, AnchorWatchSample& out) const {
+        if (age >= count_) {
+            return false;
+        }
+        size_t slot = (head_ - 1 - age) & (N - 1);
+        out.east_m = east_dm_[slot] * 0.1f;
+        out.north_m = north_dm_[slot] * 0.1f;
+        out.distance_m = distance_dm_[slot] * 0.1f;
+        out.depth_m = depth_dm_[slot] * 0.1f;
+        out.time_s = time_s_[slot];
+        return true;
+    }
+
+    /// @return Anchor latitude (1e-7 degrees)
+    int32_t getAnchorLatitudeE7() const { return anchor_lat_e7_; }
+
+    /// @return Anchor longitude (1e-7 degrees)
+    int32_t getAnchorLongitudeE7() const { return anchor_lon_e7_; }
+
+    /**
+     * @brief Horizontal reach of the rode (m)
+     * Without a depth reading the full rode length is assumed (largest radius).
+     */
+    float reach(float rode_m, float depth_m) const {
+        if (rode_m <= 0.0f) {
+            return 0.0f;
+        }
+        if (depth_m < 0.0f) {
+            return rode_m;
+        }
+        float height_m = depth_m + config_.bow_height_m;
+        return rode_m > height_m ? sqrtf(rode_m * rode_m - height_m * height_m) : 0.0f;
+    }
+
+private:
+    static constexpr float METERS_PER_DEGREE_LAT = 111195.0f;  ///< Mean Earth radius * pi / 180
+
+    AnchorWatchConfig config_;
+
+    // Struct-of-arrays history (slot = sequence & (N - 1))
+    int16_t east_dm_[N] = {};
+    int16_t north_dm_[N] = {};
+    uint16_t distance_dm_[N] = {};
+    uint16_t depth_dm_[N] = {};
+    uint16_t time_s_[N] = {};
+    uint32_t head_ = 0;      ///< Sequence of the next sample
+    size_t count_ = 0;       ///< Samples stored
+
+    // Monotonic queue of sample sequences with decreasing distance (front = window max)
+    uint32_t queue_[N] = {};
+    uint32_t queue_head_ = 0;
+    uint32_t queue_tail_ = 0;
+
+    bool set_ = false;
+    int32_t anchor_lat_e7_ = 0;
+    int32_t anchor_lon_e7_ = 0;
+    float east_m_per_unit_ = 0.0f;   ///< Metres east per 1e-7 degree longitude at the anchor
+    float distance_m_ = 0.0f;
+    float allowed_radius_m_ = 0.0f;
+    float swing_radius_m_ = 0.0f;
+    uint8_t outside_run_ = 0;        ///< Consecutive samples outside
+    uint8_t inside_run_ = 0;         ///< Consecutive samples inside
+    bool alarm_ = false;
+
+    void updateSwing(uint32_t sequence, uint16_t distance_dm) {
+        // Drop the front if it left the window (overwritten slot)
+        if (queue_tail_ != queue_head_ && sequence - queue_[queue_head_ & (N - 1)] >= N) {
+            queue_head_++;
+        }
+        // Smaller distances behind the new sample can never be the maximum again
+        while (queue_tail_ != queue_head_ &&
+               distance_dm_[queue_[(queue_tail_ - 1) & (N - 1)] & (N - 1)] <= distance_dm) {
+            queue_tail_--;
+        }
+        queue_[queue_tail_ & (N - 1)] = sequence;
+        queue_tail_++;
+        swing_radius_m_ = distance_dm_[queue_[queue_head_ & (N - 1)] & (N - 1)] * 0.1f;
+    }
+
+    bool updateAlarm() {
+        bool was_alarm = alarm_;
+        if (distance_m_ > allowed_radius_m_) {
+            inside_run_ = 0;
+            if (outside_run_ < UINT8_MAX) outside_run_++;
+            if (outside_run_ >= config_.alarm_samples) alarm_ = true;
+        } else {
+            outside_run_ = 0;
+            if (inside_run_ < UINT8_MAX) inside_run_++;
+            if (inside_run_ >= config_.alarm_samples) alarm_ = false;
+        }
+        return alarm_ != was_alarm;
+    }
+
+    static int16_t toInt16(float value) {
+        if (value > 32767.0f) return 32767;
+        if (value < -32768.0f) return -32768;
+        return static_cast<int16_t>(lroundf(value));
+    }
+
+    static uint16_t toUint16(float value) {
+        if (value <= 0.0f) return 0;
+        if (value > 65535.0f) return 65535;
+        return static_cast<uint16_t>(lroundf(value));
+    }
+};
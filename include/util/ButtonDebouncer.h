@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file ButtonDebouncer.h
+ * @brief Debounce and gesture state machine for one push button
+ *
+ * Fed with raw level changes (from an edge ISR queue or from polling) and
+ * advanced with update(). A level only becomes the debounced state once it
+ * has been stable for debounce_ms, so contact bounce and receiver noise never
+ * reach the gesture logic. Debounced transitions produce:
+ * - PRESS / RELEASE on every accepted edge
+ * - DOUBLE_PRESS when a press starts within double_press_ms of the previous one
+ * - LONG_PRESS once per press after long_press_ms held
+ *
+ * Gesture timing uses the edge timestamps, not the time update() ran, so the
+ * result does not depend on how late the main loop processes the events.
+ */
+
+/// Event flags returned by ButtonDebouncer::update() (may be combined)
+enum ButtonEvent : uint8_t {
+    BUTTON_NONE = 0,
+    BUTTON_PRESS = 1 << 0,
+    BUTTON_RELEASE = 1 << 1,
+    BUTTON_DOUBLE_PRESS = 1 << 2,
+    BUTTON_LONG_PRESS = 1 << 3,
+};
+
+class ButtonDebouncer {
+public:
+    static constexpr unsigned long NO_DEADLINE = 0xFFFFFFFFUL;  ///< nextDeadline(): nothing pending
+
+    /**
+     * @brief Construct debouncer
+     * @param debounce_ms Time a level must be stable to be accepted (0 = no debounce)
+     * @param double_press_ms Maximum gap between two presses for DOUBLE_PRESS
+     * @param long_press_ms Hold time for LONG_PRESS
+     */
+    explicit ButtonDebouncer(unsigned long debounce_ms = 30,
+                             unsigned long double_press_ms = 800,
+                             unsigned long long_press_ms = 2000)
+        : debounce_ms_(debounce_ms),
+          double_press_ms_(double_press_ms),
+          long_press_ms_(long_press_ms) {}
+
+    /**
+     * @brief Record a raw level change
+     * @param pressed Raw level (true = pressed)
+     * @param t_ms Time of the edge
+     */
+    void onEdge(bool pressed, unsigned long t_ms) {
+        if (pressed == raw_pressed_) {
+            return;
+        }
+        raw_pressed_ = pressed;
+        raw_change_ms_ = t_ms;
+    }
+
+    /**
+     * @brief Advance the state machine
+     * @param now_ms Current time
+     * @return Combination of ButtonEvent flags produced since the last call
+     */
+    uint8_t update(unsigned long now_ms) {
+        uint8_t events = BUTTON_NONE;
+
+        if (raw_pressed_ != pressed_ && now_ms - raw_change_ms_ >= debounce_ms_) {
+            pressed_ = raw_pressed_;
+            if (pressed_) {
+                events |= BUTTON_PRESS;
+                if (has_press_ && raw_change_ms_ - last_press_ms_ <= double_press_ms_) {
+                    events |= BUTTON_DOUBLE_PRESS;
+                }
+                has_press_ = true;
+                last_press_ms_ = raw_change_ms_;
+                long_press_fired_ = false;
+            } else {
+                events |= BUTTON_RELEASE;
+            }
+        }
+
+        if (pressed_ && !long_press_fired_ && now_ms - last_press_ms_ >= long_press_ms_) {
+            events |= BUTTON_LONG_PRESS;
+            long_press_fired_ = true;
+        }
+        return events;
+    }
+
+    /// @return Debounced state (true = pressed)
+    bool isPressed() const { return pressed_; }
+
+    /**
+     * @brief Time until update() can produce an event without a new edge
+     * @param now_ms Current time
+     * @return Milliseconds to the next timed transition, or NO_DEADLINE
+     */
+    unsigned long nextDeadline(unsigned long now_ms) const {
+        if (raw_pressed_ != pressed_) {
+            unsigned long elapsed = now_ms - raw_change_ms_;
+            return elapsed >= debounce_ms_ ? 0 : debounce_ms_ - elapsed;
+        }
+        if (pressed_ && !long_press_fired_) {
+            unsigned long elapsed = now_ms - last_press_ms_;
+            return elapsed >= long_press_ms_ ? 0 : long_press_ms_ - elapsed;
+        }
+        return NO_DEADLINE;
+    }
+
+private:
+    unsigned long debounce_ms_;       ///< Stability window
+    unsigned long double_press_ms_;   ///< Double-press gap
+    unsigned long long_press_ms_;     ///< Long-press hold time
+    bool raw_pressed_ = false;        ///< Last raw level seen
+    unsigned long raw_change_ms_ = 0; ///< Time of the last raw change
+    bool pressed_ = false;            ///< Debounced level
+    bool has_press_ = false;          ///< True once a press was accepted
+    unsigned long last_press_ms_ = 0; ///< Edge time of the last accepted press
+    bool long_press_fired_ = false;   ///< LONG_PRESS already reported for this press
+};
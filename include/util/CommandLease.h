@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file CommandLease.h
+ * @brief Hold-to-run validity window of a motion command
+ *
+ * A leased command keeps its actuator moving only until the lease runs
+ * out; every repeat of the command (keep-alive) renews it. The holder
+ * checks expired() on its own clock, so a client that drops off the
+ * network stops the motor one lease after its last keep-alive, without
+ * waiting for the connection to be declared lost.
+ *
+ * Single-threaded: granted and checked on the control side.
+ */
+class CommandLease {
+public:
+    /**
+     * @brief Grant or renew the lease
+     * @param direction Leased motion (-1 / 1); 0 releases the lease
+     * @param from_us Arrival of the command (micros())
+     * @param duration_us Validity window
+     */
+    void grant(int8_t direction, uint32_t from_us, uint32_t duration_us) {
+        if (direction == 0 || duration_us == 0) {
+            release();
+            return;
+        }
+        direction_ = direction;
+        expires_us_ = from_us + duration_us;
+    }
+
+    /// Drop the lease (motion latched or stopped by another command)
+    void release() { direction_ = 0; }
+
+    /// @return true while a lease is held
+    bool isActive() const { return direction_ != 0; }
+
+    /// @return Leased motion, 0 without a lease
+    int8_t direction() const { return direction_; }
+
+    /// @return true once an active lease ran out at now_us
+    bool expired(uint32_t now_us) const {
+        return isActive() && static_cast<int32_t>(now_us - expires_us_) >= 0;
+    }
+
+private:
+    int8_t direction_ = 0;
+    uint32_t expires_us_ = 0;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file Crc32.h
+ * @brief CRC-32 (IEEE 802.3, reflected) for persisted records
+ *
+ * Bitwise implementation without a lookup table: records are a few dozen
+ * bytes and written rarely, so 1 KB of table would cost more than it saves.
+ */
+
+/**
+ * @brief Compute or continue a CRC-32
+ * @param data Bytes to checksum
+ * @param length Number of bytes
+ * @param crc Previous result when checksumming in pieces (0 to start)
+ * @return CRC-32 of the bytes so far
+ */
+inline uint32_t crc32(const void* data, size_t length, uint32_t crc = 0) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
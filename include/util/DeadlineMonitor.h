@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file DeadlineMonitor.h
+ * @brief Per-task check-in deadlines for a fail-safe supervisor
+ *
+ * Each supervised task checks in every time it completes a pass; check()
+ * (the supervisor, typically a timer ISR) reports every task whose last
+ * check-in is older than its deadline. A task is only supervised from its
+ * first check-in on, so a task that never runs (no remote fitted, start-up)
+ * is not reported.
+ *
+ * Per task the monitor keeps the missed deadlines (one per overdue episode,
+ * counted by check()) and the longest interval seen between two check-ins,
+ * which is the figure to size a loop budget against.
+ *
+ * Threading: checkIn() for a given task from one task only, check() from
+ * one checker; both may run concurrently (atomics, no locks). The rest is
+ * read-only and safe from anywhere.
+ */
+template <size_t N>
+class DeadlineMonitor {
+public:
+    static constexpr size_t NONE = N;  ///< No task (add() failed)
+
+    /**
+     * @brief Register a task (setup only)
+     * @param deadline_us Longest allowed interval between check-ins
+     * @return Task index, or NONE if all N slots are used
+     */
+    size_t add(const char* name, uint32_t deadline_us) {
+        if (count_ >= N) {
+            return NONE;
+        }
+        Task& task = tasks_[count_];
+        task.name = name;
+        task.deadline_us = deadline_us;
+        return count_++;
+    }
+
+    /// Task completed a pass at now_us
+    void checkIn(size_t index, uint32_t now_us) {
+        Task& task = tasks_[index];
+        if (task.armed.load(std::memory_order_relaxed)) {
+            uint32_t interval_us = now_us - task.last_us.load(std::memory_order_relaxed);
+            if (interval_us > task.worst_interval_us.load(std::memory_order_relaxed)) {
+                task.worst_interval_us.store(interval_us, std::memory_order_relaxed);
+            }
+        }
+        task.last_us.store(now_us, std::memory_order_release);
+        task.armed.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Evaluate all deadlines (single checker)
+     * @return Bit i set while task i is overdue
+     */
+    uint32_t check(uint32_t now_us) {
+        uint32_t overdue = 0;
+        for (size_t i = 0; i < count_; i++) {
+            Task& task = tasks_[i];
+            bool late = isLate(task, now_us);
+            if (late && !task.overdue) {
+                task.misses.fetch_add(1, std::memory_order_relaxed);
+            }
+            task.overdue = late;
+            if (late) {
+                overdue |= 1UL << i;
+            }
+        }
+        return overdue;
+    }
+
+    /// @return true if no supervised task is past its deadline at now_us (any task)
+    bool allMet(uint32_t now_us) const {
+        for (size_t i = 0; i < count_; i++) {
+            if (isLate(tasks_[i], now_us)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @return Registered tasks
+    size_t size() const { return count_; }
+
+    const char* name(size_t index) const { return tasks_[index].name; }
+    uint32_t deadline(size_t index) const { return tasks_[index].deadline_us; }
+
+    /// @return true once the task has checked in
+    bool isSupervised(size_t index) const {
+        return tasks_[index].armed.load(std::memory_order_acquire);
+    }
+
+    /// @return Overdue episodes counted by check()
+    uint32_t missed(size_t index) const {
+        return tasks_[index].misses.load(std::memory_order_relaxed);
+    }
+
+    /// @return Longest interval between two check-ins (us)
+    uint32_t worstInterval(size_t index) const {
+        return tasks_[index].worst_interval_us.load(std::memory_order_relaxed);
+    }
+
+private:
+    static_assert(N <= 32, "check() reports overdue tasks as a 32-bit mask");
+
+    struct Task {
+        const char* name = nullptr;
+        uint32_t deadline_us = 0;
+        std::atomic<uint32_t> last_us{0};
+        std::atomic<bool> armed{false};
+        std::atomic<uint32_t> misses{0};
+        std::atomic<uint32_t> worst_interval_us{0};
+        bool overdue = false;  ///< Checker only
+    };
+
+    Task tasks_[N];
+    size_t count_ = 0;
+
+    static bool isLate(const Task& task, uint32_t now_us) {
+        if (!task.armed.load(std::memory_order_acquire)) {
+            return false;
+        }
+        // Signed: a check-in stamped after now_us (check-in raced the checker) is not late
+        int32_t age_us = static_cast<int32_t>(now_us - task.last_us.load(std::memory_order_acquire));
+        return age_us > static_cast<int32_t>(task.deadline_us);
+    }
+};
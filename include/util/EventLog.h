@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(ARDUINO)
+#include "freertos/FreeRTOS.h"
+#endif
+
+/**
+ * @file EventLog.h
+ * @brief Fixed-size ring of compact binary event records
+ *
+ * A record is 16 bytes: timestamp, event id, repeat count and two raw 32-bit
+ * arguments. record() costs a short critical section and a few stores - no
+ * formatting, no serial I/O - so it can be called from the control path.
+ * The text is produced later by whoever pops the records.
+ *
+ * Coalescing: if one of the newest COALESCE_DEPTH unread records has the
+ * same id and arguments, its repeat count is incremented instead of adding
+ * a record (a held button or a stop() on every pass costs no slots; the
+ * record keeps the time of the first occurrence).
+ *
+ * When full, the oldest unread record is overwritten (the newest events
+ * matter most) and counted in overwritten().
+ *
+ * On the ESP32 the ring is guarded by a spinlock critical section, so any
+ * task on either core (and an ISR) may record; one task pops. On the host
+ * (tests, benchmarks) there is no lock.
+ *
+ * @tparam N Capacity in records, must be a power of two
+ */
+
+/// One binary log record
+struct EventRecord {
+    uint32_t timestamp_ms = 0;  ///< Time of the first occurrence
+    uint16_t id = 0;            ///< Event id (interpretation up to the user)
+    uint16_t repeats = 0;       ///< Identical occurrences merged into this record
+    uint32_t a = 0;             ///< First argument (raw bits)
+    uint32_t b = 0;             ///< Second argument (raw bits)
+};
+
+template <size_t N>
+class EventLog {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "EventLog capacity must be a power of two");
+
+public:
+    static constexpr uint32_t COALESCE_DEPTH = 4;  ///< Unread records searched for a duplicate
+
+    /**
+     * @brief Append an event, or merge it into an identical recent one
+     */
+    void record(uint16_t id, uint32_t a, uint32_t b, uint32_t now_ms) {
+        lock();
+        logged_++;
+        uint32_t unread = head_ - tail_;
+        uint32_t depth = unread < COALESCE_DEPTH ? unread : COALESCE_DEPTH;
+        for (uint32_t i = 1; i <= depth; i++) {
+            EventRecord& recent = records_[(head_ - i) & (N - 1)];
+            if (recent.id == id && recent.a == a && recent.b == b && recent.repeats < UINT16_MAX) {
+                recent.repeats++;
+                coalesced_++;
+                unlock();
+                return;
+            }
+        }
+        if (unread == N) {
+            tail_++;  // Full: drop the oldest unread record
+            overwritten_++;
+        }
+        EventRecord& slot = records_[head_ & (N - 1)];
+        slot.timestamp_ms = now_ms;
+        slot.id = id;
+        slot.repeats = 0;
+        slot.a = a;
+        slot.b = b;
+        head_++;
+        unlock();
+    }
+
+    /**
+     * @brief Remove the oldest unread record (single consumer)
+     * @return false if the log is empty
+     */
+    bool pop(EventRecord& out) {
+        lock();
+        if (head_ == tail_) {
+            unlock();
+            return false;
+        }
+        out = records_[tail_ & (N - 1)];
+        tail_++;
+        unlock();
+        return true;
+    }
+
+    /// @return Events recorded (including merged ones)
+    uint32_t logged() const { return logged_; }
+
+    /// @return Events merged into an existing record
+    uint32_t coalesced() const { return coalesced_; }
+
+    /// @return Unread records lost because the log was full
+    uint32_t overwritten() const { return overwritten_; }
+
+    /// @return Compile-time capacity in records
+    static constexpr size_t capacity() { return N; }
+
+private:
+    EventRecord records_[N];  ///< Ring storage
+    uint32_t head_ = 0;       ///< Next record to write
+    uint32_t tail_ = 0;       ///< Next record to read
+    uint32_t logged_ = 0;     ///< record() calls
+    uint32_t coalesced_ = 0;  ///< Merged occurrences
+    uint32_t overwritten_ = 0;  ///< Records lost to overflow
+
+#if defined(ARDUINO)
+    portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+    void lock() { portENTER_CRITICAL_SAFE(&lock_); }
+    void unlock() { portEXIT_CRITICAL_SAFE(&lock_); }
+#else
+    void lock() {}
+    void unlock() {}
+#endif
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file FrameScheduler.h
+ * @brief Fixed minor/major frame scheduler for periodic work
+ *
+ * Time is divided into minor frames of MINOR_FRAME_MS; tick() is called
+ * once per minor frame and runs the tasks due in it. A task's period is a
+ * whole number of minor frames, and add() gives it the phase (frame offset
+ * within its period) that collides with the fewest already registered
+ * tasks over the major frame (least common multiple of the periods), so
+ * tasks of the same rate run on different frames instead of piling up on
+ * one tick.
+ *
+ * Per task the scheduler records runs, the longest execution time, budget
+ * overruns (a run longer than its budget) and late runs (started a full
+ * minor frame or more after it was due); per frame it counts ticks that took
+ * longer than the minor frame. With the frame layout fixed, the worst case
+ * from an input to code reacting to it is bounded by the task period plus
+ * the frame's execution time.
+ *
+ * Tasks are added during setup; nothing is allocated. Single-threaded:
+ * add() and tick() run on the same task.
+ */
+
+/// Scheduled task body
+using ScheduledFn = void (*)(void* context);
+
+/// Microsecond clock used to time tasks
+using SchedulerClockFn = uint32_t (*)();
+
+/// Statistics of one scheduled task
+struct ScheduledTaskStats {
+    uint32_t runs = 0;        ///< Executions
+    uint32_t max_us = 0;      ///< Longest execution
+    uint32_t overruns = 0;    ///< Executions longer than the budget
+    uint32_t late = 0;        ///< Executions started one minor frame or more past due
+};
+
+template <size_t MAX_TASKS>
+class FrameScheduler {
+public:
+    static constexpr uint32_t MAX_MAJOR_FRAMES = 4000;  ///< Cap of the phase search horizon
+
+    /**
+     * @param minor_frame_ms Length of one minor frame (tick() period)
+     * @param clock Microsecond clock (micros() on the ESP32)
+     */
+    FrameScheduler(uint32_t minor_frame_ms, SchedulerClockFn clock)
+        : minor_frame_ms_(minor_frame_ms), clock_(clock) {}
+
+    /**
+     * @brief Register a periodic task (setup only)
+     * @param name Label for the status page (static string)
+     * @param period_ms Period, rounded to a multiple of the minor frame (at least one)
+     * @param budget_us Execution time above which a run counts as an overrun (0 = none)
+     * @return Task index, or -1 if MAX_TASKS are registered
+     */
+    int add(const char* name, uint32_t period_ms, uint32_t budget_us, ScheduledFn fn, void* context) {
+        if (count_ >= MAX_TASKS || !fn) {
+            return -1;
+        }
+        Task& task = tasks_[count_];
+        task.name = name;
+        task.period = (period_ms + minor_frame_ms_ / 2) / minor_frame_ms_;
+        if (task.period == 0) task.period = 1;
+        task.budget_us = budget_us;
+        task.fn = fn;
+        task.context = context;
+        task.phase = choosePhase(task.period);
+        task.stats = ScheduledTaskStats();
+        return static_cast<int>(count_++);
+    }
+
+    /**
+     * @brief Run the tasks due in the next minor frame (call every MINOR_FRAME_MS)
+     */
+    void tick() {
+        uint32_t frame_start_us = clock_();
+        // A gap of two frames since the last tick: this one is a frame behind its slot
+        bool late = ticked_ && frame_start_us - last_tick_us_ >= 2 * minor_frame_ms_ * 1000UL;
+        if (late) {
+            late_frames_++;
+        }
+        last_tick_us_ = frame_start_us;
+        ticked_ = true;
+
+        for (size_t i = 0; i < count_; i++) {
+            Task& task = tasks_[i];
+            if (frame_ % task.period != task.phase) {
+                continue;
+            }
+            uint32_t start_us = clock_();
+            task.fn(task.context);
+            uint32_t duration_us = clock_() - start_us;
+            task.stats.runs++;
+            if (duration_us > task.stats.max_us) task.stats.max_us = duration_us;
+            if (task.budget_us && duration_us > task.budget_us) task.stats.overruns++;
+            if (late) task.stats.late++;
+        }
+
+        if (clock_() - frame_start_us > minor_frame_ms_ * 1000UL) {
+            frame_overruns_++;
+        }
+        frame_++;
+    }
+
+    /// @return Registered tasks
+    size_t size() const { return count_; }
+
+    /// @return Label of a task
+    const char* name(size_t index) const { return tasks_[index].name; }
+
+    /// @return Period of a task in minor frames
+    uint32_t period(size_t index) const { return tasks_[index].period; }
+
+    /// @return Frame offset of a task within its period
+    uint32_t phase(size_t index) const { return tasks_[index].phase; }
+
+    /// @return Statistics of a task
+    const ScheduledTaskStats& stats(size_t index) const { return tasks_[index].stats; }
+
+    /// @return Minor frames whose tasks took longer than a minor frame
+    uint32_t getFrameOverruns() const { return frame_overruns_; }
+
+    /// @return Ticks that started a minor frame or more late
+    uint32_t getLateFrames() const { return late_frames_; }
+
+    /// @return Minor frame length
+    uint32_t getMinorFrameMs() const { return minor_frame_ms_; }
+
+private:
+    struct Task {
+        const char* name = nullptr;
+        uint32_t period = 1;     ///< Minor frames
+        uint32_t phase = 0;      ///< Offset within the period
+        uint32_t budget_us = 0;
+        ScheduledFn fn = nullptr;
+        void* context = nullptr;
+        ScheduledTaskStats stats;
+    };
+
+    uint32_t minor_frame_ms_;
+    SchedulerClockFn clock_;
+    Task tasks_[MAX_TASKS];
+    size_t count_ = 0;
+    uint32_t frame_ = 0;            ///< Minor frame counter
+    uint32_t last_tick_us_ = 0;
+    bool ticked_ = false;
+    uint32_t frame_overruns_ = 0;
+    uint32_t late_frames_ = 0;
+
+    static uint32_t gcd(uint32_t a, uint32_t b) {
+        while (b) {
+            uint32_t t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    /// Offset in [0, period) whose busiest frame has the fewest registered tasks
+    uint32_t choosePhase(uint32_t period) const {
+        uint32_t major = period;
+        for (size_t i = 0; i < count_; i++) {
+            uint32_t lcm = major / gcd(major, tasks_[i].period) * tasks_[i].period;
+            major = lcm > MAX_MAJOR_FRAMES ? MAX_MAJOR_FRAMES : lcm;
+        }
+
+        uint32_t best_phase = 0;
+        uint32_t best_load = UINT32_MAX;
+        uint32_t best_total = UINT32_MAX;
+        for (uint32_t phase = 0; phase < period; phase++) {
+            uint32_t worst = 0;
+            uint32_t total = 0;
+            for (uint32_t frame = phase; frame < major; frame += period) {
+                uint32_t load = 0;
+                for (size_t i = 0; i < count_; i++) {
+                    if (frame % tasks_[i].period == tasks_[i].phase) load++;
+                }
+                if (load > worst) worst = load;
+                total += load;
+            }
+            if (worst < best_load || (worst == best_load && total < best_total)) {
+                best_phase = phase;
+                best_load = worst;
+                best_total = total;
+            }
+        }
+        return best_phase;
+    }
+};
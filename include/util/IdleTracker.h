@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file IdleTracker.h
+ * @brief Idle detection with an entry delay, and the time spent idle
+ *
+ * The system counts as idle once nothing was active for the entry delay,
+ * so the short pause between a stop and the next command (or a remote
+ * double press) does not switch power modes back and forth. Any activity
+ * leaves idle at once.
+ *
+ * Single-threaded: updated on the control side; the totals are plain
+ * counters for statistics.
+ */
+class IdleTracker {
+public:
+    /// Possible result of update()
+    enum class Transition : uint8_t {
+        NONE,        ///< Mode unchanged
+        ENTER_IDLE,  ///< Quiet for the entry delay
+        EXIT_IDLE,   ///< Activity while idle
+    };
+
+    /**
+     * @param entry_delay_ms Quiet time before idle is entered
+     */
+    explicit IdleTracker(uint32_t entry_delay_ms) : entry_delay_ms_(entry_delay_ms) {}
+
+    /**
+     * @brief Account one pass
+     * @param active Something moves, is leased or armed, or a command arrived
+     * @param now_ms millis()
+     */
+    Transition update(bool active, uint32_t now_ms) {
+        if (!started_) {
+            started_ = true;
+            last_active_ms_ = now_ms;
+            last_update_ms_ = now_ms;
+        }
+        if (idle_) {
+            idle_ms_ += now_ms - last_update_ms_;
+        }
+        last_update_ms_ = now_ms;
+
+        if (active) {
+            last_active_ms_ = now_ms;
+            if (idle_) {
+                idle_ = false;
+                return Transition::EXIT_IDLE;
+            }
+            return Transition::NONE;
+        }
+        if (!idle_ && now_ms - last_active_ms_ >= entry_delay_ms_) {
+            idle_ = true;
+            idle_entries_++;
+            return Transition::ENTER_IDLE;
+        }
+        return Transition::NONE;
+    }
+
+    /// @return true while idle
+    bool isIdle() const { return idle_; }
+
+    /// @return Milliseconds spent idle, up to the last update()
+    uint32_t idleMs() const { return idle_ms_; }
+
+    /// @return Times idle was entered
+    uint32_t idleEntries() const { return idle_entries_; }
+
+private:
+    uint32_t entry_delay_ms_;
+    uint32_t last_active_ms_ = 0;  ///< Last pass with activity
+    uint32_t last_update_ms_ = 0;  ///< Previous update()
+    uint32_t idle_ms_ = 0;
+    uint32_t idle_entries_ = 0;
+    bool idle_ = false;
+    bool started_ = false;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file LatencyHistogram.h
+ * @brief Fixed-bucket log2 latency histogram (no allocation, ISR-safe record)
+ *
+ * Bucket 0 holds samples of 0-1 us, bucket i holds [2^i, 2^(i+1)) us, the
+ * last bucket everything above. record() is a handful of integer ops and
+ * may be called from ISRs; readers tolerate a sample landing mid-read.
+ *
+ * Percentiles are reported as the upper edge of the bucket that contains
+ * the requested rank, clamped to the observed maximum: within a factor of
+ * two, which is the resolution needed to compare firmware builds.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint8_t BUCKETS = 24;  ///< Covers up to ~16 s
+
+    /**
+     * @brief Add one sample
+     * @param us Duration in microseconds
+     */
+    void record(uint32_t us) {
+        buckets_[bucketFor(us)]++;
+        if (count_ == 0 || us < min_us_) min_us_ = us;
+        if (us > max_us_) max_us_ = us;
+        count_++;
+    }
+
+    /// @return Number of samples since the last reset
+    uint32_t count() const { return count_; }
+
+    /// @return Smallest sample (0 if empty)
+    uint32_t min() const { return count_ ? min_us_ : 0; }
+
+    /// @return Largest sample (0 if empty)
+    uint32_t max() const { return max_us_; }
+
+    /**
+     * @brief Estimate a percentile
+     * @param percent 0-100
+     * @return Upper bucket edge in us containing the percentile (0 if empty)
+     */
+    uint32_t percentile(uint8_t percent) const {
+        uint32_t total = count_;
+        if (total == 0) {
+            return 0;
+        }
+        // Rank of the sample that reaches the percentile (1-based, rounded up)
+        uint32_t rank = (static_cast<uint64_t>(total) * percent + 99) / 100;
+        if (rank == 0) rank = 1;
+        uint32_t seen = 0;
+        for (uint8_t i = 0; i < BUCKETS; i++) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                uint32_t edge = upperEdge(i);
+                return edge < max_us_ ? edge : max_us_;
+            }
+        }
+        return max_us_;
+    }
+
+    /// @brief Clear all samples
+    void reset() {
+        for (uint8_t i = 0; i < BUCKETS; i++) {
+            buckets_[i] = 0;
+        }
+        count_ = 0;
+        min_us_ = 0;
+        max_us_ = 0;
+    }
+
+private:
+    volatile uint32_t buckets_[BUCKETS] = {};  ///< Sample counts per log2 bucket
+    volatile uint32_t count_ = 0;              ///< Total samples
+    volatile uint32_t min_us_ = 0;             ///< Smallest sample
+    volatile uint32_t max_us_ = 0;             ///< Largest sample
+
+    static uint8_t bucketFor(uint32_t us) {
+        uint8_t bucket = 0;
+        while (us > 1 && bucket < BUCKETS - 1) {
+            us >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    static uint32_t upperEdge(uint8_t bucket) {
+        return bucket >= 31 ? 0xFFFFFFFFUL : (2UL << bucket) - 1;
+    }
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file MpscQueue.h
+ * @brief Fixed-size lock-free multi-producer / single-consumer queue
+ *
+ * Bounded queue with a sequence number per slot (Vyukov style):
+ * - Producers claim a slot with a CAS on head_, write the item, then
+ *   publish it by advancing the slot sequence
+ * - The single consumer only writes tail_ and the slot sequence it frees
+ *
+ * Any number of tasks (SignalK event loop, wireless command channel, ...)
+ * may push concurrently; one task pops. No allocation - storage is an
+ * in-object array sized at compile time. Not for use from an ISR that can
+ * preempt a producer on the same core (the consumer would wait on the slot).
+ *
+ * When full, push() drops the new item and counts it in dropped().
+ *
+ * @tparam T Element type (trivially copyable)
+ * @tparam N Capacity, must be a power of two
+ */
+template <typename T, size_t N>
+class MpscQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue() {
+        for (uint32_t i = 0; i < N; i++) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Append an item (any producer)
+     * @return false if the queue was full and the item was dropped
+     */
+    bool push(const T& item) {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[head & (N - 1)];
+            uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+            int32_t diff = static_cast<int32_t>(sequence - head);
+            if (diff == 0) {
+                // Slot free for this lap: claim it
+                if (head_.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+                    slot.item = item;
+                    slot.sequence.store(head + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // Slot still holds last lap's item: full
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                head = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove the oldest published item (consumer side)
+     * @return false if no item is ready
+     */
+    bool pop(T& item) {
+        Slot& slot = slots_[tail_ & (N - 1)];
+        uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != tail_ + 1) {
+            return false;  // Empty, or the claiming producer has not finished writing
+        }
+        item = slot.item;
+        slot.sequence.store(tail_ + N, std::memory_order_release);
+        tail_++;
+        return true;
+    }
+
+    /// @return Number of items dropped because the queue was full
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /// @return Compile-time capacity
+    static constexpr size_t capacity() { return N; }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence{0};  ///< Lap marker: free at i, ready at i + 1
+        T item = {};                        ///< Element storage
+    };
+
+    Slot slots_[N];                       ///< Ring of slots
+    std::atomic<uint32_t> head_{0};       ///< Next slot to claim (shared by producers)
+    uint32_t tail_ = 0;                   ///< Next slot to read (consumer owned)
+    std::atomic<uint32_t> dropped_{0};    ///< Overflow counter
+};
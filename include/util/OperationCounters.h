@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "interfaces/IStatsStore.h"
+#include "util/Crc32.h"
+
+/**
+ * @file OperationCounters.h
+ * @brief Fixed-size operation counters and their persisted record
+ *
+ * OperationCounters holds one 32-bit counter per OperationStat. Updates
+ * are single relaxed atomic adds with no allocation, so motor drivers and
+ * the emergency stop can count on the control path; any task may read.
+ *
+ * Run time and starts come from motion(): each call reports the commanded
+ * direction of a motor, a change to a running direction counts a start,
+ * and the time of a run is added when the run ends (stop or reversal).
+ * motion() is control side only; OperationMotor::COUNT is not counted.
+ */
+
+constexpr uint32_t OPERATION_STATS_MAGIC = 0x54535047UL;  ///< "GPST"
+constexpr uint16_t OPERATION_STATS_VERSION = 1;            ///< OperationStatsRecord layout
+
+/// Motors with run-time accounting
+enum class OperationMotor : uint8_t {
+    WINCH,
+    BOW,
+    COUNT
+};
+
+class OperationCounters {
+public:
+    /// Add to a counter (any task)
+    void add(OperationStat stat, uint32_t amount) {
+        values_[index(stat)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /// @return Counter value
+    uint32_t get(OperationStat stat) const {
+        return values_[index(stat)].load(std::memory_order_relaxed);
+    }
+
+    /// Copy all counters (OperationStat order)
+    void snapshot(uint32_t (&values)[OPERATION_STAT_COUNT]) const {
+        for (size_t i = 0; i < OPERATION_STAT_COUNT; i++) {
+            values[i] = values_[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Report the commanded direction of a motor (control side)
+     * @param direction 1 = up / starboard, -1 = down / port, 0 = stopped
+     * @param now_ms millis()
+     */
+    void motion(OperationMotor motor, int8_t direction, uint32_t now_ms) {
+        if (motor >= OperationMotor::COUNT) {
+            return;  // Not a counted motor (additional windlass channels)
+        }
+        Run& run = runs_[static_cast<size_t>(motor)];
+        if (direction == run.direction) {
+            return;  // Repeat of the running command
+        }
+        if (run.direction != 0) {
+            add(runTimeStat(motor, run.direction), now_ms - run.start_ms);
+        }
+        run.direction = direction;
+        run.start_ms = now_ms;
+        if (direction != 0) {
+            add(startStat(motor, direction), 1);
+        }
+    }
+
+    /**
+     * @brief Count chain movement
+     * @param delta_pulses Pulses since the last call (positive = paid out)
+     */
+    void addPulses(long delta_pulses) {
+        if (delta_pulses > 0) {
+            add(OperationStat::DEPLOYED_PULSES, static_cast<uint32_t>(delta_pulses));
+        } else if (delta_pulses < 0) {
+            add(OperationStat::RETRIEVED_PULSES, static_cast<uint32_t>(-delta_pulses));
+        }
+    }
+
+private:
+    struct Run {
+        int8_t direction = 0;
+        uint32_t start_ms = 0;
+    };
+
+    std::atomic<uint32_t> values_[OPERATION_STAT_COUNT] = {};
+    Run runs_[static_cast<size_t>(OperationMotor::COUNT)];  ///< Control side only
+
+    static constexpr size_t index(OperationStat stat) { return static_cast<size_t>(stat); }
+
+    static OperationStat runTimeStat(OperationMotor motor, int8_t direction) {
+        if (motor == OperationMotor::BOW) return OperationStat::BOW_MS;
+        return direction > 0 ? OperationStat::WINCH_UP_MS : OperationStat::WINCH_DOWN_MS;
+    }
+
+    static OperationStat startStat(OperationMotor motor, int8_t direction) {
+        if (motor == OperationMotor::BOW) return OperationStat::BOW_STARTS;
+        return direction > 0 ? OperationStat::WINCH_UP_STARTS : OperationStat::WINCH_DOWN_STARTS;
+    }
+};
+
+/// @return Record with magic, version and CRC filled in
+inline OperationStatsRecord makeOperationStatsRecord(const uint32_t (&values)[OPERATION_STAT_COUNT]) {
+    OperationStatsRecord record = {};
+    record.magic = OPERATION_STATS_MAGIC;
+    record.version = OPERATION_STATS_VERSION;
+    memcpy(record.values, values, sizeof(record.values));
+    record.crc = crc32(&record, offsetof(OperationStatsRecord, crc));
+    return record;
+}
+
+/// @return true if the record has this firmware's magic and layout and a matching CRC
+inline bool isValidOperationStatsRecord(const OperationStatsRecord& record) {
+    return record.magic == OPERATION_STATS_MAGIC &&
+           record.version == OPERATION_STATS_VERSION &&
+           record.crc == crc32(&record, offsetof(OperationStatsRecord, crc));
+}
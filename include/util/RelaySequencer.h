@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file RelaySequencer.h
+ * @brief Contactor timing and thermal duty budget for a reversing relay pair
+ *
+ * Sits between the commanded direction and the two relays of one actuator
+ * (winch up/down, thruster port/starboard):
+ * - Reversal dead-time: after direction A was energised, direction B is not
+ *   energised until dead_time_ms after A opened (no reversal under arc)
+ * - Minimum off time before any re-energise, and minimum on time before a
+ *   reversal (a stop is never delayed)
+ * - Thermal budget: energised time fills a leaky bucket of duty_budget_ms
+ *   that drains at duty_budget_ms per duty_window_ms (e.g. 3 min per hour).
+ *   A full bucket trips the output off and refuses starts until it has
+ *   drained to RESUME_FRACTION. A trip drops the command, so controllers
+ *   see the actuator stopped.
+ *
+ * Commands that need no wait are applied at once, so an unconstrained start
+ * or stop is as fast as a direct relay write. Deferred transitions and the
+ * thermal trip are due at nextEventMs(); the caller runs update() then, from
+ * a timer rather than a polled loop.
+ *
+ * Pure logic (times passed in), not thread-safe: the caller serialises
+ * request() and update().
+ */
+
+/// Relay pair output
+enum class RelayOutput : int8_t {
+    OFF = 0,
+    A = 1,   ///< First relay (winch up, thruster port)
+    B = -1,  ///< Second relay (winch down, thruster starboard)
+};
+
+/// Timing limits of one actuator (0 disables a limit)
+struct RelayTiming {
+    uint32_t dead_time_ms = 0;     ///< Off time between opposite directions
+    uint32_t min_on_ms = 0;        ///< On time before a reversal is executed
+    uint32_t min_off_ms = 0;       ///< Off time before any re-energise
+    uint32_t duty_window_ms = 0;   ///< Thermal rating window (e.g. 3600000)
+    uint32_t duty_budget_ms = 0;   ///< Energised time allowed per window (e.g. 180000)
+};
+
+class RelaySequencer {
+public:
+    static constexpr uint32_t NO_EVENT = 0xFFFFFFFFUL;  ///< nextEventMs(): nothing pending
+    static constexpr float RESUME_FRACTION = 0.5f;      ///< Bucket level that ends a thermal lockout
+
+    explicit RelaySequencer(const RelayTiming& timing = RelayTiming()) : timing_(timing) {}
+
+    /**
+     * @brief Command a direction
+     * @param direction Wanted output (OFF always applies immediately)
+     * @param now_ms Current time
+     * @return Output to drive now
+     */
+    RelayOutput request(RelayOutput direction, uint32_t now_ms) {
+        account(now_ms);
+        if (direction != RelayOutput::OFF && lockout_) {
+            direction = RelayOutput::OFF;  // Thermal lockout: refuse starts
+        }
+        requested_ = direction;
+        return step(now_ms);
+    }
+
+    /**
+     * @brief Execute a due deferred transition or thermal trip
+     * @return Output to drive now
+     */
+    RelayOutput update(uint32_t now_ms) {
+        account(now_ms);
+        return step(now_ms);
+    }
+
+    /**
+     * @brief Time until update() can change the output
+     * @return Milliseconds from now_ms, or NO_EVENT
+     */
+    uint32_t nextEventMs(uint32_t now_ms) const {
+        uint32_t next = NO_EVENT;
+        if (requested_ != output_) {
+            uint32_t due = transitionDueMs();
+            next = elapsedSince(due, now_ms) ? 0 : due - now_ms;
+        }
+        if (output_ != RelayOutput::OFF && budgetEnabled() && leakRate() < 1.0f) {
+            float remaining = (timing_.duty_budget_ms - level_ms_) / (1.0f - leakRate());
+            uint32_t trip_ms = remaining > 0.0f ? static_cast<uint32_t>(remaining) + 1 : 0;
+            if (trip_ms < next) next = trip_ms;
+        }
+        return next;
+    }
+
+    /// @return Output currently driven
+    RelayOutput output() const { return output_; }
+
+    /// @return Accepted command (OFF after a thermal trip or refused start)
+    RelayOutput requested() const { return requested_; }
+
+    /// @return true while starts are refused after a thermal trip
+    bool isThermalLockout() const { return lockout_; }
+
+    /// @return Thermal bucket level (0 = cold, 1 = trip)
+    float dutyUsed() const {
+        return budgetEnabled() ? level_ms_ / timing_.duty_budget_ms : 0.0f;
+    }
+
+    /// @return Thermal trips since construction
+    uint32_t getThermalTrips() const { return thermal_trips_; }
+
+private:
+    RelayTiming timing_;
+    RelayOutput output_ = RelayOutput::OFF;     ///< Driven output
+    RelayOutput requested_ = RelayOutput::OFF;  ///< Commanded output
+    RelayOutput last_on_ = RelayOutput::OFF;    ///< Direction energised last
+    uint32_t changed_ms_ = 0;                   ///< Time output_ last changed
+    uint32_t accounted_ms_ = 0;                 ///< Time the bucket was last updated
+    bool has_accounted_ = false;                ///< accounted_ms_ valid
+    float level_ms_ = 0.0f;                     ///< Thermal bucket (energised ms)
+    bool lockout_ = false;                      ///< Thermal lockout active
+    uint32_t thermal_trips_ = 0;                ///< Trips counted
+
+    bool budgetEnabled() const { return timing_.duty_budget_ms > 0 && timing_.duty_window_ms > 0; }
+
+    float leakRate() const {
+        return static_cast<float>(timing_.duty_budget_ms) / timing_.duty_window_ms;
+    }
+
+    static bool elapsedSince(uint32_t due_ms, uint32_t now_ms) {
+        return static_cast<int32_t>(now_ms - due_ms) >= 0;
+    }
+
+    /// Fill or drain the thermal bucket up to now; trip when full
+    void account(uint32_t now_ms) {
+        if (!budgetEnabled()) {
+            return;
+        }
+        if (has_accounted_) {
+            float elapsed = static_cast<float>(now_ms - accounted_ms_);
+            if (output_ != RelayOutput::OFF) {
+                level_ms_ += elapsed * (1.0f - leakRate());
+            } else {
+                level_ms_ -= elapsed * leakRate();
+            }
+            if (level_ms_ < 0.0f) level_ms_ = 0.0f;
+        }
+        accounted_ms_ = now_ms;
+        has_accounted_ = true;
+
+        if (!lockout_ && output_ != RelayOutput::OFF && level_ms_ >= timing_.duty_budget_ms) {
+            lockout_ = true;
+            thermal_trips_++;
+            requested_ = RelayOutput::OFF;
+        } else if (lockout_ && level_ms_ <= timing_.duty_budget_ms * RESUME_FRACTION) {
+            lockout_ = false;
+        }
+    }
+
+    /// Earliest time the pending transition may execute
+    uint32_t transitionDueMs() const {
+        if (output_ != RelayOutput::OFF) {
+            // Reversal: keep the current direction for min_on first (a stop is never delayed)
+            return requested_ == RelayOutput::OFF ? changed_ms_ : changed_ms_ + timing_.min_on_ms;
+        }
+        uint32_t wait_ms = timing_.min_off_ms;
+        if (last_on_ != RelayOutput::OFF && requested_ != last_on_ && timing_.dead_time_ms > wait_ms) {
+            wait_ms = timing_.dead_time_ms;
+        }
+        return changed_ms_ + wait_ms;
+    }
+
+    RelayOutput step(uint32_t now_ms) {
+        if (requested_ == output_) {
+            return output_;
+        }
+        if (output_ != RelayOutput::OFF) {
+            if (requested_ != RelayOutput::OFF && !elapsedSince(transitionDueMs(), now_ms)) {
+                return output_;  // Reversal waits for min_on
+            }
+            // Open first; an opposite direction then waits for the dead time
+            output_ = RelayOutput::OFF;
+            changed_ms_ = now_ms;
+            if (requested_ == RelayOutput::OFF) {
+                return output_;
+            }
+        }
+        if (elapsedSince(transitionDueMs(), now_ms)) {
+            output_ = requested_;
+            last_on_ = requested_;
+            changed_ms_ = now_ms;
+        }
+        return output_;
+    }
+};
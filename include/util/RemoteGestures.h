@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include "util/ButtonDebouncer.h"
+#include "util/RemoteTiming.h"
+
+/**
+ * @file RemoteGestures.h
+ * @brief Debounced remote buttons and the emergency stop gestures
+ *
+ * One ButtonDebouncer per remote input plus a fifth "any button" channel
+ * fed with the combined debounced state, so receiver noise on any input
+ * cannot produce a gesture:
+ * - a double press of any button latches the emergency stop
+ * - a long press of any button clears it
+ *
+ * Kept apart from RemoteControl (which needs SensESP) so host-side tests
+ * run the exact gesture path of the firmware.
+ */
+
+/// Emergency stop transition decided by RemoteGestures::update()
+enum class RemoteGesture : uint8_t {
+    NONE,                  ///< No change
+    EMERGENCY_STOP,        ///< Double press while not stopped: latch the emergency stop
+    CLEAR_EMERGENCY_STOP,  ///< Long press while stopped: clear the emergency stop
+};
+
+class RemoteGestures {
+public:
+    static constexpr uint8_t BUTTON_COUNT = 4;  ///< UP, DOWN, FUNC3, FUNC4
+    static constexpr uint8_t UP = 0;            ///< Winch up
+    static constexpr uint8_t DOWN = 1;          ///< Winch down
+    static constexpr uint8_t FUNC3 = 2;         ///< Bow propeller port
+    static constexpr uint8_t FUNC4 = 3;         ///< Bow propeller starboard
+
+    /**
+     * @brief Record a raw level change of one input
+     * @param button Input index (UP, DOWN, FUNC3, FUNC4)
+     * @param pressed Raw level (true = pressed)
+     * @param t_ms Time of the edge
+     */
+    void onEdge(uint8_t button, bool pressed, unsigned long t_ms) {
+        buttons_[button].onEdge(pressed, t_ms);
+    }
+
+    /**
+     * @brief Advance all debouncers and the combined channel
+     * @param now_ms Current time
+     * @param emergency_stop_active Current emergency stop state
+     * @return Emergency stop transition to apply
+     */
+    RemoteGesture update(unsigned long now_ms, bool emergency_stop_active) {
+        bool any_pressed = false;
+        for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+            events_[i] = buttons_[i].update(now_ms);
+            any_pressed = any_pressed || buttons_[i].isPressed();
+        }
+
+        any_button_.onEdge(any_pressed, now_ms);
+        const uint8_t gestures = any_button_.update(now_ms);
+        if ((gestures & BUTTON_DOUBLE_PRESS) && !emergency_stop_active) {
+            return RemoteGesture::EMERGENCY_STOP;
+        }
+        if ((gestures & BUTTON_LONG_PRESS) && emergency_stop_active) {
+            return RemoteGesture::CLEAR_EMERGENCY_STOP;
+        }
+        return RemoteGesture::NONE;
+    }
+
+    /// @return Debounced state of one input (true = pressed)
+    bool isPressed(uint8_t button) const { return buttons_[button].isPressed(); }
+
+    /// @return ButtonEvent flags of one input from the last update()
+    uint8_t events(uint8_t button) const { return events_[button]; }
+
+    /**
+     * @brief Time until update() can produce an event without a new edge
+     * @param now_ms Current time
+     * @return Milliseconds to the earliest timed transition, or ButtonDebouncer::NO_DEADLINE
+     */
+    unsigned long nextDeadline(unsigned long now_ms) const {
+        unsigned long deadline = any_button_.nextDeadline(now_ms);
+        for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+            unsigned long button_deadline = buttons_[i].nextDeadline(now_ms);
+            if (button_deadline < deadline) deadline = button_deadline;
+        }
+        return deadline;
+    }
+
+private:
+    ButtonDebouncer buttons_[BUTTON_COUNT] = {
+        ButtonDebouncer(RemoteTiming::DEBOUNCE_MS, RemoteTiming::DOUBLE_PRESS_MS, RemoteTiming::LONG_PRESS_MS),
+        ButtonDebouncer(RemoteTiming::DEBOUNCE_MS, RemoteTiming::DOUBLE_PRESS_MS, RemoteTiming::LONG_PRESS_MS),
+        ButtonDebouncer(RemoteTiming::DEBOUNCE_MS, RemoteTiming::DOUBLE_PRESS_MS, RemoteTiming::LONG_PRESS_MS),
+        ButtonDebouncer(RemoteTiming::DEBOUNCE_MS, RemoteTiming::DOUBLE_PRESS_MS, RemoteTiming::LONG_PRESS_MS),
+    };  ///< Per-input debouncers (UP, DOWN, FUNC3, FUNC4)
+    ButtonDebouncer any_button_{0, RemoteTiming::DOUBLE_PRESS_MS, RemoteTiming::LONG_PRESS_MS};  ///< Combined debounced state
+    uint8_t events_[BUTTON_COUNT] = {};  ///< Per-input events of the last update()
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * @file RemoteTiming.h
+ * @brief Debounce and gesture timing of the physical remote
+ *
+ * Kept apart from RemoteControl (which needs SensESP) so host-side tests
+ * check the gestures with the timing the firmware uses.
+ */
+struct RemoteTiming {
+    static constexpr unsigned long DEBOUNCE_MS = 30;        ///< Button debounce window
+    static constexpr unsigned long DOUBLE_PRESS_MS = 800;   ///< Double-press gap for emergency stop
+    static constexpr unsigned long LONG_PRESS_MS = 2000;    ///< Long-press to clear emergency stop
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <math.h>
+
+/**
+ * @file ScopeTarget.h
+ * @brief Rode target from a scope ratio and a filtered depth stream
+ *
+ * The target is ratio x (depth + freeboard), where depth comes from a raw
+ * sounder stream that is filtered before it is used:
+ * - readings <= 0 (no bottom lock) are ignored
+ * - each reading is clamped to MAX_STEP_M around the filtered depth, so a
+ *   single spike (bubbles, a fish) moves it by at most that much
+ * - the clamped reading enters an exponential filter with time constant
+ *   TIME_CONSTANT_MS (time based, independent of the sample rate)
+ * The published target only moves when the filtered value differs from it
+ * by more than TARGET_DEADBAND_M, so depth noise does not change the
+ * target on every control tick.
+ *
+ * Single-threaded: fed and read on the control side.
+ */
+class ScopeTarget {
+public:
+    static constexpr unsigned long TIME_CONSTANT_MS = 10000;  ///< Depth filter time constant
+    static constexpr float MAX_STEP_M = 2.0f;                 ///< Largest deviation a reading may pull
+    static constexpr float TARGET_DEADBAND_M = 1.0f;          ///< Target change before it is republished
+
+    /**
+     * @brief Set the scope
+     * @param ratio Rode per depth (e.g. 5 for 5:1), <= 0 turns scope mode off
+     * @param freeboard_m Bow roller height above the water, added to the depth
+     */
+    void setScope(float ratio, float freeboard_m) {
+        ratio_ = ratio > 0.0f ? ratio : 0.0f;
+        freeboard_m_ = freeboard_m > 0.0f ? freeboard_m : 0.0f;
+        target_m_ = -1.0f;
+        updateTarget();
+    }
+
+    /// @return true while a scope ratio is set
+    bool isActive() const { return ratio_ > 0.0f; }
+
+    /// @return Scope ratio (0 = off)
+    float getRatio() const { return ratio_; }
+
+    /**
+     * @brief Add a depth reading
+     * @param depth_m Depth below the surface
+     * @param now_ms Reading time (millis())
+     */
+    void addDepth(float depth_m, unsigned long now_ms) {
+        if (!(depth_m > 0.0f)) {
+            return;
+        }
+        if (!has_depth_) {
+            depth_m_ = depth_m;
+            has_depth_ = true;
+        } else {
+            float reading = depth_m;
+            if (reading > depth_m_ + MAX_STEP_M) reading = depth_m_ + MAX_STEP_M;
+            if (reading < depth_m_ - MAX_STEP_M) reading = depth_m_ - MAX_STEP_M;
+            float dt_ms = static_cast<float>(now_ms - last_ms_);
+            depth_m_ += (reading - depth_m_) * dt_ms / (dt_ms + TIME_CONSTANT_MS);
+        }
+        last_ms_ = now_ms;
+        updateTarget();
+    }
+
+    /// @return true once a depth reading was filtered
+    bool hasDepth() const { return has_depth_; }
+
+    /// @return Filtered depth (m)
+    float getDepth() const { return depth_m_; }
+
+    /// @return Rode target (m), -1 without a ratio or a depth
+    float getTarget() const { return target_m_; }
+
+private:
+    float ratio_ = 0.0f;
+    float freeboard_m_ = 0.0f;
+    float depth_m_ = 0.0f;
+    bool has_depth_ = false;
+    unsigned long last_ms_ = 0;
+    float target_m_ = -1.0f;
+
+    void updateTarget() {
+        if (!isActive() || !has_depth_) {
+            target_m_ = -1.0f;
+            return;
+        }
+        float target = ratio_ * (depth_m_ + freeboard_m_);
+        if (target_m_ < 0.0f || fabsf(target - target_m_) > TARGET_DEADBAND_M) {
+            target_m_ = target;
+        }
+    }
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @file Seqlock.h
+ * @brief Single-writer sequence lock for handing a struct between tasks
+ *
+ * The writer makes the sequence odd, stores the payload, then makes it even
+ * again. A reader copies the payload between two sequence loads and retries
+ * if they differ or were odd, so it never returns a torn copy - however
+ * often the writer publishes. Neither side takes a lock or allocates.
+ *
+ * The payload is held as 32-bit atomic words (relaxed), so concurrent
+ * access is well defined; ordering comes from the sequence and fences.
+ *
+ * read() spins while a write is in progress: the writer must not be
+ * preempted by a reader on the same core (on the ESP32 the writer is the
+ * high-priority control task, readers run below it or on the other core).
+ *
+ * @tparam T Trivially copyable payload
+ */
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock payload must be trivially copyable");
+
+public:
+    Seqlock() { write(T()); }
+
+    /**
+     * @brief Publish a new value (single writer)
+     */
+    void write(const T& value) {
+        uint32_t words[WORDS] = {};
+        memcpy(words, &value, sizeof(T));
+
+        uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Try once to copy the published value (any reader)
+     * @return false if a write was in progress; out is then unspecified
+     */
+    bool tryRead(T& out) const {
+        uint32_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1U) {
+            return false;
+        }
+        uint32_t words[WORDS];
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Copy the published value, retrying until consistent (any reader)
+     */
+    T read() const {
+        T value;
+        while (!tryRead(value)) {
+        }
+        return value;
+    }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> words_[WORDS] = {};  ///< Payload storage
+    std::atomic<uint32_t> sequence_{0};        ///< Odd while a write is in progress
+};
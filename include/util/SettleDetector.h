@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file SettleDetector.h
+ * @brief Reports a counter once it has stopped changing
+ *
+ * The rode counter keeps moving after the winch stops (coast pulses), and
+ * it also moves with the winch off (chain paid out under load, manual
+ * freefall). A value is due once the winch is off and the count has not
+ * changed for the settle time; each settled value is due once, so a chain
+ * lying still for days reports nothing.
+ *
+ * Single-threaded: updated on the control side.
+ */
+class SettleDetector {
+public:
+    /**
+     * @param settle_ms Time without change (and with the winch off) before a value is due
+     */
+    explicit SettleDetector(uint32_t settle_ms) : settle_ms_(settle_ms) {}
+
+    /**
+     * @brief Account one pass
+     * @param count Current count
+     * @param winch_active Winch energised (the count is still driven)
+     * @param now_ms millis()
+     * @return true if count has settled at a value not reported before
+     */
+    bool update(int32_t count, bool winch_active, uint32_t now_ms) {
+        if (!started_ || count != count_ || winch_active) {
+            started_ = true;
+            count_ = count;
+            changed_ms_ = now_ms;
+            return false;
+        }
+        if ((reported_ && count == reported_count_) || now_ms - changed_ms_ < settle_ms_) {
+            return false;
+        }
+        reported_ = true;
+        reported_count_ = count;
+        return true;
+    }
+
+    /**
+     * @brief Mark a value as reported elsewhere (e.g. a counter reset)
+     */
+    void markReported(int32_t count) {
+        reported_ = true;
+        reported_count_ = count;
+    }
+
+private:
+    uint32_t settle_ms_;
+    uint32_t changed_ms_ = 0;     ///< Last change of the count (or pass with the winch on)
+    int32_t count_ = 0;           ///< Count of the previous pass
+    int32_t reported_count_ = 0;  ///< Last value reported
+    bool reported_ = false;
+    bool started_ = false;
+};
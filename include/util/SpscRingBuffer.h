@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file SpscRingBuffer.h
+ * @brief Fixed-size lock-free single-producer / single-consumer ring buffer
+ *
+ * Safe to push from an ISR and pop from the main loop (or another core):
+ * the producer only writes head_, the consumer only writes tail_.
+ * No allocation - storage is an in-object array sized at compile time.
+ *
+ * When full, push() drops the new item and counts it in dropped().
+ *
+ * @tparam T Element type (trivially copyable)
+ * @tparam N Capacity, must be a power of two
+ */
+template <typename T, size_t N>
+class SpscRingBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRingBuffer capacity must be a power of two");
+
+public:
+    /**
+     * @brief Append an item (producer side, ISR-safe)
+     * @return false if the buffer was full and the item was dropped
+     */
+    bool push(const T& item) {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        uint32_t tail = tail_.load(std::memory_order_acquire);
+        if (head - tail >= N) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        buffer_[head & (N - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest item (consumer side)
+     * @return false if the buffer was empty
+     */
+    bool pop(T& item) {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        uint32_t head = head_.load(std::memory_order_acquire);
+        if (tail == head) {
+            return false;
+        }
+        item = buffer_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @return Number of items currently queued
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    /// @return true if no items are queued
+    bool empty() const { return size() == 0; }
+
+    /// @return Number of items dropped because the buffer was full
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /// @return Compile-time capacity
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T buffer_[N] = {};                    ///< Element storage
+    std::atomic<uint32_t> head_{0};       ///< Next write index (producer owned)
+    std::atomic<uint32_t> tail_{0};       ///< Next read index (consumer owned)
+    std::atomic<uint32_t> dropped_{0};    ///< Overflow counter (producer owned)
+};
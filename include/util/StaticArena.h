@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+/**
+ * @file StaticArena.h
+ * @brief Fixed-size bump arena for long-lived objects created during setup
+ *
+ * Services, controllers and SensESP producers/consumers are created once at
+ * boot and never freed. With APP_USE_STATIC_ARENA=1 create() placement-news
+ * them into a statically sized buffer (BSS, not heap), so they do not
+ * fragment the heap before WiFi and TLS allocate. The size of each arena
+ * is computed at compile time with arenaBytes<T>().
+ *
+ * If an arena runs out (a miscounted size), create() falls back to the
+ * heap and counts the overflow in ArenaStats. With APP_USE_STATIC_ARENA=0
+ * create() is a plain new.
+ *
+ * Objects must never be deleted: the arena has no free().
+ */
+
+#ifndef APP_USE_STATIC_ARENA
+#define APP_USE_STATIC_ARENA 0
+#endif
+
+/// Totals over all arenas (reported on the status page)
+struct ArenaStats {
+    static inline size_t bytes_reserved = 0;  ///< Sum of arena capacities
+    static inline size_t bytes_used = 0;      ///< Bytes handed out
+    static inline uint32_t overflows = 0;     ///< create() calls that fell back to the heap
+};
+
+/**
+ * @brief Worst-case arena bytes for count objects of type T (incl. alignment)
+ */
+template <typename T>
+constexpr size_t arenaBytes(size_t count = 1) {
+    return count * (sizeof(T) + alignof(T) - 1);
+}
+
+/**
+ * @brief Bump arena over an in-object buffer
+ * @tparam N Capacity in bytes
+ */
+template <size_t N>
+class StaticArena {
+public:
+    StaticArena() {
+#if APP_USE_STATIC_ARENA
+        ArenaStats::bytes_reserved += N;
+#endif
+    }
+
+    /**
+     * @brief Construct a T in the arena (heap if disabled or full)
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+#if APP_USE_STATIC_ARENA
+        void* storage = allocate(sizeof(T), alignof(T));
+        if (storage) {
+            return new (storage) T(std::forward<Args>(args)...);
+        }
+        ArenaStats::overflows++;
+#endif
+        return new T(std::forward<Args>(args)...);
+    }
+
+    /// @return Bytes handed out so far
+    size_t used() const { return used_; }
+
+    /// @return Compile-time capacity in bytes
+    static constexpr size_t capacity() { return N; }
+
+private:
+    static constexpr size_t STORAGE_SIZE = APP_USE_STATIC_ARENA ? N : 1;
+
+    alignas(std::max_align_t) uint8_t buffer_[STORAGE_SIZE];  ///< Object storage
+    size_t used_ = 0;                                          ///< Bump offset
+
+    void* allocate(size_t size, size_t align) {
+        size_t offset = (used_ + align - 1) & ~(align - 1);
+        if (offset + size > STORAGE_SIZE) {
+            return nullptr;
+        }
+        ArenaStats::bytes_used += offset + size - used_;
+        used_ = offset + size;
+        return buffer_ + offset;
+    }
+};
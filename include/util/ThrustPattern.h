@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file ThrustPattern.h
+ * @brief Proportional setpoint as a low-frequency pulse-width pattern on an on/off actuator
+ *
+ * A thruster on contactors only knows full thrust or none. For fine
+ * docking a setpoint of -1..1 (sign = direction) is turned into a fixed
+ * period with an on-pulse of |setpoint| x period_ms at its start; the
+ * average thrust over a period follows the setpoint.
+ *
+ * Contactors and motors need a minimum pulse to pull in and spin up, and
+ * the relay sequencer enforces a minimum off time, so the on-time is
+ * quantised:
+ * - below half of min_pulse_ms: off
+ * - below min_pulse_ms: min_pulse_ms
+ * - with less than min_gap_ms left off: continuous
+ *
+ * Timing is the caller's: output() gives the direction due at a time,
+ * nextEdgeMs() when it changes next, so a one-shot hardware timer can run
+ * the pattern without polling. A new magnitude applies from the next
+ * period, so a running pulse is never cut short; a stop or a reversal
+ * applies at once and a start begins a period immediately.
+ *
+ * Pure logic (times passed in), not thread-safe: the caller serialises.
+ */
+
+/// Pulse-width pattern limits of one actuator
+struct ThrustPatternTiming {
+    uint32_t period_ms = 2000;    ///< Pattern period
+    uint32_t min_pulse_ms = 250;  ///< Shortest on-pulse
+    uint32_t min_gap_ms = 300;    ///< Shortest off-time (>= relay min off)
+};
+
+class ThrustPattern {
+public:
+    static constexpr uint32_t NO_EDGE = 0xFFFFFFFFUL;  ///< nextEdgeMs(): output constant
+
+    explicit ThrustPattern(const ThrustPatternTiming& timing = ThrustPatternTiming()) : timing_(timing) {}
+
+    /**
+     * @brief Command a setpoint
+     * @param setpoint -1..1 (+ = direction 1), clamped
+     * @param now_ms Current time
+     */
+    void set(float setpoint, uint32_t now_ms) {
+        if (setpoint > 1.0f) setpoint = 1.0f;
+        if (setpoint < -1.0f) setpoint = -1.0f;
+        const int8_t direction = setpoint > 0.0f ? 1 : (setpoint < 0.0f ? -1 : 0);
+        const uint32_t on_ms = quantise(setpoint < 0.0f ? -setpoint : setpoint);
+        setpoint_ = setpoint;
+        if (direction != direction_ || on_ms == 0 || on_ms_ == 0) {
+            // Start, stop or reversal: new period now
+            direction_ = on_ms > 0 ? direction : 0;
+            on_ms_ = on_ms;
+            pending_on_ms_ = on_ms;
+            period_start_ms_ = now_ms;
+            return;
+        }
+        pending_on_ms_ = on_ms;  // Same direction: from the next period
+    }
+
+    /**
+     * @brief Direction due at now_ms (advances the period)
+     * @return 1, -1, or 0 between pulses and when stopped
+     */
+    int8_t output(uint32_t now_ms) {
+        if (direction_ == 0) {
+            return 0;
+        }
+        uint32_t elapsed = now_ms - period_start_ms_;
+        if (elapsed >= timing_.period_ms) {
+            const uint32_t periods = elapsed / timing_.period_ms;
+            period_start_ms_ += periods * timing_.period_ms;
+            elapsed -= periods * timing_.period_ms;
+            on_ms_ = pending_on_ms_;
+        }
+        return elapsed < on_ms_ ? direction_ : 0;
+    }
+
+    /**
+     * @brief Time until output() changes
+     * @return Milliseconds from now_ms (call output(now_ms) first), or NO_EDGE
+     */
+    uint32_t nextEdgeMs(uint32_t now_ms) const {
+        if (direction_ == 0 || (on_ms_ >= timing_.period_ms && pending_on_ms_ >= timing_.period_ms)) {
+            return NO_EDGE;
+        }
+        const uint32_t elapsed = now_ms - period_start_ms_;
+        if (elapsed < on_ms_ && on_ms_ < timing_.period_ms) {
+            return on_ms_ - elapsed;  // End of the pulse
+        }
+        return timing_.period_ms - elapsed;  // Next period
+    }
+
+    /// @return Commanded setpoint (-1..1)
+    float setpoint() const { return setpoint_; }
+
+    /// @return Direction of the running pattern (0 = stopped or below the minimum pulse)
+    int8_t direction() const { return direction_; }
+
+    /// @return On-time per period of the current period
+    uint32_t onMs() const { return on_ms_; }
+
+    /// @return Pattern period
+    uint32_t periodMs() const { return timing_.period_ms; }
+
+private:
+    ThrustPatternTiming timing_;
+    float setpoint_ = 0.0f;
+    int8_t direction_ = 0;
+    uint32_t on_ms_ = 0;           ///< On-time of the current period
+    uint32_t pending_on_ms_ = 0;   ///< On-time from the next period
+    uint32_t period_start_ms_ = 0;
+
+    uint32_t quantise(float magnitude) const {
+        uint32_t on_ms = static_cast<uint32_t>(magnitude * timing_.period_ms + 0.5f);
+        if (on_ms * 2 < timing_.min_pulse_ms) {
+            return 0;
+        }
+        if (on_ms < timing_.min_pulse_ms) {
+            on_ms = timing_.min_pulse_ms;
+        }
+        if (on_ms + timing_.min_gap_ms > timing_.period_ms) {
+            on_ms = timing_.period_ms;
+        }
+        return on_ms;
+    }
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(ARDUINO)
+#include "freertos/FreeRTOS.h"
+#endif
+
+/**
+ * @file TraceBuffer.h
+ * @brief Fixed-size ring of compact binary trace records and their UDP frame
+ *
+ * A record is 16 bytes: microsecond timestamp, event kind, two small tags
+ * and two raw 32-bit values. record() costs a short critical section and a
+ * few stores, like EventLog, so the control path, the relay timer task and
+ * (on the ESP32) either core may record; one task pops.
+ *
+ * Unlike EventLog nothing is merged or overwritten: a trace replayed on the
+ * host needs every record in order, so when the ring is full new records
+ * are dropped and counted in dropped(). The counter travels in every frame,
+ * so the decoder knows where the trace has a gap.
+ *
+ * Frame layout, little endian (encodeTraceFrame()):
+ *
+ *   0  u16 magic "BT"   2  u8 version   3  u8 record count
+ *   4  u32 frame sequence               8  u32 records dropped in this capture
+ *   12 records, TRACE_RECORD_SIZE bytes each:
+ *      0 u32 timestamp (us)  4 u8 event  5 u8 tag  6 u16 arg  8 u32 a  12 u32 b
+ *
+ * tools/trace_decode.py decodes the frames; the meaning of tag, arg, a and
+ * b per event is listed with TraceEvent.
+ *
+ * @tparam N Capacity in records, must be a power of two
+ */
+
+constexpr uint16_t TRACE_FRAME_MAGIC = 0x5442;  ///< "BT"
+constexpr uint8_t TRACE_FRAME_VERSION = 1;
+constexpr size_t TRACE_FRAME_HEADER_SIZE = 12;
+constexpr size_t TRACE_RECORD_SIZE = 16;
+
+/// Traced events (values are the wire format: append only)
+enum class TraceEvent : uint8_t {
+    CAPTURE_START = 1,  ///< Capture armed; a: metres per pulse (float)
+    PULSE = 2,          ///< Pulse batch drained at its edge time; a: signed pulses (int32)
+    RELAY = 3,          ///< Relay pair output driven; tag: pin A, arg: RelayOutput (int8), a: pin B
+    COMMAND = 4,        ///< Command applied, at its arrival time; tag: ControlCommandType,
+                        ///< arg: CommandSource | channel << 8, a: value (float), b: queue delay (us)
+    AUTO_DECISION = 5,  ///< AutomaticModeController::update() step; tag: TraceDecision,
+                        ///< a: rode length (float), b: target (float)
+};
+
+/// Outcome of one automatic mode step (TraceEvent::AUTO_DECISION tag)
+enum class TraceDecision : uint8_t {
+    DEPLOY = 0,          ///< Below target: deploy
+    RETRIEVE = 1,        ///< Above target: retrieve
+    REACHED = 2,         ///< Within tolerance: stopped, disabled
+    COAST_STOP = 3,      ///< Within the predicted coast: stopped early, disabled
+    SCOPE_STOP = 4,      ///< Scope target moved below the rode: stopped, disabled
+    HOME_RETRIEVE = 5,   ///< Auto-home: retrieve until the home sensor
+    HOME_REACHED = 6,    ///< Auto-home: at home, holding
+};
+
+/// One binary trace record
+struct TraceRecord {
+    uint32_t timestamp_us = 0;  ///< Event time (micros())
+    uint8_t event = 0;          ///< TraceEvent
+    uint8_t tag = 0;            ///< Per-event tag
+    uint16_t arg = 0;           ///< Per-event argument
+    uint32_t a = 0;             ///< First value (raw bits)
+    uint32_t b = 0;             ///< Second value (raw bits)
+};
+static_assert(sizeof(TraceRecord) == TRACE_RECORD_SIZE, "TraceRecord must stay 16 bytes");
+
+template <size_t N>
+class TraceBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "TraceBuffer capacity must be a power of two");
+
+public:
+    /**
+     * @brief Append a record (any task, never waits beyond the critical section)
+     * @return false if the ring was full and the record was dropped
+     */
+    bool record(const TraceRecord& record) {
+        lock();
+        if (head_ - tail_ == N) {
+            dropped_++;
+            unlock();
+            return false;
+        }
+        records_[head_ & (N - 1)] = record;
+        head_++;
+        unlock();
+        return true;
+    }
+
+    /**
+     * @brief Remove up to max_count of the oldest records (single consumer)
+     * @return Records copied to out
+     */
+    size_t pop(TraceRecord* out, size_t max_count) {
+        lock();
+        size_t count = 0;
+        while (count < max_count && tail_ != head_) {
+            out[count++] = records_[tail_ & (N - 1)];
+            tail_++;
+        }
+        unlock();
+        return count;
+    }
+
+    /// Drop every unread record and reset the drop counter (capture restart)
+    void clear() {
+        lock();
+        tail_ = head_;
+        dropped_ = 0;
+        unlock();
+    }
+
+    /// @return Unread records
+    size_t size() const { return head_ - tail_; }
+
+    /// @return Records lost because the ring was full
+    uint32_t dropped() const { return dropped_; }
+
+    /// @return Compile-time capacity in records
+    static constexpr size_t capacity() { return N; }
+
+private:
+    TraceRecord records_[N];  ///< Ring storage
+    uint32_t head_ = 0;       ///< Next record to write
+    uint32_t tail_ = 0;       ///< Next record to read
+    uint32_t dropped_ = 0;    ///< Records lost to overflow
+
+#if defined(ARDUINO)
+    portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+    void lock() { portENTER_CRITICAL_SAFE(&lock_); }
+    void unlock() { portEXIT_CRITICAL_SAFE(&lock_); }
+#else
+    void lock() {}
+    void unlock() {}
+#endif
+};
+
+namespace trace_detail {
+    inline void putU16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+    inline void putU32(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; i++) p[i] = (v >> (8 * i)) & 0xFF;
+    }
+}
+
+/// @return Frame size for count records
+constexpr size_t traceFrameSize(size_t count) {
+    return TRACE_FRAME_HEADER_SIZE + count * TRACE_RECORD_SIZE;
+}
+
+/**
+ * @brief Serialise records into one frame
+ * @param out At least traceFrameSize(count) bytes
+ * @param count Records, at most 255
+ * @return Bytes written
+ */
+inline size_t encodeTraceFrame(uint32_t sequence, uint32_t dropped, const TraceRecord* records,
+                               size_t count, uint8_t* out) {
+    using namespace trace_detail;
+    if (count > 255) {
+        count = 255;
+    }
+    putU16(out, TRACE_FRAME_MAGIC);
+    out[2] = TRACE_FRAME_VERSION;
+    out[3] = static_cast<uint8_t>(count);
+    putU32(out + 4, sequence);
+    putU32(out + 8, dropped);
+    uint8_t* p = out + TRACE_FRAME_HEADER_SIZE;
+    for (size_t i = 0; i < count; i++, p += TRACE_RECORD_SIZE) {
+        const TraceRecord& record = records[i];
+        putU32(p, record.timestamp_us);
+        p[4] = record.event;
+        p[5] = record.tag;
+        putU16(p + 6, record.arg);
+        putU32(p + 8, record.a);
+        putU32(p + 12, record.b);
+    }
+    return traceFrameSize(count);
+}
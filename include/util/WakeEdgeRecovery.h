@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @file WakeEdgeRecovery.h
+ * @brief Restores the counted pulse edge that woke the CPU from light sleep
+ *
+ * The PCNT peripheral does not count while the CPU is in light sleep. An
+ * armed pulse input wakes the CPU on its next level change, and when that
+ * change is the counted (rising) edge the counter never sees it: chain
+ * creeping through the gypsy at anchor would lose every pulse.
+ *
+ * The wake ISR records the counted edge with its direction. The next poll
+ * adds it back unless the hardware count moved since the input was armed,
+ * which means the CPU was awake and counted the edge itself.
+ *
+ * arm() and take() run on the control side, wake() in the ISR.
+ */
+class WakeEdgeRecovery {
+public:
+    /**
+     * @brief The input is armed as a wake source
+     * @param total Hardware count before arming
+     */
+    void arm(long total) { armed_total_ = total; }
+
+    /**
+     * @brief The counted edge woke the CPU (ISR)
+     * @param sign +1 chain out, -1 chain in (direction level at the wake)
+     */
+    void wake(int8_t sign) { pending_.store(sign, std::memory_order_release); }
+
+    /**
+     * @brief Pulses to add to the hardware count (0 or ±1), once per wake
+     * @param total Hardware count now
+     */
+    long take(long total) {
+        const int8_t sign = pending_.exchange(0, std::memory_order_acquire);
+        return total == armed_total_ ? sign : 0;
+    }
+
+private:
+    long armed_total_ = 0;            ///< Hardware count when armed
+    std::atomic<int8_t> pending_{0};  ///< Sign of a lost edge, 0 if none
+};
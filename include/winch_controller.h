@@ -1,60 +1,76 @@
 #pragma once
 
-#include "interfaces/IMotor.h"
-#include "interfaces/ISensor.h"
+#include "hardware/HardwareTypes.h"
+#include "services/EventLogger.h"
 
 /**
  * @file winch_controller.h
  * @brief Manages anchor winch motor control with built-in safety checks
  * 
  * This class encapsulates all anchor winch control logic, including:
- * - Motor control via IMotor interface (abstracted hardware)
+ * - Motor control via an injected motor (abstracted hardware)
  * - Home sensor safety blocking (prevents over-retrieval of anchor chain)
  * 
  * DESIGN PRINCIPLE: Dependency Injection + Dependency Inversion
- * - Depends on IMotor and ISensor interfaces, not concrete GPIO implementations
- * - Allows testing with mock motors/sensors without hardware
+ * - Parameterised on the motor and sensor types, not concrete GPIO implementations
+ * - AnchorWinchController is the instantiation of this build (HardwareTypes.h):
+ *   the ESP32 drivers on the device (no virtual calls), IMotor / ISensor for
+ *   testing with mock motors/sensors without hardware
  * - Can be used with any motor/sensor implementation
  * 
- * SAFETY: Motor outputs use active-LOW logic. Pins default to HIGH (inactive)
- * on boot, ensuring the motor cannot start accidentally.
+ * SAFETY: Motor outputs default to inactive on boot (hardware profile active
+ * level), ensuring the motor cannot start accidentally.
  */
-class AnchorWinchController {
+template <typename Motor, typename Sensor>
+class BasicWinchController {
 public:
     /**
      * @brief Construct anchor winch controller with dependency injection
      * @param motor Reference to motor implementation (e.g., ESP32Motor)
      * @param home_sensor Reference to home sensor implementation (e.g., ESP32Sensor<PIN>)
      */
-    AnchorWinchController(IMotor& motor, ISensor& home_sensor)
+    BasicWinchController(Motor& motor, Sensor& home_sensor)
         : motor_(motor), home_sensor_(home_sensor) {}
 
     /**
      * @brief Move winch UP (retrieve chain)
      * @note Automatically blocks if anchor is already at home position
      */
-    void moveUp();
+    void moveUp() {
+        if (home_sensor_.isActive()) {
+            EventLogger::log(LogEvent::HOME_BLOCKS_UP);
+            stop();
+            return;
+        }
+        motor_.moveUp();
+    }
 
     /**
      * @brief Move winch DOWN (deploy chain)
      */
-    void moveDown();
+    void moveDown() { motor_.moveDown(); }
 
     /**
      * @brief Stop winch movement
      */
-    void stop();
+    void stop() { motor_.stop(); }
 
     /// @return true if motor is currently active
-    bool isActive() const;
+    bool isActive() const { return motor_.isActive(); }
 
     /// @return true if motor is currently moving up
-    bool isMovingUp() const;
+    bool isMovingUp() const { return motor_.isMovingUp(); }
 
     /// @return true if motor is currently moving down
-    bool isMovingDown() const;
+    bool isMovingDown() const { return motor_.isMovingDown(); }
 
 private:
-    IMotor& motor_;              ///< Motor control implementation
-    ISensor& home_sensor_;       ///< Home position sensor implementation
+    Motor& motor_;               ///< Motor control implementation
+    Sensor& home_sensor_;        ///< Home position sensor implementation
 };
+
+#if !HARDWARE_STATIC_DISPATCH
+extern template class BasicWinchController<IMotor, ISensor>;  // winch_controller.cpp
+#endif
+
+using AnchorWinchController = BasicWinchController<WinchMotor, HomeSensorInput>;
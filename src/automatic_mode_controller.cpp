@@ -1,5 +1,14 @@
 #include "automatic_mode_controller.h"
 #include "sensesp/system/local_debug.h"
+#include "services/EventLogger.h"
+#include "services/TraceRecorder.h"
+
+namespace {
+    void traceDecision(TraceDecision decision, float current_length, float target_length) {
+        TraceRecorder::record(TraceEvent::AUTO_DECISION, static_cast<uint8_t>(decision), 0,
+                              current_length, target_length);
+    }
+}
 
 using namespace sensesp;
 
@@ -18,29 +27,157 @@ void AutomaticModeController::setEnabled(bool enabled) {
     }
 }
 
+void AutomaticModeController::handOver(int8_t direction) {
+    if (!enabled_) {
+        return;
+    }
+    enabled_ = false;
+    if (!(direction > 0 && winch_.isMovingUp()) && !(direction < 0 && winch_.isMovingDown())) {
+        winch_.stop();
+    }
+}
+
 bool AutomaticModeController::isEnabled() const {
     return enabled_;
 }
 
 void AutomaticModeController::setTargetLength(float meters) {
     target_length_ = meters;
+    scope_.setScope(0.0f, freeboard_m_);
 }
 
 float AutomaticModeController::getTargetLength() const {
     return target_length_;
 }
 
+void AutomaticModeController::setScope(float ratio) {
+    scope_.setScope(ratio, freeboard_m_);
+    target_length_ = scope_.getTarget();
+}
+
+float AutomaticModeController::getScope() const {
+    return scope_.getRatio();
+}
+
+void AutomaticModeController::setFreeboard(float meters) {
+    freeboard_m_ = meters;
+    if (scope_.isActive()) {
+        setScope(scope_.getRatio());
+    }
+}
+
+void AutomaticModeController::setDepth(float depth_m, unsigned long now_ms) {
+    scope_.addDepth(depth_m, now_ms);
+    if (scope_.isActive() && !enabled_) {
+        target_length_ = scope_.getTarget();  // Armed target follows the depth until enabled
+    }
+}
+
 void AutomaticModeController::setTolerance(float meters) {
     tolerance_ = meters;
 }
 
+void AutomaticModeController::setStopPrediction(bool enabled) {
+    stop_prediction_ = enabled;
+}
+
+bool AutomaticModeController::isStopPredictionEnabled() const {
+    return stop_prediction_;
+}
+
+void AutomaticModeController::setCoastCoefficients(float coast_up_s, float coast_down_s) {
+    coast_up_s_ = coast_up_s;
+    coast_down_s_ = coast_down_s;
+}
+
+float AutomaticModeController::getCoastUp() const {
+    return coast_up_s_;
+}
+
+float AutomaticModeController::getCoastDown() const {
+    return coast_down_s_;
+}
+
+float AutomaticModeController::getChainSpeed() const {
+    return speed_;
+}
+
+void AutomaticModeController::onCoastLearned(CoastLearnedCallback callback) {
+    coast_learned_callback_ = callback;
+}
+
 bool AutomaticModeController::consumeTargetReached() {
     bool reached = target_reached_;
     target_reached_ = false;
     return reached;
 }
 
-void AutomaticModeController::update(float current_length) {
+void AutomaticModeController::trackSpeed(float current_length, unsigned long now_ms) {
+    if (last_update_ms_ != 0) {
+        unsigned long dt_ms = now_ms - last_update_ms_;
+        if (dt_ms < SPEED_WINDOW_MS) {
+            return;  // Too short to resolve pulse quantisation
+        }
+        float instant = (current_length - last_length_) * 1000.0f / dt_ms;
+        speed_ += 0.5f * (instant - speed_);  // Light smoothing
+    }
+    last_length_ = current_length;
+    last_update_ms_ = now_ms;
+}
+
+float AutomaticModeController::predictedCoast(bool deploying) const {
+    float coefficient = deploying ? coast_down_s_ : coast_up_s_;
+    return coefficient * fabs(speed_);
+}
+
+void AutomaticModeController::updateSettling(float current_length, unsigned long now_ms) {
+    if (current_length != settle_length_) {
+        settle_length_ = current_length;
+        settle_since_ms_ = now_ms;
+        return;
+    }
+    if (now_ms - settle_since_ms_ < SETTLE_TIME_MS) {
+        return;
+    }
+
+    // Chain has settled: residual past the cut point is the coast distance
+    settling_ = false;
+    float residual = settle_deploying_ ? current_length - cut_length_
+                                       : cut_length_ - current_length;
+    if (residual < 0.0f) {
+        residual = 0.0f;
+    }
+    float measured = residual / cut_speed_;
+    if (measured > MAX_COAST_S) {
+        measured = MAX_COAST_S;
+    }
+
+    float& coefficient = settle_deploying_ ? coast_down_s_ : coast_up_s_;
+    coefficient += LEARN_RATE * (measured - coefficient);
+    EventLogger::log(settle_deploying_ ? LogEvent::COAST_LEARNED_DOWN : LogEvent::COAST_LEARNED_UP,
+                     residual, coefficient);
+
+    if (coast_learned_callback_) {
+        coast_learned_callback_(coast_up_s_, coast_down_s_);
+    }
+}
+
+void AutomaticModeController::update(float current_length, unsigned long now_ms) {
+    trackSpeed(current_length, now_ms);
+
+    if (settling_) {
+        if (winch_.isActive()) {
+            // Something else drove the winch - measurement is void
+            settling_ = false;
+        } else {
+            updateSettling(current_length, now_ms);
+        }
+    }
+
+    if (enabled_ && scope_.isActive()) {
+        target_length_ = scope_.getTarget();
+    }
+
     if (!enabled_ || target_length_ < 0) {
         return;
     }
@@ -52,31 +189,54 @@ void AutomaticModeController::update(float current_length) {
         // Check home sensor directly - don't rely on pulse count
         if (home_sensor_.isHome()) {
             // At home - stop and don't try to move
+            traceDecision(TraceDecision::HOME_REACHED, current_length, target_length_);
             return;
         }
         // Only control direction - home sensor will stop the winch
+        traceDecision(TraceDecision::HOME_RETRIEVE, current_length, target_length_);
         if (!winch_.isMovingUp()) {
             winch_.moveUp();
         }
         return;
     }
 
+    // Predictive stop: cut early if the chain would coast onto the target
+    bool deploying = winch_.isMovingDown();
+    bool approaching = (deploying && error < 0) || (winch_.isMovingUp() && error > 0);
+    bool coast_reached = stop_prediction_ && approaching &&
+                         fabs(error) <= predictedCoast(deploying);
+    // Scope target moved below the rode (shallower): stop instead of reversing
+    bool scope_passed = scope_.isActive() && deploying && error > 0;
+
     // Normal distance-based control for non-zero targets
-    if (fabs(error) <= tolerance_) {
+    if (fabs(error) <= tolerance_ || coast_reached || scope_passed) {
         // Target reached
+        traceDecision(scope_passed ? TraceDecision::SCOPE_STOP
+                      : (fabs(error) <= tolerance_ ? TraceDecision::REACHED : TraceDecision::COAST_STOP),
+                      current_length, target_length_);
         if (winch_.isActive()) {
+            if (stop_prediction_ && fabs(speed_) >= MIN_LEARN_SPEED) {
+                settling_ = true;
+                settle_deploying_ = deploying;
+                cut_length_ = current_length;
+                cut_speed_ = fabs(speed_);
+                settle_length_ = current_length;
+                settle_since_ms_ = now_ms;
+            }
             winch_.stop();
         }
         enabled_ = false;
         target_reached_ = true;
-        debugD("Target %.2f m reached - automatic mode disabled", current_length);
+        EventLogger::log(LogEvent::AUTO_TARGET_REACHED, current_length);
     } else if (error < 0) {
         // Too short - need to deploy more
+        traceDecision(TraceDecision::DEPLOY, current_length, target_length_);
         if (!winch_.isMovingDown()) {
             winch_.moveDown();
         }
     } else {
         // Too long - need to retrieve
+        traceDecision(TraceDecision::RETRIEVE, current_length, target_length_);
         if (!winch_.isMovingUp()) {
             winch_.moveUp();
         }
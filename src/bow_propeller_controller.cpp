@@ -13,6 +13,18 @@ void BowPropellerController::stop() {
     motor_.stop();
 }
 
+void BowPropellerController::setThrust(float thrust) {
+    motor_.setThrust(thrust);
+}
+
+float BowPropellerController::getThrustSetpoint() const {
+    return motor_.getThrustSetpoint();
+}
+
+float BowPropellerController::getAchievedThrust(uint32_t now_ms) {
+    return motor_.getAchievedThrust(now_ms);
+}
+
 bool BowPropellerController::isActive() const {
     return motor_.isActive();
 }
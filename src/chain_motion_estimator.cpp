@@ -0,0 +1,58 @@
+#include "chain_motion_estimator.h"
+
+void ChainMotionEstimator::addEdge(const PulseEdge& edge, float meters_per_pulse) {
+    if (edge.pulses == 0) {
+        return;
+    }
+    int direction = edge.pulses > 0 ? 1 : -1;
+
+    if (has_edge_) {
+        uint32_t dt_us = edge.timestamp_us - last_edge_us_;
+        if (dt_us > 0 && dt_us < STOP_TIMEOUT_US && direction == last_direction_) {
+            float instant = edge.pulses * meters_per_pulse * 1e6f / dt_us;
+            float previous = speed_;
+            speed_ += SPEED_FILTER * (instant - speed_);
+            float instant_accel = (speed_ - previous) * 1e6f / dt_us;
+            acceleration_ += ACCEL_FILTER * (instant_accel - acceleration_);
+        } else {
+            // First edge after a stop or a reversal: no valid period yet
+            speed_ = 0.0f;
+            acceleration_ = 0.0f;
+        }
+    }
+
+    has_edge_ = true;
+    last_edge_us_ = edge.timestamp_us;
+    last_direction_ = direction;
+}
+
+void ChainMotionEstimator::update(uint32_t now_us, float meters_per_pulse, bool winch_active) {
+    if (winch_active && !was_active_) {
+        active_since_us_ = now_us;
+    }
+    was_active_ = winch_active;
+
+    uint32_t since_edge_us = has_edge_ ? now_us - last_edge_us_ : STOP_TIMEOUT_US;
+
+    if (since_edge_us >= STOP_TIMEOUT_US) {
+        speed_ = 0.0f;
+        acceleration_ = 0.0f;
+    } else if (since_edge_us > 0) {
+        // Without a new edge the chain cannot be faster than one pulse per elapsed time
+        float bound = meters_per_pulse * 1e6f / since_edge_us;
+        if (speed_ > bound) {
+            speed_ = bound;
+        } else if (speed_ < -bound) {
+            speed_ = -bound;
+        }
+    }
+
+    if (winch_active) {
+        uint32_t since_start_us = now_us - active_since_us_;
+        // No edge since boot: quiet since the start (since_edge_us is only a speed placeholder)
+        uint32_t quiet_us = has_edge_ && since_edge_us < since_start_us ? since_edge_us : since_start_us;
+        stalled_ = quiet_us >= STALL_TIMEOUT_US;
+    } else {
+        stalled_ = false;
+    }
+}
@@ -1,60 +1,186 @@
 #include "hardware/ESP32BowPropellerMotor.h"
 #include "sensesp/system/local_debug.h"
+#include "services/EventLogger.h"
+#include "services/OperationStatsService.h"
+#include "services/Supervisor.h"
 
 using namespace sensesp;
 
+namespace {
+uint32_t nowMs() {
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+
+RelayOutput toRelay(int8_t direction) {
+    // RelayOutput::A = port, B = starboard
+    return direction > 0 ? RelayOutput::B : (direction < 0 ? RelayOutput::A : RelayOutput::OFF);
+}
+
+constexpr bool kPwmDrive = PinConfig::BOW_DRIVE == BowThrusterDrive::PWM;
+constexpr uint32_t kPwmMaxDuty = (1UL << BowPropellerMotor::PWM_RESOLUTION_BITS) - 1;
+}  // namespace
+
 void BowPropellerMotor::initialize() {
-    pinMode(PinConfig::BOW_PORT, OUTPUT);
-    pinMode(PinConfig::BOW_STARBOARD, OUTPUT);
+    relays_.initialize();
+    relays_.setTripHandler(&BowPropellerMotor::onRelaysTripped, this);
+
+    if (kPwmDrive) {
+        ledcSetup(PWM_CHANNEL, PinConfig::BOW_PWM_FREQUENCY_HZ, PWM_RESOLUTION_BITS);
+        ledcAttachPin(PinConfig::BOW_PWM, PWM_CHANNEL);
+        ledcWrite(PWM_CHANNEL, 0);
+    } else if (!pattern_timer_) {
+        esp_timer_create_args_t args = {};
+        args.callback = &BowPropellerMotor::onPatternTimer;
+        args.arg = this;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "bow_pattern";
+        esp_timer_create(&args, &pattern_timer_);
+    }
     stop();
 }
 
 void BowPropellerMotor::turnPort() {
-    // Ensure starboard is off before turning port (prevent simultaneous activation)
-    digitalWrite(PinConfig::BOW_STARBOARD, HIGH);
-    digitalWrite(PinConfig::BOW_PORT, LOW);
-    active_ = true;
-    current_direction_ = Direction::PORT;
-    debugD("Bow propeller turning PORT");
+    // The relay pair opens starboard before port is closed (never both)
+    setThrust(-1.0f);
 }
 
 void BowPropellerMotor::turnStarboard() {
-    // Ensure port is off before turning starboard (prevent simultaneous activation)
-    digitalWrite(PinConfig::BOW_PORT, HIGH);
-    digitalWrite(PinConfig::BOW_STARBOARD, LOW);
-    active_ = true;
-    current_direction_ = Direction::STARBOARD;
-    debugD("Bow propeller turning STARBOARD");
+    // The relay pair opens port before starboard is closed (never both)
+    setThrust(1.0f);
 }
 
 void BowPropellerMotor::stop() {
-    digitalWrite(PinConfig::BOW_PORT, HIGH);
-    digitalWrite(PinConfig::BOW_STARBOARD, HIGH);
-    active_ = false;
-    current_direction_ = Direction::STOPPED;
-    logStopThrottled();
+    setThrust(0.0f);
+}
+
+void BowPropellerMotor::setThrust(float thrust) {
+    portENTER_CRITICAL(&lock_);
+    const uint32_t now_ms = nowMs();
+    pattern_.set(thrust, now_ms);
+    if (kPwmDrive) {
+        relays_.request(toRelay(pattern_.direction()));
+        if (relays_.isThermalLockout()) {
+            pattern_.set(0.0f, now_ms);  // Start refused or tripped: the command is dropped
+        }
+    } else {
+        applyPattern(now_ms);
+    }
+    const int8_t direction = pattern_.direction();
+    const float magnitude = direction != 0 ? (pattern_.setpoint() < 0.0f ? -pattern_.setpoint() : pattern_.setpoint()) : 0.0f;
+    portEXIT_CRITICAL(&lock_);
+    if (kPwmDrive) {
+        // LEDC driver calls stay outside the spinlock
+        ledcWrite(PWM_CHANNEL, static_cast<uint32_t>(magnitude * kPwmMaxDuty + 0.5f));
+    }
+
+    // Log and count direction changes, not every proportional update
+    if (direction != logged_direction_) {
+        logged_direction_ = direction;
+        if (direction < 0) {
+            EventLogger::log(LogEvent::BOW_PORT);
+        } else if (direction > 0) {
+            EventLogger::log(LogEvent::BOW_STARBOARD);
+        }
+        OperationStatsService::motion(OperationMotor::BOW, direction);
+    }
+    if (direction == 0) {
+        logStopThrottled();
+    }
+}
+
+float BowPropellerMotor::getThrustSetpoint() const {
+    portENTER_CRITICAL(&lock_);
+    const float setpoint = pattern_.direction() != 0 ? pattern_.setpoint() : 0.0f;
+    portEXIT_CRITICAL(&lock_);
+    return setpoint;
+}
+
+float BowPropellerMotor::getAchievedThrust(uint32_t now_ms) {
+    const uint32_t elapsed_ms = now_ms - window_start_ms_;
+    if (elapsed_ms < ACHIEVED_WINDOW_MS) {
+        return achieved_;
+    }
+    uint32_t a_ms = 0;
+    uint32_t b_ms = 0;
+    relays_.onTime(a_ms, b_ms);
+    float average = (static_cast<float>(b_ms - window_b_ms_) - static_cast<float>(a_ms - window_a_ms_)) /
+                    static_cast<float>(elapsed_ms);
+    if (kPwmDrive) {
+        average *= static_cast<float>(ledcRead(PWM_CHANNEL)) / kPwmMaxDuty;
+    }
+    achieved_ = average > 1.0f ? 1.0f : (average < -1.0f ? -1.0f : average);
+    window_start_ms_ = now_ms;
+    window_a_ms_ = a_ms;
+    window_b_ms_ = b_ms;
+    return achieved_;
+}
+
+void BowPropellerMotor::applyPattern(uint32_t now_ms) {
+    relays_.request(toRelay(pattern_.output(now_ms)));
+    if (pattern_.direction() != 0 && relays_.isThermalLockout()) {
+        // Out of budget (start refused or tripped by this pulse): the pattern ends
+        pattern_.set(0.0f, now_ms);
+    }
+    esp_timer_stop(pattern_timer_);
+    const uint32_t next_ms = pattern_.nextEdgeMs(now_ms);
+    if (next_ms != ThrustPattern::NO_EDGE) {
+        esp_timer_start_once(pattern_timer_, static_cast<uint64_t>(next_ms) * 1000ULL);
+    }
+}
+
+void BowPropellerMotor::onPatternTimer(void* arg) {
+    auto* self = static_cast<BowPropellerMotor*>(arg);
+    portENTER_CRITICAL(&self->lock_);
+    const uint32_t now_ms = nowMs();
+    if (Supervisor::isTripPending()) {
+        // Relays cut: the pattern ends, the control side logs the stop
+        self->pattern_.set(0.0f, now_ms);
+    }
+    self->applyPattern(now_ms);
+    portEXIT_CRITICAL(&self->lock_);
+}
+
+void BowPropellerMotor::onRelaysTripped(void* arg) {
+    auto* self = static_cast<BowPropellerMotor*>(arg);
+    portENTER_CRITICAL(&self->lock_);
+    self->pattern_.set(0.0f, nowMs());
+    if (!kPwmDrive) {
+        self->applyPattern(nowMs());  // Relays already off; stops the pattern timer
+    }
+    portEXIT_CRITICAL(&self->lock_);
+    if (kPwmDrive) {
+        ledcWrite(PWM_CHANNEL, 0);
+    }
 }
 
 bool BowPropellerMotor::isActive() const {
-    return active_;
+    return getCurrentDirection() != Direction::STOPPED;
 }
 
 BowPropellerMotor::Direction BowPropellerMotor::getCurrentDirection() const {
-    return current_direction_;
+    // The pattern direction: between pulses the thruster still counts as running.
+    // A thermal trip or relay cut clears the pattern, so it never outlives the relays.
+    portENTER_CRITICAL(&lock_);
+    const int8_t direction = pattern_.direction();
+    portEXIT_CRITICAL(&lock_);
+    if (direction == 0) {
+        return Direction::STOPPED;
+    }
+    return direction < 0 ? Direction::PORT : Direction::STARBOARD;
 }
 
 bool BowPropellerMotor::isTurningPort() const {
-    return active_ && digitalRead(PinConfig::BOW_PORT) == LOW;
+    return getCurrentDirection() == Direction::PORT;
 }
 
 bool BowPropellerMotor::isTurningStarboard() const {
-    return active_ && digitalRead(PinConfig::BOW_STARBOARD) == LOW;
+    return getCurrentDirection() == Direction::STARBOARD;
 }
 
 void BowPropellerMotor::logStopThrottled() {
     const unsigned long now_ms = millis();
     if (now_ms - last_stop_log_ms_ >= 5000UL) {
-        debugD("Bow propeller stopped");
+        EventLogger::log(LogEvent::BOW_STOP);
         last_stop_log_ms_ = now_ms;
     }
 }
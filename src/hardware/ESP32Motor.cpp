@@ -1,58 +1,60 @@
 #include "hardware/ESP32Motor.h"
 #include "sensesp/system/local_debug.h"
+#include "services/EventLogger.h"
+#include "services/OperationStatsService.h"
 
 using namespace sensesp;
 
 void ESP32Motor::initialize() {
-    pinMode(PinConfig::WINCH_UP, OUTPUT);
-    pinMode(PinConfig::WINCH_DOWN, OUTPUT);
+    relays_.initialize();
     stop();
 }
 
 void ESP32Motor::moveUp() {
-    digitalWrite(PinConfig::WINCH_DOWN, HIGH);
-    digitalWrite(PinConfig::WINCH_UP, LOW);
-    active_ = true;
-    current_direction_ = Direction::UP;
-    debugD("Motor UP activated");
+    relays_.request(RelayOutput::A);
+    EventLogger::log(LogEvent::MOTOR_UP);
+    OperationStatsService::motion(stats_, 1);
 }
 
 void ESP32Motor::moveDown() {
-    digitalWrite(PinConfig::WINCH_UP, HIGH);
-    digitalWrite(PinConfig::WINCH_DOWN, LOW);
-    active_ = true;
-    current_direction_ = Direction::DOWN;
-    debugD("Motor DOWN activated");
+    relays_.request(RelayOutput::B);
+    EventLogger::log(LogEvent::MOTOR_DOWN);
+    OperationStatsService::motion(stats_, -1);
 }
 
 void ESP32Motor::stop() {
-    digitalWrite(PinConfig::WINCH_UP, HIGH);
-    digitalWrite(PinConfig::WINCH_DOWN, HIGH);
-    active_ = false;
-    current_direction_ = Direction::STOPPED;
+    relays_.request(RelayOutput::OFF);
+    OperationStatsService::motion(stats_, 0);
     logStopThrottled();
 }
 
 bool ESP32Motor::isActive() const {
-    return active_;
+    return relays_.commanded() != RelayOutput::OFF;
 }
 
 IMotor::Direction ESP32Motor::getCurrentDirection() const {
-    return current_direction_;
+    switch (relays_.commanded()) {
+        case RelayOutput::A:
+            return Direction::UP;
+        case RelayOutput::B:
+            return Direction::DOWN;
+        default:
+            return Direction::STOPPED;
+    }
 }
 
 bool ESP32Motor::isMovingUp() const {
-    return active_ && digitalRead(PinConfig::WINCH_UP) == LOW;
+    return relays_.commanded() == RelayOutput::A;
 }
 
 bool ESP32Motor::isMovingDown() const {
-    return active_ && digitalRead(PinConfig::WINCH_DOWN) == LOW;
+    return relays_.commanded() == RelayOutput::B;
 }
 
 void ESP32Motor::logStopThrottled() {
     const unsigned long now_ms = millis();
     if (now_ms - last_stop_log_ms_ >= 5000UL) {
-        debugD("Motor stopped");
+        EventLogger::log(LogEvent::MOTOR_STOP);
         last_stop_log_ms_ = now_ms;
     }
 }
@@ -0,0 +1,83 @@
+#include "hardware/ESP32PulseCounter.h"
+
+#if PULSE_COUNTER_USE_PCNT
+
+#include <Arduino.h>
+#include "hardware/GpioSnapshot.h"
+#include "sensesp/system/local_debug.h"
+#include "services/PerfMonitor.h"
+
+using namespace sensesp;
+
+void ESP32PulseCounter::initialize() {
+    pinMode(pulse_pin_, INPUT_PULLUP);
+    pinMode(direction_pin_, INPUT_PULLUP);
+
+    pcnt_config_t config = {};
+    config.pulse_gpio_num = pulse_pin_;
+    config.ctrl_gpio_num = direction_pin_;
+    config.unit = unit_;
+    config.channel = PCNT_CHANNEL_0;
+    config.pos_mode = PCNT_COUNT_INC;     // Count on rising edge
+    config.neg_mode = PCNT_COUNT_DIS;     // Ignore falling edge
+    // Chain out counts up, chain in counts down (direction polarity of the profile)
+    config.hctrl_mode = PinConfig::DIRECTION_OUT_HIGH ? PCNT_MODE_KEEP : PCNT_MODE_REVERSE;
+    config.lctrl_mode = PinConfig::DIRECTION_OUT_HIGH ? PCNT_MODE_REVERSE : PCNT_MODE_KEEP;
+    config.counter_h_lim = COUNTER_LIMIT;
+    config.counter_l_lim = -COUNTER_LIMIT;
+    pcnt_unit_config(&config);
+
+    pcnt_set_filter_value(unit_, GLITCH_FILTER_CYCLES);
+    pcnt_filter_enable(unit_);
+
+    pcnt_event_enable(unit_, PCNT_EVT_H_LIM);
+    pcnt_event_enable(unit_, PCNT_EVT_L_LIM);
+
+    pcnt_counter_pause(unit_);
+    pcnt_counter_clear(unit_);
+    overflow_ = 0;
+    last_total_ = 0;
+
+    pcnt_isr_service_install(0);  // Shared by all units: a second install is a no-op
+    pcnt_isr_handler_add(unit_, overflowISR, this);
+    pcnt_counter_resume(unit_);
+
+    debugD("PCNT unit %d pulse counter on GPIO %d (direction GPIO %d), filter %u cycles",
+           (int)unit_, pulse_pin_, direction_pin_, GLITCH_FILTER_CYCLES);
+}
+
+void IRAM_ATTR ESP32PulseCounter::overflowISR(void* arg) {
+    PerfSpan span(PerfProbe::PULSE_ISR);
+    auto* self = static_cast<ESP32PulseCounter*>(arg);
+    uint32_t status = 0;
+    pcnt_get_event_status(self->unit_, &status);
+    if (status & PCNT_EVT_H_LIM) {
+        self->overflow_ += COUNTER_LIMIT;
+    } else if (status & PCNT_EVT_L_LIM) {
+        self->overflow_ -= COUNTER_LIMIT;
+    }
+}
+
+long ESP32PulseCounter::readTotal() const {
+    // Re-read if the overflow ISR fired between the two reads
+    long overflow;
+    int16_t count = 0;
+    do {
+        overflow = overflow_;
+        pcnt_get_counter_value(unit_, &count);
+    } while (overflow != overflow_);
+    return overflow + count;
+}
+
+void IRAM_ATTR ESP32PulseCounter::wakeEdgeFromIsr() {
+    wake_recovery_.wake(GpioSnapshot::readPin(direction_pin_) == PinConfig::DIRECTION_OUT_HIGH ? 1 : -1);
+}
+
+long ESP32PulseCounter::takeDelta() {
+    long total = readTotal();
+    long delta = total - last_total_ + wake_recovery_.take(total);
+    last_total_ = total;
+    return delta;
+}
+
+#endif  // PULSE_COUNTER_USE_PCNT
@@ -0,0 +1,146 @@
+#include "hardware/ESP32RelayPair.h"
+#include <Arduino.h>
+#include "pin_config.h"
+#include "services/EventLogger.h"
+#include "services/PerfMonitor.h"
+#include "services/TraceRecorder.h"
+#include "soc/gpio_struct.h"
+
+namespace {
+uint32_t nowMs() {
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+
+// Active level of the profile: energise / de-energise a set of relay pins
+inline void relayOn(uint32_t mask) {
+    if (PinConfig::RELAY_ACTIVE_LOW) GPIO.out_w1tc = mask; else GPIO.out_w1ts = mask;
+}
+
+inline void relayOff(uint32_t mask) {
+    if (PinConfig::RELAY_ACTIVE_LOW) GPIO.out_w1ts = mask; else GPIO.out_w1tc = mask;
+}
+}  // namespace
+
+ESP32RelayPair::ESP32RelayPair(uint8_t pin_a, uint8_t pin_b, const RelayTiming& timing, const char* name,
+                               bool command_probes)
+    : pin_a_(pin_a), pin_b_(pin_b), mask_a_(1UL << pin_a), mask_b_(1UL << pin_b),
+      name_(name), command_probes_(command_probes), sequencer_(timing) {}
+
+void ESP32RelayPair::initialize() {
+    relayOff(mask_a_ | mask_b_);  // Output latch inactive before the pins are driven
+    pinMode(pin_a_, OUTPUT);
+    pinMode(pin_b_, OUTPUT);
+    driven_ = RelayOutput::OFF;
+
+#if RELAY_USE_SEQUENCER
+    if (!timer_) {
+        esp_timer_create_args_t args = {};
+        args.callback = &ESP32RelayPair::onTimer;
+        args.arg = this;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = name_;
+        esp_timer_create(&args, &timer_);
+    }
+#endif
+}
+
+RelayOutput ESP32RelayPair::request(RelayOutput output) {
+#if RELAY_USE_SEQUENCER
+    portENTER_CRITICAL(&lock_);
+    uint32_t now_ms = nowMs();
+    drive(sequencer_.request(output, now_ms));
+    armTimer(now_ms);
+    RelayOutput driven = driven_;
+    portEXIT_CRITICAL(&lock_);
+    return driven;
+#else
+    drive(output);
+    return output;
+#endif
+}
+
+RelayOutput ESP32RelayPair::commanded() const {
+#if RELAY_USE_SEQUENCER
+    portENTER_CRITICAL(&lock_);
+    RelayOutput requested = sequencer_.requested();
+    portEXIT_CRITICAL(&lock_);
+    return requested;
+#else
+    return driven_;
+#endif
+}
+
+RelayOutput ESP32RelayPair::output() const {
+    return driven_;
+}
+
+bool ESP32RelayPair::isThermalLockout() const {
+    portENTER_CRITICAL(&lock_);
+    bool lockout = sequencer_.isThermalLockout();
+    portEXIT_CRITICAL(&lock_);
+    return lockout;
+}
+
+uint32_t ESP32RelayPair::getThermalTrips() const {
+    portENTER_CRITICAL(&lock_);
+    uint32_t trips = sequencer_.getThermalTrips();
+    portEXIT_CRITICAL(&lock_);
+    return trips;
+}
+
+void ESP32RelayPair::onTime(uint32_t& a_ms, uint32_t& b_ms) const {
+    portENTER_CRITICAL(&lock_);
+    const uint32_t running_ms = nowMs() - driven_since_ms_;
+    a_ms = on_a_ms_ + (driven_ == RelayOutput::A ? running_ms : 0);
+    b_ms = on_b_ms_ + (driven_ == RelayOutput::B ? running_ms : 0);
+    portEXIT_CRITICAL(&lock_);
+}
+
+void ESP32RelayPair::drive(RelayOutput output) {
+    // Written every time (not only on change): the home ISR may have cut
+    // WINCH_UP behind our back. Open the active relay before closing the other.
+    relayOff((output != RelayOutput::A ? mask_a_ : 0) | (output != RelayOutput::B ? mask_b_ : 0));
+    if (output == RelayOutput::A) relayOn(mask_a_);
+    if (output == RelayOutput::B) relayOn(mask_b_);
+    if (output != driven_) {
+        const uint32_t now_ms = nowMs();
+        if (driven_ == RelayOutput::A) on_a_ms_ += now_ms - driven_since_ms_;
+        if (driven_ == RelayOutput::B) on_b_ms_ += now_ms - driven_since_ms_;
+        driven_since_ms_ = now_ms;
+        TraceRecorder::record(TraceEvent::RELAY, pin_a_, static_cast<uint16_t>(static_cast<int8_t>(output)),
+                              pin_b_);
+        if (command_probes_ && output != RelayOutput::OFF) {
+            PerfMonitor::endArmed(PerfProbe::COMMAND_TO_RELAY);
+            PerfMonitor::endArmed(PerfProbe::DIRECT_COMMAND_TO_RELAY);
+        }
+    }
+    driven_ = output;
+}
+
+void ESP32RelayPair::armTimer(uint32_t now_ms) {
+    if (!timer_) {
+        return;
+    }
+    esp_timer_stop(timer_);  // Not running is fine
+    uint32_t next_ms = sequencer_.nextEventMs(now_ms);
+    if (next_ms != RelaySequencer::NO_EVENT) {
+        esp_timer_start_once(timer_, static_cast<uint64_t>(next_ms) * 1000ULL + 500ULL);
+    }
+}
+
+void ESP32RelayPair::onTimer(void* arg) {
+    auto* self = static_cast<ESP32RelayPair*>(arg);
+    portENTER_CRITICAL(&self->lock_);
+    uint32_t now_ms = nowMs();
+    uint32_t trips = self->sequencer_.getThermalTrips();
+    self->drive(self->sequencer_.update(now_ms));
+    self->armTimer(now_ms);
+    bool tripped = self->sequencer_.getThermalTrips() != trips;
+    portEXIT_CRITICAL(&self->lock_);
+    if (tripped) {
+        EventLogger::log(LogEvent::RELAY_THERMAL_TRIP, self->pin_a_);
+        if (self->trip_handler_) {
+            self->trip_handler_(self->trip_context_);
+        }
+    }
+}
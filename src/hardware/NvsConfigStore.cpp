@@ -0,0 +1,24 @@
+#include "hardware/NvsConfigStore.h"
+
+namespace {
+    constexpr const char* RECORD_KEY = "runtime";
+}
+
+bool NvsConfigStore::initialize() {
+    ready_ = preferences_.begin("config", false);
+    return ready_;
+}
+
+bool NvsConfigStore::read(RuntimeConfig& config) {
+    if (!ready_) {
+        return false;
+    }
+    return preferences_.getBytes(RECORD_KEY, &config, sizeof(config)) == sizeof(config);
+}
+
+bool NvsConfigStore::write(const RuntimeConfig& config) {
+    if (!ready_) {
+        return false;
+    }
+    return preferences_.putBytes(RECORD_KEY, &config, sizeof(config)) == sizeof(config);
+}
@@ -0,0 +1,31 @@
+#include "hardware/NvsRodeStore.h"
+
+bool NvsRodeStore::initialize() {
+    ready_ = preferences_.begin("rode", false);
+    return ready_;
+}
+
+void NvsRodeStore::slotKey(size_t slot, char (&key)[4]) {
+    key[0] = 's';
+    key[1] = static_cast<char>('0' + slot % 10);
+    key[2] = '\0';
+    key[3] = '\0';
+}
+
+bool NvsRodeStore::readSlot(size_t slot, RodeRecord& record) {
+    if (!ready_) {
+        return false;
+    }
+    char key[4];
+    slotKey(slot, key);
+    return preferences_.getBytes(key, &record, sizeof(record)) == sizeof(record);
+}
+
+bool NvsRodeStore::writeSlot(size_t slot, const RodeRecord& record) {
+    if (!ready_) {
+        return false;
+    }
+    char key[4];
+    slotKey(slot, key);
+    return preferences_.putBytes(key, &record, sizeof(record)) == sizeof(record);
+}
@@ -0,0 +1,24 @@
+#include "hardware/NvsStatsStore.h"
+
+namespace {
+    constexpr const char* RECORD_KEY = "lifetime";
+}
+
+bool NvsStatsStore::initialize() {
+    ready_ = preferences_.begin("stats", false);
+    return ready_;
+}
+
+bool NvsStatsStore::read(OperationStatsRecord& record) {
+    if (!ready_) {
+        return false;
+    }
+    return preferences_.getBytes(RECORD_KEY, &record, sizeof(record)) == sizeof(record);
+}
+
+bool NvsStatsStore::write(const OperationStatsRecord& record) {
+    if (!ready_) {
+        return false;
+    }
+    return preferences_.putBytes(RECORD_KEY, &record, sizeof(record)) == sizeof(record);
+}
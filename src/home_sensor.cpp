@@ -1,13 +1,6 @@
 #include "home_sensor.h"
 
-bool HomeSensor::isHome() const {
-    return sensor_.isActive();
-}
-
-bool HomeSensor::justArrived() {
-    return sensor_.justActivated();
-}
-
-bool HomeSensor::justLeft() {
-    return sensor_.justDeactivated();
-}
+// Interface instantiation shared by the native tests, benchmarks and simulator
+#if !HARDWARE_STATIC_DISPATCH
+template class BasicHomeSensor<ISensor>;
+#endif
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <memory>
 #include <ArduinoJson.h>
 #include <SPIFFS.h>
@@ -5,8 +6,15 @@
 #include "sensesp/signalk/signalk_output.h"
 #include "sensesp/ui/config_item.h"
 #include "sensesp/ui/ui_controls.h"
+#include "sensesp/ui/status_page_item.h"
 
 #include "services/BoatBowControlApp.h"
+#include "services/BootMetrics.h"
+#include "services/ConfigBlob.h"
+#include "hardware/NvsConfigStore.h"
+#include "services/SignalKService.h"
+#include "services/DirectCommandService.h"
+#include "util/StaticArena.h"
 #include "secrets.h"
 
 #ifndef AP_PASSWORD
@@ -20,11 +28,34 @@
 using namespace sensesp;
 
 // ========================================
-// Configuration Variables (persisted in SPIFFS)
+// Configuration Variables
+// Runtime values come from one binary record in NVS (ConfigBlob), read once
+// at boot. The SensESP NumberConfig JSON files in SPIFFS are only the web UI
+// view of the same variables; edits there are written back to the record.
 // ========================================
 float g_config_meters_per_pulse = 0.01f;  // Default: 1cm per pulse
 String g_config_path_meters_per_pulse = "/Calibration/MetersPerPulse";
 
+// Learned windlass coast coefficients (seconds of coast per m/s of chain speed)
+float g_config_coast_up_s = 0.0f;
+String g_config_path_coast_up = "/Calibration/CoastUp";
+float g_config_coast_down_s = 0.0f;
+String g_config_path_coast_down = "/Calibration/CoastDown";
+std::atomic<bool> g_coast_save_pending{false};  // Set on the control side, saved by the event loop
+
+// Minimum rode length change (meters) that triggers a SignalK update
+float g_config_rode_deadband = 0.05f;
+String g_config_path_rode_deadband = "/SignalK/RodeDeadband";
+
+// Bow roller height above the water, added to the depth in scope mode
+float g_config_freeboard = 1.0f;
+String g_config_path_freeboard = "/Anchor/Freeboard";
+
+// Binary runtime configuration record
+NvsConfigStore g_config_store;
+ConfigBlob g_config_blob(g_config_store);
+uint16_t g_config_flags = 0;  // RuntimeConfigFlag bits
+
 namespace {
     bool findConfigFile(const String& config_path, String& filename) {
         const String hash_path = String("/") + Base64Sha1(config_path);
@@ -95,6 +126,72 @@ namespace {
         serializeJson(doc, out);
         out.close();
     }
+
+    void onCoastLearned(float coast_up_s, float coast_down_s) {
+        g_config_coast_up_s = coast_up_s;
+        g_config_coast_down_s = coast_down_s;
+        // Called from the control side: flag it, the event loop persists it
+        // (flash writes stall the CPU and the event loop is not thread-safe)
+        g_coast_save_pending.store(true, std::memory_order_release);
+    }
+
+    // Heap at the start of setup(), before SensESP, WiFi and the app allocate
+    uint32_t g_boot_free_heap = 0;
+    uint32_t g_boot_max_alloc = 0;
+
+    void reportBootHeap() {
+        const uint32_t free_heap = ESP.getFreeHeap();
+        const uint32_t max_alloc = ESP.getMaxAllocHeap();
+        const uint32_t min_free = ESP.getMinFreeHeap();
+        debugD("Heap before boot: free %lu, largest block %lu",
+               (unsigned long)g_boot_free_heap, (unsigned long)g_boot_max_alloc);
+        debugD("Heap after boot: free %lu, largest block %lu, low-water %lu",
+               (unsigned long)free_heap, (unsigned long)max_alloc, (unsigned long)min_free);
+        debugD("Static arenas: %lu of %lu bytes used, %lu heap fallbacks",
+               (unsigned long)ArenaStats::bytes_used, (unsigned long)ArenaStats::bytes_reserved,
+               (unsigned long)ArenaStats::overflows);
+
+        new StatusPageItem<int>("Free heap before boot", g_boot_free_heap, "Memory", 1100);
+        new StatusPageItem<int>("Free heap after boot", free_heap, "Memory", 1101);
+        new StatusPageItem<int>("Largest free block after boot", max_alloc, "Memory", 1102);
+        new StatusPageItem<int>("Heap low-water mark", min_free, "Memory", 1103);
+        new StatusPageItem<int>("Static arena bytes", ArenaStats::bytes_used, "Memory", 1104);
+    }
+
+    // Staged startup timing (SignalK ready is published on first connection)
+    void reportBootTiming() {
+        const uint32_t safe_ms = BootMetrics::ms(BootMetrics::Stage::SAFE_OUTPUTS);
+        const uint32_t control_ms = BootMetrics::ms(BootMetrics::Stage::FIRST_CONTROL);
+        const uint32_t network_ms = BootMetrics::ms(BootMetrics::Stage::NETWORK_STARTED);
+        debugD("Boot: outputs safe %lu ms, first control %lu ms, network started %lu ms",
+               (unsigned long)safe_ms, (unsigned long)control_ms, (unsigned long)network_ms);
+
+        new StatusPageItem<int>("Outputs safe (ms after reset)", safe_ms, "Boot", 1200);
+        new StatusPageItem<int>("First control step (ms after reset)", control_ms, "Boot", 1201);
+        new StatusPageItem<int>("Network started (ms after reset)", network_ms, "Boot", 1202);
+    }
+
+    void applyRuntimeConfig(const RuntimeConfig& config) {
+        g_config_meters_per_pulse = config.meters_per_pulse;
+        g_config_coast_up_s = config.coast_up_s;
+        g_config_coast_down_s = config.coast_down_s;
+        g_config_rode_deadband = config.rode_deadband;
+        g_config_freeboard = config.freeboard_m;
+        g_config_flags = config.flags;
+    }
+
+    // Write the record when learned coast or a web UI edit changed a value
+    // (ConfigBlob skips the write if the record is unchanged)
+    void saveRuntimeConfig() {
+        // Acquire pairs with onCoastLearned(): the coast values are complete
+        g_coast_save_pending.exchange(false, std::memory_order_acquire);
+        if (g_config_blob.save(makeRuntimeConfig(g_config_meters_per_pulse, g_config_coast_up_s,
+                                                 g_config_coast_down_s, g_config_rode_deadband,
+                                                 g_config_freeboard, g_config_flags))) {
+            debugD("Runtime config saved (%lu writes since boot)",
+                   (unsigned long)g_config_blob.getWrites());
+        }
+    }
 }
 
 // ========================================
@@ -105,13 +202,36 @@ BoatBowControlApp app;
 void setup() {
     // Initialize logging (must be first)
     SetupLogging();
+    g_boot_free_heap = ESP.getFreeHeap();
+    g_boot_max_alloc = ESP.getMaxAllocHeap();
     debugD("=== Boat Anchor Chain Counter and Bow Control System ===");
     debugD("Build: %s @ %s", __DATE__, __TIME__);
 
-    // Setup SensESP with network and web UI FIRST (creates sensesp_app global)
-    // This must happen before app.initialize() which calls event_loop()
+    // Runtime configuration: one NVS read, no filesystem or JSON
+    RuntimeConfig runtime_config = {};
+    const bool have_runtime_config = g_config_store.initialize() &&
+                                     g_config_blob.load(runtime_config);
+    if (have_runtime_config) {
+        applyRuntimeConfig(runtime_config);
+    } else {
+        debugD("No valid runtime config record - using web UI config files");
+    }
+
+    // Stage 0: outputs safe, control task, remote and emergency stop live
+    // (milliseconds after reset, before any networking)
+    app.setMetersPerPulse(g_config_meters_per_pulse);
+    app.initializeControl();
+    app.getAutoModeController()->setCoastCoefficients(g_config_coast_up_s, g_config_coast_down_s);
+
+    // Stage 1: networking, config files and SignalK. The control task runs
+    // at higher priority meanwhile, so slow steps here do not block it.
+    // SensESP must exist before app.initializeNetworking() (uses event_loop())
     SensESPAppBuilder builder;
-    updateApPasswordIfDefault(AP_PASSWORD);
+    if (!(g_config_flags & RuntimeConfigFlag::AP_PASSWORD_CHECKED)) {
+        // SPIFFS scan and JSON parse only until the record says it was done
+        updateApPasswordIfDefault(AP_PASSWORD);
+        g_config_flags |= RuntimeConfigFlag::AP_PASSWORD_CHECKED;
+    }
     sensesp_app = builder
                       .set_wifi_access_point("anchor-counter", AP_PASSWORD)
                       ->set_hostname("anchor-counter")
@@ -119,28 +239,83 @@ void setup() {
                       ->get_app();
 
     // Register SensESP configuration items (must be before sensesp_app->start())
-    // Meters per pulse is a calibration value persisted in SPIFFS
+    // These are the web UI view; loading them reads the JSON files into the variables
+    // Meters per pulse is the chain counter calibration
     ConfigItem(new NumberConfig(g_config_meters_per_pulse, g_config_path_meters_per_pulse))
         ->set_title("Meters Per Pulse")
         ->set_description("Calibration: distance in meters for each chain counter pulse")
         ->set_sort_order(200);
 
-    // Now initialize the application hardware and services (uses sensesp_app)
-    app.initialize();
-    
-    // Load the configured value into the state manager
-    app.getStateManager().setMetersPerPulse(g_config_meters_per_pulse);
+    // Coast coefficients are learned by automatic mode (saved in the runtime record)
+    ConfigItem(new NumberConfig(g_config_coast_up_s, g_config_path_coast_up))
+        ->set_title("Coast Up")
+        ->set_description("Learned: windlass coast after stop when retrieving (seconds per m/s)")
+        ->set_sort_order(210);
+    ConfigItem(new NumberConfig(g_config_coast_down_s, g_config_path_coast_down))
+        ->set_title("Coast Down")
+        ->set_description("Learned: windlass coast after stop when deploying (seconds per m/s)")
+        ->set_sort_order(220);
+
+    ConfigItem(new NumberConfig(g_config_rode_deadband, g_config_path_rode_deadband))
+        ->set_title("Rode Report Deadband")
+        ->set_description("Minimum rode length change in meters before SignalK is updated")
+        ->set_sort_order(230);
+
+    ConfigItem(new NumberConfig(g_config_freeboard, g_config_path_freeboard))
+        ->set_title("Freeboard")
+        ->set_description("Bow roller height above the water in meters, added to the depth for scope targets")
+        ->set_sort_order(240);
+
+    // The binary record is authoritative; without one (first boot, layout
+    // change) the JSON values just loaded are migrated into a new record
+    const uint16_t flags = g_config_flags;
+    if (have_runtime_config) {
+        applyRuntimeConfig(runtime_config);
+        g_config_flags = flags;
+    }
+    saveRuntimeConfig();
+
+    // Services that run on the event loop (uses sensesp_app)
+    app.initializeNetworking();
+
+    // Load the configured values into the application (again, if they came
+    // from JSON). Safe while the control task runs: automatic mode cannot be
+    // armed before SignalK is connected.
+    app.setMetersPerPulse(g_config_meters_per_pulse);
+    app.getAutoModeController()->setCoastCoefficients(g_config_coast_up_s, g_config_coast_down_s);
+    app.getAutoModeController()->setFreeboard(g_config_freeboard);
+    app.getAutoModeController()->onCoastLearned(onCoastLearned);
+    app.getScheduler().add("Config save", 1000, 30000, [](void*) { saveRuntimeConfig(); }, nullptr);
+    app.getSignalKService()->setRodeDeadband(g_config_rode_deadband);
 
     // Initialize web UI and start
     sensesp_app->start();
+    BootMetrics::mark(BootMetrics::Stage::NETWORK_STARTED);
 
     // After SensESP is initialized, start SignalK integration
     app.startSignalK();
 
+#if DIRECT_COMMAND_USE_UDP && defined(DIRECT_COMMAND_KEY)
+    // Direct helm link, only with a pairing key in secrets.h
+    uint8_t direct_key[SIPHASH_KEY_SIZE];
+    if (parseDirectKey(DIRECT_COMMAND_KEY, direct_key)) {
+        app.startDirectLink(direct_key);
+    } else {
+        debugD("DIRECT_COMMAND_KEY must be 32 hex digits - direct link disabled");
+    }
+#endif
+
+    // Heap high-water marks before vs. after boot (debug log and status page)
+    reportBootHeap();
+    reportBootTiming();
+
+    // Event loop on core 0 (no-op with CONTROL_USE_TASKS=0)
+    app.startNetworkTask();
+
     debugD("Setup complete - waiting for SignalK connection");
 }
 
 void loop() {
-    // Process inputs and tick the event loop
+    // Process inputs and tick the event loop (or sleep when tasks run them)
     app.processInputs();
 }
@@ -1,4 +1,58 @@
 #include "remote_control.h"
+#include "hardware/GpioSnapshot.h"
+#include "services/OperationStatsService.h"
+#include "services/PerfMonitor.h"
+#include "services/PowerManager.h"
+
+namespace {
+    // Remote inputs in debouncer order (DRAM so the ISR can read it with flash cache off)
+    DRAM_ATTR const uint8_t kRemotePins[RemoteControl::BUTTON_COUNT] = {
+        PinConfig::REMOTE_UP, PinConfig::REMOTE_DOWN,
+        PinConfig::REMOTE_FUNC3, PinConfig::REMOTE_FUNC4,
+    };
+}
+
+#if REMOTE_USE_INTERRUPTS
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include <atomic>
+
+namespace {
+    /// Raw edge posted by the ISR
+    struct RemoteEdge {
+        uint32_t timestamp_ms;  ///< millis() at the edge
+        uint8_t button;         ///< Index into kRemotePins
+        uint8_t pressed;        ///< Level after the edge (1 = pressed)
+    };
+
+    constexpr UBaseType_t kEdgeQueueLength = 32;
+    constexpr uint8_t kWakeEdge = 0xFF;  ///< RemoteEdge::button of a wake() marker
+    StaticQueue_t g_edge_queue_buffer;
+    uint8_t g_edge_queue_storage[kEdgeQueueLength * sizeof(RemoteEdge)];
+    QueueHandle_t g_edge_queue = nullptr;
+    std::atomic<uint32_t> g_dropped_edges{0};
+    uint32_t g_seen_dropped_edges = 0;  ///< Main-loop copy of g_dropped_edges
+
+    // One handler for all four inputs; arg is the button index
+    void IRAM_ATTR remoteEdgeISR(void* arg) {
+        PowerManager::wakeFromIsr();
+        PerfSpan span(PerfProbe::REMOTE_ISR);
+        uint8_t button = static_cast<uint8_t>(reinterpret_cast<uintptr_t>(arg));
+        RemoteEdge edge = {
+            static_cast<uint32_t>(millis()),
+            button,
+            static_cast<uint8_t>(GpioSnapshot::readPin(kRemotePins[button])),
+        };
+        BaseType_t woken = pdFALSE;
+        if (xQueueSendFromISR(g_edge_queue, &edge, &woken) != pdTRUE) {
+            g_dropped_edges.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (woken) {
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+#endif
 
 RemoteControl::RemoteControl(StateManager& state_manager,
                              AnchorWinchController& winch,
@@ -19,49 +73,102 @@ void RemoteControl::initialize() {
     pinMode(PinConfig::REMOTE_FUNC3, INPUT);
     pinMode(PinConfig::REMOTE_FUNC4, INPUT);
     
-    // Bow propeller relay outputs (inactive HIGH for active-LOW safety)
+    // Bow propeller relay outputs (inactive level of the hardware profile)
+    constexpr uint8_t relay_off = PinConfig::RELAY_ACTIVE_LOW ? HIGH : LOW;
     pinMode(PinConfig::BOW_PORT, OUTPUT);
-    digitalWrite(PinConfig::BOW_PORT, HIGH);
+    digitalWrite(PinConfig::BOW_PORT, relay_off);
     
     pinMode(PinConfig::BOW_STARBOARD, OUTPUT);
-    digitalWrite(PinConfig::BOW_STARBOARD, HIGH);
+    digitalWrite(PinConfig::BOW_STARBOARD, relay_off);
+
+    // Start from the actual levels so a button held at boot is not missed
+    GpioSnapshot::capture();
+    sampleInputs(millis());
+
+#if REMOTE_USE_INTERRUPTS
+    g_edge_queue = xQueueCreateStatic(kEdgeQueueLength, sizeof(RemoteEdge),
+                                      g_edge_queue_storage, &g_edge_queue_buffer);
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        attachInterruptArg(digitalPinToInterrupt(kRemotePins[i]), remoteEdgeISR,
+                           reinterpret_cast<void*>(static_cast<uintptr_t>(i)), CHANGE);
+    }
+#endif
 }
 
-bool RemoteControl::processInputs() {
-    bool up_pressed = digitalRead(PinConfig::REMOTE_UP) == HIGH;
-    bool down_pressed = digitalRead(PinConfig::REMOTE_DOWN) == HIGH;
-    bool func3_pressed = digitalRead(PinConfig::REMOTE_FUNC3) == HIGH;
-    bool func4_pressed = digitalRead(PinConfig::REMOTE_FUNC4) == HIGH;
-    bool any_button_active = up_pressed || down_pressed || func3_pressed || func4_pressed;
-
-    const unsigned long kDoublePressMs = 800;
-    const unsigned long kLongPressMs = 2000;
+bool RemoteControl::waitForInput(unsigned long max_wait_ms) {
+#if REMOTE_USE_INTERRUPTS
     unsigned long now_ms = millis();
+    unsigned long wait_ms = max_wait_ms;
+    unsigned long deadline = gestures_.nextDeadline(now_ms);
+    if (deadline < wait_ms) wait_ms = deadline;
+    if (wait_ms == 0) return true;
 
-    // Detect rising edge for double-press
-    if (any_button_active && !prev_button_active_) {
-        if (last_press_ms_ > 0 && (now_ms - last_press_ms_ <= kDoublePressMs)) {
-            // Double-press detected: activate emergency stop
-            state_manager_.setEmergencyStopActive(true);
-        }
-        last_press_ms_ = now_ms;
-        press_start_ms_ = now_ms;
-        long_press_fired_ = false;
+    // Peek so the edge stays queued for collectEdges()
+    RemoteEdge edge;
+    xQueuePeek(g_edge_queue, &edge, pdMS_TO_TICKS(wait_ms));
+    return true;
+#else
+    (void)max_wait_ms;
+    return false;
+#endif
+}
+
+bool RemoteControl::wake() {
+#if REMOTE_USE_INTERRUPTS
+    // A queued edge ends the wait already; never crowd out real edges
+    if (uxQueueMessagesWaiting(g_edge_queue) == 0) {
+        RemoteEdge edge = {static_cast<uint32_t>(millis()), kWakeEdge, 0};
+        xQueueSend(g_edge_queue, &edge, 0);
     }
+    return true;
+#else
+    return false;
+#endif
+}
 
-    // Long-press to clear emergency stop
-    if (any_button_active && state_manager_.isEmergencyStopActive() && !long_press_fired_ && press_start_ms_ > 0 &&
-        now_ms - press_start_ms_ >= kLongPressMs) {
-        state_manager_.setEmergencyStopActive(false);
-        long_press_fired_ = true;
+void RemoteControl::sampleInputs(unsigned long now_ms) {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        gestures_.onEdge(i, GpioSnapshot::level(kRemotePins[i]), now_ms);
     }
+}
 
-    if (!any_button_active && prev_button_active_) {
-        press_start_ms_ = 0;
-        long_press_fired_ = false;
+void RemoteControl::collectEdges(unsigned long now_ms) {
+#if REMOTE_USE_INTERRUPTS
+    RemoteEdge edge;
+    while (xQueueReceive(g_edge_queue, &edge, 0) == pdTRUE) {
+        if (edge.button != kWakeEdge) {
+            gestures_.onEdge(edge.button, edge.pressed != 0, edge.timestamp_ms);
+        }
     }
+    // Queue overflowed (extreme noise): resynchronise from the pins once
+    uint32_t dropped = g_dropped_edges.load(std::memory_order_relaxed);
+    if (dropped != g_seen_dropped_edges) {
+        g_seen_dropped_edges = dropped;
+        sampleInputs(now_ms);
+    }
+#else
+    sampleInputs(now_ms);
+#endif
+}
 
-    prev_button_active_ = any_button_active;
+bool RemoteControl::processInputs() {
+    unsigned long now_ms = millis();
+    collectEdges(now_ms);
+
+    // Gestures on the combined debounced state
+    RemoteGesture gesture = gestures_.update(now_ms, state_manager_.isEmergencyStopActive());
+    if (gesture == RemoteGesture::EMERGENCY_STOP) {
+        // Double-press detected: activate emergency stop
+        state_manager_.setEmergencyStopActive(true);
+        OperationStatsService::emergencyStop(CommandSource::REMOTE);
+    } else if (gesture == RemoteGesture::CLEAR_EMERGENCY_STOP) {
+        // Long-press to clear emergency stop
+        state_manager_.setEmergencyStopActive(false);
+    }
+    bool up_pressed = gestures_.isPressed(RemoteGestures::UP);
+    bool down_pressed = gestures_.isPressed(RemoteGestures::DOWN);
+    bool func3_pressed = gestures_.isPressed(RemoteGestures::FUNC3);
+    bool func4_pressed = gestures_.isPressed(RemoteGestures::FUNC4);
 
     if (state_manager_.isEmergencyStopActive()) {
         if (remote_active_) {
@@ -71,13 +178,14 @@ bool RemoteControl::processInputs() {
         if (bow_propeller_controller_) {
             bow_propeller_controller_->stop();
         }
+        remote_bow_active_ = false;
         return false;
     }
 
     // Remote button press overrides automatic mode
     if ((up_pressed || down_pressed) && auto_mode_controller_) {
         if (auto_mode_controller_->isEnabled()) {
-            auto_mode_controller_->setEnabled(false);
+            auto_mode_controller_->handOver(up_pressed ? 1 : -1);
             state_manager_.setAutoModeEnabled(false);
             if (auto_mode_output_ptr_) {
                 auto_mode_output_ptr_->set_input(0.0f);
@@ -104,13 +212,16 @@ bool RemoteControl::processInputs() {
     if (bow_propeller_controller_) {
         if (func3_pressed) {
             bow_propeller_controller_->turnPort();
+            remote_bow_active_ = true;
             return true;
         } else if (func4_pressed) {
             bow_propeller_controller_->turnStarboard();
+            remote_bow_active_ = true;
             return true;
-        } else if (bow_propeller_controller_->isActive()) {
-            // Button released - stop bow propeller
+        } else if (remote_bow_active_) {
+            // Button released - only stop thrust the remote started (not SignalK's)
             bow_propeller_controller_->stop();
+            remote_bow_active_ = false;
             return true;
         }
     }
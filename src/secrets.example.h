@@ -5,3 +5,7 @@
 
 #define AP_PASSWORD "change_me"   // Access point password (min 8 chars)
 #define OTA_PASSWORD "change_me"  // Used for Over-The-Air firmware updates
+
+// Optional: pairing key of the direct helm command link (32 hex digits,
+// same key in the helm controller). Leave undefined to disable the link.
+// #define DIRECT_COMMAND_KEY "00112233445566778899aabbccddeeff"
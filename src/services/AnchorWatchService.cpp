@@ -0,0 +1,127 @@
+#include "services/AnchorWatchService.h"
+#include <cmath>
+#include "sensesp_app.h"
+#include "sensesp/signalk/signalk_output.h"
+#include "sensesp/signalk/signalk_value_listener.h"
+#include "sensesp/system/local_debug.h"
+#include "sensesp/system/valueconsumer.h"
+#include "sensesp/types/position.h"
+#include "util/StaticArena.h"
+
+using namespace sensesp;
+
+namespace {
+    /// Listener sink that forwards fixes to the service
+    class PositionSink : public ValueConsumer<Position> {
+    public:
+        explicit PositionSink(AnchorWatchService& service) : service_(service) {}
+        void set(const Position& position) override {
+            service_.onPosition(position.latitude, position.longitude);
+        }
+
+    private:
+        AnchorWatchService& service_;
+    };
+
+    /// Listener sink that forwards depth readings to the service
+    class DepthSink : public ValueConsumer<float> {
+    public:
+        explicit DepthSink(AnchorWatchService& service) : service_(service) {}
+        void set(const float& depth_m) override { service_.onDepth(depth_m); }
+
+    private:
+        AnchorWatchService& service_;
+    };
+
+    StaticArena<arenaBytes<SKValueListener<Position>>() + arenaBytes<FloatSKListener>() +
+                arenaBytes<PositionSink>() + arenaBytes<DepthSink>() +
+                arenaBytes<SKOutputFloat>(3) + arenaBytes<SKOutputRawJson>()> g_anchor_watch_arena;
+
+    SKOutputFloat* g_current_radius = nullptr;
+    SKOutputFloat* g_max_radius = nullptr;
+    SKOutputFloat* g_swing_radius = nullptr;
+    SKOutputRawJson* g_drag_notification = nullptr;
+
+    int32_t toE7(double degrees) {
+        return static_cast<int32_t>(lround(degrees * 1e7));
+    }
+}
+
+AnchorWatchService::AnchorWatchService(StateManager& state_manager)
+    : state_manager_(state_manager) {}
+
+void AnchorWatchService::initialize() {
+    g_anchor_watch_arena.create<SKValueListener<Position>>("navigation.position")
+        ->connect_to(g_anchor_watch_arena.create<PositionSink>(*this));
+    g_anchor_watch_arena.create<FloatSKListener>("environment.depth.belowSurface")
+        ->connect_to(g_anchor_watch_arena.create<DepthSink>(*this));
+
+    g_current_radius = g_anchor_watch_arena.create<SKOutputFloat>(
+        "navigation.anchor.currentRadius", "/anchor_watch/current_radius/sk_path", new SKMetadata("m"));
+    g_max_radius = g_anchor_watch_arena.create<SKOutputFloat>(
+        "navigation.anchor.maxRadius", "/anchor_watch/max_radius/sk_path", new SKMetadata("m"));
+    g_swing_radius = g_anchor_watch_arena.create<SKOutputFloat>(
+        "navigation.anchor.swingRadius", "/anchor_watch/swing_radius/sk_path", new SKMetadata("m"));
+    g_drag_notification = g_anchor_watch_arena.create<SKOutputRawJson>(
+        "notifications.anchor.drag", "/anchor_watch/notification/sk_path");
+}
+
+void AnchorWatchService::onDepth(float depth_m) {
+    depth_m_ = depth_m;
+    depth_ms_ = millis();
+}
+
+float AnchorWatchService::currentDepth(unsigned long now_ms) const {
+    if (depth_m_ < 0.0f || now_ms - depth_ms_ > DEPTH_STALE_MS) {
+        return -1.0f;
+    }
+    return depth_m_;
+}
+
+void AnchorWatchService::onPosition(double latitude, double longitude) {
+    const unsigned long now_ms = millis();
+    const float rode_m = state_manager_.readSnapshot().rode_length;
+    const float depth_m = currentDepth(now_ms);
+
+    if (!watch_.isSet()) {
+        float down_rode_m = depth_m >= 0.0f ? watch_.reach(rode_m, depth_m) : rode_m - ANCHOR_DOWN_RODE_M;
+        if (down_rode_m <= 0.0f) {
+            return;  // Anchor not on the bottom yet
+        }
+        watch_.drop(toE7(latitude), toE7(longitude));
+        debugD("Anchor watch: anchor down at %.6f, %.6f (rode %.1f m)", latitude, longitude, rode_m);
+    } else if (rode_m < ANCHOR_UP_RODE_M) {
+        bool was_dragging = watch_.isDragging();
+        watch_.raise();
+        debugD("Anchor watch: anchor up");
+        if (was_dragging) {
+            publishNotification(now_ms);
+        }
+        return;
+    }
+
+    bool changed = watch_.addSample(toE7(latitude), toE7(longitude), rode_m, depth_m, now_ms / 1000);
+    g_current_radius->set_input(watch_.getDistance());
+    g_max_radius->set_input(watch_.getAllowedRadius());
+    g_swing_radius->set_input(watch_.getSwingRadius());
+
+    if (changed || (watch_.isDragging() && now_ms - last_notification_ms_ >= NOTIFICATION_REPEAT_MS)) {
+        publishNotification(now_ms);
+    }
+}
+
+void AnchorWatchService::publishNotification(unsigned long now_ms) {
+    char json[160];
+    if (watch_.isDragging()) {
+        snprintf(json, sizeof(json),
+                 "{\"state\":\"alarm\",\"method\":[\"visual\",\"sound\"],"
+                 "\"message\":\"Anchor dragging: %.0f m from anchor (allowed %.0f m)\"}",
+                 watch_.getDistance(), watch_.getAllowedRadius());
+        debugD("Anchor watch: DRAG ALARM %.0f m from anchor", watch_.getDistance());
+    } else {
+        snprintf(json, sizeof(json),
+                 "{\"state\":\"normal\",\"method\":[],\"message\":\"Anchor holding\"}");
+    }
+    g_drag_notification->set_input(String(json));
+    last_notification_ms_ = now_ms;
+}
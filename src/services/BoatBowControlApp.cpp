@@ -1,42 +1,122 @@
 #include "services/BoatBowControlApp.h"
 #include "services/SignalKService.h"
+#include "services/AnchorWatchService.h"
+#include "services/DirectCommandService.h"
+#include "esp_timer.h"
+#include "hardware/GpioSnapshot.h"
+#include "services/BootMetrics.h"
+#include "services/PerfMonitor.h"
+#include "util/StaticArena.h"
+#include "sensesp_app.h"
+#include "sensesp/ui/status_page_item.h"
+
+#if CONTROL_USE_TASKS
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
 
 // Global app instance (needed for ISR access)
 static BoatBowControlApp* g_app = nullptr;
 
+// Storage for the controllers and services created in initializeControl()
+// and initializeNetworking()
+static StaticArena<arenaBytes<AutomaticModeController>() + arenaBytes<RemoteControl>() +
+                   arenaBytes<BowPropellerController>() + arenaBytes<EmergencyStopService>() +
+                   arenaBytes<PulseCounterService>() + arenaBytes<RodePersistenceService>() +
+                   arenaBytes<ControlLoopService>() +
+                   arenaBytes<ControlTask>() + arenaBytes<EventLogger>() + arenaBytes<PerfMonitor>() +
+                   arenaBytes<Supervisor>() + arenaBytes<OperationStatsService>() +
+                   arenaBytes<PowerManager>() +
+                   arenaBytes<SignalKService>() + arenaBytes<AnchorWatchService>() +
+                   arenaBytes<DirectCommandService>() +
+                   arenaBytes<WindlassChannels>(WindlassChannels::COUNT > 0 ? 1 : 0) +
+                   arenaBytes<TraceRecorder>(TRACE_CAPTURE ? 1 : 0)> g_app_arena;
+
+// Status page line per scheduled task plus one for the frame counters
+static StaticArena<arenaBytes<sensesp::StatusPageItem<String>>(NETWORK_SCHEDULER_TASKS + 1)> g_scheduler_arena;
+static sensesp::StatusPageItem<String>* g_scheduler_status[NETWORK_SCHEDULER_TASKS + 1] = {};
+static size_t g_scheduler_items = 0;  // Tasks with a status item
+
 void emergencyStopChangedThunk(bool is_active, const char* reason) {
     if (g_app) {
         g_app->onEmergencyStopChanged(is_active, reason);
     }
 }
 
+#if !PULSE_COUNTER_USE_PCNT
 // Interrupt Service Routine - Pulse Counter with Direction Sensing
+// Fallback when the PCNT backend is disabled at build time
 // Called from ISR context - must be very fast
 void IRAM_ATTR pulseISR() {
+    PowerManager::wakeFromIsr();
     if (!g_app) return;
+    if (!GpioSnapshot::readPin(PinConfig::PULSE_INPUT)) return;  // Wake on the falling level: not a count
+    PerfSpan span(PerfProbe::PULSE_ISR);
     
+    uint32_t now_us = (uint32_t)esp_timer_get_time();
     delayMicroseconds(10);  // Allow direction signal to stabilize
     
-    if (digitalRead(PinConfig::DIRECTION)) {
-        g_app->getStateManager().incrementPulse();  // Chain out
+    StateManager& state = g_app->getStateManager();
+    if (GpioSnapshot::readPin(PinConfig::DIRECTION) == PinConfig::DIRECTION_OUT_HIGH) {
+        state.incrementPulse();  // Chain out
+        state.pushPulseEdge({now_us, 1});
     } else {
-        g_app->getStateManager().decrementPulse();  // Chain in
+        state.decrementPulse();  // Chain in
+        state.pushPulseEdge({now_us, -1});
+    }
+}
+#endif
+
+// Home sensor edge to its active level (anchor arrived): cut the retrieve relay
+// at once by writing WINCH_UP's inactive level to the output register.
+// Deploying (WINCH_DOWN) is left alone - it moves the anchor away from home.
+// PulseCounterService picks up the posted edge to sync winch state, zero the
+// counter and finish auto-home.
+void IRAM_ATTR homeISR() {
+    uint32_t entry_cycles = PerfMonitor::cycles();
+    PowerManager::wakeFromIsr();
+    if (GpioSnapshot::readPin(PinConfig::ANCHOR_HOME) == PinConfig::HOME_ACTIVE_LOW) {
+        return;  // Glitch: line is already back at the inactive level (not at home)
+    }
+    constexpr uint32_t winch_up_mask = 1UL << PinConfig::WINCH_UP;
+    const bool energised = ((GPIO.out & winch_up_mask) != 0) != PinConfig::RELAY_ACTIVE_LOW;
+    if (energised) {
+        if (PinConfig::RELAY_ACTIVE_LOW) GPIO.out_w1ts = winch_up_mask; else GPIO.out_w1tc = winch_up_mask;
+        PerfMonitor::record(PerfProbe::HOME_ISR_TO_RELAY, entry_cycles);
+    }
+    if (g_app) {
+        g_app->getStateManager().postHomeEdge(entry_cycles);
     }
 }
 
 BoatBowControlApp::BoatBowControlApp()
     : motor_(),
-      home_sensor_impl_(),
+      home_sensor_impl_(PinConfig::ANCHOR_HOME, PinConfig::HOME_ACTIVE_LOW),
       winch_controller_(motor_, home_sensor_impl_),
       home_sensor_(home_sensor_impl_) {
     g_app = this;  // Store global pointer for ISR
 }
 
-void BoatBowControlApp::initialize() {
+void BoatBowControlApp::initializeControl() {
     initializeHardware();
     initializeControllers();
     initializeServices();
-    attachPulseISR();
+    initializePulseSource();
+    initializeHomeInterrupt();
+
+    // Counter from before the reset; stays unverified until the next home event
+    pulse_counter_service_->restoreCounter();
+
+    // Idle power mode: wake inputs are configured by now, the ECU starts active
+    PowerManager::start();
+
+    // Relays are cut if a control-side task misses its deadline from here on
+    Supervisor::start();
+
+    // Remote, home sensor and emergency stop are live from here on
+#if CONTROL_USE_TASKS
+    control_task_->start();
+#endif
 
     debugD("=== Boat Bow Control App Initialized ===");
     debugD("Pulse input: GPIO %d, Direction: GPIO %d", 
@@ -51,6 +131,62 @@ void BoatBowControlApp::initialize() {
            PinConfig::REMOTE_FUNC3, PinConfig::REMOTE_FUNC4);
 }
 
+void BoatBowControlApp::initializeNetworking() {
+    // One event loop timer drives every periodic task (see NetworkScheduler)
+    event_loop()->onRepeat(NETWORK_MINOR_FRAME_MS, [this]() { scheduler_.tick(); });
+
+    // Journal writes and perf publishing run on the event loop
+    rode_persistence_->initialize(scheduler_);
+
+    // Control-side log records are formatted and printed here, not in the control path
+    event_logger_ = g_app_arena.create<EventLogger>();
+    event_logger_->initialize(scheduler_);
+
+    // Latency histograms published under electrical.bow.ecu.perf.*
+    perf_monitor_ = g_app_arena.create<PerfMonitor>();
+    perf_monitor_->initialize(scheduler_);
+
+    // Missed deadlines per control-side task under electrical.bow.ecu.supervisor.*
+    supervisor_ = g_app_arena.create<Supervisor>();
+    supervisor_->initialize(scheduler_);
+
+    // Lifetime totals saved in batches, summaries under electrical.bow.ecu.statistics.*
+    operation_stats_->initialize(scheduler_);
+
+    // WiFi modem sleep follows the idle power mode, idle time on the status page
+    power_manager_ = g_app_arena.create<PowerManager>();
+    power_manager_->initialize(scheduler_);
+
+#if TRACE_CAPTURE
+    // High-rate trace streamed to a requesting host (tools/trace_decode.py)
+    trace_recorder_ = g_app_arena.create<TraceRecorder>(state_manager_);
+    trace_recorder_->initialize(scheduler_);
+#endif
+
+    // Initialize SignalK service with bow propeller controller
+    signalk_service_ = g_app_arena.create<SignalKService>(state_manager_, winch_controller_,
+                                                          home_sensor_, auto_mode_controller_,
+                                                          emergency_stop_service_,
+                                                          pulse_counter_service_, *control_task_,
+                                                          bow_propeller_controller_);
+    signalk_service_->initialize(scheduler_);
+
+#if WINDLASS_CHANNELS > 1
+    // Additional windlasses under navigation.anchor.<name>.*
+    windlass_channels_->initialize(scheduler_, *control_task_);
+#endif
+
+    // Drag alarm computed on the ECU from position, depth and rode
+    anchor_watch_ = g_app_arena.create<AnchorWatchService>(state_manager_);
+    anchor_watch_->initialize();
+
+    scheduler_.add("Scheduler stats", 1000, 0,
+                   [](void* self) { static_cast<BoatBowControlApp*>(self)->publishSchedulerStats(); },
+                   this);
+
+    debugD("Networking services initialized");
+}
+
 void BoatBowControlApp::startSignalK() {
     if (!signalk_service_) {
         debugD("ERROR: SignalK service not initialized!");
@@ -61,14 +197,83 @@ void BoatBowControlApp::startSignalK() {
     debugD("SignalK integration started - waiting for connection...");
 }
 
-void BoatBowControlApp::processInputs() {
-    // Process physical remote control inputs
-    if (remote_control_) {
-        remote_control_->processInputs();
+void BoatBowControlApp::startDirectLink(const uint8_t* key) {
+    // Same command queue and guards as SignalK, independent of the server connection
+    direct_link_ = g_app_arena.create<DirectCommandService>(state_manager_, *control_task_, key);
+    direct_link_->initialize(scheduler_);
+}
+
+void BoatBowControlApp::startNetworkTask() {
+#if CONTROL_USE_TASKS
+    xTaskCreatePinnedToCore(networkTaskEntry, "network", NETWORK_STACK_SIZE, this,
+                            NETWORK_PRIORITY, nullptr, NETWORK_CORE);
+    debugD("Event loop task started on core %u", NETWORK_CORE);
+#endif
+}
+
+void BoatBowControlApp::networkTaskEntry(void* arg) {
+#if CONTROL_USE_TASKS
+    (void)arg;
+    for (;;) {
+        {
+            PerfSpan span(PerfProbe::EVENT_LOOP_TICK);
+            event_loop()->tick();
+        }
+#if POWER_USE_IDLE_SLEEP
+        // Idle: fewer wake-ups so the CPU can stay in light sleep between passes
+        vTaskDelay(PowerManager::isIdle() ? pdMS_TO_TICKS(PowerManager::IDLE_EVENT_LOOP_DELAY_MS) : 1);
+#else
+        vTaskDelay(1);  // Yield so the idle task can feed the watchdog
+#endif
     }
-    
-    // Tick the SensESP event loop
+#else
+    (void)arg;
+#endif
+}
+
+uint32_t BoatBowControlApp::clockUs() {
+    return static_cast<uint32_t>(esp_timer_get_time());
+}
+
+void BoatBowControlApp::publishSchedulerStats() {
+    // Items are created on the first run, when every task is registered
+    if (g_scheduler_items == 0) {
+        g_scheduler_items = scheduler_.size();
+        for (size_t i = 0; i < g_scheduler_items; i++) {
+            g_scheduler_status[i] = g_scheduler_arena.create<sensesp::StatusPageItem<String>>(
+                scheduler_.name(i), "", "Scheduler", 1400 + i);
+        }
+        g_scheduler_status[g_scheduler_items] = g_scheduler_arena.create<sensesp::StatusPageItem<String>>(
+            "Frames", "", "Scheduler", 1400 + g_scheduler_items);
+    }
+
+    char text[80];
+    for (size_t i = 0; i < g_scheduler_items; i++) {
+        const ScheduledTaskStats& stats = scheduler_.stats(i);
+        snprintf(text, sizeof(text), "every %lu ms (phase %lu), max %lu us, %lu overruns, %lu late",
+                 (unsigned long)(scheduler_.period(i) * NETWORK_MINOR_FRAME_MS),
+                 (unsigned long)scheduler_.phase(i), (unsigned long)stats.max_us,
+                 (unsigned long)stats.overruns, (unsigned long)stats.late);
+        g_scheduler_status[i]->set(String(text));
+    }
+    snprintf(text, sizeof(text), "%lu ms minor frame, %lu overruns, %lu late",
+             (unsigned long)NETWORK_MINOR_FRAME_MS, (unsigned long)scheduler_.getFrameOverruns(),
+             (unsigned long)scheduler_.getLateFrames());
+    g_scheduler_status[g_scheduler_items]->set(String(text));
+}
+
+void BoatBowControlApp::processInputs() {
+#if CONTROL_USE_TASKS
+    // Control and event loop run in their own tasks
+    vTaskDelay(portMAX_DELAY);
+#else
+    // Control step: remote, pulses, automatic mode (waits for remote edges)
+    control_task_->runOnce(INPUT_WAIT_MS);
+
+    // Tick the SensESP event loop (SignalK, status publishing)
+    PerfSpan span(PerfProbe::EVENT_LOOP_TICK);
     event_loop()->tick();
+#endif
 }
 
 void BoatBowControlApp::initializeHardware() {
@@ -81,21 +286,25 @@ void BoatBowControlApp::initializeHardware() {
     // Initialize bow propeller motor
     bow_propeller_motor_.initialize();
 
+    BootMetrics::mark(BootMetrics::Stage::SAFE_OUTPUTS);
     debugD("Hardware initialized - all outputs inactive");
 }
 
 void BoatBowControlApp::initializeControllers() {
     // Initialize automatic mode controller
-    auto_mode_controller_ = new AutomaticModeController(winch_controller_, home_sensor_);
-    // Note: meters_per_pulse is set by main.cpp from SensESP ConfigItem after initialize()
+    auto_mode_controller_ = g_app_arena.create<AutomaticModeController>(winch_controller_,
+                                                                        home_sensor_);
+
+    // Note: meters_per_pulse is set by main.cpp via setMetersPerPulse() after initialize()
     auto_mode_controller_->setTolerance(state_manager_.getMetersPerPulse() * 2.0);
+    auto_mode_controller_->setStopPrediction(true);
     
     // Initialize remote control
-    remote_control_ = new RemoteControl(state_manager_, winch_controller_);
+    remote_control_ = g_app_arena.create<RemoteControl>(state_manager_, winch_controller_);
     remote_control_->initialize();
     
     // Initialize bow propeller controller
-    bow_propeller_controller_ = new BowPropellerController(bow_propeller_motor_);
+    bow_propeller_controller_ = g_app_arena.create<BowPropellerController>(bow_propeller_motor_);
     
     // Wire bow propeller to remote control
     remote_control_->setBowPropellerController(bow_propeller_controller_);
@@ -105,45 +314,84 @@ void BoatBowControlApp::initializeControllers() {
 
 void BoatBowControlApp::initializeServices() {
     // Initialize emergency stop service (without callback - SignalK will handle updates)
-    emergency_stop_service_ = new EmergencyStopService(state_manager_, winch_controller_);
+    emergency_stop_service_ = g_app_arena.create<EmergencyStopService>(state_manager_,
+                                                                       winch_controller_);
     // Wire bow propeller to emergency stop service
     emergency_stop_service_->setBowPropellerController(bow_propeller_controller_);
     // Use a thunk to forward the callback to the app instance
     emergency_stop_service_->onStateChange(emergencyStopChangedThunk);
     
-    // Initialize pulse counter service
-    pulse_counter_service_ = new PulseCounterService(state_manager_, winch_controller_, 
-                                                      home_sensor_, 100);
-    pulse_counter_service_->initialize();
-    
-    // Initialize SignalK service with bow propeller controller
-    signalk_service_ = new SignalKService(state_manager_, winch_controller_, home_sensor_,
-                                         auto_mode_controller_, emergency_stop_service_,
-                                         pulse_counter_service_, bow_propeller_controller_);
-    signalk_service_->initialize();
+    // Initialize pulse counter service (driven by the control loop)
+    pulse_counter_service_ = g_app_arena.create<PulseCounterService>(state_manager_, winch_controller_,
+                                                                     home_sensor_);
+
+    // Rode counter persistence: RTC memory on every tick, NVS journal once the count settles
+    if (!rode_store_.initialize()) {
+        debugD("NVS unavailable - rode journal disabled (RTC only)");
+    }
+    rode_persistence_ = g_app_arena.create<RodePersistenceService>(rode_store_);
+    pulse_counter_service_->setPersistence(rode_persistence_);
+
+    // Operation statistics: counted in RAM, lifetime record restored once here
+    if (!stats_store_.initialize()) {
+        debugD("NVS unavailable - lifetime statistics kept per session only");
+    }
+    operation_stats_ = g_app_arena.create<OperationStatsService>(stats_store_, state_manager_);
+    operation_stats_->restore();
+
+    // Fixed-rate control loop: pulse drain + automatic mode every 20 ms
+    control_loop_service_ = g_app_arena.create<ControlLoopService>(state_manager_,
+                                                                   *pulse_counter_service_,
+                                                                   *auto_mode_controller_, 20);
+
+    // Control side: the only caller of controllers; SignalK submits commands
+    control_task_ = g_app_arena.create<ControlTask>(state_manager_, winch_controller_,
+                                                    *control_loop_service_, *pulse_counter_service_,
+                                                    auto_mode_controller_, emergency_stop_service_,
+                                                    remote_control_, bow_propeller_controller_);
+
+#if WINDLASS_CHANNELS > 1
+    // Additional windlasses: own relays, home sensor and PCNT unit, served after the control loop
+    windlass_channels_ = g_app_arena.create<WindlassChannels>(state_manager_);
+    windlass_channels_->initializeHardware();
+    control_task_->setWindlassChannels(windlass_channels_);
+#endif
 
-    debugD("Services initialized");
+    debugD("Control services initialized");
 }
 
-void BoatBowControlApp::attachPulseISR() {
+void BoatBowControlApp::initializeHomeInterrupt() {
+    // Pin mode is set by the home sensor (pull towards the inactive level)
+    attachInterrupt(digitalPinToInterrupt(PinConfig::ANCHOR_HOME), homeISR,
+                    PinConfig::HOME_ACTIVE_LOW ? FALLING : RISING);
+    debugD("Home ISR attached to GPIO %d (direct WINCH_UP cut)", PinConfig::ANCHOR_HOME);
+}
+
+void BoatBowControlApp::initializePulseSource() {
+#if PULSE_COUNTER_USE_PCNT
+    // Hardware counting: PulseCounterService polls the PCNT unit every tick
+    pulse_counter_hw_.initialize();
+    pulse_counter_service_->setPulseSource(&pulse_counter_hw_);
+    PowerManager::addPulseInput(pulse_counter_hw_);
+#else
     // Configure the pulse input pin and direction pin
     pinMode(PinConfig::PULSE_INPUT, INPUT_PULLUP);
     pinMode(PinConfig::DIRECTION, INPUT_PULLUP);
     attachInterrupt(digitalPinToInterrupt(PinConfig::PULSE_INPUT), pulseISR, RISING);
 
     debugD("Pulse ISR attached to GPIO %d", PinConfig::PULSE_INPUT);
+#endif
 }
 
-void BoatBowControlApp::onEmergencyStopChanged(bool is_active, const char* reason) {
-    // Update SignalK status when emergency stop state changes
-    if (signalk_service_) {
-        auto status_value = signalk_service_->getEmergencyStopStatus();
-        if (status_value) {
-            status_value->set(is_active);
-            status_value->notify();  // Force emission even if unchanged
-        }
+void BoatBowControlApp::setMetersPerPulse(float meters_per_pulse) {
+    state_manager_.setMetersPerPulse(meters_per_pulse);
+    if (auto_mode_controller_) {
+        auto_mode_controller_->setTolerance(meters_per_pulse * 2.0f);
     }
-    
+}
+
+void BoatBowControlApp::onEmergencyStopChanged(bool is_active, const char* reason) {
+    // Runs on the control side; SignalK status follows from the state snapshot
     if (is_active) {
         debugD("EMERGENCY STOP ACTIVATED (%s)", reason);
     } else {
@@ -0,0 +1,46 @@
+#include "services/ControlLoopService.h"
+#include <Arduino.h>
+#include "services/Supervisor.h"
+
+void ControlLoopService::tick(unsigned long now_us) {
+    const unsigned long period_us = period_ms_ * 1000UL;
+    bool missed = false;
+
+    // Interval jitter against the nominal period
+    if (last_tick_us_ != 0) {
+        unsigned long interval_us = now_us - last_tick_us_;
+        unsigned long jitter_us = interval_us > period_us ? interval_us - period_us
+                                                          : period_us - interval_us;
+        stats_.last_jitter_us = jitter_us;
+        if (jitter_us > stats_.max_jitter_us) {
+            stats_.max_jitter_us = jitter_us;
+        }
+        if (interval_us > period_us + period_us / 2) {
+            missed = true;
+        }
+    }
+    last_tick_us_ = now_us;
+
+    // Fresh pulse snapshot, then act on the motor in the same tick
+    pulse_counter_service_.update();
+    auto_mode_controller_.update(state_manager_.getRodeLength(),
+                                 state_manager_.getPulseSnapshot().timestamp_ms);
+    if (auto_mode_controller_.consumeTargetReached()) {
+        state_manager_.setAutoModeEnabled(false);
+    }
+
+    unsigned long exec_us = micros() - now_us;
+    stats_.last_exec_us = exec_us;
+    if (exec_us > stats_.max_exec_us) {
+        stats_.max_exec_us = exec_us;
+    }
+    if (exec_us > period_us) {
+        missed = true;
+    }
+
+    stats_.ticks++;
+    if (missed) {
+        stats_.deadline_misses++;
+    }
+    Supervisor::checkIn(SupervisedTask::CONTROL_LOOP);
+}
@@ -0,0 +1,432 @@
+#include "services/ControlTask.h"
+#include "hardware/GpioSnapshot.h"
+#include "services/BootMetrics.h"
+#include "services/EventLogger.h"
+#include "services/OperationStatsService.h"
+#include "services/PerfMonitor.h"
+#include "services/PowerManager.h"
+#include "services/Supervisor.h"
+#include "services/TraceRecorder.h"
+#include "sensesp/system/local_debug.h"
+
+#if CONTROL_USE_TASKS
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+using namespace sensesp;
+
+ControlTask::ControlTask(StateManager& state_manager,
+                         AnchorWinchController& winch_controller,
+                         ControlLoopService& control_loop,
+                         PulseCounterService& pulse_counter_service,
+                         AutomaticModeController* auto_mode_controller,
+                         EmergencyStopService* emergency_stop_service,
+                         RemoteControl* remote_control,
+                         BowPropellerController* bow_propeller_controller)
+    : state_manager_(state_manager),
+      winch_controller_(winch_controller),
+      control_loop_(control_loop),
+      pulse_counter_service_(pulse_counter_service),
+      auto_mode_controller_(auto_mode_controller),
+      emergency_stop_service_(emergency_stop_service),
+      remote_control_(remote_control),
+      bow_propeller_controller_(bow_propeller_controller) {}
+
+bool ControlTask::submit(ControlCommand command) {
+    command.arrival_us = micros();
+    if (!commands_.push(command)) {
+        EventLogger::log(LogEvent::COMMAND_QUEUE_FULL);
+        return false;
+    }
+    wake();
+    return true;
+}
+
+void ControlTask::wake() {
+#if CONTROL_USE_TASKS
+    if (!task_ || xTaskGetCurrentTaskHandle() == task_) {
+        return;
+    }
+    // The task blocks on the remote edge queue (interrupt mode) or on its notification
+    if (!remote_control_ || !remote_control_->wake()) {
+        xTaskNotifyGive(task_);
+    }
+#endif
+}
+
+void ControlTask::start() {
+#if CONTROL_USE_TASKS
+    next_tick_us_ = micros();
+    xTaskCreatePinnedToCore(taskEntry, "control", CONTROL_STACK_SIZE, this,
+                            CONTROL_PRIORITY, &task_, CONTROL_CORE);
+    debugD("Control task started on core %u (priority %u)", CONTROL_CORE, CONTROL_PRIORITY);
+#endif
+}
+
+void ControlTask::taskEntry(void* arg) {
+#if CONTROL_USE_TASKS
+    auto* self = static_cast<ControlTask*>(arg);
+    for (;;) {
+        unsigned long wait_ms = self->msUntilTick(micros());
+        // Block on remote edges when interrupt-driven, otherwise sleep to the next tick;
+        // either way a submitted command ends the wait (wake())
+        bool waited = self->remote_control_ && self->remote_control_->waitForInput(wait_ms);
+        if (!waited && wait_ms > 0) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
+        }
+        self->step();
+    }
+#else
+    (void)arg;
+#endif
+}
+
+void ControlTask::runOnce(unsigned long max_wait_ms) {
+    unsigned long wait_ms = msUntilTick(micros());
+    if (max_wait_ms < wait_ms) {
+        wait_ms = max_wait_ms;
+    }
+    if (remote_control_) {
+        remote_control_->waitForInput(wait_ms);
+    }
+    step();
+}
+
+void ControlTask::step() {
+    // One consistent view of all digital inputs for this step
+    GpioSnapshot::capture();
+
+    if (Supervisor::takeTrip()) {
+        stopAfterTrip();
+    }
+
+    const bool commands_applied = drainCommands() > 0;
+    expireLeases(micros());
+
+    if (remote_control_) {
+        remote_control_->processInputs();
+        Supervisor::checkIn(SupervisedTask::REMOTE_INPUT);
+    }
+
+    unsigned long now_us = micros();
+    if (static_cast<long>(now_us - next_tick_us_) >= 0) {
+        control_loop_.tick(now_us);
+#if WINDLASS_CHANNELS > 1
+        if (windlass_channels_) {
+            windlass_channels_->update(millis());
+        }
+#endif
+        const unsigned long period_us = control_loop_.getPeriodMs() * 1000UL;
+        next_tick_us_ += period_us;
+        if (static_cast<long>(now_us - next_tick_us_) >= 0) {
+            next_tick_us_ = now_us + period_us;  // Far behind: skip instead of bursting
+        }
+    }
+
+    publishSnapshot();
+    Supervisor::feedWatchdog();
+
+    const long pulse_count = state_manager_.getPulseCount();
+    PowerManager::update(commands_applied || pulse_count != last_pulse_count_ || isActive(), millis());
+    last_pulse_count_ = pulse_count;
+
+    if (!first_step_done_) {
+        BootMetrics::mark(BootMetrics::Stage::FIRST_CONTROL);
+        first_step_done_ = true;
+    }
+}
+
+unsigned long ControlTask::msUntilTick(unsigned long now_us) const {
+    long remaining_us = static_cast<long>(next_tick_us_ - now_us);
+    if (remaining_us <= 0) {
+        return 0;
+    }
+    return (remaining_us + 999) / 1000;
+}
+
+size_t ControlTask::drainCommands() {
+    ControlCommand batch[COMMAND_QUEUE_SIZE];
+    size_t count = 0;
+    while (count < COMMAND_QUEUE_SIZE && commands_.pop(batch[count])) {
+        count++;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    size_t kept = coalesceCommands(batch, count);
+    coalesced_commands_ += count - kept;
+
+    for (size_t i = 0; i < kept; i++) {
+        const ControlCommand& command = batch[i];
+        const uint32_t queue_delay_us = micros() - command.arrival_us;
+        PerfMonitor::recordUs(PerfProbe::COMMAND_QUEUE_DELAY, queue_delay_us);
+        TraceRecorder::recordAt(command.arrival_us, TraceEvent::COMMAND, static_cast<uint8_t>(command.type),
+                                static_cast<uint16_t>(static_cast<uint8_t>(command.source) | (command.channel << 8)),
+                                command.value, queue_delay_us);
+        execute(command);
+    }
+    return kept;
+}
+
+bool ControlTask::isActive() const {
+    if (winch_controller_.isActive() || winch_lease_.isActive() || bow_lease_.isActive()) {
+        return true;
+    }
+    if (bow_propeller_controller_ && bow_propeller_controller_->isActive()) {
+        return true;
+    }
+    if (auto_mode_controller_ && auto_mode_controller_->isEnabled()) {
+        return true;
+    }
+#if WINDLASS_CHANNELS > 1
+    if (windlass_channels_ && windlass_channels_->isActive()) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+void ControlTask::execute(const ControlCommand& command) {
+    // Re-check on the control side: the emergency stop may have latched since queuing
+    bool estop = state_manager_.isEmergencyStopActive();
+
+#if WINDLASS_CHANNELS > 1
+    if (command.channel != 0 && (!windlass_channels_ || windlass_channels_->execute(command, estop))) {
+        return;
+    }
+#endif
+
+    switch (command.type) {
+    case ControlCommandType::MANUAL_WINCH: {
+        const PerfProbe probe = command.source == CommandSource::DIRECT ? PerfProbe::DIRECT_COMMAND_TO_RELAY
+                                                                        : PerfProbe::COMMAND_TO_RELAY;
+        if (estop) {
+            PerfMonitor::cancel(probe);
+            return;
+        }
+        // Manual control always overrides automatic mode; a repeated command
+        // (keep-alive, re-send) leaves the running winch alone
+        const int8_t direction = command.value > 0.5f ? 1 : (command.value < -0.5f ? -1 : 0);
+        const bool relay_edge_due = (direction > 0 && !winch_controller_.isMovingUp()) ||
+                                    (direction < 0 && !winch_controller_.isMovingDown());
+        if (auto_mode_controller_ && auto_mode_controller_->isEnabled()) {
+            auto_mode_controller_->handOver(direction);
+            state_manager_.setAutoModeEnabled(false);
+        }
+        if (direction > 0) {
+            winch_controller_.moveUp();
+            winch_lease_.grant(1, command.arrival_us, command.lease_ms * 1000UL);
+        } else if (direction < 0) {
+            winch_controller_.moveDown();
+            winch_lease_.grant(-1, command.arrival_us, command.lease_ms * 1000UL);
+        } else {
+            winch_controller_.stop();
+            winch_lease_.release();
+        }
+        // The winch relay pair ends the measurement at its relay-on edge
+        if (relay_edge_due && (direction > 0 ? winch_controller_.isMovingUp() : winch_controller_.isMovingDown())) {
+            PerfMonitor::arm(probe);
+        } else {
+            PerfMonitor::cancel(probe);
+        }
+        break;
+    }
+
+    case ControlCommandType::BOW_THRUSTER:
+        if (estop || !bow_propeller_controller_) return;
+        if (command.value > 0.5f) {
+            bow_propeller_controller_->turnStarboard();
+            bow_lease_.grant(1, command.arrival_us, command.lease_ms * 1000UL);
+        } else if (command.value < -0.5f) {
+            bow_propeller_controller_->turnPort();
+            bow_lease_.grant(-1, command.arrival_us, command.lease_ms * 1000UL);
+        } else {
+            bow_propeller_controller_->stop();
+            bow_lease_.release();
+        }
+        break;
+
+    case ControlCommandType::BOW_THRUST: {
+        if (estop || !bow_propeller_controller_) return;
+        const float thrust = command.value > 1.0f ? 1.0f : (command.value < -1.0f ? -1.0f : command.value);
+        bow_propeller_controller_->setThrust(thrust);
+        if (bow_propeller_controller_->isActive()) {
+            bow_lease_.grant(thrust > 0.0f ? 1 : -1, command.arrival_us, command.lease_ms * 1000UL);
+        } else {
+            bow_lease_.release();
+        }
+        break;
+    }
+
+    case ControlCommandType::AUTO_MODE: {
+        if (estop || !auto_mode_controller_) return;
+        bool enable = command.value > 0.5f;
+        if (enable == auto_mode_controller_->isEnabled()) return;
+        auto_mode_controller_->setEnabled(enable);
+        state_manager_.setAutoModeEnabled(enable);
+        EventLogger::log(LogEvent::AUTO_MODE_SET, enable);
+        if (enable && auto_mode_controller_->getTargetLength() >= 0) {
+            auto_mode_controller_->update(state_manager_.getRodeLength(), millis());
+        }
+        break;
+    }
+
+    case ControlCommandType::ARM_TARGET:
+    case ControlCommandType::HOME: {
+        if (estop || !auto_mode_controller_) return;
+        bool home = command.type == ControlCommandType::HOME;
+        float target = home ? 0.0f : command.value;
+        if (target < 0) return;
+        if (home && winch_controller_.isActive() && !auto_mode_controller_->isEnabled()) {
+            EventLogger::log(LogEvent::HOME_COMMAND_BLOCKED);
+            return;
+        }
+        auto_mode_controller_->setTargetLength(target);
+        state_manager_.setAutoModeTarget(target);
+        EventLogger::log(LogEvent::TARGET_ARMED, target, state_manager_.getRodeLength());
+        // Arming always requires a fresh enable
+        if (auto_mode_controller_->isEnabled()) {
+            auto_mode_controller_->setEnabled(false);
+            state_manager_.setAutoModeEnabled(false);
+            EventLogger::log(LogEvent::TARGET_NEEDS_ENABLE);
+        }
+        break;
+    }
+
+    case ControlCommandType::ARM_SCOPE: {
+        if (estop || !auto_mode_controller_) return;
+        if (command.value < 1.0f) return;  // Less rode than depth cannot hold
+        auto_mode_controller_->setScope(command.value);
+        float target = auto_mode_controller_->getTargetLength();
+        state_manager_.setAutoModeTarget(target);
+        EventLogger::log(LogEvent::SCOPE_ARMED, command.value, target);
+        // Arming always requires a fresh enable
+        if (auto_mode_controller_->isEnabled()) {
+            auto_mode_controller_->setEnabled(false);
+            state_manager_.setAutoModeEnabled(false);
+            EventLogger::log(LogEvent::TARGET_NEEDS_ENABLE);
+        }
+        break;
+    }
+
+    case ControlCommandType::DEPTH:
+        if (auto_mode_controller_) {
+            auto_mode_controller_->setDepth(command.value, millis());
+        }
+        break;
+
+    case ControlCommandType::RESET_RODE:
+        if (estop) return;
+        state_manager_.requestPulseReset();
+        state_manager_.setRodeLength(0.0f);
+        state_manager_.setRodeVerified(true);  // Operator asserts the anchor is home
+        EventLogger::log(LogEvent::RESET_COMMAND);
+        break;
+
+    case ControlCommandType::EMERGENCY_STOP:
+        if (emergency_stop_service_) {
+            if (command.value > 0.5f && !emergency_stop_service_->isActive()) {
+                OperationStatsService::emergencyStop(command.source);
+            }
+            emergency_stop_service_->setActive(command.value > 0.5f,
+                                               commandSourceName(command.source));
+        }
+#if WINDLASS_CHANNELS > 1
+        if (windlass_channels_ && command.value > 0.5f) {
+            windlass_channels_->stopAll();
+        }
+#endif
+        break;
+
+    case ControlCommandType::STOP_ALL:
+        if (auto_mode_controller_) {
+            auto_mode_controller_->setEnabled(false);
+            state_manager_.setAutoModeEnabled(false);
+        }
+        winch_controller_.stop();
+        winch_lease_.release();
+        PerfMonitor::cancel(PerfProbe::COMMAND_TO_RELAY);
+        PerfMonitor::cancel(PerfProbe::DIRECT_COMMAND_TO_RELAY);
+        if (bow_propeller_controller_) {
+            bow_propeller_controller_->stop();
+        }
+        bow_lease_.release();
+#if WINDLASS_CHANNELS > 1
+        if (windlass_channels_) {
+            windlass_channels_->stopAll();
+        }
+#endif
+        break;
+    }
+}
+
+void ControlTask::expireLeases(uint32_t now_us) {
+    // Stop only the leased motion: the remote may have taken the actuator over since
+    if (winch_lease_.expired(now_us)) {
+        int8_t direction = winch_lease_.direction();
+        winch_lease_.release();
+        if ((direction > 0 && winch_controller_.isMovingUp()) ||
+            (direction < 0 && winch_controller_.isMovingDown())) {
+            winch_controller_.stop();
+            EventLogger::log(LogEvent::COMMAND_LEASE_EXPIRED, static_cast<int32_t>(CommandActuator::WINCH));
+        }
+    }
+    if (bow_lease_.expired(now_us)) {
+        int8_t direction = bow_lease_.direction();
+        bow_lease_.release();
+        if (bow_propeller_controller_ &&
+            ((direction > 0 && bow_propeller_controller_->isTurningStarboard()) ||
+             (direction < 0 && bow_propeller_controller_->isTurningPort()))) {
+            bow_propeller_controller_->stop();
+            EventLogger::log(LogEvent::COMMAND_LEASE_EXPIRED, static_cast<int32_t>(CommandActuator::BOW));
+        }
+    }
+}
+
+void ControlTask::stopAfterTrip() {
+    // The supervisor ISR already opened the relays; bring the controllers in line
+    if (auto_mode_controller_) {
+        auto_mode_controller_->setEnabled(false);
+        state_manager_.setAutoModeEnabled(false);
+    }
+    winch_controller_.stop();
+    winch_lease_.release();
+    if (bow_propeller_controller_) {
+        bow_propeller_controller_->stop();
+    }
+    bow_lease_.release();
+#if WINDLASS_CHANNELS > 1
+    if (windlass_channels_) {
+        windlass_channels_->stopAll();
+    }
+#endif
+    EventLogger::log(LogEvent::SUPERVISOR_TRIP, Supervisor::getTrips());
+}
+
+void ControlTask::publishSnapshot() {
+    StateSnapshot snapshot;
+    snapshot.sequence = ++snapshot_sequence_;
+    snapshot.timestamp_ms = millis();
+    snapshot.pulse_count = state_manager_.getPulseSnapshot().count;
+    snapshot.rode_length = state_manager_.getRodeLength();
+    snapshot.chain_speed = pulse_counter_service_.getChainSpeed();
+    snapshot.chain_acceleration = pulse_counter_service_.getChainAcceleration();
+    snapshot.chain_stalled = pulse_counter_service_.isChainStalled();
+    snapshot.rode_verified = state_manager_.isRodeVerified();
+    snapshot.winch_direction = winch_controller_.isMovingUp() ? 1 : (winch_controller_.isMovingDown() ? -1 : 0);
+    if (bow_propeller_controller_) {
+        snapshot.bow_direction = bow_propeller_controller_->isTurningStarboard()
+                                     ? 1
+                                     : (bow_propeller_controller_->isTurningPort() ? -1 : 0);
+        snapshot.bow_thrust = bow_propeller_controller_->getAchievedThrust(snapshot.timestamp_ms);
+    }
+    if (auto_mode_controller_) {
+        snapshot.auto_mode_enabled = auto_mode_controller_->isEnabled();
+        snapshot.auto_mode_target = auto_mode_controller_->getTargetLength();
+        snapshot.auto_mode_scope = auto_mode_controller_->getScope();
+    }
+    snapshot.emergency_stop_active = state_manager_.isEmergencyStopActive();
+    state_manager_.publishSnapshot(snapshot);
+}
@@ -0,0 +1,130 @@
+#include "services/DirectCommandService.h"
+#include <cstring>
+#include "sensesp_app.h"
+#include "sensesp/system/local_debug.h"
+#include "sensesp/ui/status_page_item.h"
+#include "services/EventLogger.h"
+#include "services/PerfMonitor.h"
+#include "util/StaticArena.h"
+
+#if DIRECT_COMMAND_USE_UDP
+#include <AsyncUDP.h>
+#include "esp_random.h"
+#endif
+
+using namespace sensesp;
+
+namespace {
+#if DIRECT_COMMAND_USE_UDP
+    AsyncUDP g_direct_udp;
+#endif
+
+    // Storage for the status page items
+    StaticArena<arenaBytes<StatusPageItem<int>>(3)> g_direct_arena;
+
+    StatusPageItem<int>* g_accepted = nullptr;
+    StatusPageItem<int>* g_blocked = nullptr;
+    StatusPageItem<int>* g_rejected = nullptr;
+}
+
+DirectCommandService::DirectCommandService(StateManager& state_manager, ControlTask& control_task,
+                                           const uint8_t* key)
+    : state_manager_(state_manager), control_task_(control_task), replay_guard_(0) {
+    memcpy(key_, key, sizeof(key_));
+}
+
+void DirectCommandService::initialize(NetworkScheduler& scheduler) {
+    g_accepted = g_direct_arena.create<StatusPageItem<int>>("Direct commands accepted", 0, "Direct link", 1500);
+    g_blocked = g_direct_arena.create<StatusPageItem<int>>("Direct commands blocked", 0, "Direct link", 1501);
+    g_rejected = g_direct_arena.create<StatusPageItem<int>>("Direct frames rejected", 0, "Direct link", 1502);
+
+    scheduler.add("Direct status", STATUS_INTERVAL_MS, STATUS_BUDGET_US,
+                  [](void* self) { static_cast<DirectCommandService*>(self)->publishStatus(); }, this);
+
+#if DIRECT_COMMAND_USE_UDP
+    // RF is up (SensESP started WiFi): esp_random() is a true random source now
+    replay_guard_.reset(esp_random() | 1);
+    if (!g_direct_udp.listen(DIRECT_COMMAND_PORT)) {
+        debugD("Direct link: cannot listen on UDP %u", DIRECT_COMMAND_PORT);
+        return;
+    }
+    g_direct_udp.onPacket([this](AsyncUDPPacket& packet) {
+        uint8_t reply[DIRECT_FRAME_SIZE];
+        if (receive(packet.data(), packet.length(), reply)) {
+            packet.write(reply, sizeof(reply));
+        }
+    });
+    debugD("Direct link listening on UDP %u", DIRECT_COMMAND_PORT);
+#endif
+}
+
+bool DirectCommandService::receive(const uint8_t* data, size_t length, uint8_t* reply) {
+    DirectFrame frame;
+    if (decodeDirectFrame(data, length, key_, frame) != DirectFrameStatus::ACCEPTED ||
+        frame.kind != DirectFrameKind::COMMAND) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;  // Not authentic: no reply, nothing to amplify
+    }
+
+    DirectFrameStatus status = replay_guard_.check(frame);
+    if (status == DirectFrameStatus::REPLAY) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (status == DirectFrameStatus::NONCE) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        encodeAck(frame, status, reply);  // Tells the helm the current nonce
+        return true;
+    }
+
+    if (frame.rtt_ms != DIRECT_RTT_UNKNOWN) {
+        PerfMonitor::recordUs(PerfProbe::DIRECT_ROUND_TRIP, frame.rtt_ms * 1000UL);
+    }
+
+    // Same guards as the SignalK command table; the authentic frame stands in for a stable connection
+    uint8_t guards = 0;
+    bool allowed = directCommandGuards(frame.command, guards) &&
+                   skCommandAllowed(guards, frame.value, state_manager_.readSnapshot().emergency_stop_active, true);
+    if (!allowed) {
+        blocked_.fetch_add(1, std::memory_order_relaxed);
+        encodeAck(frame, DirectFrameStatus::BLOCKED, reply);
+        return true;
+    }
+
+    const ControlCommandType type = static_cast<ControlCommandType>(frame.command);
+    if (type == ControlCommandType::MANUAL_WINCH && (frame.value > 0.5f || frame.value < -0.5f)) {
+        PerfMonitor::begin(PerfProbe::DIRECT_COMMAND_TO_RELAY);
+    }
+
+    // Hold-to-run: the control task expires the lease of winch and thruster motion
+    // (ignored by other commands)
+    if (!control_task_.submit({type, frame.value, CommandSource::DIRECT, 0, DIRECT_HOLD_TIMEOUT_MS})) {
+        if (type == ControlCommandType::MANUAL_WINCH) {
+            PerfMonitor::cancel(PerfProbe::DIRECT_COMMAND_TO_RELAY);
+        }
+        blocked_.fetch_add(1, std::memory_order_relaxed);
+        encodeAck(frame, DirectFrameStatus::BLOCKED, reply);
+        return true;
+    }
+    accepted_.fetch_add(1, std::memory_order_relaxed);
+    EventLogger::log(LogEvent::DIRECT_COMMAND, frame.command, frame.value);
+    encodeAck(frame, DirectFrameStatus::ACCEPTED, reply);
+    return true;
+}
+
+void DirectCommandService::publishStatus() {
+    g_accepted->set(static_cast<int>(getAccepted()));
+    g_blocked->set(static_cast<int>(getBlocked()));
+    g_rejected->set(static_cast<int>(getRejected()));
+}
+
+void DirectCommandService::encodeAck(const DirectFrame& frame, DirectFrameStatus status, uint8_t* reply) const {
+    DirectFrame ack;
+    ack.kind = DirectFrameKind::ACK;
+    ack.nonce = replay_guard_.nonce();
+    ack.sequence = frame.sequence;
+    ack.sender_ms = frame.sender_ms;  // Echo: the helm computes the round trip
+    ack.command = frame.command;
+    ack.status = static_cast<uint8_t>(status);
+    encodeDirectFrame(ack, key_, reply);
+}
@@ -0,0 +1,44 @@
+#include "services/EventLogger.h"
+#include "sensesp_app.h"
+#include "sensesp/ui/status_page_item.h"
+#include "util/StaticArena.h"
+
+using namespace sensesp;
+
+namespace {
+    // Storage for the status page items
+    StaticArena<arenaBytes<StatusPageItem<String>>() + arenaBytes<StatusPageItem<int>>(3)> g_log_arena;
+
+    StatusPageItem<String>* g_last_event = nullptr;
+    StatusPageItem<int>* g_logged = nullptr;
+    StatusPageItem<int>* g_coalesced = nullptr;
+    StatusPageItem<int>* g_overwritten = nullptr;
+}
+
+void EventLogger::initialize(NetworkScheduler& scheduler) {
+    g_last_event = g_log_arena.create<StatusPageItem<String>>("Last event", "none", "Event log", 1300);
+    g_logged = g_log_arena.create<StatusPageItem<int>>("Events logged", 0, "Event log", 1301);
+    g_coalesced = g_log_arena.create<StatusPageItem<int>>("Events merged", 0, "Event log", 1302);
+    g_overwritten = g_log_arena.create<StatusPageItem<int>>("Events overwritten", 0, "Event log", 1303);
+
+    scheduler.add("Event log drain", DRAIN_INTERVAL_MS, DRAIN_BUDGET_US,
+                  [](void* self) { static_cast<EventLogger*>(self)->drain(); }, this);
+}
+
+void EventLogger::drain() {
+    EventRecord record;
+    char text[96];
+    bool any = false;
+    for (uint8_t i = 0; i < DRAIN_BATCH && log_.pop(record); i++) {
+        format(record, text, sizeof(text));
+        debugD("[%lu ms] %s", (unsigned long)record.timestamp_ms, text);
+        any = true;
+    }
+    if (!any) {
+        return;
+    }
+    g_last_event->set(String(text));
+    g_logged->set(static_cast<int>(log_.logged()));
+    g_coalesced->set(static_cast<int>(log_.coalesced()));
+    g_overwritten->set(static_cast<int>(log_.overwritten()));
+}
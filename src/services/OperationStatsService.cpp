@@ -0,0 +1,114 @@
+#include "services/OperationStatsService.h"
+#include "sensesp_app.h"
+#include "sensesp/signalk/signalk_output.h"
+#include "sensesp/system/local_debug.h"
+#include "sensesp/ui/status_page_item.h"
+#include "util/StaticArena.h"
+
+using namespace sensesp;
+
+namespace {
+    SKOutputRawJson* g_session_output = nullptr;
+    SKOutputRawJson* g_lifetime_output = nullptr;
+    StatusPageItem<String>* g_chain_status = nullptr;
+    StatusPageItem<String>* g_motor_status = nullptr;
+
+    // Storage for the outputs and status items
+    StaticArena<arenaBytes<SKOutputRawJson>(2) + arenaBytes<StatusPageItem<String>>(2)> g_stats_arena;
+
+    float seconds(const uint32_t (&values)[OPERATION_STAT_COUNT], OperationStat stat) {
+        return values[static_cast<size_t>(stat)] * 0.001f;
+    }
+
+    unsigned long count(const uint32_t (&values)[OPERATION_STAT_COUNT], OperationStat stat) {
+        return static_cast<unsigned long>(values[static_cast<size_t>(stat)]);
+    }
+}
+
+void OperationStatsService::emergencyStop(CommandSource source) {
+    switch (source) {
+    case CommandSource::SIGNALK: session_.add(OperationStat::ESTOP_SIGNALK, 1); break;
+    case CommandSource::REMOTE: session_.add(OperationStat::ESTOP_REMOTE, 1); break;
+    case CommandSource::LOCAL: session_.add(OperationStat::ESTOP_LOCAL, 1); break;
+    case CommandSource::DIRECT: session_.add(OperationStat::ESTOP_DIRECT, 1); break;
+    }
+}
+
+bool OperationStatsService::restore() {
+    OperationStatsRecord record;
+    if (!store_.read(record) || !isValidOperationStatsRecord(record)) {
+        debugD("Operation statistics: no valid lifetime record, starting at 0");
+        return false;
+    }
+    memcpy(lifetime_base_, record.values, sizeof(lifetime_base_));
+    return true;
+}
+
+void OperationStatsService::initialize(NetworkScheduler& scheduler) {
+    g_session_output = g_stats_arena.create<SKOutputRawJson>(
+        "electrical.bow.ecu.statistics.session", "/statistics/session/sk_path");
+    g_lifetime_output = g_stats_arena.create<SKOutputRawJson>(
+        "electrical.bow.ecu.statistics.lifetime", "/statistics/lifetime/sk_path");
+    g_chain_status = g_stats_arena.create<StatusPageItem<String>>("Lifetime chain out / in", "",
+                                                                  "Statistics", 1700);
+    g_motor_status = g_stats_arena.create<StatusPageItem<String>>("Lifetime winch / thruster", "",
+                                                                  "Statistics", 1701);
+
+    scheduler.add("Stats save", SAVE_INTERVAL_MS, SAVE_BUDGET_US,
+                  [](void* self) { static_cast<OperationStatsService*>(self)->flush(); }, this);
+}
+
+void OperationStatsService::flush() {
+    uint32_t session[OPERATION_STAT_COUNT];
+    session_.snapshot(session);
+    if (published_ && memcmp(session, last_flushed_, sizeof(session)) == 0) {
+        return;  // Nothing counted since the last batch
+    }
+
+    uint32_t lifetime[OPERATION_STAT_COUNT];
+    for (size_t i = 0; i < OPERATION_STAT_COUNT; i++) {
+        lifetime[i] = lifetime_base_[i] + session[i];
+    }
+    if (memcmp(session, last_flushed_, sizeof(session)) != 0) {
+        if (store_.write(makeOperationStatsRecord(lifetime))) {
+            writes_++;
+        } else {
+            debugW("Operation statistics: lifetime record write failed");
+        }
+    }
+    memcpy(last_flushed_, session, sizeof(session));
+
+    publish(session, false);
+    publish(lifetime, true);
+    published_ = true;
+
+    const float meters_per_pulse = state_manager_.getMetersPerPulse();
+    char text[64];
+    snprintf(text, sizeof(text), "%.0f m / %.0f m",
+             count(lifetime, OperationStat::DEPLOYED_PULSES) * meters_per_pulse,
+             count(lifetime, OperationStat::RETRIEVED_PULSES) * meters_per_pulse);
+    g_chain_status->set(String(text));
+    snprintf(text, sizeof(text), "%.1f h / %.1f h",
+             (seconds(lifetime, OperationStat::WINCH_UP_MS) + seconds(lifetime, OperationStat::WINCH_DOWN_MS)) / 3600.0f,
+             seconds(lifetime, OperationStat::BOW_MS) / 3600.0f);
+    g_motor_status->set(String(text));
+}
+
+void OperationStatsService::publish(const uint32_t (&values)[OPERATION_STAT_COUNT], bool lifetime) {
+    const float meters_per_pulse = state_manager_.getMetersPerPulse();
+    char json[384];
+    snprintf(json, sizeof(json),
+             "{\"deployed\":%.1f,\"retrieved\":%.1f,"
+             "\"winchUpTime\":%.1f,\"winchDownTime\":%.1f,"
+             "\"winchUpStarts\":%lu,\"winchDownStarts\":%lu,"
+             "\"bowThrusterTime\":%.1f,\"bowThrusterStarts\":%lu,"
+             "\"emergencyStops\":{\"signalk\":%lu,\"remote\":%lu,\"local\":%lu,\"direct\":%lu}}",
+             count(values, OperationStat::DEPLOYED_PULSES) * meters_per_pulse,
+             count(values, OperationStat::RETRIEVED_PULSES) * meters_per_pulse,
+             seconds(values, OperationStat::WINCH_UP_MS), seconds(values, OperationStat::WINCH_DOWN_MS),
+             count(values, OperationStat::WINCH_UP_STARTS), count(values, OperationStat::WINCH_DOWN_STARTS),
+             seconds(values, OperationStat::BOW_MS), count(values, OperationStat::BOW_STARTS),
+             count(values, OperationStat::ESTOP_SIGNALK), count(values, OperationStat::ESTOP_REMOTE),
+             count(values, OperationStat::ESTOP_LOCAL), count(values, OperationStat::ESTOP_DIRECT));
+    (lifetime ? g_lifetime_output : g_session_output)->set_input(String(json));
+}
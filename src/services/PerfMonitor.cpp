@@ -0,0 +1,84 @@
+#include "services/PerfMonitor.h"
+#include "sensesp_app.h"
+#include "sensesp/signalk/signalk_output.h"
+#include "sensesp/ui/status_page_item.h"
+#include "util/StaticArena.h"
+
+using namespace sensesp;
+
+namespace {
+    // SignalK path segment and status page label per probe (PerfProbe order)
+    const char* const kProbeNames[] = {
+        "pulseIsr", "remoteIsr", "eventLoopTick", "commandToRelay", "commandQueueDelay", "homeIsrToRelay", "homeToStop",
+        "directCommandToRelay", "directRoundTrip",
+    };
+    const char* const kProbeTitles[] = {
+        "Pulse ISR", "Remote ISR", "Event loop tick", "Command to relay", "Command queue delay", "Home ISR to relay", "Home to stop",
+        "Direct command to relay", "Direct round trip",
+    };
+
+    struct ProbeOutputs {
+        SKOutputFloat* min = nullptr;
+        SKOutputFloat* p50 = nullptr;
+        SKOutputFloat* p99 = nullptr;
+        SKOutputFloat* max = nullptr;
+        StatusPageItem<String>* status = nullptr;
+    };
+    constexpr size_t kProbeCount = static_cast<size_t>(PerfProbe::COUNT);
+    ProbeOutputs g_probe_outputs[kProbeCount];
+
+    // Storage for the per-probe outputs and status items (SKMetadata stays on the heap)
+    StaticArena<arenaBytes<SKOutputFloat>(4 * kProbeCount) +
+                arenaBytes<StatusPageItem<String>>(kProbeCount)> g_perf_arena;
+
+    SKOutputFloat* makeOutput(const char* probe, const char* stat) {
+        String path = String("electrical.bow.ecu.perf.") + probe + "." + stat;
+        String config = String("/perf/") + probe + "/" + stat + "/sk_path";
+        return g_perf_arena.create<SKOutputFloat>(path, config, new SKMetadata("s"));
+    }
+}
+
+void PerfMonitor::initialize(NetworkScheduler& scheduler) {
+    cycles_per_us_ = getCpuFrequencyMhz();
+
+    for (uint8_t i = 0; i < PROBE_COUNT; i++) {
+        ProbeOutputs& outputs = g_probe_outputs[i];
+        outputs.min = makeOutput(kProbeNames[i], "min");
+        outputs.p50 = makeOutput(kProbeNames[i], "p50");
+        outputs.p99 = makeOutput(kProbeNames[i], "p99");
+        outputs.max = makeOutput(kProbeNames[i], "max");
+        outputs.status = g_perf_arena.create<StatusPageItem<String>>(kProbeTitles[i], "no samples",
+                                                                     "Performance", 1000 + i);
+    }
+
+    scheduler.add("Perf publish", PUBLISH_INTERVAL_MS, PUBLISH_BUDGET_US,
+                  [](void* self) { static_cast<PerfMonitor*>(self)->publish(); }, this);
+}
+
+void PerfMonitor::publish() {
+    for (uint8_t i = 0; i < PROBE_COUNT; i++) {
+        LatencyHistogram& histogram = histograms_[i];
+        ProbeOutputs& outputs = g_probe_outputs[i];
+        uint32_t count = histogram.count();
+        if (count == 0) {
+            continue;  // Nothing ran in this window; keep the last published values
+        }
+
+        uint32_t min_us = histogram.min();
+        uint32_t p50_us = histogram.percentile(50);
+        uint32_t p99_us = histogram.percentile(99);
+        uint32_t max_us = histogram.max();
+        histogram.reset();
+
+        outputs.min->set_input(min_us * 1e-6f);
+        outputs.p50->set_input(p50_us * 1e-6f);
+        outputs.p99->set_input(p99_us * 1e-6f);
+        outputs.max->set_input(max_us * 1e-6f);
+
+        char text[64];
+        snprintf(text, sizeof(text), "%lu/%lu/%lu/%lu us (n=%lu)",
+                 (unsigned long)min_us, (unsigned long)p50_us,
+                 (unsigned long)p99_us, (unsigned long)max_us, (unsigned long)count);
+        outputs.status->set(String(text));
+    }
+}
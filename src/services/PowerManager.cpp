@@ -0,0 +1,309 @@
+#include "services/PowerManager.h"
+#include "pin_config.h"
+#include "hardware/ESP32PulseCounter.h"
+#include "hardware/GpioSnapshot.h"
+#include "services/EventLogger.h"
+#include "services/WindlassChannels.h"
+#include "sensesp/system/local_debug.h"
+#include "sensesp/ui/status_page_item.h"
+#include "util/StaticArena.h"
+
+#if POWER_USE_IDLE_SLEEP
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#include "esp_wifi.h"
+#include "soc/gpio_struct.h"
+#endif
+
+using namespace sensesp;
+
+namespace {
+    StaticArena<arenaBytes<StatusPageItem<String>>(2)> g_power_arena;
+    StatusPageItem<String>* g_mode_status = nullptr;
+    StatusPageItem<String>* g_idle_status = nullptr;
+
+    constexpr unsigned STATUS_EVERY_RUNS = 4;  ///< Status refresh every fourth publish()
+    unsigned g_publish_runs = 0;
+
+#if POWER_USE_IDLE_SLEEP
+    // GPIO interrupt types (gpio_int_type_t) used as wake levels
+    constexpr uint8_t kWakeOnLow = 4;
+    constexpr uint8_t kWakeOnHigh = 5;
+    constexpr uint8_t kNotArmed = 0xFF;
+
+    // Remote, home and pulse inputs of every windlass; read by wakeFromIsr() (DRAM)
+    constexpr size_t kWakePinsMax = 6 + 2 * EXTRA_WINDLASS_CHANNELS;
+    uint8_t g_wake_pins[kWakePinsMax];
+    uint8_t g_edge_types[kWakePinsMax];    ///< Interrupt type to restore
+    uint8_t g_armed_levels[kWakePinsMax];  ///< Armed wake level, kNotArmed if none
+#if PULSE_COUNTER_USE_PCNT
+    ESP32PulseCounter* g_pulse_inputs[kWakePinsMax];  ///< PCNT counter of the pin, nullptr if none
+#endif
+    size_t g_wake_pin_count = 0;
+    volatile bool g_any_armed = false;     ///< Fast exit for wakeFromIsr()
+    std::atomic<bool> g_pulse_woke{false}; ///< A pulse input woke the CPU, not yet accounted
+    portMUX_TYPE g_wake_lock = portMUX_INITIALIZER_UNLOCKED;
+
+    esp_pm_lock_handle_t g_active_lock = nullptr;  ///< Held while active: no light sleep
+    bool g_lock_held = false;                      ///< g_active_lock acquired (g_wake_lock)
+
+    void addWakePin(uint8_t pin) {
+        g_wake_pins[g_wake_pin_count] = pin;
+        g_armed_levels[g_wake_pin_count] = kNotArmed;
+#if PULSE_COUNTER_USE_PCNT
+        g_pulse_inputs[g_wake_pin_count] = nullptr;
+#endif
+        g_wake_pin_count++;
+    }
+
+    // Caller holds g_wake_lock
+    inline void IRAM_ATTR disarmLocked() {
+        for (size_t i = 0; i < g_wake_pin_count; i++) {
+            if (g_armed_levels[i] != kNotArmed) {
+                GPIO.pin[g_wake_pins[i]].wakeup_enable = 0;
+                GPIO.pin[g_wake_pins[i]].int_type = g_edge_types[i];
+                g_armed_levels[i] = kNotArmed;
+            }
+        }
+        g_any_armed = false;
+    }
+
+    // Caller holds g_wake_lock
+    inline void IRAM_ATTR holdActiveLocked() {
+#if CONFIG_PM_ENABLE
+        if (!g_lock_held) {
+            esp_pm_lock_acquire(g_active_lock);
+    g_lock_held = true;
+            g_lock_held = true;
+        }
+#endif
+    }
+
+    // Caller holds g_wake_lock
+    inline void releaseActiveLocked() {
+#if CONFIG_PM_ENABLE
+        if (g_lock_held) {
+            esp_pm_lock_release(g_active_lock);
+            g_lock_held = false;
+        }
+#endif
+    }
+
+#if PULSE_COUNTER_USE_PCNT
+    // PCNT inputs registered before start()
+    ESP32PulseCounter* g_pulse_counters[1 + EXTRA_WINDLASS_CHANNELS];
+    size_t g_pulse_counter_count = 0;
+
+    // Armed PCNT input changed level. PCNT stopped in light sleep, so keep the
+    // CPU awake from here on and hand a counted edge back to its counter.
+    void IRAM_ATTR pulseWakeISR(void* arg) {
+        const size_t index = static_cast<size_t>(reinterpret_cast<uintptr_t>(arg));
+        portENTER_CRITICAL_ISR(&g_wake_lock);
+        if (g_armed_levels[index] != kNotArmed) {  // Else already disarmed by another wake
+            if (g_armed_levels[index] == kWakeOnHigh) {
+                g_pulse_inputs[index]->wakeEdgeFromIsr();  // Rising edge: the counted one
+            }
+            disarmLocked();
+            holdActiveLocked();
+            g_pulse_woke.store(true, std::memory_order_relaxed);
+        }
+        portEXIT_CRITICAL_ISR(&g_wake_lock);
+    }
+
+    void addPulseWakePin(ESP32PulseCounter& counter) {
+        const size_t index = g_wake_pin_count;
+        addWakePin(counter.pulsePin());
+        g_pulse_inputs[index] = &counter;
+        // PCNT counts the input; the interrupt only fires while it is armed as a wake source
+        attachInterruptArg(digitalPinToInterrupt(counter.pulsePin()), pulseWakeISR,
+                           reinterpret_cast<void*>(static_cast<uintptr_t>(index)), RISING);
+        GPIO.pin[counter.pulsePin()].int_type = 0;
+    }
+#endif
+#endif
+}
+
+void PowerManager::addPulseInput(ESP32PulseCounter& counter) {
+#if POWER_USE_IDLE_SLEEP && PULSE_COUNTER_USE_PCNT
+    g_pulse_counters[g_pulse_counter_count++] = &counter;
+#else
+    (void)counter;
+#endif
+}
+
+void PowerManager::start() {
+#if POWER_USE_IDLE_SLEEP
+    g_wake_pin_count = 0;
+    addWakePin(PinConfig::REMOTE_UP);
+    addWakePin(PinConfig::REMOTE_DOWN);
+    addWakePin(PinConfig::REMOTE_FUNC3);
+    addWakePin(PinConfig::REMOTE_FUNC4);
+    addWakePin(PinConfig::ANCHOR_HOME);
+    for (size_t i = 0; i < EXTRA_WINDLASS_CHANNELS; i++) {
+        addWakePin(WindlassChannels::pins(i).anchor_home);
+    }
+#if PULSE_COUNTER_USE_PCNT
+    for (size_t i = 0; i < g_pulse_counter_count; i++) {
+        addPulseWakePin(*g_pulse_counters[i]);
+    }
+#else
+    addWakePin(PinConfig::PULSE_INPUT);  // pulseISR counts the wake edge itself
+#endif
+
+#if CONFIG_PM_ENABLE
+    // Take the lock before light sleep is allowed: the ECU starts active
+    esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "active", &g_active_lock);
+    esp_pm_lock_acquire(g_active_lock);
+
+    // No frequency scaling: PerfMonitor converts cycles at a fixed CPU clock
+    esp_pm_config_esp32_t config = {};
+    config.max_freq_mhz = getCpuFrequencyMhz();
+    config.min_freq_mhz = config.max_freq_mhz;
+    config.light_sleep_enable = true;
+    const esp_err_t result = esp_pm_configure(&config);
+    light_sleep_ = result == ESP_OK;
+    if (light_sleep_) {
+        esp_sleep_enable_gpio_wakeup();
+        debugD("Power: automatic light sleep when idle, %u wake inputs", (unsigned)g_wake_pin_count);
+    } else {
+        debugD("Power: automatic light sleep not available (%s) - modem sleep only",
+               esp_err_to_name(result));
+    }
+#else
+    debugD("Power: framework built without CONFIG_PM_ENABLE - modem sleep only");
+#endif
+#endif
+}
+
+void PowerManager::update(bool active, uint32_t now_ms) {
+#if POWER_USE_IDLE_SLEEP
+    // The chain moves: stay awake until the count has settled
+    const bool pulse_woke = g_pulse_woke.exchange(false, std::memory_order_relaxed);
+#else
+    const bool pulse_woke = false;
+#endif
+    switch (tracker_.update(active || pulse_woke, now_ms)) {
+    case IdleTracker::Transition::ENTER_IDLE:
+        enterIdle();
+        break;
+    case IdleTracker::Transition::EXIT_IDLE:
+        exitIdle();
+        break;
+    case IdleTracker::Transition::NONE:
+        if (tracker_.isIdle() && light_sleep_) {
+            armWakeSources();  // Follow the levels of the inputs that did not fire
+        }
+        break;
+    }
+    idle_ms_.store(tracker_.idleMs(), std::memory_order_relaxed);
+}
+
+void PowerManager::enterIdle() {
+    idle_entries_.store(tracker_.idleEntries(), std::memory_order_relaxed);
+    idle_.store(true, std::memory_order_relaxed);
+#if POWER_USE_IDLE_SLEEP && CONFIG_PM_ENABLE
+    if (light_sleep_) {
+        armWakeSources();
+        portENTER_CRITICAL(&g_wake_lock);
+        if (!g_pulse_woke.load(std::memory_order_relaxed)) {
+            releaseActiveLocked();  // Otherwise the next update() leaves idle again
+        }
+        portEXIT_CRITICAL(&g_wake_lock);
+    }
+#endif
+    EventLogger::log(LogEvent::POWER_IDLE_ENTERED, static_cast<int32_t>(tracker_.idleEntries()));
+}
+
+void PowerManager::exitIdle() {
+#if POWER_USE_IDLE_SLEEP && CONFIG_PM_ENABLE
+    if (light_sleep_) {
+        portENTER_CRITICAL(&g_wake_lock);
+        holdActiveLocked();
+        disarmLocked();
+        portEXIT_CRITICAL(&g_wake_lock);
+    }
+#endif
+    idle_.store(false, std::memory_order_relaxed);
+    EventLogger::log(LogEvent::POWER_IDLE_EXITED);
+}
+
+void PowerManager::armWakeSources() {
+#if POWER_USE_IDLE_SLEEP
+    // Wake on the level opposite to the current one: any change wakes the CPU
+    portENTER_CRITICAL(&g_wake_lock);
+    if (g_pulse_woke.load(std::memory_order_relaxed)) {
+        portEXIT_CRITICAL(&g_wake_lock);
+        return;  // Leaving idle: keep the count snapshot of the wake
+    }
+    for (size_t i = 0; i < g_wake_pin_count; i++) {
+        const uint8_t pin = g_wake_pins[i];
+        const uint8_t level = GpioSnapshot::readPin(pin) ? kWakeOnLow : kWakeOnHigh;
+        if (g_armed_levels[i] == level) {
+            continue;
+        }
+        if (g_armed_levels[i] == kNotArmed) {
+            g_edge_types[i] = GPIO.pin[pin].int_type;
+        }
+#if PULSE_COUNTER_USE_PCNT
+        if (g_pulse_inputs[i]) {
+            g_pulse_inputs[i]->armWake();  // Count before the input can fire
+        }
+#endif
+        GPIO.pin[pin].int_type = level;
+        GPIO.pin[pin].wakeup_enable = 1;
+        g_armed_levels[i] = level;
+    }
+    g_any_armed = true;
+    portEXIT_CRITICAL(&g_wake_lock);
+#endif
+}
+
+void IRAM_ATTR PowerManager::wakeFromIsr() {
+#if POWER_USE_IDLE_SLEEP
+    if (!g_any_armed) {
+        return;
+    }
+    portENTER_CRITICAL_ISR(&g_wake_lock);
+    disarmLocked();
+    portEXIT_CRITICAL_ISR(&g_wake_lock);
+#endif
+}
+
+void PowerManager::initialize(NetworkScheduler& scheduler) {
+    g_mode_status = g_power_arena.create<StatusPageItem<String>>("Power mode", "active", "Power", 1900);
+    g_idle_status = g_power_arena.create<StatusPageItem<String>>("Idle time", "0 %", "Power", 1901);
+
+    scheduler.add("Power mode", PUBLISH_INTERVAL_MS, PUBLISH_BUDGET_US,
+                  [](void* self) { static_cast<PowerManager*>(self)->publish(); }, this);
+}
+
+void PowerManager::publish() {
+    const bool idle = isIdle();
+#if POWER_USE_IDLE_SLEEP
+    // Modem sleep only while idle: no DTIM wait for commands while something moves
+    if (idle != wifi_power_save_ && esp_wifi_set_ps(idle ? WIFI_PS_MIN_MODEM : WIFI_PS_NONE) == ESP_OK) {
+        wifi_power_save_ = idle;
+    }
+#endif
+
+    if (++g_publish_runs % STATUS_EVERY_RUNS != 0) {
+        return;
+    }
+    const char* mode = "active";
+    if (idle) {
+#if POWER_USE_IDLE_SLEEP
+        mode = light_sleep_ ? "idle: light sleep, modem sleep" : "idle: modem sleep";
+#else
+        mode = "idle (power saving disabled)";
+#endif
+    }
+    g_mode_status->set(String(mode));
+
+    char text[48];
+    const uint32_t uptime_ms = millis();
+    const uint32_t idle_ms = idle_ms_.load(std::memory_order_relaxed);
+    snprintf(text, sizeof(text), "%lu %% (%lu entries)",
+             (unsigned long)(uptime_ms > 0 ? static_cast<uint64_t>(idle_ms) * 100 / uptime_ms : 0),
+             (unsigned long)idle_entries_.load(std::memory_order_relaxed));
+    g_idle_status->set(String(text));
+}
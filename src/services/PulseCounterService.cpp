@@ -1,50 +1,115 @@
 #include "services/PulseCounterService.h"
 #include "sensesp_app.h"
 #include "sensesp/system/local_debug.h"
+#include "services/EventLogger.h"
+#include "services/OperationStatsService.h"
+#include "services/PerfMonitor.h"
+#include "services/Supervisor.h"
+#include "services/TraceRecorder.h"
+#include "hardware/GpioSnapshot.h"
+#include "pin_config.h"
 
 using namespace sensesp;
 
-void PulseCounterService::initialize() {
-    // Set up repeating task to update pulse count and rode length
-    event_loop()->onRepeat(read_delay_ms_, [this]() { this->update(); });
+void PulseCounterService::restoreCounter() {
+    state_manager_.setRodeVerified(false);
+    if (!persistence_) {
+        return;
+    }
+    int32_t pulse_count = 0;
+    persistence_->restore(pulse_count);
+    state_manager_.setPulseCount(pulse_count);
+    state_manager_.setRodeLength(pulse_count * state_manager_.getMetersPerPulse());
 }
 
 void PulseCounterService::update() {
+    // Pull pulses counted in hardware since the last tick
+    if (pulse_source_) {
+        long delta = pulse_source_->takeDelta();
+        if (delta != 0) {
+            state_manager_.addPulses(delta);
+            // Hardware counts have no per-edge time; record the batch at the poll time
+            state_manager_.pushPulseEdge({static_cast<uint32_t>(micros()),
+                                          static_cast<int32_t>(delta)});
+        }
+    }
+
+    // Period-based speed from the edge timestamps (no allocation)
+    float meters_per_pulse = state_manager_.getMetersPerPulse();
+    PulseEdge edge;
+    while (state_manager_.popPulseEdge(edge)) {
+        TraceRecorder::recordAt(edge.timestamp_us, TraceEvent::PULSE, 0, 0, edge.pulses);
+        motion_.addEdge(edge, meters_per_pulse);
+    }
+    motion_.update(static_cast<uint32_t>(micros()), meters_per_pulse, winch_controller_.isActive());
+
+    // Home ISR already cut the relay; edge time (if any) for the latency probe
+    uint32_t home_edge_cycles = 0;
+    bool home_edge = state_manager_.takeHomeEdge(home_edge_cycles);
+    if (home_edge && !home_sensor_.isHome() &&
+        static_cast<int32_t>(home_edge_cycles - GpioSnapshot::captureCycles()) > 0) {
+        // Edge arrived after this pass's GPIO snapshot: handle it next tick
+        state_manager_.postHomeEdge(home_edge_cycles);
+        home_edge = false;
+    }
+
     // Handle home sensor logic
     if (home_sensor_.isHome()) {
         // Anchor is at home
         if (winch_controller_.isMovingUp()) {
+            // Sync winch state (and cut the relay if the ISR path did not run)
             winch_controller_.stop();
-            debugD("Anchor home reached - stopped");
+            PerfMonitor::record(PerfProbe::HOME_TO_STOP,
+                                home_edge ? home_edge_cycles
+                                          : GpioSnapshot::edgeCycles(PinConfig::ANCHOR_HOME));
+            EventLogger::log(LogEvent::HOME_STOPPED);
         }
         
         if (home_sensor_.justArrived()) {
-            // Just arrived at home - reset counter
-            state_manager_.setPulseCount(0);
-            debugD("Anchor at home - counter reset");
+            // Just arrived at home - reset counter (applied by the drain below)
+            state_manager_.requestPulseReset();
+            state_manager_.setRodeVerified(true);
+            EventLogger::log(LogEvent::HOME_COUNTER_RESET);
         }
         
         // If auto-mode was targeting home (0.0), disable it
         if (state_manager_.isAutoModeEnabled() &&
             state_manager_.getAutoModeTarget() == 0.0f) {
             state_manager_.setAutoModeEnabled(false);
-            debugD("Auto-home reached - automatic mode disabled");
+            EventLogger::log(LogEvent::AUTO_HOME_DONE);
         }
     } else {
         // Keep edge tracking accurate when not at home
         home_sensor_.justLeft();
     }
 
-    // Calculate and update rode length
-    long pulse_count = state_manager_.getPulseCount();
-    float meters_per_pulse = state_manager_.getMetersPerPulse();
+    // Drain ISR/hardware pulses and calculate rode length
+    PulseSnapshot snapshot = state_manager_.drainPulses(millis());
+    OperationStatsService::addPulses(snapshot.delta);
+    long pulse_count = snapshot.count;
     float meters = pulse_count * meters_per_pulse;
     state_manager_.setRodeLength(meters);
 
+    // Live count to RTC memory; a journal record once the count settled with
+    // the winch off (after the coast, or chain moved by hand), and at once
+    // when the counter was reset (home, reset command)
+    if (persistence_) {
+        const int32_t count = static_cast<int32_t>(pulse_count);
+        persistence_->updateLive(count);
+        if (snapshot.epoch != journaled_epoch_) {
+            persistence_->requestJournal(count);
+            journal_settle_.markReported(count);
+            journaled_epoch_ = snapshot.epoch;
+        } else if (journal_settle_.update(count, winch_controller_.isActive(), snapshot.timestamp_ms)) {
+            persistence_->requestJournal(count);
+        }
+    }
+
     // Periodic debug output (throttled)
-    const unsigned long now_ms = millis();
+    const unsigned long now_ms = snapshot.timestamp_ms;
     if (now_ms - last_debug_ms_ > 5000) {
-        debugD("Pulses: %ld, Chain: %.2f m", pulse_count, meters);
+        EventLogger::log(LogEvent::PULSE_STATUS, pulse_count, meters);
         last_debug_ms_ = now_ms;
     }
+    Supervisor::checkIn(SupervisedTask::PULSE_PROCESSING);
 }
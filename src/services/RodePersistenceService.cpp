@@ -0,0 +1,72 @@
+#include "services/RodePersistenceService.h"
+#include <Arduino.h>
+#include "esp_system.h"
+#include "sensesp_app.h"
+#include "sensesp/system/local_debug.h"
+
+using namespace sensesp;
+
+// Live counter, kept by the RTC domain across everything but a power loss
+RTC_NOINIT_ATTR static RodeRecord g_rtc_rode;
+
+void RodePersistenceService::initialize(NetworkScheduler& scheduler) {
+    scheduler.add("Rode journal", FLUSH_INTERVAL_MS, FLUSH_BUDGET_US,
+                  [](void* self) { static_cast<RodePersistenceService*>(self)->flush(); }, this);
+}
+
+RodePersistenceService::RestoreSource RodePersistenceService::restore(int32_t& pulse_count) {
+    RestoreSource source = RestoreSource::NONE;
+    pulse_count = 0;
+
+    // RTC memory content is undefined after power-on; only trust it after a reset
+    if (esp_reset_reason() != ESP_RST_POWERON && isValidRodeRecord(g_rtc_rode)) {
+        pulse_count = g_rtc_rode.pulse_count;
+        source = RestoreSource::RTC;
+    }
+
+    // Always read the journal so the next append continues its sequence
+    int32_t journal_count = 0;
+    if (journal_.restore(journal_count) && source == RestoreSource::NONE) {
+        pulse_count = journal_count;
+        source = RestoreSource::JOURNAL;
+    }
+
+    updateLive(pulse_count);
+    debugD("Rode counter restored from %s: %ld pulses (unverified until home)",
+           sourceName(source), (long)pulse_count);
+    return source;
+}
+
+void RodePersistenceService::updateLive(int32_t pulse_count) {
+    if (has_live_ && pulse_count == live_count_) {
+        return;
+    }
+    g_rtc_rode = makeRodeRecord(0, pulse_count);
+    live_count_ = pulse_count;
+    has_live_ = true;
+}
+
+void RodePersistenceService::requestJournal(int32_t pulse_count) {
+    pending_count_.store(pulse_count, std::memory_order_relaxed);
+    journal_pending_.store(true, std::memory_order_release);
+}
+
+void RodePersistenceService::flush() {
+    if (!journal_pending_.exchange(false, std::memory_order_acquire)) {
+        return;
+    }
+    int32_t pulse_count = pending_count_.load(std::memory_order_relaxed);
+    if (journal_.append(pulse_count)) {
+        journal_writes_++;
+        debugD("Rode counter journaled: %ld pulses", (long)pulse_count);
+    }
+}
+
+const char* RodePersistenceService::sourceName(RestoreSource source) {
+    switch (source) {
+    case RestoreSource::RTC: return "RTC memory";
+    case RestoreSource::JOURNAL: return "NVS journal";
+    case RestoreSource::NONE: break;
+    }
+    return "nothing";
+}
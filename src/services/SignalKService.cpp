@@ -1,17 +1,49 @@
 #include "services/SignalKService.h"
 #include "sensesp/signalk/signalk_value_listener.h"
-#include "sensesp/transforms/lambda_transform.h"
 #include "sensesp/system/valueconsumer.h"
 #include "sensesp_app.h"
+#include "services/BootMetrics.h"
+#include "services/EventLogger.h"
+#include "services/PerfMonitor.h"
 
 using namespace sensesp;
 
+namespace {
+    /**
+     * @brief Listener sink that forwards a value to its command table entry
+     */
+    template <typename T>
+    class SKCommandRoute : public ValueConsumer<T> {
+    public:
+        SKCommandRoute(SignalKService& service, size_t index) : service_(service), index_(index) {}
+
+        void set(const T& new_value) override {
+            service_.dispatchCommand(index_, static_cast<float>(new_value));
+        }
+
+    private:
+        SignalKService& service_;  ///< Dispatcher
+        size_t index_;             ///< Entry in the command table
+    };
+}
+
+// Storage for the SignalK producers and consumers created in initialize().
+// SKMetadata stays on the heap: SKOutput keeps the pointer it is handed.
+static StaticArena<arenaBytes<SKOutputFloat>(SignalKService::FLOAT_OUTPUTS) +
+                   arenaBytes<SKOutputBool>(SignalKService::BOOL_OUTPUTS) +
+                   arenaBytes<SKOutputInt>(SignalKService::INT_OUTPUTS) + arenaBytes<BoolSKListener>(3) +
+                   arenaBytes<IntSKListener>(4) + arenaBytes<FloatSKListener>(6) +
+                   arenaBytes<SKCommandRoute<bool>>(3) + arenaBytes<SKCommandRoute<int>>(4) +
+                   arenaBytes<SKCommandRoute<float>>(6) +
+                   arenaBytes<ObservableValue<bool>>()> g_signalk_arena;
+
 SignalKService::SignalKService(StateManager& state_manager,
                                AnchorWinchController& winch_controller,
                                HomeSensor& home_sensor,
                                AutomaticModeController* auto_mode_controller,
                                EmergencyStopService* emergency_stop_service,
                                PulseCounterService* pulse_counter_service,
+                               ControlTask& control_task,
                                BowPropellerController* bow_propeller_controller)
     : state_manager_(state_manager),
       winch_controller_(winch_controller),
@@ -19,274 +51,200 @@ SignalKService::SignalKService(StateManager& state_manager,
       auto_mode_controller_(auto_mode_controller),
       emergency_stop_service_(emergency_stop_service),
       pulse_counter_service_(pulse_counter_service),
+      control_task_(control_task),
       bow_propeller_controller_(bow_propeller_controller) {}
 
-void SignalKService::initialize() {
+void SignalKService::initialize(NetworkScheduler& scheduler) {
+    scheduler_ = &scheduler;
     setupRodeLengthOutput();
     setupEmergencyStopBindings();
     setupManualControlBindings();
     setupAutoModeBindings();
     setupHomeCommandBindings();
     setupBowPropellerBindings();
+    setupBootMetricsOutputs();
+    setupCommandRoutes();
 }
 
 void SignalKService::setupRodeLengthOutput() {
     // Create the rode length output and set up periodic updates from state manager
-    rode_output_ = new SKOutputFloat("navigation.anchor.currentRode", "/rode_length_sensor/sk_path");
-    rode_output_->set_metadata(new SKMetadata("m"));  // Set units to meters
+    // All status outputs are batched: changes within one tick share one delta
+    status_publisher_.initialize();
+
+    auto* rode_sk_output = g_signalk_arena.create<SKOutputFloat>("navigation.anchor.currentRode", "/rode_length_sensor/sk_path");
+    rode_sk_output->set_metadata(new SKMetadata("m"));  // Set units to meters
+    rode_output_ = status_publisher_.add(rode_sk_output);
     rode_output_->set_input(0.0f);  // Initialize to 0
     
-    // Periodic emission of rode length every 1000ms
-    event_loop()->onRepeat(1000, [this]() { this->updateRodeLength(); });
+    // Chain motion telemetry (from pulse edge timestamps)
+    auto* speed_sk_output = g_signalk_arena.create<SKOutputFloat>("navigation.anchor.chainSpeed", "/chain_speed/sk_path");
+    speed_sk_output->set_metadata(new SKMetadata("m/s"));  // + = deploying, - = retrieving
+    chain_speed_output_ = status_publisher_.add(speed_sk_output);
+    chain_speed_output_->set_input(0.0f);
+    auto* accel_sk_output = g_signalk_arena.create<SKOutputFloat>("navigation.anchor.chainAcceleration", "/chain_acceleration/sk_path");
+    accel_sk_output->set_metadata(new SKMetadata("m/s2"));
+    chain_acceleration_output_ = status_publisher_.add(accel_sk_output);
+    chain_acceleration_output_->set_input(0.0f);
+    chain_stalled_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputBool>("navigation.anchor.chainStalled", "/chain_stalled/sk_path"));
+    chain_stalled_output_->set_input(false);
+    // False while a counter restored after a reset has not been confirmed at home
+    rode_verified_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputBool>("navigation.anchor.rodeVerified", "/rode_verified/sk_path"));
+    
+    // Status sampling every 100ms; adaptive emitters decide what is actually sent
+    scheduler_->add("Telemetry", STATUS_INTERVAL_MS, STATUS_BUDGET_US,
+                    [](void* self) { static_cast<SignalKService*>(self)->updateStatusOutputs(); }, this);
 
-    // Reset command listener
-    auto* reset_listener = new BoolSKListener("navigation.anchor.resetRode");
-    reset_output_ = new SKOutputBool("navigation.anchor.resetRode", "/reset_rode/sk_path");
+    // Reset command echo (self-clearing, see COMMAND_TABLE)
+    reset_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputBool>("navigation.anchor.resetRode", "/reset_rode/sk_path"));
     reset_output_->set_input(false);  // Clear command on boot
-    
-    reset_listener->connect_to(new LambdaTransform<bool, bool>([this](bool reset_signal) {
-        if (state_manager_.isEmergencyStopActive()) return reset_signal;
-        if (!state_manager_.areCommandsAllowed()) return reset_signal;  // Block until connection stable
-        if (reset_signal) {
-            state_manager_.setPulseCount(0);
-            state_manager_.setRodeLength(0.0f);
-            debugD("Reset command triggered");
-            // Clear command immediately to allow retriggering
-            reset_output_->set_input(false);
-        }
-        return reset_signal;
-    }));
 }
 
 void SignalKService::setupEmergencyStopBindings() {
-    auto* emergency_cmd_listener = new BoolSKListener("navigation.bow.ecu.emergencyStopCommand");
-    
     // Create ObservableValue for status with automatic SignalK emission
-    emergency_stop_status_value_ = new ObservableValue<bool>();
-    emergency_stop_status_value_->connect_to(new SKOutputBool(
+    emergency_stop_status_value_ = g_signalk_arena.create<ObservableValue<bool>>();
+    emergency_stop_status_value_->connect_to(status_publisher_.add(g_signalk_arena.create<SKOutputBool>(
         "navigation.bow.ecu.emergencyStopStatus",
         "/emergency_stop_status/sk_path"
-    ));
+    )));
     emergency_stop_status_value_->set(false);
     emergency_stop_status_value_->notify();  // Initialize and emit first value
-    
-    emergency_cmd_listener->connect_to(new LambdaTransform<bool, bool>([this](bool emergency_active) {
-        if (!state_manager_.areCommandsAllowed() && !state_manager_.isEmergencyStopActive()) {
-            // During startup, force status to false
-            if (emergency_stop_status_value_) {
-                emergency_stop_status_value_->set(false);
-                emergency_stop_status_value_->notify();
-            }
-            return emergency_active;
-        }
-
-        // Process command: delegate to emergency stop service
-        if (emergency_stop_service_) {
-            emergency_stop_service_->setActive(emergency_active, "signalk");
-            
-            // Update status value to reflect actual state and emit to SignalK
-            if (emergency_stop_status_value_) {
-                bool actual_state = emergency_stop_service_->isActive();
-                emergency_stop_status_value_->set(actual_state);
-                emergency_stop_status_value_->notify();
-                debugD("Emergency stop status updated: %s", actual_state ? "ACTIVE" : "CLEARED");
-            }
-        }
-        return emergency_active;
-    }))->connect_to(emergency_stop_status_value_);
 }
 
 void SignalKService::setupManualControlBindings() {
     // Manual Windlass Control: Single path with three states (1=UP, 0=STOP, -1=DOWN)
     // Manual control overrides automatic mode
-    manual_control_output_ = new SKOutputInt("navigation.anchor.manualControlStatus", "/manual_control_status/sk_path");
+    manual_control_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputInt>("navigation.anchor.manualControlStatus", "/manual_control_status/sk_path"));
     manual_control_output_->set_input(0);  // Initialize to STOP on boot
-    auto* manual_control_listener = new IntSKListener("navigation.anchor.manualControl");
-    
-    manual_control_listener->connect_to(new LambdaTransform<int, int>([this](int command) {
-        if (state_manager_.isEmergencyStopActive()) return 0;
-        if (!state_manager_.areCommandsAllowed()) return 0;  // Block until connection stable
-        // Manual control always overrides automatic mode
-        if (auto_mode_controller_) {
-            auto_mode_controller_->setEnabled(false);
-            state_manager_.setAutoModeEnabled(false);
-            if (auto_mode_output_) {
-                auto_mode_output_->set_input(0.0f);
-            }
-        }
-        
-        if (command == 1) {
-            winch_controller_.moveUp();
-        } else if (command == -1) {
-            winch_controller_.moveDown();
-        } else {
-            winch_controller_.stop();
-        }
-        debugD("Manual control: %s", command == 1 ? "UP" : (command == -1 ? "DOWN" : "STOP"));
-        return command;
-    }))->connect_to(manual_control_output_);
 }
 
 void SignalKService::setupAutoModeBindings() {
     // Automatic Mode Control: Enable/disable automatic windlass control
     // Using FloatSKListener (value > 0.5 = enable, <= 0.5 = disable)
-    auto_mode_output_ = new SKOutputFloat("navigation.anchor.automaticModeStatus", "/automatic_mode_status/sk_path");
+    auto_mode_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputFloat>("navigation.anchor.automaticModeStatus", "/automatic_mode_status/sk_path"));
     
     // Target Rode Length: Arm target for automatic mode
-    target_output_ = new SKOutputFloat("navigation.anchor.targetRodeStatus", "/target_rode_status/sk_path");
-    target_output_->set_metadata(new SKMetadata("m"));  // Set units to meters
+    auto* target_sk_output = g_signalk_arena.create<SKOutputFloat>("navigation.anchor.targetRodeStatus", "/target_rode_status/sk_path");
+    target_sk_output->set_metadata(new SKMetadata("m"));  // Set units to meters
+    target_output_ = status_publisher_.add(target_sk_output);
+
+    // Scope mode: armed ratio (0 = length target); the target follows the depth
+    scope_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputFloat>("navigation.anchor.targetScopeStatus", "/target_scope_status/sk_path"));
     
-    // Ensure auto mode starts disabled on boot and target is cleared
-    if (auto_mode_controller_) {
-        auto_mode_controller_->setEnabled(false);
-        state_manager_.setAutoModeEnabled(false);
-    }
+    // Auto mode starts disabled on boot and target is cleared
     auto_mode_output_->set_input(0.0f);
     target_output_->set_input(-1.0f);
-    
-    auto* auto_mode_listener = new FloatSKListener("navigation.anchor.automaticModeCommand");
-    
-    auto_mode_listener->connect_to(new LambdaTransform<float, float>([this](float value) {
-        if (state_manager_.isEmergencyStopActive()) return 0.0f;
-        if (!state_manager_.areCommandsAllowed()) return 0.0f;  // Block until connection stable
-        bool enable = (value > 0.5);
-        
-        if (!auto_mode_controller_) return value;
-        
-        if (enable != auto_mode_controller_->isEnabled()) {
-            if (enable) {
-                auto_mode_controller_->setEnabled(true);
-                state_manager_.setAutoModeEnabled(true);
-                debugD("Automatic mode ENABLED");
-                if (auto_mode_controller_->getTargetLength() >= 0) {
-                    float current = state_manager_.getRodeLength();
-                    debugD("Target armed: %.2f m, current: %.2f m", 
-                           auto_mode_controller_->getTargetLength(), current);
-                    auto_mode_controller_->update(current);
-                }
-            } else {
-                debugD("Automatic mode DISABLED");
-                auto_mode_controller_->setEnabled(false);
-                state_manager_.setAutoModeEnabled(false);
-            }
-        }
-        return value;
-    }))->connect_to(auto_mode_output_);
-
-    auto* target_listener = new FloatSKListener("navigation.anchor.targetRodeCommand");
-    
-    target_listener->connect_to(new LambdaTransform<float, float>([this](float target) {
-        if (state_manager_.isEmergencyStopActive()) return -1.0f;
-        if (!state_manager_.areCommandsAllowed()) return target;  // Block until connection stable
-        
-        if (!auto_mode_controller_) return target;
-        
-        // Accept any valid target (including re-sending same value)
-        if (target >= 0) {
-            auto_mode_controller_->setTargetLength(target);
-            state_manager_.setAutoModeTarget(target);
-            float current = state_manager_.getRodeLength();
-            
-            debugD("Target armed: %.2f m (current: %.2f m)", target, current);
-
-            // If auto mode was enabled before arming, disable it to enforce arm-then-enable
-            if (auto_mode_controller_->isEnabled()) {
-                auto_mode_controller_->setEnabled(false);
-                state_manager_.setAutoModeEnabled(false);
-                auto_mode_output_->set_input(0.0f);
-                debugD("Auto mode disabled - target armed requires re-enable");
-            }
-        }
-        return target;
-    }))->connect_to(target_output_);
+    scope_output_->set_input(0.0f);
 }
 
 void SignalKService::setupHomeCommandBindings() {
     // Home Command: Arm target to 0.0m (auto-home) - self-clearing
-    auto* home_listener = new BoolSKListener("navigation.anchor.homeCommand");
-    home_command_output_ = new SKOutputBool("navigation.anchor.homeCommand", "/home_command/sk_path");
+    home_command_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputBool>("navigation.anchor.homeCommand", "/home_command/sk_path"));
     home_command_output_->set_input(false);  // Clear command on boot
-    
-    home_listener->connect_to(new LambdaTransform<bool, bool>([this](bool go_home) {
-        if (state_manager_.isEmergencyStopActive()) {
-            if (go_home) {
-                home_command_output_->set_input(false);
-            }
-            return go_home;
-        }
-        if (!state_manager_.areCommandsAllowed()) return go_home;  // Block until connection stable
-        
-        if (!auto_mode_controller_) return go_home;
-        
-        if (go_home) {
-            if (winch_controller_.isActive() && !auto_mode_controller_->isEnabled()) {
-                debugD("Home command blocked - manual control active");
-            } else {
-                auto_mode_controller_->setTargetLength(0.0f);
-                state_manager_.setAutoModeTarget(0.0f);
-                target_output_->set_input(0.0f);
-                debugD("Home command armed: target set to 0.0 m");
-                if (auto_mode_controller_->isEnabled()) {
-                    auto_mode_controller_->setEnabled(false);
-                    state_manager_.setAutoModeEnabled(false);
-                    auto_mode_output_->set_input(0.0f);
-                    debugD("Auto mode disabled - home armed requires re-enable");
-                }
-            }
-            // Clear command immediately to allow retriggering
-            home_command_output_->set_input(false);
-        }
-        return go_home;
-    }));
 }
 
-void SignalKService::updateRodeLength() {
-    if (rode_output_) {
-        float rode_length = state_manager_.getRodeLength();
-        rode_output_->set_input(rode_length);
+void SignalKService::setupBootMetricsOutputs() {
+    // Startup timing, sent once on the first SignalK connection
+    auto* control_sk_output = g_signalk_arena.create<SKOutputFloat>("electrical.bow.ecu.boot.timeToControl", "/boot_time_to_control/sk_path");
+    control_sk_output->set_metadata(new SKMetadata("s"));
+    boot_control_output_ = status_publisher_.add(control_sk_output);
+    auto* signalk_sk_output = g_signalk_arena.create<SKOutputFloat>("electrical.bow.ecu.boot.timeToSignalK", "/boot_time_to_signalk/sk_path");
+    signalk_sk_output->set_metadata(new SKMetadata("s"));
+    boot_signalk_output_ = status_publisher_.add(signalk_sk_output);
+}
+
+void SignalKService::publishBootMetrics() {
+    const uint32_t control_ms = BootMetrics::ms(BootMetrics::Stage::FIRST_CONTROL);
+    const uint32_t signalk_ms = BootMetrics::ms(BootMetrics::Stage::SIGNALK_READY);
+    debugD("Boot: first control after %lu ms, SignalK after %lu ms",
+           (unsigned long)control_ms, (unsigned long)signalk_ms);
+    boot_control_output_->set_input(control_ms / 1000.0f);
+    boot_signalk_output_->set_input(signalk_ms / 1000.0f);
+}
+
+void SignalKService::updateStatusOutputs() {
+    const unsigned long now_ms = millis();
+    // Control-side state, published by ControlTask after every step
+    const StateSnapshot snapshot = state_manager_.readSnapshot();
+    bool active = snapshot.winch_direction != 0 || snapshot.bow_direction != 0;
+
+    if (rode_output_ && rode_emitter_.shouldEmit(snapshot.rode_length, active, now_ms)) {
+        rode_output_->set_input(snapshot.rode_length);
+    }
+    if (chain_speed_output_ && chain_speed_emitter_.shouldEmit(snapshot.chain_speed, active, now_ms)) {
+        chain_speed_output_->set_input(snapshot.chain_speed);
+    }
+    if (chain_acceleration_output_ &&
+        chain_acceleration_emitter_.shouldEmit(snapshot.chain_acceleration, active, now_ms)) {
+        chain_acceleration_output_->set_input(snapshot.chain_acceleration);
+    }
+    if (chain_stalled_output_ && chain_stalled_emitter_.shouldEmit(snapshot.chain_stalled, active, now_ms)) {
+        chain_stalled_output_->set_input(snapshot.chain_stalled);
+    }
+    if (rode_verified_output_ &&
+        rode_verified_emitter_.shouldEmit(snapshot.rode_verified, active, now_ms)) {
+        rode_verified_output_->set_input(snapshot.rode_verified);
+    }
+    // Actual winch state (covers SignalK, remote and automatic mode)
+    if (manual_control_output_ &&
+        manual_control_emitter_.shouldEmit(snapshot.winch_direction, active, now_ms)) {
+        manual_control_output_->set_input(snapshot.winch_direction);
+    }
+    if (bow_propeller_status_output_ &&
+        bow_propeller_status_emitter_.shouldEmit(snapshot.bow_direction, active, now_ms)) {
+        bow_propeller_status_output_->set_input(snapshot.bow_direction);
+    }
+    if (bow_thrust_output_ && bow_thrust_emitter_.shouldEmit(snapshot.bow_thrust, active, now_ms)) {
+        bow_thrust_output_->set_input(snapshot.bow_thrust * 100.0f);
+    }
+    float auto_mode_state = snapshot.auto_mode_enabled ? 1.0f : 0.0f;
+    if (auto_mode_output_ && auto_mode_emitter_.shouldEmit(auto_mode_state, active, now_ms)) {
+        auto_mode_output_->set_input(auto_mode_state);
+    }
+    if (target_output_ && target_emitter_.shouldEmit(snapshot.auto_mode_target, active, now_ms)) {
+        target_output_->set_input(snapshot.auto_mode_target);
+    }
+    if (scope_output_ && scope_emitter_.shouldEmit(snapshot.auto_mode_scope, active, now_ms)) {
+        scope_output_->set_input(snapshot.auto_mode_scope);
+    }
+    // Emergency stop from any source (SignalK, remote double-press)
+    if (emergency_stop_status_value_ &&
+        emergency_stop_emitter_.shouldEmit(snapshot.emergency_stop_active, active, now_ms)) {
+        emergency_stop_status_value_->set(snapshot.emergency_stop_active);
+        emergency_stop_status_value_->notify();
     }
 }
 
 void SignalKService::startConnectionMonitoring() {
     // Monitor SignalK connection state - check every 100ms for fast response
-    event_loop()->onRepeat(100, [this]() {
-        static bool was_connected = false;
-        auto ws_client = sensesp_app->get_ws_client();
-        bool is_connected = ws_client ? ws_client->is_connected() : false;
-        
-        if (was_connected && !is_connected) {
-            // Connection lost - immediately stop all automatic operations and block commands
-            debugD("SignalK connection lost - stopping automatic operations");
-            if (auto_mode_controller_) {
-                auto_mode_controller_->setEnabled(false);
-                state_manager_.setAutoModeEnabled(false);
-            }
-            winch_controller_.stop();
-            state_manager_.setCommandsAllowed(false);
-            connection_stable_time_ = 0;
-        } else if (!was_connected && is_connected) {
-            // Connection established - wait 5 seconds before allowing commands
-            connection_stable_time_ = millis() + 5000;
-            state_manager_.setCommandsAllowed(false);
-            debugD("SignalK connected - commands blocked for 5 seconds");
-        } else if (is_connected && !state_manager_.areCommandsAllowed() && connection_stable_time_ > 0 && millis() >= connection_stable_time_) {
-            // Connection has been stable for 5 seconds - allow commands
-            state_manager_.setCommandsAllowed(true);
-            debugD("SignalK connection stable - commands now allowed");
-        }
-        was_connected = is_connected;
-        
-        // Sync emergency stop status back to SignalK (in case it was triggered by physical remote)
-        if (emergency_stop_status_value_ && emergency_stop_service_) {
-            bool actual_state = emergency_stop_service_->isActive();
-            bool current_value = emergency_stop_status_value_->get();
-            if (actual_state != current_value) {
-                emergency_stop_status_value_->set(actual_state);
-                emergency_stop_status_value_->notify();
-                debugD("Emergency stop status synced: %s", actual_state ? "ACTIVE" : "CLEARED");
-            }
+    scheduler_->add("Connection monitor", CONNECTION_CHECK_MS, CONNECTION_BUDGET_US,
+                    [](void* self) { static_cast<SignalKService*>(self)->monitorConnection(); }, this);
+}
+
+void SignalKService::monitorConnection() {
+    auto ws_client = sensesp_app->get_ws_client();
+    bool is_connected = ws_client ? ws_client->is_connected() : false;
+
+    if (was_connected_ && !is_connected) {
+        // Connection lost - immediately stop all automatic operations and block commands
+        debugD("SignalK connection lost - stopping automatic operations");
+        state_manager_.setCommandsAllowed(false);
+        control_task_.submit({ControlCommandType::STOP_ALL, 0.0f, CommandSource::LOCAL});
+        connection_stable_time_ = 0;
+    } else if (!was_connected_ && is_connected) {
+        // Connection established - wait 5 seconds before allowing commands
+        connection_stable_time_ = millis() + 5000;
+        state_manager_.setCommandsAllowed(false);
+        debugD("SignalK connected - commands blocked for 5 seconds");
+        if (!BootMetrics::reached(BootMetrics::Stage::SIGNALK_READY)) {
+            BootMetrics::mark(BootMetrics::Stage::SIGNALK_READY);
+            publishBootMetrics();
         }
-    });
+    } else if (is_connected && !state_manager_.areCommandsAllowed() && connection_stable_time_ > 0 && millis() >= connection_stable_time_) {
+        // Connection has been stable for 5 seconds - allow commands
+        state_manager_.setCommandsAllowed(true);
+        debugD("SignalK connection stable - commands now allowed");
+    }
+    was_connected_ = is_connected;
 }
 
 void SignalKService::setupBowPropellerBindings() {
@@ -296,37 +254,167 @@ void SignalKService::setupBowPropellerBindings() {
     }
     
     // Bow Propeller Command: Three states (-1=PORT, 0=STOP, 1=STARBOARD)
-    bow_propeller_command_output_ = new SKOutputInt("propulsion.bowThruster.command", "/bow_propeller_command/sk_path");
+    bow_propeller_command_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputInt>("propulsion.bowThruster.command", "/bow_propeller_command/sk_path"));
     bow_propeller_command_output_->set_input(0);  // Initialize to STOP on boot
     
-    bow_propeller_status_output_ = new SKOutputInt("propulsion.bowThruster.status", "/bow_propeller_status/sk_path");
+    bow_propeller_status_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputInt>("propulsion.bowThruster.status", "/bow_propeller_status/sk_path"));
     bow_propeller_status_output_->set_input(0);  // Initialize to STOP on boot
-    
-    auto* bow_command_listener = new IntSKListener("propulsion.bowThruster.command");
-    
-    bow_command_listener->connect_to(new LambdaTransform<int, int>([this](int command) {
-        if (state_manager_.isEmergencyStopActive()) return 0;
-        if (!state_manager_.areCommandsAllowed()) return 0;  // Block until connection stable
-        
-        if (command == 1) {
-            bow_propeller_controller_->turnStarboard();
-            if (bow_propeller_status_output_) {
-                bow_propeller_status_output_->set_input(1);
-            }
-            debugD("Bow propeller command: STARBOARD");
-        } else if (command == -1) {
-            bow_propeller_controller_->turnPort();
-            if (bow_propeller_status_output_) {
-                bow_propeller_status_output_->set_input(-1);
-            }
-            debugD("Bow propeller command: PORT");
-        } else {
-            bow_propeller_controller_->stop();
-            if (bow_propeller_status_output_) {
-                bow_propeller_status_output_->set_input(0);
-            }
-            debugD("Bow propeller command: STOP");
+
+    // Achieved average thrust in % (-100 = full port, 100 = full starboard)
+    bow_thrust_output_ = status_publisher_.add(g_signalk_arena.create<SKOutputFloat>("propulsion.bowThruster.thrust", "/bow_thrust/sk_path"));
+    bow_thrust_output_->set_input(0.0f);
+}
+
+// ========== Command Table ==========
+
+template <ControlCommandType TYPE, uint16_t LEASE_MS>
+void SignalKService::submitCommand(SignalKService& service, float value) {
+    service.control_task_.submit({TYPE, value, CommandSource::SIGNALK, 0, LEASE_MS});
+}
+
+template <uint16_t LEASE_MS>
+void SignalKService::submitManualWinch(SignalKService& service, float value) {
+    // Latency of motion commands only; the control side arms or cancels it
+    const bool motion = value > 0.5f || value < -0.5f;
+    if (motion) {
+        PerfMonitor::begin(PerfProbe::COMMAND_TO_RELAY);
+    }
+    // Manual control always overrides automatic mode (applied on the control side)
+    if (!service.control_task_.submit({ControlCommandType::MANUAL_WINCH, value, CommandSource::SIGNALK, 0, LEASE_MS}) &&
+        motion) {
+        PerfMonitor::cancel(PerfProbe::COMMAND_TO_RELAY);
+    }
+}
+
+template <uint16_t LEASE_MS>
+void SignalKService::submitBowThrust(SignalKService& service, float value) {
+    // SignalK setpoint in %, the control side takes -1..1
+    submitCommand<ControlCommandType::BOW_THRUST, LEASE_MS>(service, value / 100.0f);
+}
+
+template <BatchedOutput<bool>* SignalKService::*MEMBER>
+void SignalKService::clearTrigger(SignalKService& service, float value) {
+    // Self-clearing command: reset to false so the next true retriggers
+    if (value > 0.5f && service.*MEMBER) {
+        (service.*MEMBER)->set_input(false);
+    }
+}
+
+template <BatchedOutput<int>* SignalKService::*MEMBER>
+void SignalKService::echoCommand(SignalKService& service, float value) {
+    // Echo the accepted command (0 when blocked)
+    if (service.*MEMBER) {
+        (service.*MEMBER)->set_input(static_cast<int>(value));
+    }
+}
+
+// Status is never echoed here: it follows from the control-side snapshot
+const SKCommandEntry SignalKService::COMMAND_TABLE[] = {
+    {"navigation.anchor.resetRode", SKCommandValue::BOOL,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::TRIGGER,
+     &SignalKService::submitCommand<ControlCommandType::RESET_RODE>,
+     &SignalKService::clearTrigger<&SignalKService::reset_output_>},
+    // Emergency stop: before the connection is stable only a latched stop may be cleared
+    {"navigation.bow.ecu.emergencyStopCommand", SKCommandValue::BOOL,
+     SKCommandGuard::CONNECTED_OR_ESTOP,
+     &SignalKService::submitCommand<ControlCommandType::EMERGENCY_STOP>,
+     nullptr},
+    // 1 = UP, 0 = STOP, -1 = DOWN
+    {"navigation.anchor.manualControl", SKCommandValue::INT,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED,
+     &SignalKService::submitManualWinch<0>,
+     nullptr},
+    // Hold-to-run: as manualControl, stops COMMAND_LEASE_MS after the last repeat
+    {"navigation.anchor.manualControlLease", SKCommandValue::INT,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED,
+     &SignalKService::submitManualWinch<COMMAND_LEASE_MS>,
+     nullptr},
+    // value > 0.5 = enable, <= 0.5 = disable
+    {"navigation.anchor.automaticModeCommand", SKCommandValue::FLOAT,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::NEEDS_AUTO_MODE,
+     &SignalKService::submitCommand<ControlCommandType::AUTO_MODE>,
+     nullptr},
+    // Arming disables a running auto mode (arm-then-enable); negative targets are ignored
+    {"navigation.anchor.targetRodeCommand", SKCommandValue::FLOAT,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::NEEDS_AUTO_MODE,
+     &SignalKService::submitCommand<ControlCommandType::ARM_TARGET>,
+     nullptr},
+    // Arm a scope ratio (e.g. 5 = 5:1); the target follows ratio x (depth + freeboard)
+    {"navigation.anchor.targetScopeCommand", SKCommandValue::FLOAT,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::NEEDS_AUTO_MODE,
+     &SignalKService::submitCommand<ControlCommandType::ARM_SCOPE>,
+     nullptr},
+    // Depth stream for scope mode (coalesced per control step, filtered on the control side)
+    {"environment.depth.belowSurface", SKCommandValue::FLOAT,
+     SKCommandGuard::NEEDS_AUTO_MODE | SKCommandGuard::QUIET,
+     &SignalKService::submitCommand<ControlCommandType::DEPTH>,
+     nullptr},
+    // Arm target 0.0 m (auto-home); blocked on the control side while manual control runs
+    {"navigation.anchor.homeCommand", SKCommandValue::BOOL,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::TRIGGER |
+         SKCommandGuard::NEEDS_AUTO_MODE,
+     &SignalKService::submitCommand<ControlCommandType::HOME>,
+     &SignalKService::clearTrigger<&SignalKService::home_command_output_>},
+    // -1 = PORT, 0 = STOP, 1 = STARBOARD
+    {"propulsion.bowThruster.command", SKCommandValue::INT,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::NEEDS_BOW,
+     &SignalKService::submitCommand<ControlCommandType::BOW_THRUSTER>,
+     &SignalKService::echoCommand<&SignalKService::bow_propeller_command_output_>},
+    // Hold-to-run: as bowThruster.command, stops COMMAND_LEASE_MS after the last repeat
+    {"propulsion.bowThruster.commandLease", SKCommandValue::INT,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::NEEDS_BOW,
+     &SignalKService::submitCommand<ControlCommandType::BOW_THRUSTER, COMMAND_LEASE_MS>,
+     nullptr},
+    // Proportional thrust -100..100 % (+ = starboard), pulsed or PWM (PinConfig::BOW_DRIVE)
+    {"propulsion.bowThruster.thrustCommand", SKCommandValue::FLOAT,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::NEEDS_BOW,
+     &SignalKService::submitBowThrust<0>,
+     nullptr},
+    // Hold-to-run: as thrustCommand, stops COMMAND_LEASE_MS after the last repeat
+    {"propulsion.bowThruster.thrustCommandLease", SKCommandValue::FLOAT,
+     SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::NEEDS_BOW,
+     &SignalKService::submitBowThrust<COMMAND_LEASE_MS>,
+     nullptr},
+};
+
+const size_t SignalKService::COMMAND_COUNT = sizeof(COMMAND_TABLE) / sizeof(COMMAND_TABLE[0]);
+
+void SignalKService::setupCommandRoutes() {
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        const SKCommandEntry& entry = COMMAND_TABLE[i];
+        if (!isRouted(entry)) {
+            continue;
+        }
+
+        switch (entry.type) {
+        case SKCommandValue::BOOL:
+            g_signalk_arena.create<BoolSKListener>(entry.path)
+                ->connect_to(g_signalk_arena.create<SKCommandRoute<bool>>(*this, i));
+            break;
+        case SKCommandValue::INT:
+            g_signalk_arena.create<IntSKListener>(entry.path)
+                ->connect_to(g_signalk_arena.create<SKCommandRoute<int>>(*this, i));
+            break;
+        case SKCommandValue::FLOAT:
+            g_signalk_arena.create<FloatSKListener>(entry.path)
+                ->connect_to(g_signalk_arena.create<SKCommandRoute<float>>(*this, i));
+            break;
         }
-        return command;
-    }))->connect_to(bow_propeller_command_output_);
+    }
+}
+
+bool SignalKService::isRouted(const SKCommandEntry& entry) const {
+    if ((entry.guards & SKCommandGuard::NEEDS_AUTO_MODE) && !auto_mode_controller_) {
+        return false;
+    }
+    if ((entry.guards & SKCommandGuard::NEEDS_BOW) && !bow_propeller_controller_) {
+        return false;
+    }
+    return true;
+}
+
+void SignalKService::dispatchCommand(size_t index, float value) {
+    skDispatchCommand(COMMAND_TABLE, index, *this, value,
+                      state_manager_.readSnapshot().emergency_stop_active,
+                      state_manager_.areCommandsAllowed());
 }
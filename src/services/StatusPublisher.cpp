@@ -0,0 +1,46 @@
+#include "services/StatusPublisher.h"
+#include "sensesp/system/local_debug.h"
+#include "sensesp_app.h"
+
+using namespace sensesp;
+
+void StatusPublisher::initialize() {
+    event_loop()->onTick([this]() { this->flush(); });
+}
+
+void StatusPublisher::countOutput() {
+    output_count_++;
+    if (output_count_ > capacity_) {
+        // Outputs beyond the capacity fall back to the heap and can overflow a batch
+        debugW("StatusPublisher: output %u exceeds the capacity of %u - raise it with the output count",
+               (unsigned)output_count_, (unsigned)capacity_);
+    }
+}
+
+void StatusPublisher::markDirty(BatchedOutputBase* output) {
+    if (output->dirty_) {
+        return;  // Already queued; the newer value is sent on flush
+    }
+    if (pending_count_ >= capacity_) {
+        // Never lose a status value: send it on its own instead
+        overflow_count_++;
+        value_count_++;
+        output->flush();
+        return;
+    }
+    output->dirty_ = true;
+    pending_[pending_count_++] = output;
+}
+
+void StatusPublisher::flush() {
+    if (pending_count_ == 0) {
+        return;
+    }
+    for (size_t i = 0; i < pending_count_; i++) {
+        pending_[i]->dirty_ = false;
+        pending_[i]->flush();
+    }
+    value_count_ += pending_count_;
+    pending_count_ = 0;
+    batch_count_++;
+}
@@ -0,0 +1,138 @@
+#include "services/Supervisor.h"
+#include "pin_config.h"
+#include "services/WindlassChannels.h"
+#include "sensesp_app.h"
+#include "sensesp/signalk/signalk_output.h"
+#include "sensesp/system/local_debug.h"
+#include "sensesp/ui/status_page_item.h"
+#include "soc/gpio_struct.h"
+#include "util/StaticArena.h"
+
+#if SUPERVISOR_USE_WATCHDOG
+#include "esp_task_wdt.h"
+#endif
+
+using namespace sensesp;
+
+namespace {
+    // SignalK path segment, status page label and deadline per task (SupervisedTask order)
+    const char* const kTaskNames[] = {"controlLoop", "remoteInput", "pulseProcessing"};
+    const char* const kTaskTitles[] = {"Control loop", "Remote input", "Pulse processing"};
+    constexpr uint32_t kTaskDeadlinesUs[] = {
+        Supervisor::CONTROL_DEADLINE_US, Supervisor::REMOTE_DEADLINE_US, Supervisor::PULSE_DEADLINE_US,
+    };
+    constexpr size_t kTaskCount = static_cast<size_t>(SupervisedTask::COUNT);
+    static_assert(sizeof(kTaskDeadlinesUs) / sizeof(kTaskDeadlinesUs[0]) == kTaskCount,
+                  "One deadline per SupervisedTask");
+
+    // All relays are in the GPIO.out bank (checked in pin_config.h)
+    constexpr uint32_t kRelayMask = (1UL << PinConfig::WINCH_UP) | (1UL << PinConfig::WINCH_DOWN) |
+                                    (1UL << PinConfig::BOW_PORT) | (1UL << PinConfig::BOW_STARBOARD) |
+                                    extraWindlassRelayMask();
+
+    struct TaskOutputs {
+        SKOutputInt* missed = nullptr;
+        SKOutputFloat* worst = nullptr;
+        StatusPageItem<String>* status = nullptr;
+    };
+    TaskOutputs g_task_outputs[kTaskCount];
+    SKOutputInt* g_trips_output = nullptr;
+    StatusPageItem<int>* g_trips_status = nullptr;
+
+    // Storage for the outputs and status items (SKMetadata stays on the heap)
+    StaticArena<arenaBytes<SKOutputInt>(kTaskCount + 1) + arenaBytes<SKOutputFloat>(kTaskCount) +
+                arenaBytes<StatusPageItem<String>>(kTaskCount) +
+                arenaBytes<StatusPageItem<int>>()> g_supervisor_arena;
+
+#if SUPERVISOR_USE_WATCHDOG
+    hw_timer_t* g_timer = nullptr;
+#endif
+}
+
+void Supervisor::start() {
+    if (monitor_.size() == 0) {
+        for (size_t i = 0; i < kTaskCount; i++) {
+            monitor_.add(kTaskTitles[i], kTaskDeadlinesUs[i]);
+        }
+    }
+
+#if SUPERVISOR_USE_WATCHDOG
+    esp_task_wdt_init(WATCHDOG_TIMEOUT_S, true);  // Reconfigures the watchdog started by the core
+
+    // 1 MHz timer (80 MHz APB / 80), auto-reloading alarm every CHECK_PERIOD_US
+    g_timer = timerBegin(TIMER_NUMBER, 80, true);
+    timerAttachInterrupt(g_timer, &Supervisor::onTimer, true);
+    timerAlarmWrite(g_timer, CHECK_PERIOD_US, true);
+    timerAlarmEnable(g_timer);
+    debugD("Supervisor started (check every %lu us, watchdog %lu s)",
+           (unsigned long)CHECK_PERIOD_US, (unsigned long)WATCHDOG_TIMEOUT_S);
+#endif
+}
+
+void Supervisor::onTimer() {
+    // Re-cut on every check while overdue: a deferred relay transition may re-close a relay
+    if (monitor_.check(micros()) != 0) {
+        if (PinConfig::RELAY_ACTIVE_LOW) GPIO.out_w1ts = kRelayMask; else GPIO.out_w1tc = kRelayMask;
+        if (!trip_pending_.exchange(true, std::memory_order_release)) {
+            trips_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Supervisor::feedWatchdog() {
+#if SUPERVISOR_USE_WATCHDOG
+    if (!watchdog_subscribed_) {
+        esp_task_wdt_add(nullptr);  // Calling task
+        watchdog_subscribed_ = true;
+    }
+    if (monitor_.allMet(micros())) {
+        esp_task_wdt_reset();
+    }
+#endif
+}
+
+void Supervisor::initialize(NetworkScheduler& scheduler) {
+    for (size_t i = 0; i < kTaskCount; i++) {
+        TaskOutputs& outputs = g_task_outputs[i];
+        String path = String("electrical.bow.ecu.supervisor.") + kTaskNames[i];
+        String config = String("/supervisor/") + kTaskNames[i];
+        outputs.missed = g_supervisor_arena.create<SKOutputInt>(path + ".missedDeadlines",
+                                                                config + "/missed/sk_path");
+        outputs.worst = g_supervisor_arena.create<SKOutputFloat>(path + ".worstInterval",
+                                                                 config + "/worst/sk_path",
+                                                                 new SKMetadata("s"));
+        outputs.status = g_supervisor_arena.create<StatusPageItem<String>>(kTaskTitles[i], "not running",
+                                                                           "Supervisor", 1600 + i);
+    }
+    g_trips_output = g_supervisor_arena.create<SKOutputInt>("electrical.bow.ecu.supervisor.trips",
+                                                            "/supervisor/trips/sk_path");
+    g_trips_status = g_supervisor_arena.create<StatusPageItem<int>>("Relay cut-offs", 0,
+                                                                    "Supervisor", 1600 + kTaskCount);
+
+    scheduler.add("Supervisor", PUBLISH_INTERVAL_MS, PUBLISH_BUDGET_US,
+                  [](void* self) { static_cast<Supervisor*>(self)->publish(); }, this);
+}
+
+void Supervisor::publish() {
+#if !SUPERVISOR_USE_WATCHDOG
+    monitor_.check(micros());  // No timer interrupt: count misses here
+#endif
+    for (size_t i = 0; i < kTaskCount; i++) {
+        TaskOutputs& outputs = g_task_outputs[i];
+        if (!monitor_.isSupervised(i)) {
+            continue;
+        }
+        uint32_t missed = monitor_.missed(i);
+        uint32_t worst_us = monitor_.worstInterval(i);
+        outputs.missed->set_input(static_cast<int>(missed));
+        outputs.worst->set_input(worst_us * 1e-6f);
+
+        char text[64];
+        snprintf(text, sizeof(text), "%lu missed, worst %lu/%lu ms", (unsigned long)missed,
+                 (unsigned long)(worst_us / 1000), (unsigned long)(monitor_.deadline(i) / 1000));
+        outputs.status->set(String(text));
+    }
+    int trips = static_cast<int>(getTrips());
+    g_trips_output->set_input(trips);
+    g_trips_status->set(trips);
+}
@@ -0,0 +1,125 @@
+#include "services/TraceRecorder.h"
+
+#if TRACE_CAPTURE
+
+#include <AsyncUDP.h>
+#include "sensesp_app.h"
+#include "sensesp/system/local_debug.h"
+#include "sensesp/ui/status_page_item.h"
+#include "services/StateManager.h"
+#include "util/StaticArena.h"
+
+using namespace sensesp;
+
+namespace {
+    AsyncUDP g_trace_udp;
+
+    // Storage for the status page item
+    StaticArena<arenaBytes<StatusPageItem<String>>()> g_trace_arena;
+    StatusPageItem<String>* g_trace_status = nullptr;
+
+    constexpr unsigned STATUS_EVERY_FRAMES = 20;  ///< Status refresh while streaming
+
+    // Frame assembly (event loop only), off the task stack
+    TraceRecord g_records[TraceRecorder::FRAME_RECORDS];
+    uint8_t g_frame[traceFrameSize(TraceRecorder::FRAME_RECORDS)];
+
+    bool isRequest(const uint8_t* data, size_t length, const char* request) {
+        size_t request_length = strlen(request);
+        return length == request_length && memcmp(data, request, request_length) == 0;
+    }
+}
+
+void TraceRecorder::initialize(NetworkScheduler& scheduler) {
+    g_trace_status = g_trace_arena.create<StatusPageItem<String>>("Trace capture", "off", "Trace", 1800);
+
+    scheduler.add("Trace stream", STREAM_INTERVAL_MS, STREAM_BUDGET_US,
+                  [](void* self) { static_cast<TraceRecorder*>(self)->stream(); }, this);
+
+    if (!g_trace_udp.listen(TRACE_PORT)) {
+        debugD("Trace: cannot listen on UDP %u", TRACE_PORT);
+        return;
+    }
+    g_trace_udp.onPacket([this](AsyncUDPPacket& packet) {
+        receive(packet.data(), packet.length(), static_cast<uint32_t>(packet.remoteIP()),
+                packet.remotePort(), static_cast<uint32_t>(millis()));
+    });
+    debugD("Trace capture requests on UDP %u (%u records buffered)", TRACE_PORT, (unsigned)CAPACITY);
+}
+
+bool TraceRecorder::receive(const uint8_t* data, size_t length, uint32_t address, uint16_t port,
+                            uint32_t now_ms) {
+    if (isRequest(data, length, "TRACE START")) {
+        // A repeat from the same host is a keep-alive; a new host restarts the capture
+        last_request_ms_.store(now_ms, std::memory_order_relaxed);
+        if (!capturing_.load(std::memory_order_relaxed) ||
+            client_address_.load(std::memory_order_relaxed) != address ||
+            client_port_.load(std::memory_order_relaxed) != port) {
+            client_address_.store(address, std::memory_order_relaxed);
+            client_port_.store(port, std::memory_order_relaxed);
+            start_pending_.store(true, std::memory_order_release);
+        }
+        return true;
+    }
+    if (isRequest(data, length, "TRACE STOP")) {
+        capturing_.store(false, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void TraceRecorder::startCapture() {
+    capturing_.store(false, std::memory_order_relaxed);
+    buffer_.clear();
+    frames_sent_ = 0;
+    records_sent_ = 0;
+    capturing_.store(true, std::memory_order_relaxed);
+    record(TraceEvent::CAPTURE_START, 0, 0, state_manager_.getMetersPerPulse());
+    debugD("Trace capture started");
+    updateStatus();
+}
+
+void TraceRecorder::stream() {
+    const uint32_t now_ms = static_cast<uint32_t>(millis());
+    if (start_pending_.exchange(false, std::memory_order_acquire)) {
+        startCapture();
+    }
+    if (capturing_.load(std::memory_order_relaxed) &&
+        now_ms - last_request_ms_.load(std::memory_order_relaxed) > CLIENT_TIMEOUT_MS) {
+        capturing_.store(false, std::memory_order_relaxed);  // Host gone: flush, then stop
+        debugD("Trace capture ended (no keep-alive)");
+    }
+
+    const uint32_t address = client_address_.load(std::memory_order_relaxed);
+    if (address == 0) {
+        return;
+    }
+    size_t count = buffer_.pop(g_records, FRAME_RECORDS);
+    if (count == 0) {
+        if (!capturing_.load(std::memory_order_relaxed)) {
+            client_address_.store(0, std::memory_order_relaxed);  // Flushed
+            updateStatus();
+        }
+        return;
+    }
+    size_t length = encodeTraceFrame(frames_sent_, buffer_.dropped(), g_records, count, g_frame);
+    g_trace_udp.writeTo(g_frame, length, IPAddress(address), client_port_.load(std::memory_order_relaxed));
+    frames_sent_++;
+    records_sent_ += count;
+    if (frames_sent_ % STATUS_EVERY_FRAMES == 0) {
+        updateStatus();
+    }
+}
+
+void TraceRecorder::updateStatus() {
+    char text[64];
+    if (capturing_.load(std::memory_order_relaxed)) {
+        snprintf(text, sizeof(text), "streaming: %lu records, %lu dropped",
+                 (unsigned long)records_sent_, (unsigned long)buffer_.dropped());
+    } else {
+        snprintf(text, sizeof(text), "off (last capture: %lu records)", (unsigned long)records_sent_);
+    }
+    g_trace_status->set(String(text));
+}
+
+#endif  // TRACE_CAPTURE
@@ -0,0 +1,355 @@
+#include "services/WindlassChannels.h"
+
+#if WINDLASS_CHANNELS > 1
+
+#include "hardware/GpioSnapshot.h"
+#include "sensesp/signalk/signalk_output.h"
+#include "sensesp/signalk/signalk_value_listener.h"
+#include "sensesp/system/local_debug.h"
+#include "sensesp/system/valueconsumer.h"
+#include "sensesp_app.h"
+#include "services/ControlTask.h"
+#include "services/EventLogger.h"
+#include "services/PowerManager.h"
+#include "services/SignalKCommandTable.h"
+#include "soc/gpio_struct.h"
+#include "util/StaticArena.h"
+
+using namespace sensesp;
+
+/// Drivers and controllers of one additional windlass
+struct WindlassChannels::Channel {
+    ESP32Motor motor;
+    ESP32Sensor home_input;
+    AnchorWinchController winch;
+    HomeSensor home;
+    AutomaticModeController auto_mode;
+    ESP32PulseCounter pulses;
+    uint32_t up_mask;  ///< GPIO.out bit of the retrieve relay
+
+    Channel(const WindlassChannelPins& pins, pcnt_unit_t unit)
+        : motor(pins.winch_up, pins.winch_down, OperationMotor::COUNT, pins.name, false),
+          home_input(pins.anchor_home, PinConfig::HOME_ACTIVE_LOW),
+          winch(motor, home_input),
+          home(home_input),
+          auto_mode(winch, home),
+          pulses(pins.pulse_input, pins.direction, unit),
+          up_mask(1UL << pins.winch_up) {}
+
+    // Home edge to its active level: cut the retrieve relay at once (as the primary homeISR);
+    // update() syncs the winch state and zeroes the counter on the next pass
+    static void IRAM_ATTR homeISR(void* arg) {
+        PowerManager::wakeFromIsr();
+        auto* channel = static_cast<Channel*>(arg);
+        if (GpioSnapshot::readPin(channel->home_input.pin()) == PinConfig::HOME_ACTIVE_LOW) {
+            return;  // Glitch: line is already back at the inactive level (not at home)
+        }
+        const bool energised = ((GPIO.out & channel->up_mask) != 0) != PinConfig::RELAY_ACTIVE_LOW;
+        if (energised) {
+            if (PinConfig::RELAY_ACTIVE_LOW) GPIO.out_w1ts = channel->up_mask; else GPIO.out_w1tc = channel->up_mask;
+        }
+    }
+};
+
+namespace {
+    /// One command path per channel: navigation.anchor.<name>.<suffix>
+    struct ChannelCommand {
+        const char* suffix;
+        SKCommandValue value;
+        uint8_t guards;           ///< SKCommandGuard flags
+        ControlCommandType type;  ///< Submitted with the channel number
+    };
+
+    // Same values and guards as the primary windlass rows (SignalKService::COMMAND_TABLE)
+    constexpr ChannelCommand kChannelCommands[] = {
+        {"manualControl", SKCommandValue::INT,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED, ControlCommandType::MANUAL_WINCH},
+        {"automaticModeCommand", SKCommandValue::FLOAT,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED, ControlCommandType::AUTO_MODE},
+        {"targetRodeCommand", SKCommandValue::FLOAT,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED, ControlCommandType::ARM_TARGET},
+        {"homeCommand", SKCommandValue::BOOL,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::TRIGGER,
+         ControlCommandType::HOME},
+        {"resetRode", SKCommandValue::BOOL,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::TRIGGER,
+         ControlCommandType::RESET_RODE},
+    };
+    constexpr size_t kCommandCount = sizeof(kChannelCommands) / sizeof(kChannelCommands[0]);
+    constexpr size_t kChannels = WindlassChannels::COUNT;
+
+    /**
+     * @brief Listener sink that forwards a value to its channel command
+     */
+    template <typename T>
+    class ChannelCommandRoute : public ValueConsumer<T> {
+    public:
+        ChannelCommandRoute(WindlassChannels& channels, uint8_t channel, size_t command)
+            : channels_(channels), channel_(channel), command_(command) {}
+
+        void set(const T& new_value) override {
+            channels_.dispatch(channel_, command_, static_cast<float>(new_value));
+        }
+
+    private:
+        WindlassChannels& channels_;
+        uint8_t channel_;  ///< Windlass channel (1..)
+        size_t command_;   ///< Row of kChannelCommands
+    };
+
+    struct ChannelOutputs {
+        SKOutputFloat* rode = nullptr;
+        SKOutputInt* manual = nullptr;
+        SKOutputFloat* auto_mode = nullptr;
+        SKOutputFloat* target = nullptr;
+        SKOutputBool* verified = nullptr;
+    };
+    ChannelOutputs g_outputs[kChannels];
+
+    // Storage for the outputs and listeners (SKMetadata stays on the heap)
+    StaticArena<arenaBytes<SKOutputFloat>(3 * kChannels) + arenaBytes<SKOutputInt>(kChannels) +
+                arenaBytes<SKOutputBool>(kChannels) + arenaBytes<IntSKListener>(kChannels) +
+                arenaBytes<FloatSKListener>(2 * kChannels) + arenaBytes<BoolSKListener>(2 * kChannels) +
+                arenaBytes<ChannelCommandRoute<int>>(kChannels) +
+                arenaBytes<ChannelCommandRoute<float>>(2 * kChannels) +
+                arenaBytes<ChannelCommandRoute<bool>>(2 * kChannels)> g_channel_signalk_arena;
+
+    String channelPath(size_t index, const char* suffix) {
+        return String("navigation.anchor.") + WindlassChannels::pins(index).name + "." + suffix;
+    }
+}
+
+void WindlassChannels::initializeHardware() {
+    // Storage for the channel drivers and controllers
+    static StaticArena<arenaBytes<Channel>(COUNT)> channel_arena;
+    for (size_t i = 0; i < COUNT; i++) {
+        // PCNT unit 0 counts the primary windlass
+        Channel* channel = channel_arena.create<Channel>(pins(i), static_cast<pcnt_unit_t>(i + 1));
+        channel->motor.initialize();
+        channel->home_input.initialize();
+        channel->pulses.initialize();
+        PowerManager::addPulseInput(channel->pulses);
+        channel->auto_mode.setStopPrediction(true);
+        attachInterruptArg(digitalPinToInterrupt(pins(i).anchor_home), &Channel::homeISR, channel,
+                           PinConfig::HOME_ACTIVE_LOW ? FALLING : RISING);
+        channels_[i] = channel;
+        debugD("Windlass channel %u (%s): pulse GPIO %d, direction GPIO %d, home GPIO %d, UP=GPIO %d, DOWN=GPIO %d",
+               (unsigned)(i + 1), pins(i).name, pins(i).pulse_input, pins(i).direction,
+               pins(i).anchor_home, pins(i).winch_up, pins(i).winch_down);
+    }
+    published_.write(states_);
+}
+
+bool WindlassChannels::execute(const ControlCommand& command, bool emergency_stop) {
+    switch (command.type) {
+    case ControlCommandType::MANUAL_WINCH:
+    case ControlCommandType::AUTO_MODE:
+    case ControlCommandType::ARM_TARGET:
+    case ControlCommandType::HOME:
+    case ControlCommandType::RESET_RODE:
+        break;
+    default:
+        return false;  // Shared by every channel (emergency stop, stop all, ...)
+    }
+    if (command.channel == 0 || command.channel > COUNT || emergency_stop) {
+        return true;
+    }
+    const size_t index = command.channel - 1;
+    Channel& channel = *channels_[index];
+    WindlassChannelState& state = states_.channel[index];
+
+    switch (command.type) {
+    case ControlCommandType::MANUAL_WINCH: {
+        // Manual control always overrides automatic mode (no hold-to-run lease per channel)
+        const int8_t direction = command.value > 0.5f ? 1 : (command.value < -0.5f ? -1 : 0);
+        channel.auto_mode.handOver(direction);
+        if (direction > 0) {
+            channel.winch.moveUp();
+        } else if (direction < 0) {
+            channel.winch.moveDown();
+        } else {
+            channel.winch.stop();
+        }
+        break;
+    }
+
+    case ControlCommandType::AUTO_MODE: {
+        bool enable = command.value > 0.5f;
+        if (enable == channel.auto_mode.isEnabled()) break;
+        channel.auto_mode.setEnabled(enable);
+        if (enable && channel.auto_mode.getTargetLength() >= 0) {
+            channel.auto_mode.update(state.rode_m, millis());
+        }
+        break;
+    }
+
+    case ControlCommandType::ARM_TARGET:
+    case ControlCommandType::HOME: {
+        bool home = command.type == ControlCommandType::HOME;
+        float target = home ? 0.0f : command.value;
+        if (target < 0) break;
+        if (home && channel.winch.isActive() && !channel.auto_mode.isEnabled()) break;
+        channel.auto_mode.setTargetLength(target);
+        // Arming always requires a fresh enable (a manually running winch keeps running)
+        if (channel.auto_mode.isEnabled()) {
+            channel.auto_mode.setEnabled(false);
+        }
+        break;
+    }
+
+    case ControlCommandType::RESET_RODE:
+        // Operator asserts the anchor is home
+        state.pulse_count = 0;
+        state.rode_m = 0.0f;
+        state.flags |= WindlassChannelFlag::RODE_VERIFIED;
+        break;
+
+    default:
+        break;
+    }
+    return true;
+}
+
+void WindlassChannels::update(unsigned long now_ms) {
+    const float meters_per_pulse = state_manager_.getMetersPerPulse();
+    const bool retune = meters_per_pulse != meters_per_pulse_;
+    meters_per_pulse_ = meters_per_pulse;
+    const bool estop = state_manager_.isEmergencyStopActive();
+
+    for (size_t i = 0; i < COUNT; i++) {
+        Channel& channel = *channels_[i];
+        WindlassChannelState& state = states_.channel[i];
+        const int32_t channel_number = static_cast<int32_t>(i + 1);
+
+        if (retune) {
+            channel.auto_mode.setTolerance(meters_per_pulse * 2.0f);
+        }
+        state.pulse_count += channel.pulses.takeDelta();
+
+        // The home ISR already cut the relay; sync the controllers and zero the counter
+        if (channel.home.isHome()) {
+            if (channel.winch.isMovingUp()) {
+                channel.winch.stop();
+                EventLogger::log(LogEvent::CHANNEL_HOME_STOPPED, channel_number);
+            }
+            if (channel.home.justArrived()) {
+                state.pulse_count = 0;
+                state.flags |= WindlassChannelFlag::RODE_VERIFIED;
+                EventLogger::log(LogEvent::CHANNEL_HOME_RESET, channel_number);
+            }
+            if (channel.auto_mode.isEnabled() && channel.auto_mode.getTargetLength() == 0.0f) {
+                channel.auto_mode.setEnabled(false);
+                EventLogger::log(LogEvent::AUTO_HOME_DONE);
+            }
+        } else {
+            channel.home.justLeft();
+        }
+
+        if (estop && (channel.winch.isActive() || channel.auto_mode.isEnabled())) {
+            channel.auto_mode.setEnabled(false);
+            channel.winch.stop();
+        }
+
+        state.rode_m = state.pulse_count * meters_per_pulse;
+        channel.auto_mode.update(state.rode_m, now_ms);
+        channel.auto_mode.consumeTargetReached();
+
+        state.target_m = channel.auto_mode.getTargetLength();
+        state.direction = channel.winch.isMovingUp() ? 1 : (channel.winch.isMovingDown() ? -1 : 0);
+        uint8_t flags = state.flags & WindlassChannelFlag::RODE_VERIFIED;
+        if (channel.auto_mode.isEnabled()) flags |= WindlassChannelFlag::AUTO_MODE;
+        if (channel.home.isHome()) flags |= WindlassChannelFlag::AT_HOME;
+        state.flags = flags;
+    }
+    published_.write(states_);
+}
+
+void WindlassChannels::stopAll() {
+    for (size_t i = 0; i < COUNT; i++) {
+        channels_[i]->auto_mode.setEnabled(false);
+        channels_[i]->winch.stop();
+    }
+}
+
+void WindlassChannels::initialize(NetworkScheduler& scheduler, ControlTask& control_task) {
+    control_task_ = &control_task;
+
+    for (size_t i = 0; i < COUNT; i++) {
+        ChannelOutputs& outputs = g_outputs[i];
+        outputs.rode = g_channel_signalk_arena.create<SKOutputFloat>(channelPath(i, "currentRode"), "");
+        outputs.rode->set_metadata(new SKMetadata("m"));
+        outputs.manual = g_channel_signalk_arena.create<SKOutputInt>(channelPath(i, "manualControlStatus"), "");
+        outputs.auto_mode = g_channel_signalk_arena.create<SKOutputFloat>(channelPath(i, "automaticModeStatus"), "");
+        outputs.target = g_channel_signalk_arena.create<SKOutputFloat>(channelPath(i, "targetRodeStatus"), "");
+        outputs.target->set_metadata(new SKMetadata("m"));
+        outputs.verified = g_channel_signalk_arena.create<SKOutputBool>(channelPath(i, "rodeVerified"), "");
+
+        const uint8_t channel = static_cast<uint8_t>(i + 1);
+        for (size_t c = 0; c < kCommandCount; c++) {
+            const String path = channelPath(i, kChannelCommands[c].suffix);
+            switch (kChannelCommands[c].value) {
+            case SKCommandValue::BOOL:
+                g_channel_signalk_arena.create<BoolSKListener>(path)->connect_to(
+                    g_channel_signalk_arena.create<ChannelCommandRoute<bool>>(*this, channel, c));
+                break;
+            case SKCommandValue::INT:
+                g_channel_signalk_arena.create<IntSKListener>(path)->connect_to(
+                    g_channel_signalk_arena.create<ChannelCommandRoute<int>>(*this, channel, c));
+                break;
+            case SKCommandValue::FLOAT:
+                g_channel_signalk_arena.create<FloatSKListener>(path)->connect_to(
+                    g_channel_signalk_arena.create<ChannelCommandRoute<float>>(*this, channel, c));
+                break;
+            }
+        }
+    }
+
+    scheduler.add("Windlass channels", PUBLISH_INTERVAL_MS, PUBLISH_BUDGET_US,
+                  [](void* self) { static_cast<WindlassChannels*>(self)->publish(); }, this);
+}
+
+void WindlassChannels::dispatch(uint8_t channel, size_t command, float value) {
+    if (!control_task_ || command >= kCommandCount) {
+        return;
+    }
+    const ChannelCommand& entry = kChannelCommands[command];
+    if (!skCommandAllowed(entry.guards, value, state_manager_.readSnapshot().emergency_stop_active,
+                          state_manager_.areCommandsAllowed())) {
+        return;
+    }
+    ControlCommand submitted{entry.type, value, CommandSource::SIGNALK};
+    submitted.channel = channel;
+    control_task_->submit(submitted);
+}
+
+void WindlassChannels::publish() {
+    const WindlassChannelStates states = published_.read();
+    for (size_t i = 0; i < COUNT; i++) {
+        const WindlassChannelState& state = states.channel[i];
+        const WindlassChannelState& sent = sent_.channel[i];
+        const bool first = !sent_valid_;
+        ChannelOutputs& outputs = g_outputs[i];
+
+        if (first || state.rode_m != sent.rode_m) {
+            outputs.rode->set_input(state.rode_m);
+        }
+        if (first || state.direction != sent.direction) {
+            outputs.manual->set_input(state.direction);
+        }
+        const bool auto_mode = (state.flags & WindlassChannelFlag::AUTO_MODE) != 0;
+        if (first || auto_mode != ((sent.flags & WindlassChannelFlag::AUTO_MODE) != 0)) {
+            outputs.auto_mode->set_input(auto_mode ? 1.0f : 0.0f);
+        }
+        if (first || state.target_m != sent.target_m) {
+            outputs.target->set_input(state.target_m);
+        }
+        const bool verified = (state.flags & WindlassChannelFlag::RODE_VERIFIED) != 0;
+        if (first || verified != ((sent.flags & WindlassChannelFlag::RODE_VERIFIED) != 0)) {
+            outputs.verified->set_input(verified);
+        }
+    }
+    sent_ = states;
+    sent_valid_ = true;
+}
+
+#endif  // WINDLASS_CHANNELS > 1
@@ -0,0 +1,19 @@
+// Mock sensesp/system/local_debug.h for native builds
+// Lets firmware sources that log through debugD() compile on the host
+
+#ifndef SENSESP_LOCAL_DEBUG_H
+#define SENSESP_LOCAL_DEBUG_H
+
+// The real header pulls in Arduino.h (and with it math.h)
+#include <Arduino.h>
+#include <math.h>
+
+namespace sensesp {}
+
+#define debugE(...) ((void)0)
+#define debugW(...) ((void)0)
+#define debugI(...) ((void)0)
+#define debugD(...) ((void)0)
+#define debugV(...) ((void)0)
+
+#endif // SENSESP_LOCAL_DEBUG_H
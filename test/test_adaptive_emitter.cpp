@@ -0,0 +1,68 @@
+// Unit tests for AdaptiveEmitter
+// Tests change-driven emission, deadband, rate limit and heartbeats
+
+#include <unity.h>
+#include "util/AdaptiveEmitter.h"
+
+void test_adaptive_emitter_deadband_and_rate_limit(void) {
+    AdaptiveEmitter<float> emitter(0.05f, 100, 1000, 30000);
+
+    // First sample is always sent
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.0f, true, 0));
+
+    // Change inside deadband is suppressed
+    TEST_ASSERT_FALSE(emitter.shouldEmit(10.03f, true, 200));
+
+    // Change beyond deadband is sent, but not faster than the minimum interval
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.2f, true, 300));
+    TEST_ASSERT_FALSE(emitter.shouldEmit(10.4f, true, 350));
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.4f, true, 400));
+
+    // Deadband is measured against the last emitted value
+    TEST_ASSERT_FALSE(emitter.shouldEmit(10.44f, true, 500));
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.46f, true, 600));
+}
+
+void test_adaptive_emitter_heartbeat_depends_on_activity(void) {
+    AdaptiveEmitter<int> emitter;
+
+    TEST_ASSERT_TRUE(emitter.shouldEmit(0, false, 0));
+
+    // Idle: unchanged value only re-sent after the idle heartbeat
+    TEST_ASSERT_FALSE(emitter.shouldEmit(0, false, 1000));
+    TEST_ASSERT_FALSE(emitter.shouldEmit(0, false, 29999));
+    TEST_ASSERT_TRUE(emitter.shouldEmit(0, false, 30000));
+
+    // Active: unchanged value re-sent every active heartbeat
+    TEST_ASSERT_FALSE(emitter.shouldEmit(0, true, 30500));
+    TEST_ASSERT_TRUE(emitter.shouldEmit(0, true, 31000));
+
+    // Any change of an integer state is sent immediately
+    TEST_ASSERT_TRUE(emitter.shouldEmit(1, true, 31100));
+
+    // invalidate() forces the next sample out
+    emitter.invalidate();
+    TEST_ASSERT_TRUE(emitter.shouldEmit(1, true, 31110));
+}
+
+void test_adaptive_emitter_sends_final_value_when_stopping(void) {
+    AdaptiveEmitter<float> emitter(0.05f, 100, 1000, 30000);
+
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.0f, true, 0));
+    TEST_ASSERT_FALSE(emitter.shouldEmit(10.03f, true, 200));
+
+    // Winch stops with a change inside the deadband: sent now, not at the idle heartbeat
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.03f, false, 300));
+    TEST_ASSERT_FALSE(emitter.shouldEmit(10.03f, false, 400));
+
+    // Stopping inside the rate limit: sent once the minimum interval has passed
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.2f, true, 1000));
+    TEST_ASSERT_FALSE(emitter.shouldEmit(10.22f, false, 1050));
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.22f, false, 1100));
+
+    // Stopping on the emitted value sends nothing; later small changes wait for the heartbeat
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.4f, true, 2000));
+    TEST_ASSERT_FALSE(emitter.shouldEmit(10.4f, false, 2100));
+    TEST_ASSERT_FALSE(emitter.shouldEmit(10.43f, false, 2200));
+    TEST_ASSERT_TRUE(emitter.shouldEmit(10.43f, false, 32000));
+}
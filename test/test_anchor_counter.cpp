@@ -57,9 +57,145 @@ extern void test_remote_button_release_stops_motor(void);
 
 // System-level integration tests
 extern void test_signalk_and_remote_can_coexist(void);
+extern void test_signalk_thrust_survives_remote_step_without_buttons(void);
 extern void test_emergency_stop_blocks_both_signalk_and_remote(void);
 extern void test_full_scenario_normal_operation(void);
 
+// Pulse accumulator tests
+extern void test_pulse_accumulator_drain_applies_pending(void);
+extern void test_pulse_accumulator_clamps_at_zero(void);
+extern void test_pulse_accumulator_reset_is_epoch_bump(void);
+extern void test_pulse_edge_buffer_fifo_and_overflow(void);
+extern void test_home_edge_event_is_consumed_once(void);
+
+// Chain motion estimator tests
+extern void test_chain_motion_speed_from_edge_period(void);
+extern void test_chain_motion_speed_bounded_and_zero_without_edges(void);
+extern void test_chain_motion_stall_detection(void);
+extern void test_chain_motion_direction_change(void);
+
+// Adaptive emitter tests
+extern void test_adaptive_emitter_deadband_and_rate_limit(void);
+extern void test_adaptive_emitter_heartbeat_depends_on_activity(void);
+extern void test_adaptive_emitter_sends_final_value_when_stopping(void);
+
+// Button debouncer tests
+extern void test_button_debouncer_rejects_bounce(void);
+extern void test_button_debouncer_double_press_uses_edge_time(void);
+extern void test_button_debouncer_long_press_and_deadline(void);
+
+// Remote gesture tests
+extern void test_remote_gestures_double_press_of_any_buttons(void);
+extern void test_remote_gestures_long_press_clears_only_when_stopped(void);
+
+// Latency histogram tests
+extern void test_latency_histogram_min_max_and_reset(void);
+extern void test_latency_histogram_percentiles_from_buckets(void);
+
+// Control command queue tests
+extern void test_mpsc_queue_fifo_overflow_and_wrap(void);
+extern void test_commands_coalesce_to_last_per_actuator_in_order(void);
+extern void test_commands_coalesce_per_windlass_channel(void);
+extern void test_commands_stop_all_is_never_coalesced(void);
+
+// State snapshot tests
+extern void test_seqlock_round_trip_keeps_all_fields(void);
+extern void test_state_manager_publishes_snapshot_as_one_unit(void);
+
+// Static arena tests
+extern void test_static_arena_places_aligned_objects_and_falls_back(void);
+
+// SignalK command table tests
+extern void test_signalk_command_guards_block_motion_commands(void);
+extern void test_signalk_emergency_stop_can_be_cleared_before_connection_is_stable(void);
+
+// Rode journal tests
+extern void test_rode_journal_restores_newest_record_across_wrap(void);
+extern void test_rode_journal_skips_corrupt_record(void);
+extern void test_settle_detector_waits_for_coast_pulses(void);
+extern void test_settle_detector_reports_chain_moved_with_winch_off(void);
+
+// Runtime config record tests
+extern void test_config_blob_round_trip_and_skips_unchanged_save(void);
+extern void test_config_blob_rejects_corrupt_or_foreign_record(void);
+
+// Relay sequencer tests
+extern void test_relay_sequencer_reversal_waits_for_dead_time(void);
+extern void test_relay_sequencer_stop_is_immediate_and_min_off_applies(void);
+extern void test_relay_sequencer_thermal_trip_and_recovery(void);
+
+// Event log tests
+extern void test_event_log_coalesces_repeats_and_overwrites_oldest(void);
+extern void test_event_logger_formats_records(void);
+
+// Frame scheduler tests
+extern void test_frame_scheduler_spreads_phases_and_keeps_periods(void);
+extern void test_frame_scheduler_records_overruns_and_late_frames(void);
+
+// Anchor watch tests
+extern void test_anchor_watch_alarm_is_debounced_against_rode_reach(void);
+extern void test_anchor_watch_swing_radius_follows_history_window(void);
+
+// Scope target tests
+extern void test_scope_target_from_ratio_depth_and_freeboard(void);
+extern void test_scope_target_filters_spikes_and_holds_within_deadband(void);
+
+// Stop prediction tests
+extern void test_auto_mode_cuts_inside_predicted_coast(void);
+extern void test_auto_mode_no_cut_moving_away_from_target(void);
+extern void test_auto_mode_coast_learning_converges(void);
+extern void test_auto_mode_coast_learning_clamped(void);
+extern void test_auto_mode_no_learning_below_min_speed(void);
+extern void test_auto_mode_settle_voided_when_winch_restarts(void);
+
+// Direct command link tests
+extern void test_siphash_matches_reference_vectors(void);
+extern void test_direct_frames_authenticate_and_reject_replays(void);
+extern void test_direct_commands_use_signalk_guards(void);
+
+// Supervisor deadline tests
+extern void test_deadline_monitor_counts_one_miss_per_stall(void);
+extern void test_deadline_monitor_tracks_worst_interval(void);
+
+// Command lease tests
+extern void test_command_lease_expires_without_keep_alive(void);
+extern void test_command_lease_latched_and_stop_commands_release(void);
+
+// Operation statistics tests
+extern void test_operation_counters_count_runs_and_starts(void);
+extern void test_operation_stats_record_rejects_damage(void);
+
+// Hardware profile tests
+extern void test_winch_controller_static_dispatch_blocks_up_at_home(void);
+extern void test_hardware_profile_pins_distinct_and_timed(void);
+
+// Trace buffer tests
+extern void test_trace_buffer_keeps_order_and_drops_when_full(void);
+extern void test_trace_frame_layout_is_little_endian(void);
+
+// Idle power mode tests
+extern void test_idle_tracker_enters_after_quiet_delay(void);
+extern void test_idle_tracker_exits_on_activity_and_counts_idle_time(void);
+extern void test_wake_edge_recovery_restores_edge_lost_in_sleep(void);
+extern void test_wake_edge_recovery_skips_edge_counted_awake(void);
+extern void test_wake_edge_recovery_creeping_chain_while_idle(void);
+
+// Bow thrust pattern tests
+extern void test_thrust_pattern_quantises_pulses(void);
+extern void test_thrust_pattern_edges_and_setpoint_changes(void);
+
+// Performance regression gate (budgets in test_perf_budgets.cpp)
+extern void test_perf_auto_mode_overshoot_within_budget(void);
+extern void test_perf_command_to_relay_within_budget(void);
+extern void test_perf_control_tick_allocation_free(void);
+extern void test_perf_remote_double_press_within_one_tick(void);
+extern void test_perf_dispatch_micro_benchmarks_within_budget(void);
+
+// Simulated windlass tests
+extern void test_sim_repeated_manual_command_keeps_relay_on(void);
+extern void test_sim_manual_takeover_keeps_automatic_direction(void);
+extern void test_sim_manual_takeover_reverses_automatic_direction(void);
+
 // Mock GPIO states for testing
 bool mock_gpio_states[40] = {false};
 int mock_gpio_modes[40] = {0};
@@ -795,6 +931,141 @@ void setup() {
     RUN_TEST(test_pulse_isr_increments_on_direction_high);
     RUN_TEST(test_pulse_isr_decrements_on_direction_low);
     
+    // Pulse accumulator tests
+    RUN_TEST(test_pulse_accumulator_drain_applies_pending);
+    RUN_TEST(test_pulse_accumulator_clamps_at_zero);
+    RUN_TEST(test_pulse_accumulator_reset_is_epoch_bump);
+    RUN_TEST(test_pulse_edge_buffer_fifo_and_overflow);
+    RUN_TEST(test_home_edge_event_is_consumed_once);
+
+    // Chain motion estimator tests
+    RUN_TEST(test_chain_motion_speed_from_edge_period);
+    RUN_TEST(test_chain_motion_speed_bounded_and_zero_without_edges);
+    RUN_TEST(test_chain_motion_stall_detection);
+    RUN_TEST(test_chain_motion_direction_change);
+
+    // Adaptive emitter tests
+    RUN_TEST(test_adaptive_emitter_deadband_and_rate_limit);
+    RUN_TEST(test_adaptive_emitter_heartbeat_depends_on_activity);
+    RUN_TEST(test_adaptive_emitter_sends_final_value_when_stopping);
+
+    // Button debouncer tests
+    RUN_TEST(test_button_debouncer_rejects_bounce);
+    RUN_TEST(test_button_debouncer_double_press_uses_edge_time);
+    RUN_TEST(test_button_debouncer_long_press_and_deadline);
+
+    // Remote gesture tests
+    RUN_TEST(test_remote_gestures_double_press_of_any_buttons);
+    RUN_TEST(test_remote_gestures_long_press_clears_only_when_stopped);
+
+    // Latency histogram tests
+    RUN_TEST(test_latency_histogram_min_max_and_reset);
+    RUN_TEST(test_latency_histogram_percentiles_from_buckets);
+
+    // Control command queue tests
+    RUN_TEST(test_mpsc_queue_fifo_overflow_and_wrap);
+    RUN_TEST(test_commands_coalesce_to_last_per_actuator_in_order);
+    RUN_TEST(test_commands_coalesce_per_windlass_channel);
+    RUN_TEST(test_commands_stop_all_is_never_coalesced);
+
+    // State snapshot tests
+    RUN_TEST(test_seqlock_round_trip_keeps_all_fields);
+    RUN_TEST(test_state_manager_publishes_snapshot_as_one_unit);
+
+    // Static arena tests
+    RUN_TEST(test_static_arena_places_aligned_objects_and_falls_back);
+
+    // SignalK command table tests
+    RUN_TEST(test_signalk_command_guards_block_motion_commands);
+    RUN_TEST(test_signalk_emergency_stop_can_be_cleared_before_connection_is_stable);
+
+    // Rode journal tests
+    RUN_TEST(test_rode_journal_restores_newest_record_across_wrap);
+    RUN_TEST(test_rode_journal_skips_corrupt_record);
+    RUN_TEST(test_settle_detector_waits_for_coast_pulses);
+    RUN_TEST(test_settle_detector_reports_chain_moved_with_winch_off);
+
+    // Runtime config record tests
+    RUN_TEST(test_config_blob_round_trip_and_skips_unchanged_save);
+    RUN_TEST(test_config_blob_rejects_corrupt_or_foreign_record);
+
+    // Relay sequencer tests
+    RUN_TEST(test_relay_sequencer_reversal_waits_for_dead_time);
+    RUN_TEST(test_relay_sequencer_stop_is_immediate_and_min_off_applies);
+    RUN_TEST(test_relay_sequencer_thermal_trip_and_recovery);
+
+    // Event log tests
+    RUN_TEST(test_event_log_coalesces_repeats_and_overwrites_oldest);
+    RUN_TEST(test_event_logger_formats_records);
+
+    // Frame scheduler tests
+    RUN_TEST(test_frame_scheduler_spreads_phases_and_keeps_periods);
+    RUN_TEST(test_frame_scheduler_records_overruns_and_late_frames);
+
+    // Anchor watch tests
+    RUN_TEST(test_anchor_watch_alarm_is_debounced_against_rode_reach);
+    RUN_TEST(test_anchor_watch_swing_radius_follows_history_window);
+
+    // Scope target tests
+    RUN_TEST(test_scope_target_from_ratio_depth_and_freeboard);
+    RUN_TEST(test_scope_target_filters_spikes_and_holds_within_deadband);
+
+    // Stop prediction tests
+    RUN_TEST(test_auto_mode_cuts_inside_predicted_coast);
+    RUN_TEST(test_auto_mode_no_cut_moving_away_from_target);
+    RUN_TEST(test_auto_mode_coast_learning_converges);
+    RUN_TEST(test_auto_mode_coast_learning_clamped);
+    RUN_TEST(test_auto_mode_no_learning_below_min_speed);
+    RUN_TEST(test_auto_mode_settle_voided_when_winch_restarts);
+
+    // Direct command link tests
+    RUN_TEST(test_siphash_matches_reference_vectors);
+    RUN_TEST(test_direct_frames_authenticate_and_reject_replays);
+    RUN_TEST(test_direct_commands_use_signalk_guards);
+
+    // Supervisor deadline tests
+    RUN_TEST(test_deadline_monitor_counts_one_miss_per_stall);
+    RUN_TEST(test_deadline_monitor_tracks_worst_interval);
+
+    // Command lease tests
+    RUN_TEST(test_command_lease_expires_without_keep_alive);
+    RUN_TEST(test_command_lease_latched_and_stop_commands_release);
+
+    // Operation statistics tests
+    RUN_TEST(test_operation_counters_count_runs_and_starts);
+    RUN_TEST(test_operation_stats_record_rejects_damage);
+
+    // Hardware profile tests
+    RUN_TEST(test_winch_controller_static_dispatch_blocks_up_at_home);
+    RUN_TEST(test_hardware_profile_pins_distinct_and_timed);
+
+    // Trace buffer tests
+    RUN_TEST(test_trace_buffer_keeps_order_and_drops_when_full);
+    RUN_TEST(test_trace_frame_layout_is_little_endian);
+
+    // Idle power mode tests
+    RUN_TEST(test_idle_tracker_enters_after_quiet_delay);
+    RUN_TEST(test_idle_tracker_exits_on_activity_and_counts_idle_time);
+    RUN_TEST(test_wake_edge_recovery_restores_edge_lost_in_sleep);
+    RUN_TEST(test_wake_edge_recovery_skips_edge_counted_awake);
+    RUN_TEST(test_wake_edge_recovery_creeping_chain_while_idle);
+
+    // Bow thrust pattern tests
+    RUN_TEST(test_thrust_pattern_quantises_pulses);
+    RUN_TEST(test_thrust_pattern_edges_and_setpoint_changes);
+
+    // Performance regression gate
+    RUN_TEST(test_perf_auto_mode_overshoot_within_budget);
+    RUN_TEST(test_perf_command_to_relay_within_budget);
+    RUN_TEST(test_perf_control_tick_allocation_free);
+    RUN_TEST(test_perf_remote_double_press_within_one_tick);
+    RUN_TEST(test_perf_dispatch_micro_benchmarks_within_budget);
+
+    // Simulated windlass tests
+    RUN_TEST(test_sim_repeated_manual_command_keeps_relay_on);
+    RUN_TEST(test_sim_manual_takeover_keeps_automatic_direction);
+    RUN_TEST(test_sim_manual_takeover_reverses_automatic_direction);
+    
     // Safety sensor tests
     RUN_TEST(test_home_sensor_blocks_winch_up);
     RUN_TEST(test_home_sensor_allows_winch_down);
@@ -870,6 +1141,7 @@ void setup() {
     
     // Bow system-level integration tests
     RUN_TEST(test_signalk_and_remote_can_coexist);
+    RUN_TEST(test_signalk_thrust_survives_remote_step_without_buttons);
     RUN_TEST(test_emergency_stop_blocks_both_signalk_and_remote);
     RUN_TEST(test_full_scenario_normal_operation);
     
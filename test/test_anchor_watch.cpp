@@ -0,0 +1,74 @@
+// Unit tests for AnchorWatch
+// Tests the allowed radius, the debounced drag alarm and the swing radius window
+
+#include <unity.h>
+#include "util/AnchorWatch.h"
+
+namespace {
+    constexpr int32_t ANCHOR_LAT_E7 = 600000000;   // 60 N
+    constexpr int32_t ANCHOR_LON_E7 = 250000000;   // 25 E
+    constexpr int32_t E7_PER_METER_NORTH = 90;     // ~1e7 / 111195
+
+    int32_t northOf(float meters) {
+        return ANCHOR_LAT_E7 + static_cast<int32_t>(meters * E7_PER_METER_NORTH);
+    }
+}
+
+void test_anchor_watch_alarm_is_debounced_against_rode_reach(void) {
+    AnchorWatch<16> watch;  // margin 15 m, bow 1 m, 5 samples
+    watch.drop(ANCHOR_LAT_E7, ANCHOR_LON_E7);
+    TEST_ASSERT_TRUE(watch.isSet());
+
+    // 50 m rode in 13 m of water: reach sqrt(50^2 - 14^2) = 48 m, allowed 63 m
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 48.0f, watch.reach(50.0f, 13.0f));
+    TEST_ASSERT_FALSE(watch.addSample(northOf(40.0f), ANCHOR_LON_E7, 50.0f, 13.0f, 1));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 40.0f, watch.getDistance());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 63.0f, watch.getAllowedRadius());
+
+    // Four samples outside: still holding; the fifth raises the alarm
+    for (uint32_t t = 2; t < 6; t++) {
+        TEST_ASSERT_FALSE(watch.addSample(northOf(70.0f), ANCHOR_LON_E7, 50.0f, 13.0f, t));
+    }
+    TEST_ASSERT_FALSE(watch.isDragging());
+    TEST_ASSERT_TRUE(watch.addSample(northOf(70.0f), ANCHOR_LON_E7, 50.0f, 13.0f, 6));
+    TEST_ASSERT_TRUE(watch.isDragging());
+
+    // One sample back inside does not clear it, five do
+    TEST_ASSERT_FALSE(watch.addSample(northOf(40.0f), ANCHOR_LON_E7, 50.0f, 13.0f, 7));
+    TEST_ASSERT_TRUE(watch.isDragging());
+    for (uint32_t t = 8; t < 11; t++) {
+        TEST_ASSERT_FALSE(watch.addSample(northOf(40.0f), ANCHOR_LON_E7, 50.0f, 13.0f, t));
+    }
+    TEST_ASSERT_TRUE(watch.addSample(northOf(40.0f), ANCHOR_LON_E7, 50.0f, 13.0f, 11));
+    TEST_ASSERT_FALSE(watch.isDragging());
+
+    // Raising the anchor stops the watch
+    watch.raise();
+    TEST_ASSERT_FALSE(watch.isSet());
+    TEST_ASSERT_FALSE(watch.addSample(northOf(200.0f), ANCHOR_LON_E7, 1.0f, 13.0f, 12));
+}
+
+void test_anchor_watch_swing_radius_follows_history_window(void) {
+    AnchorWatch<8> watch;
+    watch.drop(ANCHOR_LAT_E7, ANCHOR_LON_E7);
+
+    // One far sample, then seven close ones: still the window maximum
+    watch.addSample(northOf(30.0f), ANCHOR_LON_E7, 40.0f, 5.0f, 0);
+    for (uint32_t t = 1; t < 8; t++) {
+        watch.addSample(northOf(10.0f + t), ANCHOR_LON_E7, 40.0f, 5.0f, t);
+    }
+    TEST_ASSERT_EQUAL(8, watch.size());
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 30.0f, watch.getSwingRadius());
+
+    // The ninth sample overwrites it: the maximum is now the 17 m sample
+    watch.addSample(northOf(5.0f), ANCHOR_LON_E7, 40.0f, 5.0f, 8);
+    TEST_ASSERT_EQUAL(8, watch.size());
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 17.0f, watch.getSwingRadius());
+
+    AnchorWatchSample newest;
+    TEST_ASSERT_TRUE(watch.sample(0, newest));
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 5.0f, newest.north_m);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 5.0f, newest.depth_m);
+    TEST_ASSERT_EQUAL(8, newest.time_s);
+    TEST_ASSERT_FALSE(watch.sample(8, newest));
+}
@@ -0,0 +1,214 @@
+// Unit tests for AutomaticModeController stop prediction
+// Tests the early cut inside the predicted coast, the approach check and coast coefficient learning
+
+#include <unity.h>
+#include "automatic_mode_controller.h"
+
+namespace {
+    constexpr unsigned long STEP_MS = AutomaticModeController::SPEED_WINDOW_MS;
+
+    class FakeMotor : public IMotor {
+    public:
+        void moveUp() override { direction_ = 1; }
+        void moveDown() override { direction_ = -1; }
+        void stop() override { direction_ = 0; }
+        bool isActive() const override { return direction_ != 0; }
+        Direction getCurrentDirection() const override {
+            return direction_ > 0 ? Direction::UP : (direction_ < 0 ? Direction::DOWN : Direction::STOPPED);
+        }
+        bool isMovingUp() const override { return direction_ > 0; }
+        bool isMovingDown() const override { return direction_ < 0; }
+
+    private:
+        int direction_ = 0;
+    };
+
+    class FakeSensor : public ISensor {
+    public:
+        bool isActive() const override { return false; }
+        bool justActivated() override { return false; }
+        bool justDeactivated() override { return false; }
+        void update() override {}
+    };
+
+    struct Rig {
+        FakeMotor motor;
+        FakeSensor home_input;
+        AnchorWinchController winch{motor, home_input};
+        HomeSensor home{home_input};
+        AutomaticModeController auto_mode{winch, home};
+        float length = 5.0f;
+        unsigned long now_ms = 1000;  // 0 means "no speed sample yet"
+
+        /// One control period: the chain moves with the winch at speed_mps
+        void step(float speed_mps) {
+            auto_mode.update(length, now_ms);
+            if (motor.isMovingDown()) length += speed_mps * STEP_MS / 1000.0f;
+            if (motor.isMovingUp()) length -= speed_mps * STEP_MS / 1000.0f;
+            now_ms += STEP_MS;
+        }
+
+        /// Run automatic mode to target; @return rode length when the relay was cut
+        float runToTarget(float target, float speed_mps) {
+            auto_mode.setTargetLength(target);
+            auto_mode.setEnabled(true);
+            for (int i = 0; i < 1000 && auto_mode.isEnabled(); i++) step(speed_mps);
+            return length;
+        }
+
+        /// Chain coasts on by residual after the cut, then lies still past the settle time
+        void coast(float residual) {
+            const int coast_steps = 4;
+            for (int i = 0; i < coast_steps; i++) {
+                length += residual / coast_steps;
+                step(0.0f);
+            }
+            hold(AutomaticModeController::SETTLE_TIME_MS + 2 * STEP_MS);
+        }
+
+        /// Chain lies still for duration_ms
+        void hold(unsigned long duration_ms) {
+            for (unsigned long t = 0; t < duration_ms; t += STEP_MS) step(0.0f);
+        }
+    };
+
+    int g_learned_calls = 0;
+    float g_learned_up = 0.0f;
+    float g_learned_down = 0.0f;
+
+    void onLearned(float coast_up_s, float coast_down_s) {
+        g_learned_calls++;
+        g_learned_up = coast_up_s;
+        g_learned_down = coast_down_s;
+    }
+
+    void resetLearned() {
+        g_learned_calls = 0;
+        g_learned_up = 0.0f;
+        g_learned_down = 0.0f;
+    }
+}
+
+void test_auto_mode_cuts_inside_predicted_coast(void) {
+    Rig rig;
+    rig.auto_mode.setTolerance(0.2f);
+    rig.auto_mode.setStopPrediction(true);
+    rig.auto_mode.setCoastCoefficients(0.0f, 1.0f);
+
+    // 0.5 m/s deploying with a 1 s coast: cut 0.5 m short, well before the tolerance band
+    float cut = rig.runToTarget(10.0f, 0.5f);
+    TEST_ASSERT_FALSE(rig.motor.isActive());
+    TEST_ASSERT_FLOAT_WITHIN(0.06f, 9.5f, cut);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, rig.auto_mode.getChainSpeed());
+    TEST_ASSERT_TRUE(rig.auto_mode.consumeTargetReached());
+
+    // Prediction off: the same run stops at the tolerance band
+    Rig plain;
+    plain.auto_mode.setTolerance(0.2f);
+    plain.auto_mode.setCoastCoefficients(0.0f, 1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.06f, 9.8f, plain.runToTarget(10.0f, 0.5f));
+}
+
+void test_auto_mode_no_cut_moving_away_from_target(void) {
+    Rig rig;
+    rig.auto_mode.setTolerance(0.2f);
+    rig.auto_mode.setStopPrediction(true);
+    rig.auto_mode.setCoastCoefficients(3.0f, 3.0f);
+
+    // Manually deploying past 10 m: the speed is tracked while disabled
+    rig.length = 10.0f;
+    rig.motor.moveDown();
+    for (int i = 0; i < 12; i++) rig.step(0.5f);
+    TEST_ASSERT_TRUE(rig.auto_mode.getChainSpeed() > 0.4f);
+
+    // Within the 1.5 m predicted coast, but the chain runs away from the target: reverse, don't cut
+    rig.auto_mode.setTargetLength(10.0f);
+    rig.auto_mode.setEnabled(true);
+    rig.step(0.5f);
+    TEST_ASSERT_TRUE(rig.motor.isMovingUp());
+    TEST_ASSERT_TRUE(rig.auto_mode.isEnabled());
+    TEST_ASSERT_FALSE(rig.auto_mode.consumeTargetReached());
+}
+
+void test_auto_mode_coast_learning_converges(void) {
+    resetLearned();
+    Rig rig;
+    rig.auto_mode.setTolerance(0.2f);
+    rig.auto_mode.setStopPrediction(true);
+    rig.auto_mode.onCoastLearned(onLearned);
+
+    // The windlass always coasts 0.8 s x 0.5 m/s = 0.4 m past the cut
+    const int cycles = 15;
+    for (int i = 0; i < cycles; i++) {
+        rig.runToTarget(rig.length + 5.0f, 0.5f);
+        rig.coast(0.4f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.8f, rig.auto_mode.getCoastDown());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, rig.auto_mode.getCoastUp());
+
+    // One callback per settled cut, carrying both coefficients
+    TEST_ASSERT_EQUAL(cycles, g_learned_calls);
+    TEST_ASSERT_EQUAL_FLOAT(rig.auto_mode.getCoastDown(), g_learned_down);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, g_learned_up);
+
+    // Retrieving learns the other direction only
+    const float coast_down = rig.auto_mode.getCoastDown();
+    rig.runToTarget(rig.length - 5.0f, 0.5f);
+    rig.coast(-0.25f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, AutomaticModeController::LEARN_RATE * 0.5f, rig.auto_mode.getCoastUp());
+    TEST_ASSERT_EQUAL_FLOAT(coast_down, rig.auto_mode.getCoastDown());
+    TEST_ASSERT_EQUAL(cycles + 1, g_learned_calls);
+    TEST_ASSERT_EQUAL_FLOAT(rig.auto_mode.getCoastUp(), g_learned_up);
+}
+
+void test_auto_mode_coast_learning_clamped(void) {
+    resetLearned();
+    Rig rig;
+    rig.auto_mode.setTolerance(0.2f);
+    rig.auto_mode.setStopPrediction(true);
+    rig.auto_mode.setCoastCoefficients(0.0f, AutomaticModeController::MAX_COAST_S);
+    rig.auto_mode.onCoastLearned(onLearned);
+
+    // 2.5 m at 0.5 m/s is a 5 s coast: learned as MAX_COAST_S
+    rig.runToTarget(rig.length + 5.0f, 0.5f);
+    rig.coast(2.5f);
+    TEST_ASSERT_EQUAL(1, g_learned_calls);
+    TEST_ASSERT_EQUAL_FLOAT(AutomaticModeController::MAX_COAST_S, rig.auto_mode.getCoastDown());
+}
+
+void test_auto_mode_no_learning_below_min_speed(void) {
+    resetLearned();
+    Rig rig;
+    rig.auto_mode.setTolerance(0.2f);
+    rig.auto_mode.setStopPrediction(true);
+    rig.auto_mode.onCoastLearned(onLearned);
+
+    // Creeping at half the minimum learn speed: the residual would divide by noise
+    const float creep = AutomaticModeController::MIN_LEARN_SPEED / 2.0f;
+    rig.length = 9.7f;
+    rig.runToTarget(10.0f, creep);
+    TEST_ASSERT_FALSE(rig.motor.isActive());
+    rig.coast(0.1f);
+    TEST_ASSERT_EQUAL(0, g_learned_calls);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, rig.auto_mode.getCoastDown());
+}
+
+void test_auto_mode_settle_voided_when_winch_restarts(void) {
+    resetLearned();
+    Rig rig;
+    rig.auto_mode.setTolerance(0.2f);
+    rig.auto_mode.setStopPrediction(true);
+    rig.auto_mode.onCoastLearned(onLearned);
+
+    rig.runToTarget(10.0f, 0.5f);
+    rig.hold(AutomaticModeController::SETTLE_TIME_MS / 2);
+
+    // Driven again before the chain settled: the residual is not coast
+    rig.motor.moveUp();
+    rig.step(0.5f);
+    rig.motor.stop();
+    rig.hold(2 * AutomaticModeController::SETTLE_TIME_MS);
+    TEST_ASSERT_EQUAL(0, g_learned_calls);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, rig.auto_mode.getCoastUp());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, rig.auto_mode.getCoastDown());
+}
@@ -195,6 +195,7 @@ public:
             return false;
         }
         controller_.turnPort();
+        remote_bow_active_ = true;
         return true;
     }
     
@@ -205,13 +206,21 @@ public:
             return false;
         }
         controller_.turnStarboard();
+        remote_bow_active_ = true;
         return true;
     }
     
+    /**
+     * Process a step with no bow button held (button released)
+     * Mimics RemoteControl::processInputs(): stops only thrust the remote
+     * itself started, so SignalK thrust keeps running; during emergency
+     * stop, we stop anyway
+     */
     void processButtonRelease() {
-        // Button release = STOP (unless emergency stop is active)
-        // Actually during emergency stop, we stop anyway
-        controller_.stop();
+        if (emergency_service_.isActive() || remote_bow_active_) {
+            controller_.stop();
+        }
+        remote_bow_active_ = false;
     }
     
     int getBlockedCount() const { return blocked_count_; }
@@ -220,6 +229,7 @@ private:
     IntegrationMockController& controller_;
     MockEmergencyStopService& emergency_service_;
     int blocked_count_;
+    bool remote_bow_active_ = false;  ///< Remote started the running thrust
 };
 
 // ========== SIGNALK INTEGRATION TESTS ==========
@@ -515,6 +525,28 @@ void test_signalk_and_remote_can_coexist(void) {
     TEST_ASSERT_EQUAL_INT(-1, controller.getLastCommand());
 }
 
+void test_signalk_thrust_survives_remote_step_without_buttons(void) {
+    IntegrationMockMotor motor;
+    motor.initialize();
+    IntegrationMockController controller(motor);
+    MockEmergencyStopService emergency;
+    MockSignalKService signalk(controller, emergency);
+    MockRemoteControl remote(controller, emergency);
+    
+    signalk.setConnected(true);
+    signalk.processCommand(1);
+    
+    // Control steps with no remote button held leave SignalK's thrust running
+    remote.processButtonRelease();
+    remote.processButtonRelease();
+    TEST_ASSERT_EQUAL_INT(1, controller.getLastCommand());
+    
+    // Thrust the remote takes over is stopped when its button is released
+    remote.processFUNC3Press();
+    remote.processButtonRelease();
+    TEST_ASSERT_EQUAL_INT(0, controller.getLastCommand());
+}
+
 void test_emergency_stop_blocks_both_signalk_and_remote(void) {
     IntegrationMockMotor motor;
     motor.initialize();
@@ -0,0 +1,67 @@
+// Unit tests for ButtonDebouncer
+// Tests bounce rejection, press/release events, double-press and long-press
+
+#include <unity.h>
+#include "util/ButtonDebouncer.h"
+
+void test_button_debouncer_rejects_bounce(void) {
+    ButtonDebouncer button(30, 800, 2000);
+
+    // Contact bounce: raw level flips several times within the window
+    button.onEdge(true, 0);
+    button.onEdge(false, 5);
+    button.onEdge(true, 10);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_NONE, button.update(20));
+    TEST_ASSERT_FALSE(button.isPressed());
+
+    // Stable for 30 ms after the last edge: accepted as a single press
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_PRESS, button.update(40));
+    TEST_ASSERT_TRUE(button.isPressed());
+
+    // A noise spike shorter than the window never produces a release
+    button.onEdge(false, 100);
+    button.onEdge(true, 110);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_NONE, button.update(200));
+    TEST_ASSERT_TRUE(button.isPressed());
+
+    button.onEdge(false, 300);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_RELEASE, button.update(330));
+    TEST_ASSERT_FALSE(button.isPressed());
+}
+
+void test_button_debouncer_double_press_uses_edge_time(void) {
+    ButtonDebouncer button(30, 800, 2000);
+
+    button.onEdge(true, 1000);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_PRESS, button.update(1030));
+    button.onEdge(false, 1100);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_RELEASE, button.update(1130));
+
+    // Second press 790 ms after the first; processed late, still a double-press
+    button.onEdge(true, 1790);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_PRESS | BUTTON_DOUBLE_PRESS, button.update(1900));
+    button.onEdge(false, 1850);
+    button.update(1900);
+
+    // Third press too late for a double-press
+    button.onEdge(true, 2700);
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_PRESS, button.update(2730));
+}
+
+void test_button_debouncer_long_press_and_deadline(void) {
+    ButtonDebouncer button(30, 800, 2000);
+    TEST_ASSERT_EQUAL_UINT32(ButtonDebouncer::NO_DEADLINE, button.nextDeadline(0));
+
+    button.onEdge(true, 0);
+    TEST_ASSERT_EQUAL_UINT32(20, button.nextDeadline(10));
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_PRESS, button.update(30));
+
+    // Next timed event is the long-press
+    TEST_ASSERT_EQUAL_UINT32(1500, button.nextDeadline(500));
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_NONE, button.update(1999));
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_LONG_PRESS, button.update(2000));
+
+    // Reported once per press
+    TEST_ASSERT_EQUAL_UINT8(BUTTON_NONE, button.update(5000));
+    TEST_ASSERT_EQUAL_UINT32(ButtonDebouncer::NO_DEADLINE, button.nextDeadline(5000));
+}
@@ -0,0 +1,93 @@
+// Unit tests for ChainMotionEstimator
+// Tests period-based speed, the no-edge speed bound, stall detection and direction changes
+
+#include <unity.h>
+#include "chain_motion_estimator.h"
+
+namespace {
+    constexpr float METERS_PER_PULSE = 0.01f;
+
+    /// Feed count single-pulse edges period_us apart, starting at start_us; @return time of the last edge
+    uint32_t feedEdges(ChainMotionEstimator& motion, uint32_t start_us, uint32_t period_us, int count,
+                       int32_t pulses = 1) {
+        uint32_t now_us = start_us;
+        for (int i = 0; i < count; i++) {
+            now_us = start_us + i * period_us;
+            motion.addEdge({now_us, pulses}, METERS_PER_PULSE);
+            motion.update(now_us, METERS_PER_PULSE, true);
+        }
+        return now_us;
+    }
+}
+
+void test_chain_motion_speed_from_edge_period(void) {
+    ChainMotionEstimator motion;
+    // 1 pulse every 20 ms at 0.01 m/pulse = 0.5 m/s deploying
+    uint32_t last_us = feedEdges(motion, 1000, 20000, 20);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.5f, motion.getSpeed());
+
+    // A PCNT batch of 4 pulses over 80 ms is the same speed
+    motion.addEdge({last_us + 80000, 4}, METERS_PER_PULSE);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.5f, motion.getSpeed());
+
+    // Faster edges: speed and acceleration follow upwards
+    last_us = feedEdges(motion, last_us + 90000, 10000, 3);
+    TEST_ASSERT_TRUE(motion.getSpeed() > 0.5f);
+    TEST_ASSERT_TRUE(motion.getAcceleration() > 0.0f);
+}
+
+void test_chain_motion_speed_bounded_and_zero_without_edges(void) {
+    ChainMotionEstimator motion;
+    uint32_t last_us = feedEdges(motion, 0, 20000, 20);
+
+    // No edge for 100 ms: at most one pulse per 100 ms = 0.1 m/s
+    motion.update(last_us + 100000, METERS_PER_PULSE, false);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.1f, motion.getSpeed());
+
+    // No edge for the stop timeout: stopped
+    motion.update(last_us + ChainMotionEstimator::STOP_TIMEOUT_US, METERS_PER_PULSE, false);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, motion.getSpeed());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, motion.getAcceleration());
+
+    // The first edge after a stop has no valid period
+    motion.addEdge({last_us + 2000000, 1}, METERS_PER_PULSE);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, motion.getSpeed());
+}
+
+void test_chain_motion_stall_detection(void) {
+    ChainMotionEstimator motion;
+    const uint32_t stall_us = ChainMotionEstimator::STALL_TIMEOUT_US;
+
+    // Winch energised, chain never moved since boot: stalled once the timeout has passed since the start
+    motion.update(5000000, METERS_PER_PULSE, true);
+    motion.update(5000000 + stall_us - 1, METERS_PER_PULSE, true);
+    TEST_ASSERT_FALSE(motion.isStalled());
+    motion.update(5000000 + stall_us, METERS_PER_PULSE, true);
+    TEST_ASSERT_TRUE(motion.isStalled());
+
+    // Edges clear the stall; a quiet chain with the winch off is not a stall
+    uint32_t last_us = feedEdges(motion, 7000000, 20000, 5);
+    TEST_ASSERT_FALSE(motion.isStalled());
+    motion.update(last_us + stall_us, METERS_PER_PULSE, false);
+    TEST_ASSERT_FALSE(motion.isStalled());
+
+    // Energised again: the quiet time counts from the new start, not from the last edge
+    motion.update(last_us + stall_us + 1000, METERS_PER_PULSE, true);
+    TEST_ASSERT_FALSE(motion.isStalled());
+    motion.update(last_us + 2 * stall_us + 1000, METERS_PER_PULSE, true);
+    TEST_ASSERT_TRUE(motion.isStalled());
+}
+
+void test_chain_motion_direction_change(void) {
+    ChainMotionEstimator motion;
+    uint32_t last_us = feedEdges(motion, 0, 20000, 20);
+    TEST_ASSERT_TRUE(motion.getSpeed() > 0.0f);
+
+    // Reversal: the first retrieve edge has no valid period, then speed goes negative
+    motion.addEdge({last_us + 20000, -1}, METERS_PER_PULSE);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, motion.getSpeed());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, motion.getAcceleration());
+
+    feedEdges(motion, last_us + 40000, 25000, 20, -1);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -0.4f, motion.getSpeed());
+}
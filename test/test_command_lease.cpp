@@ -0,0 +1,42 @@
+// Unit tests for CommandLease
+// Tests hold-to-run expiry, renewal by keep-alives and release
+
+#include <unity.h>
+#include "util/CommandLease.h"
+
+void test_command_lease_expires_without_keep_alive(void) {
+    CommandLease lease;
+    TEST_ASSERT_FALSE(lease.expired(0));  // No lease, nothing to expire
+
+    lease.grant(1, 1000, 300000);
+    TEST_ASSERT_TRUE(lease.isActive());
+    TEST_ASSERT_EQUAL(1, lease.direction());
+    TEST_ASSERT_FALSE(lease.expired(300999));
+    TEST_ASSERT_TRUE(lease.expired(301000));
+
+    // Keep-alives renew from their own arrival time
+    lease.grant(1, 250000, 300000);
+    TEST_ASSERT_FALSE(lease.expired(549999));
+    TEST_ASSERT_TRUE(lease.expired(550000));
+
+    // Across the 32-bit micros() wrap
+    lease.grant(-1, 0xFFFFFF00UL, 1000);
+    TEST_ASSERT_FALSE(lease.expired(0x00000100UL));
+    TEST_ASSERT_TRUE(lease.expired(0x000002E8UL));
+}
+
+void test_command_lease_latched_and_stop_commands_release(void) {
+    CommandLease lease;
+    lease.grant(1, 0, 300000);
+    lease.grant(1, 1000, 0);  // Same motion, latched: no expiry
+    TEST_ASSERT_FALSE(lease.isActive());
+    TEST_ASSERT_FALSE(lease.expired(10000000));
+
+    lease.grant(-1, 0, 300000);
+    lease.grant(0, 1000, 300000);  // Stop
+    TEST_ASSERT_FALSE(lease.isActive());
+
+    lease.grant(-1, 0, 300000);
+    lease.release();
+    TEST_ASSERT_EQUAL(0, lease.direction());
+}
@@ -0,0 +1,73 @@
+// Unit tests for ConfigBlob
+// Tests the versioned, CRC-checked runtime configuration record
+
+#include <unity.h>
+#include "services/ConfigBlob.h"
+
+namespace {
+    class MemoryConfigStore : public IConfigStore {
+    public:
+        bool read(RuntimeConfig& config) override {
+            if (!written) return false;
+            config = record;
+            return true;
+        }
+        bool write(const RuntimeConfig& config) override {
+            record = config;
+            written = true;
+            writes++;
+            return true;
+        }
+
+        RuntimeConfig record = {};
+        bool written = false;
+        int writes = 0;
+    };
+}
+
+void test_config_blob_round_trip_and_skips_unchanged_save(void) {
+    MemoryConfigStore store;
+    RuntimeConfig loaded = {};
+
+    ConfigBlob first_boot(store);
+    TEST_ASSERT_FALSE(first_boot.load(loaded));
+
+    RuntimeConfig config = makeRuntimeConfig(0.02f, 0.3f, 0.4f, 0.1f, 1.2f,
+                                             RuntimeConfigFlag::AP_PASSWORD_CHECKED);
+    TEST_ASSERT_TRUE(first_boot.save(config));
+    // Periodic save with the same values does not touch the store
+    TEST_ASSERT_FALSE(first_boot.save(config));
+    TEST_ASSERT_EQUAL(1, store.writes);
+
+    ConfigBlob next_boot(store);
+    TEST_ASSERT_TRUE(next_boot.load(loaded));
+    TEST_ASSERT_EQUAL_FLOAT(0.02f, loaded.meters_per_pulse);
+    TEST_ASSERT_EQUAL_FLOAT(0.3f, loaded.coast_up_s);
+    TEST_ASSERT_EQUAL_FLOAT(0.4f, loaded.coast_down_s);
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, loaded.rode_deadband);
+    TEST_ASSERT_EQUAL_FLOAT(1.2f, loaded.freeboard_m);
+    TEST_ASSERT_TRUE(loaded.flags & RuntimeConfigFlag::AP_PASSWORD_CHECKED);
+
+    // Unchanged after load: no write; a learned value changes: one write
+    TEST_ASSERT_FALSE(next_boot.save(config));
+    TEST_ASSERT_TRUE(next_boot.save(makeRuntimeConfig(0.02f, 0.35f, 0.4f, 0.1f, 1.2f,
+                                                      RuntimeConfigFlag::AP_PASSWORD_CHECKED)));
+    TEST_ASSERT_EQUAL(2, store.writes);
+}
+
+void test_config_blob_rejects_corrupt_or_foreign_record(void) {
+    MemoryConfigStore store;
+    RuntimeConfig loaded = {};
+    ConfigBlob blob(store);
+
+    store.write(makeRuntimeConfig(0.02f, 0.0f, 0.0f, 0.05f, 1.0f, 0));
+    store.record.meters_per_pulse = 0.03f;  // Bit rot: CRC no longer matches
+    TEST_ASSERT_FALSE(blob.load(loaded));
+
+    // Record from another layout version (even with a matching CRC)
+    RuntimeConfig other = makeRuntimeConfig(0.02f, 0.0f, 0.0f, 0.05f, 1.0f, 0);
+    other.version = RUNTIME_CONFIG_VERSION + 1;
+    other.crc = crc32(&other, offsetof(RuntimeConfig, crc));
+    store.write(other);
+    TEST_ASSERT_FALSE(blob.load(loaded));
+}
@@ -0,0 +1,103 @@
+// Unit tests for the control command queue
+// Tests MPSC queue ordering and overflow, and per-actuator coalescing
+
+#include <unity.h>
+#include "util/MpscQueue.h"
+#include "services/ControlCommand.h"
+
+void test_mpsc_queue_fifo_overflow_and_wrap(void) {
+    MpscQueue<int, 4> queue;
+    int value = 0;
+
+    TEST_ASSERT_FALSE(queue.pop(value));
+
+    // Fill to capacity; the fifth push is dropped and counted
+    for (int i = 1; i <= 4; i++) {
+        TEST_ASSERT_TRUE(queue.push(i));
+    }
+    TEST_ASSERT_FALSE(queue.push(5));
+    TEST_ASSERT_EQUAL_UINT32(1, queue.dropped());
+
+    // Drain half, refill across the wrap point, order is preserved
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL(1, value);
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL(2, value);
+    TEST_ASSERT_TRUE(queue.push(6));
+    TEST_ASSERT_TRUE(queue.push(7));
+
+    const int expected[] = {3, 4, 6, 7};
+    for (int e : expected) {
+        TEST_ASSERT_TRUE(queue.pop(value));
+        TEST_ASSERT_EQUAL(e, value);
+    }
+    TEST_ASSERT_FALSE(queue.pop(value));
+}
+
+void test_commands_coalesce_to_last_per_actuator_in_order(void) {
+    ControlCommand batch[] = {
+        {ControlCommandType::MANUAL_WINCH, 1.0f, CommandSource::SIGNALK, 10},
+        {ControlCommandType::AUTO_MODE, 1.0f, CommandSource::SIGNALK, 20},
+        {ControlCommandType::ARM_TARGET, 15.0f, CommandSource::SIGNALK, 30},
+        {ControlCommandType::MANUAL_WINCH, 0.0f, CommandSource::SIGNALK, 40},
+        {ControlCommandType::AUTO_MODE, 1.0f, CommandSource::SIGNALK, 50},
+        {ControlCommandType::HOME, 0.0f, CommandSource::SIGNALK, 60},
+    };
+
+    size_t kept = coalesceCommands(batch, 6);
+
+    // Last winch (stop), then auto enable, then home - arrival order kept
+    TEST_ASSERT_EQUAL(3, kept);
+    TEST_ASSERT_TRUE(batch[0].type == ControlCommandType::MANUAL_WINCH);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, batch[0].value);
+    TEST_ASSERT_EQUAL_UINT32(40, batch[0].arrival_us);
+    TEST_ASSERT_TRUE(batch[1].type == ControlCommandType::AUTO_MODE);
+    TEST_ASSERT_EQUAL_UINT32(50, batch[1].arrival_us);
+    TEST_ASSERT_TRUE(batch[2].type == ControlCommandType::HOME);
+}
+
+void test_commands_coalesce_per_windlass_channel(void) {
+    ControlCommand batch[] = {
+        {ControlCommandType::MANUAL_WINCH, 1.0f, CommandSource::SIGNALK, 10},
+        {ControlCommandType::MANUAL_WINCH, -1.0f, CommandSource::SIGNALK, 20},
+        {ControlCommandType::MANUAL_WINCH, 0.0f, CommandSource::SIGNALK, 30},
+        {ControlCommandType::MANUAL_WINCH, 1.0f, CommandSource::SIGNALK, 40},
+    };
+    batch[1].channel = 1;
+    batch[3].channel = 1;
+
+    size_t kept = coalesceCommands(batch, 4);
+
+    // One survivor per channel: primary stop, then the stern retrieve
+    TEST_ASSERT_EQUAL(2, kept);
+    TEST_ASSERT_EQUAL_UINT8(0, batch[0].channel);
+    TEST_ASSERT_EQUAL_UINT32(30, batch[0].arrival_us);
+    TEST_ASSERT_EQUAL_UINT8(1, batch[1].channel);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, batch[1].value);
+}
+
+void test_commands_stop_all_is_never_coalesced(void) {
+    ControlCommand batch[] = {
+        {ControlCommandType::BOW_THRUST, 0.6f, CommandSource::SIGNALK, 10},
+        {ControlCommandType::STOP_ALL, 0.0f, CommandSource::LOCAL, 20},
+        {ControlCommandType::MANUAL_WINCH, 1.0f, CommandSource::DIRECT, 30},
+    };
+
+    size_t kept = coalesceCommands(batch, 3);
+
+    // A keep-alive after the connection-lost stop does not drop it
+    TEST_ASSERT_EQUAL(3, kept);
+    TEST_ASSERT_TRUE(batch[1].type == ControlCommandType::STOP_ALL);
+    TEST_ASSERT_TRUE(batch[2].type == ControlCommandType::MANUAL_WINCH);
+
+    // Winch commands around it still coalesce among themselves
+    ControlCommand repeated[] = {
+        {ControlCommandType::MANUAL_WINCH, 1.0f, CommandSource::DIRECT, 10},
+        {ControlCommandType::STOP_ALL, 0.0f, CommandSource::LOCAL, 20},
+        {ControlCommandType::MANUAL_WINCH, 1.0f, CommandSource::DIRECT, 30},
+    };
+    kept = coalesceCommands(repeated, 3);
+    TEST_ASSERT_EQUAL(2, kept);
+    TEST_ASSERT_TRUE(repeated[0].type == ControlCommandType::STOP_ALL);
+    TEST_ASSERT_EQUAL_UINT32(30, repeated[1].arrival_us);
+}
@@ -0,0 +1,50 @@
+// Unit tests for DeadlineMonitor
+// Tests overdue detection, miss counting per episode and the worst check-in interval
+
+#include <unity.h>
+#include "util/DeadlineMonitor.h"
+
+void test_deadline_monitor_counts_one_miss_per_stall(void) {
+    DeadlineMonitor<3> monitor;
+    const size_t control = monitor.add("control", 100);
+    const size_t remote = monitor.add("remote", 50);
+    TEST_ASSERT_EQUAL(1, remote);
+
+    // Nothing checked in yet: nothing is supervised, nothing is late
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.check(1000));
+    TEST_ASSERT_TRUE(monitor.allMet(1000));
+    TEST_ASSERT_FALSE(monitor.isSupervised(control));
+
+    monitor.checkIn(control, 1000);
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.check(1100));  // Exactly on the deadline
+    TEST_ASSERT_EQUAL_UINT32(1UL << control, monitor.check(1101));
+    TEST_ASSERT_FALSE(monitor.allMet(1101));
+
+    // Still the same stall: reported every check, counted once
+    TEST_ASSERT_EQUAL_UINT32(1UL << control, monitor.check(1500));
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.missed(control));
+
+    // Recovers, stalls again: a second miss
+    monitor.checkIn(control, 1550);
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.check(1560));
+    TEST_ASSERT_EQUAL_UINT32(1UL << control, monitor.check(1700));
+    TEST_ASSERT_EQUAL_UINT32(2, monitor.missed(control));
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.missed(remote));
+
+    // A check-in stamped after the checker's clock reading is not late
+    monitor.checkIn(control, 2000);
+    TEST_ASSERT_TRUE(monitor.allMet(1990));
+}
+
+void test_deadline_monitor_tracks_worst_interval(void) {
+    DeadlineMonitor<1> monitor;
+    const size_t pulse = monitor.add("pulse", 1000);
+    TEST_ASSERT_EQUAL(DeadlineMonitor<1>::NONE, monitor.add("full", 1000));
+
+    monitor.checkIn(pulse, 0xFFFFFF00UL);  // Across the 32-bit micros() wrap
+    monitor.checkIn(pulse, 0x00000100UL);
+    monitor.checkIn(pulse, 0x00000200UL);
+    TEST_ASSERT_EQUAL_UINT32(0x200, monitor.worstInterval(pulse));
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.check(0x00000300UL));
+    TEST_ASSERT_EQUAL_UINT32(1000, monitor.deadline(pulse));
+}
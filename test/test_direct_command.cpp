@@ -0,0 +1,90 @@
+// Unit tests for the direct helm link frames
+// Tests SipHash reference vectors, frame authentication, replay protection and guards
+
+#include <unity.h>
+#include "services/DirectCommandFrame.h"
+
+namespace {
+    const uint8_t kKey[SIPHASH_KEY_SIZE] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+    DirectFrame command(uint32_t nonce, uint32_t sequence, ControlCommandType type, float value) {
+        DirectFrame frame;
+        frame.nonce = nonce;
+        frame.sequence = sequence;
+        frame.sender_ms = 1000 + sequence;
+        frame.command = static_cast<uint8_t>(type);
+        frame.value = value;
+        return frame;
+    }
+}
+
+void test_siphash_matches_reference_vectors(void) {
+    uint8_t message[15];
+    for (uint8_t i = 0; i < sizeof(message); i++) message[i] = i;
+
+    // Vectors from the SipHash paper (key 00..0f, message 00..len-1)
+    TEST_ASSERT_TRUE(sipHash24(kKey, message, 0) == 0x726fdb47dd0e0e31ULL);
+    TEST_ASSERT_TRUE(sipHash24(kKey, message, 8) == 0x93f5f5799a932462ULL);
+    TEST_ASSERT_TRUE(sipHash24(kKey, message, 15) == 0xa129ca6149be45e5ULL);
+
+    uint8_t key[SIPHASH_KEY_SIZE];
+    TEST_ASSERT_TRUE(parseDirectKey("000102030405060708090a0B0c0D0e0F", key));
+    TEST_ASSERT_EQUAL_MEMORY(kKey, key, sizeof(key));
+    TEST_ASSERT_FALSE(parseDirectKey("000102030405060708090a0b0c0d0e", key));    // Short
+    TEST_ASSERT_FALSE(parseDirectKey("000102030405060708090a0b0c0d0e0f00", key));  // Long
+    TEST_ASSERT_FALSE(parseDirectKey("0001020304050607080x0a0b0c0d0e0f", key));  // Not hex
+}
+
+void test_direct_frames_authenticate_and_reject_replays(void) {
+    uint8_t wire[DIRECT_FRAME_SIZE];
+    DirectFrame decoded;
+    encodeDirectFrame(command(0x1234, 7, ControlCommandType::MANUAL_WINCH, -1.0f), kKey, wire);
+
+    TEST_ASSERT_TRUE(decodeDirectFrame(wire, sizeof(wire), kKey, decoded) == DirectFrameStatus::ACCEPTED);
+    TEST_ASSERT_EQUAL_UINT32(0x1234, decoded.nonce);
+    TEST_ASSERT_EQUAL_UINT32(7, decoded.sequence);
+    TEST_ASSERT_EQUAL_UINT32(1007, decoded.sender_ms);
+    TEST_ASSERT_TRUE(decoded.command == static_cast<uint8_t>(ControlCommandType::MANUAL_WINCH));
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, decoded.value);
+    TEST_ASSERT_EQUAL_UINT16(DIRECT_RTT_UNKNOWN, decoded.rtt_ms);
+
+    // Any flipped bit, a truncated frame or another key fails the tag check
+    uint8_t tampered[DIRECT_FRAME_SIZE];
+    memcpy(tampered, wire, sizeof(wire));
+    tampered[20] ^= 0x80;  // -1.0 -> 1.0
+    TEST_ASSERT_TRUE(decodeDirectFrame(tampered, sizeof(tampered), kKey, decoded) == DirectFrameStatus::INVALID);
+    TEST_ASSERT_TRUE(decodeDirectFrame(wire, sizeof(wire) - 1, kKey, decoded) == DirectFrameStatus::INVALID);
+    uint8_t other_key[SIPHASH_KEY_SIZE] = {};
+    TEST_ASSERT_TRUE(decodeDirectFrame(wire, sizeof(wire), other_key, decoded) == DirectFrameStatus::INVALID);
+
+    // Replay guard: current nonce only, sequences strictly rising (with wrap)
+    DirectReplayGuard guard(0x1234);
+    TEST_ASSERT_TRUE(guard.check(command(0x9999, 1, ControlCommandType::HOME, 1.0f)) == DirectFrameStatus::NONCE);
+    TEST_ASSERT_TRUE(guard.check(command(0x1234, 0xFFFFFFFFUL, ControlCommandType::HOME, 1.0f)) == DirectFrameStatus::ACCEPTED);
+    TEST_ASSERT_TRUE(guard.check(command(0x1234, 0xFFFFFFFFUL, ControlCommandType::HOME, 1.0f)) == DirectFrameStatus::REPLAY);
+    TEST_ASSERT_TRUE(guard.check(command(0x1234, 3, ControlCommandType::HOME, 1.0f)) == DirectFrameStatus::ACCEPTED);
+    TEST_ASSERT_TRUE(guard.check(command(0x1234, 2, ControlCommandType::HOME, 1.0f)) == DirectFrameStatus::REPLAY);
+    guard.reset(0x5678);  // ECU reboot: frames of the old session are stale
+    TEST_ASSERT_TRUE(guard.check(command(0x1234, 4, ControlCommandType::HOME, 1.0f)) == DirectFrameStatus::NONCE);
+}
+
+void test_direct_commands_use_signalk_guards(void) {
+    uint8_t guards = 0;
+
+    // Motion is blocked by a latched emergency stop; no connection requirement
+    TEST_ASSERT_TRUE(directCommandGuards(static_cast<uint8_t>(ControlCommandType::MANUAL_WINCH), guards));
+    TEST_ASSERT_FALSE(skCommandAllowed(guards, 1.0f, true, true));
+    TEST_ASSERT_TRUE(skCommandAllowed(guards, 1.0f, false, true));
+
+    // Home is a trigger; the emergency stop itself can always be set or cleared
+    TEST_ASSERT_TRUE(directCommandGuards(static_cast<uint8_t>(ControlCommandType::HOME), guards));
+    TEST_ASSERT_FALSE(skCommandAllowed(guards, 0.0f, false, true));
+    TEST_ASSERT_TRUE(directCommandGuards(static_cast<uint8_t>(ControlCommandType::EMERGENCY_STOP), guards));
+    TEST_ASSERT_TRUE(skCommandAllowed(guards, 0.0f, true, true));
+
+    // Chart-plotter-only and internal commands are not accepted over the link
+    TEST_ASSERT_FALSE(directCommandGuards(static_cast<uint8_t>(ControlCommandType::RESET_RODE), guards));
+    TEST_ASSERT_FALSE(directCommandGuards(static_cast<uint8_t>(ControlCommandType::DEPTH), guards));
+    TEST_ASSERT_FALSE(directCommandGuards(static_cast<uint8_t>(ControlCommandType::STOP_ALL), guards));
+    TEST_ASSERT_FALSE(directCommandGuards(200, guards));
+}
@@ -0,0 +1,64 @@
+// Unit tests for EventLog and EventLogger formatting
+// Tests coalescing, overflow and deferred text formatting of binary records
+
+#include <unity.h>
+#include <string.h>
+#include "services/EventLogger.h"
+
+void test_event_log_coalesces_repeats_and_overwrites_oldest(void) {
+    EventLog<8> log;
+    EventRecord record;
+
+    log.record(1, 0, 0, 100);
+    log.record(2, 5, 0, 110);
+    log.record(1, 0, 0, 120);  // Within the coalesce depth: merged
+    log.record(2, 6, 0, 130);  // Different argument: new record
+    TEST_ASSERT_EQUAL_UINT32(4, log.logged());
+    TEST_ASSERT_EQUAL_UINT32(1, log.coalesced());
+
+    TEST_ASSERT_TRUE(log.pop(record));
+    TEST_ASSERT_EQUAL_UINT32(100, record.timestamp_ms);
+    TEST_ASSERT_EQUAL_UINT32(1, record.repeats);
+
+    // A popped record is not merged into again
+    log.record(1, 0, 0, 140);
+    TEST_ASSERT_TRUE(log.pop(record));
+    TEST_ASSERT_EQUAL_UINT32(2, record.id);
+    TEST_ASSERT_TRUE(log.pop(record));
+    TEST_ASSERT_EQUAL_UINT32(6, record.a);
+    TEST_ASSERT_TRUE(log.pop(record));
+    TEST_ASSERT_EQUAL_UINT32(140, record.timestamp_ms);
+    TEST_ASSERT_EQUAL_UINT32(0, record.repeats);
+    TEST_ASSERT_FALSE(log.pop(record));
+
+    // Full: the oldest unread records are dropped, the newest kept
+    for (uint32_t i = 0; i < 10; i++) {
+        log.record(3, i, 0, 200 + i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, log.overwritten());
+    TEST_ASSERT_TRUE(log.pop(record));
+    TEST_ASSERT_EQUAL_UINT32(2, record.a);
+}
+
+void test_event_logger_formats_records(void) {
+    EventLog<8> log;
+    EventRecord record;
+    char text[96];
+
+    EventLogger::log(LogEvent::MOTOR_UP);  // Direct-print build: must not crash
+
+    // Arguments as stored by EventLogger::log(LogEvent::PULSE_STATUS, -12L, 0.25f)
+    float meters = 0.25f;
+    uint32_t meters_bits;
+    memcpy(&meters_bits, &meters, sizeof(meters_bits));
+    log.record(static_cast<uint16_t>(LogEvent::PULSE_STATUS), static_cast<uint32_t>(-12), meters_bits, 0);
+    log.record(static_cast<uint16_t>(LogEvent::PULSE_STATUS), static_cast<uint32_t>(-12), meters_bits, 0);
+    TEST_ASSERT_TRUE(log.pop(record));
+    EventLogger::format(record, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("Pulses: -12, Chain: 0.25 m (x2)", text);
+
+    record.id = static_cast<uint16_t>(LogEvent::BOW_STOP);
+    record.repeats = 0;
+    EventLogger::format(record, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("Bow propeller stopped", text);
+}
@@ -0,0 +1,73 @@
+// Unit tests for FrameScheduler
+// Tests phase assignment, task periods and overrun/late statistics
+
+#include <unity.h>
+#include "util/FrameScheduler.h"
+
+namespace {
+    uint32_t fake_now_us = 0;
+    uint32_t fakeClock() { return fake_now_us; }
+
+    struct Counter {
+        int runs = 0;
+        uint32_t busy_us = 0;  ///< Simulated execution time per run
+    };
+
+    void runCounter(void* context) {
+        auto* counter = static_cast<Counter*>(context);
+        counter->runs++;
+        fake_now_us += counter->busy_us;
+    }
+}
+
+void test_frame_scheduler_spreads_phases_and_keeps_periods(void) {
+    fake_now_us = 0;
+    FrameScheduler<8> scheduler(25, fakeClock);
+    Counter telemetry, connection, drain, slow;
+
+    TEST_ASSERT_EQUAL(0, scheduler.add("telemetry", 100, 0, runCounter, &telemetry));
+    TEST_ASSERT_EQUAL(1, scheduler.add("connection", 100, 0, runCounter, &connection));
+    TEST_ASSERT_EQUAL(2, scheduler.add("drain", 100, 0, runCounter, &drain));
+    TEST_ASSERT_EQUAL(3, scheduler.add("slow", 1000, 0, runCounter, &slow));
+
+    // Same-rate tasks on different frames; the 1 Hz task on the free one
+    TEST_ASSERT_EQUAL_UINT32(4, scheduler.period(0));
+    TEST_ASSERT_TRUE(scheduler.phase(0) != scheduler.phase(1));
+    TEST_ASSERT_TRUE(scheduler.phase(1) != scheduler.phase(2));
+    TEST_ASSERT_TRUE(scheduler.phase(0) != scheduler.phase(2));
+    TEST_ASSERT_EQUAL_UINT32(3, scheduler.phase(3) % 4);
+
+    for (int frame = 0; frame < 80; frame++) {  // 2 s
+        scheduler.tick();
+        fake_now_us += 25000;
+    }
+    TEST_ASSERT_EQUAL(20, telemetry.runs);
+    TEST_ASSERT_EQUAL(20, connection.runs);
+    TEST_ASSERT_EQUAL(20, drain.runs);
+    TEST_ASSERT_EQUAL(2, slow.runs);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getFrameOverruns());
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getLateFrames());
+}
+
+void test_frame_scheduler_records_overruns_and_late_frames(void) {
+    fake_now_us = 0;
+    FrameScheduler<1> scheduler(25, fakeClock);
+    Counter heavy;
+    heavy.busy_us = 30000;  // Longer than its 5 ms budget and the 25 ms frame
+
+    scheduler.add("heavy", 25, 5000, runCounter, &heavy);
+    Counter other;
+    TEST_ASSERT_EQUAL(-1, scheduler.add("full", 25, 0, runCounter, &other));
+
+    scheduler.tick();
+    fake_now_us += 60000;  // Next tick arrives more than a frame late
+    scheduler.tick();
+
+    const ScheduledTaskStats& stats = scheduler.stats(0);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.runs);
+    TEST_ASSERT_EQUAL_UINT32(30000, stats.max_us);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.overruns);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.late);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getFrameOverruns());
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getLateFrames());
+}
@@ -0,0 +1,40 @@
+// Unit tests for IdleTracker
+// Tests the idle entry delay, immediate exit on activity and the idle time account
+
+#include <unity.h>
+#include "util/IdleTracker.h"
+
+void test_idle_tracker_enters_after_quiet_delay(void) {
+    IdleTracker tracker(3000);
+    TEST_ASSERT_TRUE(tracker.update(false, 1000) == IdleTracker::Transition::NONE);
+    TEST_ASSERT_TRUE(tracker.update(false, 3999) == IdleTracker::Transition::NONE);
+    TEST_ASSERT_FALSE(tracker.isIdle());
+
+    // A stop followed by the next command within the delay stays active
+    TEST_ASSERT_TRUE(tracker.update(true, 3500) == IdleTracker::Transition::NONE);
+    TEST_ASSERT_TRUE(tracker.update(false, 6499) == IdleTracker::Transition::NONE);
+    TEST_ASSERT_TRUE(tracker.update(false, 6500) == IdleTracker::Transition::ENTER_IDLE);
+    TEST_ASSERT_TRUE(tracker.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.idleEntries());
+    TEST_ASSERT_TRUE(tracker.update(false, 7000) == IdleTracker::Transition::NONE);
+}
+
+void test_idle_tracker_exits_on_activity_and_counts_idle_time(void) {
+    IdleTracker tracker(100);
+    tracker.update(false, 0);
+    TEST_ASSERT_TRUE(tracker.update(false, 100) == IdleTracker::Transition::ENTER_IDLE);
+    tracker.update(false, 600);
+    TEST_ASSERT_EQUAL_UINT32(500, tracker.idleMs());
+
+    // First activity leaves idle at once; the time up to it still counts
+    TEST_ASSERT_TRUE(tracker.update(true, 700) == IdleTracker::Transition::EXIT_IDLE);
+    TEST_ASSERT_FALSE(tracker.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(600, tracker.idleMs());
+    tracker.update(false, 750);
+    TEST_ASSERT_EQUAL_UINT32(600, tracker.idleMs());
+
+    // Across the 32-bit millis() wrap
+    IdleTracker wrapping(100);
+    wrapping.update(true, 0xFFFFFFC0UL);
+    TEST_ASSERT_TRUE(wrapping.update(false, 0x00000024UL) == IdleTracker::Transition::ENTER_IDLE);
+}
@@ -0,0 +1,39 @@
+// Unit tests for LatencyHistogram
+// Tests bucket placement, min/max and percentile estimation
+
+#include <unity.h>
+#include "util/LatencyHistogram.h"
+
+void test_latency_histogram_min_max_and_reset(void) {
+    LatencyHistogram histogram;
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.count());
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.percentile(50));
+
+    histogram.record(12);
+    histogram.record(3);
+    histogram.record(700);
+    TEST_ASSERT_EQUAL_UINT32(3, histogram.count());
+    TEST_ASSERT_EQUAL_UINT32(3, histogram.min());
+    TEST_ASSERT_EQUAL_UINT32(700, histogram.max());
+
+    histogram.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.count());
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.min());
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.max());
+}
+
+void test_latency_histogram_percentiles_from_buckets(void) {
+    LatencyHistogram histogram;
+
+    // 98 fast samples (bucket [8,16)), 2 slow outliers (bucket [1024,2048))
+    for (int i = 0; i < 98; i++) {
+        histogram.record(10);
+    }
+    histogram.record(1500);
+    histogram.record(1600);
+
+    // p50 is the upper edge of the fast bucket; p99 lands in the outlier bucket
+    TEST_ASSERT_EQUAL_UINT32(15, histogram.percentile(50));
+    TEST_ASSERT_EQUAL_UINT32(1600, histogram.percentile(99));  // Clamped to max
+    TEST_ASSERT_EQUAL_UINT32(15, histogram.percentile(98));
+}
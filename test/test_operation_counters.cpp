@@ -0,0 +1,63 @@
+// Unit tests for OperationCounters
+// Tests run time and start accounting per direction, chain counting and the persisted record
+
+#include <unity.h>
+#include "util/OperationCounters.h"
+
+void test_operation_counters_count_runs_and_starts(void) {
+    OperationCounters counters;
+
+    counters.motion(OperationMotor::WINCH, 1, 1000);
+    counters.motion(OperationMotor::WINCH, 1, 1500);  // Repeat of the running command
+    TEST_ASSERT_EQUAL_UINT32(1, counters.get(OperationStat::WINCH_UP_STARTS));
+    TEST_ASSERT_EQUAL_UINT32(0, counters.get(OperationStat::WINCH_UP_MS));  // Added when the run ends
+
+    // Reversal ends the up run and starts a down run
+    counters.motion(OperationMotor::WINCH, -1, 3000);
+    TEST_ASSERT_EQUAL_UINT32(2000, counters.get(OperationStat::WINCH_UP_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, counters.get(OperationStat::WINCH_DOWN_STARTS));
+
+    counters.motion(OperationMotor::WINCH, 0, 3250);
+    counters.motion(OperationMotor::WINCH, 0, 9000);  // Stop while stopped
+    TEST_ASSERT_EQUAL_UINT32(250, counters.get(OperationStat::WINCH_DOWN_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, counters.get(OperationStat::WINCH_DOWN_STARTS));
+
+    // The thruster sums both directions; run time is wrap-safe
+    counters.motion(OperationMotor::BOW, 1, 0xFFFFFF00UL);
+    counters.motion(OperationMotor::BOW, -1, 0x00000100UL);
+    counters.motion(OperationMotor::BOW, 0, 0x00000200UL);
+    TEST_ASSERT_EQUAL_UINT32(0x300, counters.get(OperationStat::BOW_MS));
+    TEST_ASSERT_EQUAL_UINT32(2, counters.get(OperationStat::BOW_STARTS));
+    TEST_ASSERT_EQUAL_UINT32(2250, counters.get(OperationStat::WINCH_UP_MS) +
+                                       counters.get(OperationStat::WINCH_DOWN_MS));
+
+    counters.addPulses(120);
+    counters.addPulses(-45);
+    counters.addPulses(0);
+    TEST_ASSERT_EQUAL_UINT32(120, counters.get(OperationStat::DEPLOYED_PULSES));
+    TEST_ASSERT_EQUAL_UINT32(45, counters.get(OperationStat::RETRIEVED_PULSES));
+}
+
+void test_operation_stats_record_rejects_damage(void) {
+    OperationCounters counters;
+    counters.add(OperationStat::ESTOP_REMOTE, 3);
+    counters.add(OperationStat::DEPLOYED_PULSES, 5000);
+
+    uint32_t values[OPERATION_STAT_COUNT];
+    counters.snapshot(values);
+    OperationStatsRecord record = makeOperationStatsRecord(values);
+    TEST_ASSERT_TRUE(isValidOperationStatsRecord(record));
+    TEST_ASSERT_EQUAL_UINT32(3, record.values[static_cast<size_t>(OperationStat::ESTOP_REMOTE)]);
+    TEST_ASSERT_EQUAL_UINT32(0, record.values[static_cast<size_t>(OperationStat::ESTOP_LOCAL)]);
+
+    OperationStatsRecord damaged = record;
+    damaged.values[static_cast<size_t>(OperationStat::DEPLOYED_PULSES)] ^= 1;
+    TEST_ASSERT_FALSE(isValidOperationStatsRecord(damaged));
+
+    OperationStatsRecord old_layout = record;
+    old_layout.version = OPERATION_STATS_VERSION + 1;
+    TEST_ASSERT_FALSE(isValidOperationStatsRecord(old_layout));
+
+    OperationStatsRecord blank = {};
+    TEST_ASSERT_FALSE(isValidOperationStatsRecord(blank));
+}
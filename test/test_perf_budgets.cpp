@@ -0,0 +1,207 @@
+// Performance regression gate
+// Simulator scenarios and dispatch micro-benchmarks checked against fixed budgets,
+// so `pio test -e native` fails before a slower or sloppier build reaches the boat
+
+#include <unity.h>
+#include <cstdlib>
+#include <new>
+#include "BenchHarness.h"
+#include "sim/WindlassSim.h"
+#include "services/ControlCommand.h"
+#include "services/SignalKCommandTable.h"
+#include "util/MpscQueue.h"
+#include "util/RemoteGestures.h"
+#include "util/RemoteTiming.h"
+
+// Counts every heap allocation of the test binary (operator new is replaceable program-wide)
+namespace {
+    size_t g_allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    g_allocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+    // ========== BUDGETS ==========
+    // Simulated budgets are exact (virtual clock). Wall-clock budgets hold
+    // about 50x the -O2 figures of env:native_bench (bench_output.txt): this
+    // env builds without optimisation and may run on a shared CI machine.
+    constexpr float OVERSHOOT_BUDGET_PULSES = 2.0f;      ///< Mean auto-mode overshoot at 0.5 m/s
+    constexpr uint32_t COMMAND_TO_RELAY_BUDGET_US = 5000;  ///< Submit -> relay edge (simulated)
+    constexpr uint32_t DOUBLE_PRESS_BUDGET_TICKS = 1;    ///< Stable second press -> emergency stop
+    constexpr double COMMAND_PATH_BUDGET_NS = 30000.0;   ///< 4 values dispatched, queued, drained, coalesced
+
+    /// Deterministic target sequence (LCG), as bench_windlass_sim
+    float nextTarget(uint32_t& seed) {
+        seed = seed * 1664525UL + 1013904223UL;
+        return 2.0f + static_cast<float>((seed >> 8) % 5800) / 100.0f;  // 2 .. 60 m
+    }
+
+    /// ControlTask::submit() without the wake: the queue the control side drains
+    MpscQueue<ControlCommand, 16> g_gate_queue;
+
+    template <ControlCommandType TYPE>
+    void gateSubmit(SignalKService& service, float value) {
+        (void)service;
+        g_gate_queue.push({TYPE, value, CommandSource::SIGNALK});
+    }
+
+    // Guards as SignalKService::COMMAND_TABLE, handlers submitting to the gate queue
+    const SKCommandEntry GATE_TABLE[] = {
+        {"navigation.anchor.manualControl", SKCommandValue::INT,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED,
+         gateSubmit<ControlCommandType::MANUAL_WINCH>, nullptr},
+        {"navigation.anchor.automaticModeCommand", SKCommandValue::FLOAT,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::NEEDS_AUTO_MODE,
+         gateSubmit<ControlCommandType::AUTO_MODE>, nullptr},
+        {"propulsion.bowThruster.command", SKCommandValue::INT,
+         SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED | SKCommandGuard::NEEDS_BOW,
+         gateSubmit<ControlCommandType::BOW_THRUSTER>, nullptr},
+    };
+    constexpr size_t GATE_MANUAL = 0;
+    constexpr size_t GATE_AUTO_MODE = 1;
+    constexpr size_t GATE_BOW = 2;
+
+    /**
+     * @brief Received values through the firmware dispatch, then the control-side drain
+     * Two winch commands, auto mode and thruster: one winch command is coalesced away
+     * @return Commands kept for execution, or 0 if a value was blocked
+     */
+    size_t commandRound() {
+        SignalKService& service = *reinterpret_cast<SignalKService*>(&g_gate_queue);  // Never dereferenced
+        const bool allowed = skDispatchCommand(GATE_TABLE, GATE_MANUAL, service, 1.0f, false, true) &&
+                             skDispatchCommand(GATE_TABLE, GATE_MANUAL, service, 0.0f, false, true) &&
+                             skDispatchCommand(GATE_TABLE, GATE_AUTO_MODE, service, 1.0f, false, true) &&
+                             skDispatchCommand(GATE_TABLE, GATE_BOW, service, -1.0f, false, true);
+        ControlCommand batch[16];
+        size_t count = 0;
+        while (count < 16 && g_gate_queue.pop(batch[count])) count++;
+        const size_t kept = coalesceCommands(batch, count);
+        return allowed ? kept : 0;
+    }
+}
+
+void test_perf_auto_mode_overshoot_within_budget(void) {
+    // 0.5 m/s both ways, coast learned from a few moves first
+    WindlassParams params;
+    params.up_speed = 0.5f;
+    params.down_speed = 0.5f;
+    WindlassSim sim(params);
+    uint32_t seed = 2024;
+    for (int i = 0; i < 10; i++) sim.runToTarget(nextTarget(seed));
+
+    SimStats stats;
+    for (int i = 0; i < 100; i++) {
+        stats.add(sim.runToTarget(nextTarget(seed)), 0.10f);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, stats.missed_stops);
+    TEST_ASSERT_LESS_THAN_FLOAT(OVERSHOOT_BUDGET_PULSES * params.pitch_m, stats.meanOvershoot());
+}
+
+void test_perf_command_to_relay_within_budget(void) {
+    // A command arriving anywhere within a control period reaches the relay
+    // before the next period (the control task is woken by submit())
+    WindlassSim sim;
+    sim.runToTarget(10.0f);  // Off the home switch, which blocks retrieving
+    uint32_t worst_us = 0;
+    for (uint32_t offset_ms = 0; offset_ms < WindlassSim::CONTROL_PERIOD_MS; offset_ms++) {
+        sim.runMs(offset_ms);
+        const int8_t direction = offset_ms % 2 ? 1 : -1;
+        TEST_ASSERT_TRUE(sim.submit({ControlCommandType::MANUAL_WINCH, static_cast<float>(direction),
+                                     CommandSource::SIGNALK}));
+        sim.runMs(COMMAND_TO_RELAY_BUDGET_US / 1000);
+        TEST_ASSERT_TRUE(sim.relays().driven() == (direction > 0 ? RelayOutput::A : RelayOutput::B));
+        uint32_t latency_us = sim.relays().lastEdgeUs() - sim.lastCommandUs();
+        if (latency_us > worst_us) worst_us = latency_us;
+
+        // Stops are never deferred
+        TEST_ASSERT_TRUE(sim.submit({ControlCommandType::MANUAL_WINCH, 0.0f, CommandSource::SIGNALK}));
+        sim.runMs(COMMAND_TO_RELAY_BUDGET_US / 1000);
+        TEST_ASSERT_TRUE(sim.relays().driven() == RelayOutput::OFF);
+        latency_us = sim.relays().lastEdgeUs() - sim.lastCommandUs();
+        if (latency_us > worst_us) worst_us = latency_us;
+
+        sim.runMs(1000);  // Past the minimum off time and the coast
+    }
+    TEST_ASSERT_LESS_THAN_UINT32(COMMAND_TO_RELAY_BUDGET_US, worst_us);
+}
+
+void test_perf_control_tick_allocation_free(void) {
+    WindlassSim sim;
+    sim.runToTarget(5.0f);  // Anything lazily allocated is allocated now
+
+    const size_t before = g_allocations;
+    sim.runToTarget(25.0f);
+    sim.submit({ControlCommandType::MANUAL_WINCH, 1.0f, CommandSource::SIGNALK});
+    sim.runMs(2000);
+    sim.submit({ControlCommandType::STOP_ALL, 0.0f, CommandSource::LOCAL});
+    sim.runToTarget(10.0f);
+    TEST_ASSERT_EQUAL_UINT32(3, commandRound());
+
+    TEST_ASSERT_EQUAL_UINT32(0, g_allocations - before);
+}
+
+void test_perf_remote_double_press_within_one_tick(void) {
+    constexpr unsigned long tick_ms = WindlassSim::CONTROL_PERIOD_MS;
+    // Polling mode (REMOTE_USE_INTERRUPTS=0): the pins are sampled once per tick
+    for (unsigned long phase_ms = 0; phase_ms < tick_ms; phase_ms++) {
+        RemoteGestures remote;
+        const unsigned long second_press_ms = 1300 + phase_ms;
+        unsigned long pressed_ms = 0;
+        unsigned long detected_ms = 0;
+        for (unsigned long now_ms = 0; now_ms < 3000 && !detected_ms; now_ms += tick_ms) {
+            const bool level = (now_ms >= 1000 + phase_ms && now_ms < 1100 + phase_ms) ||
+                               now_ms >= second_press_ms;
+            remote.onEdge(RemoteGestures::UP, level, now_ms);
+            if (remote.update(now_ms, false) == RemoteGesture::EMERGENCY_STOP) detected_ms = now_ms;
+            if ((remote.events(RemoteGestures::UP) & BUTTON_PRESS) && now_ms >= second_press_ms) {
+                pressed_ms = now_ms;
+            }
+        }
+        // The gesture latches in the tick the second press is debounced, which
+        // is at most sampling + debounce (rounded up to ticks) after the edge
+        TEST_ASSERT_TRUE(detected_ms > 0);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(DOUBLE_PRESS_BUDGET_TICKS * tick_ms,
+                                         static_cast<uint32_t>(detected_ms - pressed_ms));
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(RemoteTiming::DEBOUNCE_MS + 2 * tick_ms,
+                                         static_cast<uint32_t>(detected_ms - second_press_ms));
+    }
+
+    // Interrupt mode: edges carry their time and the task wakes at the debounce deadline
+    constexpr unsigned long debounce_ms = RemoteTiming::DEBOUNCE_MS;
+    constexpr unsigned long second_press_ms = 1307;
+    RemoteGestures remote;
+    remote.onEdge(RemoteGestures::UP, true, 1000);
+    remote.update(1000 + debounce_ms, false);
+    remote.onEdge(RemoteGestures::UP, false, 1100);
+    remote.update(1100 + debounce_ms, false);
+    remote.onEdge(RemoteGestures::UP, true, second_press_ms);
+    TEST_ASSERT_TRUE(remote.update(second_press_ms, false) == RemoteGesture::NONE);
+    const unsigned long deadline_ms = second_press_ms + remote.nextDeadline(second_press_ms);
+    TEST_ASSERT_TRUE(remote.update(deadline_ms, false) == RemoteGesture::EMERGENCY_STOP);
+    TEST_ASSERT_EQUAL_UINT32(second_press_ms + debounce_ms, deadline_ms);
+}
+
+void test_perf_dispatch_micro_benchmarks_within_budget(void) {
+    constexpr uint32_t iterations = 20000;
+    constexpr size_t kept_per_round = 3;
+    size_t rounds = 0;  // measure() adds warm-up rounds
+    size_t kept_total = 0;
+    const double path_ns = bench::measure(iterations, [&](uint32_t i) {
+        (void)i;
+        kept_total += commandRound();
+        rounds++;
+    });
+    TEST_ASSERT_EQUAL_UINT32(0, g_gate_queue.dropped());
+    TEST_ASSERT_EQUAL_UINT32(rounds * kept_per_round, kept_total);
+    TEST_ASSERT_TRUE(path_ns < COMMAND_PATH_BUDGET_NS);
+}
@@ -0,0 +1,95 @@
+// Unit tests for the StateManager pulse accumulator
+// Tests ISR-side accumulation, main-loop drain snapshots and epoch resets
+
+#include <unity.h>
+#include <Arduino.h>
+#include "services/StateManager.h"
+
+void test_pulse_accumulator_drain_applies_pending(void) {
+    StateManager state;
+
+    for (int i = 0; i < 7; i++) {
+        state.incrementPulse();
+    }
+    state.decrementPulse();
+
+    // Nothing visible until the main loop drains
+    TEST_ASSERT_EQUAL_INT32(0, state.getPulseCount());
+
+    PulseSnapshot snapshot = state.drainPulses(1234);
+    TEST_ASSERT_EQUAL_INT32(6, snapshot.count);
+    TEST_ASSERT_EQUAL_INT32(6, snapshot.delta);
+    TEST_ASSERT_EQUAL_INT32(1234, snapshot.timestamp_ms);
+    TEST_ASSERT_EQUAL_INT32(6, state.getPulseCount());
+
+    // Second drain with nothing pending reports zero delta
+    snapshot = state.drainPulses(1334);
+    TEST_ASSERT_EQUAL_INT32(6, snapshot.count);
+    TEST_ASSERT_EQUAL_INT32(0, snapshot.delta);
+}
+
+void test_pulse_accumulator_clamps_at_zero(void) {
+    StateManager state;
+
+    state.addPulses(3);
+    state.drainPulses(0);
+    state.addPulses(-10);
+
+    PulseSnapshot snapshot = state.drainPulses(100);
+    TEST_ASSERT_EQUAL_INT32(0, snapshot.count);
+    TEST_ASSERT_EQUAL_INT32(-3, snapshot.delta);
+}
+
+void test_pulse_accumulator_reset_is_epoch_bump(void) {
+    StateManager state;
+
+    state.addPulses(50);
+    state.drainPulses(0);
+    uint32_t epoch_before = state.getPulseSnapshot().epoch;
+
+    // Pulses pending at the time of the reset belong to the old epoch
+    state.addPulses(5);
+    state.requestPulseReset();
+
+    PulseSnapshot snapshot = state.drainPulses(100);
+    TEST_ASSERT_EQUAL_INT32(0, snapshot.count);
+    TEST_ASSERT_EQUAL_INT32(0, snapshot.delta);  // A reset is not chain movement
+    TEST_ASSERT_TRUE(snapshot.epoch != epoch_before);
+
+    // Counting continues normally in the new epoch
+    state.incrementPulse();
+    snapshot = state.drainPulses(200);
+    TEST_ASSERT_EQUAL_INT32(1, snapshot.count);
+}
+
+void test_pulse_edge_buffer_fifo_and_overflow(void) {
+    StateManager state;
+    PulseEdge edge;
+
+    TEST_ASSERT_FALSE(state.popPulseEdge(edge));
+
+    // Fill beyond capacity: extra edges are dropped and counted
+    for (uint32_t i = 0; i < 70; i++) {
+        state.pushPulseEdge({i * 1000, 1});
+    }
+    TEST_ASSERT_EQUAL_INT(6, state.getDroppedPulseEdges());
+
+    TEST_ASSERT_TRUE(state.popPulseEdge(edge));
+    TEST_ASSERT_EQUAL_INT(0, edge.timestamp_us);
+    TEST_ASSERT_TRUE(state.popPulseEdge(edge));
+    TEST_ASSERT_EQUAL_INT(1000, edge.timestamp_us);
+}
+
+void test_home_edge_event_is_consumed_once(void) {
+    StateManager state;
+    uint32_t cycles = 0;
+
+    TEST_ASSERT_FALSE(state.takeHomeEdge(cycles));
+
+    // Two edges before the main loop runs: the latest timestamp wins
+    state.postHomeEdge(1000);
+    state.postHomeEdge(2000);
+    TEST_ASSERT_TRUE(state.takeHomeEdge(cycles));
+    TEST_ASSERT_EQUAL_UINT32(2000, cycles);
+    TEST_ASSERT_FALSE(state.takeHomeEdge(cycles));
+}
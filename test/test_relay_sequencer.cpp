@@ -0,0 +1,71 @@
+// Unit tests for RelaySequencer
+// Tests reversal dead time, minimum on/off times and the thermal duty budget
+
+#include <unity.h>
+#include "util/RelaySequencer.h"
+
+void test_relay_sequencer_reversal_waits_for_dead_time(void) {
+    RelayTiming timing;
+    timing.dead_time_ms = 250;
+    timing.min_on_ms = 200;
+    RelaySequencer relays(timing);
+
+    TEST_ASSERT_TRUE(relays.request(RelayOutput::A, 1000) == RelayOutput::A);
+
+    // Reversal 50 ms after the start: A is held for min_on, then opened
+    TEST_ASSERT_TRUE(relays.request(RelayOutput::B, 1050) == RelayOutput::A);
+    TEST_ASSERT_EQUAL_UINT32(150, relays.nextEventMs(1050));
+    TEST_ASSERT_TRUE(relays.update(1200) == RelayOutput::OFF);
+
+    // B only closes dead_time after A opened
+    TEST_ASSERT_EQUAL_UINT32(250, relays.nextEventMs(1200));
+    TEST_ASSERT_TRUE(relays.update(1449) == RelayOutput::OFF);
+    TEST_ASSERT_TRUE(relays.update(1450) == RelayOutput::B);
+    TEST_ASSERT_EQUAL_UINT32(RelaySequencer::NO_EVENT, relays.nextEventMs(1450));
+}
+
+void test_relay_sequencer_stop_is_immediate_and_min_off_applies(void) {
+    RelayTiming timing;
+    timing.dead_time_ms = 250;
+    timing.min_on_ms = 200;
+    timing.min_off_ms = 100;
+    RelaySequencer relays(timing);
+
+    TEST_ASSERT_TRUE(relays.request(RelayOutput::A, 1000) == RelayOutput::A);
+    // Stop just after the start is not delayed by min_on
+    TEST_ASSERT_TRUE(relays.request(RelayOutput::OFF, 1010) == RelayOutput::OFF);
+
+    // Same direction again waits min_off only, not the dead time
+    TEST_ASSERT_TRUE(relays.request(RelayOutput::A, 1050) == RelayOutput::OFF);
+    TEST_ASSERT_TRUE(relays.requested() == RelayOutput::A);
+    TEST_ASSERT_TRUE(relays.update(1110) == RelayOutput::A);
+
+    // A stop cancels a pending start
+    relays.request(RelayOutput::OFF, 1500);
+    relays.request(RelayOutput::B, 1510);
+    TEST_ASSERT_TRUE(relays.request(RelayOutput::OFF, 1520) == RelayOutput::OFF);
+    TEST_ASSERT_TRUE(relays.update(2000) == RelayOutput::OFF);
+}
+
+void test_relay_sequencer_thermal_trip_and_recovery(void) {
+    RelayTiming timing;
+    timing.duty_window_ms = 3600000;
+    timing.duty_budget_ms = 180000;  // 3 minutes per hour
+    RelaySequencer relays(timing);
+
+    TEST_ASSERT_TRUE(relays.request(RelayOutput::A, 0) == RelayOutput::A);
+    // Bucket fills at 1 - 180/3600 = 0.95 ms per ms: trips after ~189.5 s
+    uint32_t trip_in = relays.nextEventMs(0);
+    TEST_ASSERT_UINT32_WITHIN(10, 189474, trip_in);
+    TEST_ASSERT_TRUE(relays.update(100000) == RelayOutput::A);
+    TEST_ASSERT_TRUE(relays.update(trip_in) == RelayOutput::OFF);
+    TEST_ASSERT_TRUE(relays.isThermalLockout());
+    TEST_ASSERT_TRUE(relays.requested() == RelayOutput::OFF);
+    TEST_ASSERT_EQUAL_UINT32(1, relays.getThermalTrips());
+
+    // Starts are refused until half the budget has drained (90 s at 0.05 ms/ms = 1800 s)
+    TEST_ASSERT_TRUE(relays.request(RelayOutput::B, trip_in + 1000000) == RelayOutput::OFF);
+    TEST_ASSERT_TRUE(relays.isThermalLockout());
+    TEST_ASSERT_TRUE(relays.request(RelayOutput::B, trip_in + 1810000) == RelayOutput::B);
+    TEST_ASSERT_FALSE(relays.isThermalLockout());
+}
@@ -0,0 +1,60 @@
+// Unit tests for RemoteGestures
+// Tests the any-button double press and long press and their emergency stop gating
+
+#include <unity.h>
+#include "util/RemoteGestures.h"
+
+namespace {
+    constexpr unsigned long DEBOUNCE_MS = RemoteTiming::DEBOUNCE_MS;
+
+    /// Press button at t_ms and debounce it; @return gesture of the debounced press
+    RemoteGesture press(RemoteGestures& remote, uint8_t button, unsigned long t_ms, bool stopped) {
+        remote.onEdge(button, true, t_ms);
+        return remote.update(t_ms + DEBOUNCE_MS, stopped);
+    }
+
+    void release(RemoteGestures& remote, uint8_t button, unsigned long t_ms, bool stopped) {
+        remote.onEdge(button, false, t_ms);
+        remote.update(t_ms + DEBOUNCE_MS, stopped);
+    }
+}
+
+void test_remote_gestures_double_press_of_any_buttons(void) {
+    RemoteGestures remote;
+    TEST_ASSERT_TRUE(press(remote, RemoteGestures::UP, 1000, false) == RemoteGesture::NONE);
+    TEST_ASSERT_TRUE(remote.isPressed(RemoteGestures::UP));
+    TEST_ASSERT_TRUE(remote.events(RemoteGestures::UP) & BUTTON_PRESS);
+    release(remote, RemoteGestures::UP, 1100, false);
+
+    // Second press on another input: the combined channel sees the double press
+    TEST_ASSERT_TRUE(press(remote, RemoteGestures::FUNC4, 1300, false) == RemoteGesture::EMERGENCY_STOP);
+    release(remote, RemoteGestures::FUNC4, 1400, true);
+
+    // Already stopped: a double press changes nothing
+    press(remote, RemoteGestures::DOWN, 3000, true);
+    release(remote, RemoteGestures::DOWN, 3100, true);
+    TEST_ASSERT_TRUE(press(remote, RemoteGestures::DOWN, 3300, true) == RemoteGesture::NONE);
+
+    // Bounce shorter than the debounce window never reaches the combined channel
+    remote.onEdge(RemoteGestures::FUNC3, true, 3310);
+    remote.onEdge(RemoteGestures::FUNC3, false, 3315);
+    TEST_ASSERT_TRUE(remote.update(3400, false) == RemoteGesture::NONE);
+    TEST_ASSERT_FALSE(remote.isPressed(RemoteGestures::FUNC3));
+}
+
+void test_remote_gestures_long_press_clears_only_when_stopped(void) {
+    RemoteGestures remote;
+    const unsigned long long_ms = RemoteTiming::LONG_PRESS_MS;
+
+    // Not stopped: a long press is just a held button
+    press(remote, RemoteGestures::UP, 1000, false);
+    TEST_ASSERT_TRUE(remote.update(1000 + DEBOUNCE_MS + long_ms, false) == RemoteGesture::NONE);
+    release(remote, RemoteGestures::UP, 4000, false);
+
+    // Stopped: the long press clears, once per press
+    press(remote, RemoteGestures::DOWN, 6000, true);
+    const unsigned long hold_from_ms = 6000 + DEBOUNCE_MS;
+    TEST_ASSERT_TRUE(remote.update(hold_from_ms + long_ms - 1, true) == RemoteGesture::NONE);
+    TEST_ASSERT_TRUE(remote.update(hold_from_ms + long_ms, true) == RemoteGesture::CLEAR_EMERGENCY_STOP);
+    TEST_ASSERT_TRUE(remote.update(hold_from_ms + 2 * long_ms, true) == RemoteGesture::NONE);
+}
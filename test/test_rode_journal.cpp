@@ -0,0 +1,68 @@
+// Unit tests for RodeJournal
+// Tests newest-record selection across the slot ring and corruption handling
+
+#include <unity.h>
+#include "services/RodeJournal.h"
+
+namespace {
+    class MemoryRodeStore : public IRodeStore {
+    public:
+        bool readSlot(size_t slot, RodeRecord& record) override {
+            if (!written[slot]) return false;
+            record = slots[slot];
+            return true;
+        }
+        bool writeSlot(size_t slot, const RodeRecord& record) override {
+            slots[slot] = record;
+            written[slot] = true;
+            writes++;
+            return true;
+        }
+
+        RodeRecord slots[RodeJournal::SLOTS] = {};
+        bool written[RodeJournal::SLOTS] = {};
+        int writes = 0;
+    };
+}
+
+void test_rode_journal_restores_newest_record_across_wrap(void) {
+    MemoryRodeStore store;
+    int32_t count = -1;
+
+    RodeJournal empty(store);
+    TEST_ASSERT_FALSE(empty.restore(count));
+
+    // More appends than slots: the ring wraps, the newest value wins
+    RodeJournal journal(store);
+    for (int32_t i = 1; i <= 11; i++) {
+        TEST_ASSERT_TRUE(journal.append(i * 100));
+    }
+    // Repeating the last value does not write (no wear while lying at anchor)
+    TEST_ASSERT_FALSE(journal.append(1100));
+    TEST_ASSERT_EQUAL(11, store.writes);
+
+    RodeJournal after_reboot(store);
+    TEST_ASSERT_TRUE(after_reboot.restore(count));
+    TEST_ASSERT_EQUAL_INT32(1100, count);
+
+    // The sequence continues after restore
+    TEST_ASSERT_TRUE(after_reboot.append(1200));
+    RodeJournal second_reboot(store);
+    TEST_ASSERT_TRUE(second_reboot.restore(count));
+    TEST_ASSERT_EQUAL_INT32(1200, count);
+}
+
+void test_rode_journal_skips_corrupt_record(void) {
+    MemoryRodeStore store;
+    RodeJournal journal(store);
+    journal.append(400);
+    journal.append(500);
+
+    // Torn write of the newest record (slot of sequence 2): CRC no longer matches
+    store.slots[2 % RodeJournal::SLOTS].pulse_count = 9999;
+
+    int32_t count = 0;
+    RodeJournal after_reboot(store);
+    TEST_ASSERT_TRUE(after_reboot.restore(count));
+    TEST_ASSERT_EQUAL_INT32(400, count);
+}
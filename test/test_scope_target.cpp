@@ -0,0 +1,51 @@
+// Unit tests for ScopeTarget
+// Tests the scope target, depth spike rejection and the target deadband
+
+#include <unity.h>
+#include "util/ScopeTarget.h"
+
+void test_scope_target_from_ratio_depth_and_freeboard(void) {
+    ScopeTarget scope;
+    TEST_ASSERT_FALSE(scope.isActive());
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, scope.getTarget());
+
+    // No depth yet: armed but no target
+    scope.setScope(5.0f, 1.0f);
+    TEST_ASSERT_TRUE(scope.isActive());
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, scope.getTarget());
+
+    // No bottom lock readings are ignored; the first real one seeds the filter
+    scope.addDepth(0.0f, 1000);
+    TEST_ASSERT_FALSE(scope.hasDepth());
+    scope.addDepth(7.0f, 2000);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f, scope.getTarget());  // 5 x (7 + 1)
+
+    // Ratio 0 turns scope mode off
+    scope.setScope(0.0f, 1.0f);
+    TEST_ASSERT_FALSE(scope.isActive());
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, scope.getTarget());
+}
+
+void test_scope_target_filters_spikes_and_holds_within_deadband(void) {
+    ScopeTarget scope;
+    scope.setScope(5.0f, 1.0f);
+    scope.addDepth(7.0f, 0);
+    float target = scope.getTarget();
+
+    // A 50 m spike (no bottom lock) pulls the depth by a fraction of MAX_STEP_M
+    scope.addDepth(50.0f, 1000);
+    TEST_ASSERT_TRUE(scope.getDepth() < 7.0f + ScopeTarget::MAX_STEP_M);
+
+    // Noise of +-0.1 m around 7 m: the target does not move
+    scope.addDepth(7.0f, 30000);
+    for (unsigned long t = 31000; t < 60000; t += 1000) {
+        scope.addDepth((t / 1000) % 2 ? 7.1f : 6.9f, t);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(target, scope.getTarget());
+
+    // The water really deepens to 9 m: the target follows to 5 x (9 + 1)
+    for (unsigned long t = 60000; t < 180000; t += 1000) {
+        scope.addDepth(9.0f, t);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(ScopeTarget::TARGET_DEADBAND_M, 50.0f, scope.getTarget());
+}
@@ -0,0 +1,51 @@
+// Unit tests for Seqlock
+// Tests publish/read round trip and StateManager snapshot handoff
+
+#include <unity.h>
+#include "util/Seqlock.h"
+#include "services/StateManager.h"
+
+void test_seqlock_round_trip_keeps_all_fields(void) {
+    Seqlock<StateSnapshot> lock;
+
+    // Default value is readable before the first publish
+    StateSnapshot initial = lock.read();
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, initial.auto_mode_target);
+
+    StateSnapshot snapshot;
+    snapshot.sequence = 7;
+    snapshot.pulse_count = -1234;
+    snapshot.rode_length = 12.34f;
+    snapshot.winch_direction = -1;
+    snapshot.emergency_stop_active = true;
+    lock.write(snapshot);
+
+    StateSnapshot copy;
+    TEST_ASSERT_TRUE(lock.tryRead(copy));
+    TEST_ASSERT_EQUAL_UINT32(7, copy.sequence);
+    TEST_ASSERT_EQUAL_INT32(-1234, copy.pulse_count);
+    TEST_ASSERT_EQUAL_FLOAT(12.34f, copy.rode_length);
+    TEST_ASSERT_EQUAL_INT(-1, copy.winch_direction);
+    TEST_ASSERT_TRUE(copy.emergency_stop_active);
+}
+
+void test_state_manager_publishes_snapshot_as_one_unit(void) {
+    StateManager state;
+    StateSnapshot snapshot;
+    snapshot.sequence = 1;
+    snapshot.rode_length = 5.0f;
+    snapshot.auto_mode_enabled = true;
+    snapshot.auto_mode_target = 0.0f;
+    state.publishSnapshot(snapshot);
+
+    snapshot.sequence = 2;
+    snapshot.rode_length = 4.5f;
+    snapshot.auto_mode_enabled = false;
+    state.publishSnapshot(snapshot);
+
+    StateSnapshot copy = state.readSnapshot();
+    TEST_ASSERT_EQUAL_UINT32(2, copy.sequence);
+    TEST_ASSERT_EQUAL_FLOAT(4.5f, copy.rode_length);
+    TEST_ASSERT_FALSE(copy.auto_mode_enabled);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, copy.auto_mode_target);
+}
@@ -0,0 +1,43 @@
+// Unit tests for SettleDetector
+// Tests the journal trigger after coast pulses and for chain moved with the winch off
+
+#include <unity.h>
+#include "util/SettleDetector.h"
+
+void test_settle_detector_waits_for_coast_pulses(void) {
+    SettleDetector settle(1000);
+    TEST_ASSERT_FALSE(settle.update(100, true, 0));
+    TEST_ASSERT_FALSE(settle.update(400, true, 5000));
+
+    // Winch stops at 400 pulses; the chain coasts on for another 12
+    TEST_ASSERT_FALSE(settle.update(400, false, 5100));
+    TEST_ASSERT_FALSE(settle.update(405, false, 5200));
+    TEST_ASSERT_FALSE(settle.update(412, false, 5400));
+    TEST_ASSERT_FALSE(settle.update(412, false, 6399));
+    TEST_ASSERT_TRUE(settle.update(412, false, 6400));
+
+    // Reported once while the chain lies still
+    TEST_ASSERT_FALSE(settle.update(412, false, 7400));
+    TEST_ASSERT_FALSE(settle.update(412, false, 100000));
+}
+
+void test_settle_detector_reports_chain_moved_with_winch_off(void) {
+    SettleDetector settle(1000);
+    settle.update(200, false, 0);
+    TEST_ASSERT_TRUE(settle.update(200, false, 1000));
+
+    // Chain paid out under load: no winch run, still journaled once settled
+    TEST_ASSERT_FALSE(settle.update(230, false, 2000));
+    TEST_ASSERT_FALSE(settle.update(260, false, 2500));
+    TEST_ASSERT_TRUE(settle.update(260, false, 3500));
+
+    // Back to a reported value elsewhere (reset) is not repeated, a new one is
+    settle.markReported(0);
+    TEST_ASSERT_FALSE(settle.update(0, false, 4000));
+    TEST_ASSERT_FALSE(settle.update(0, false, 6000));
+
+    // Across the 32-bit millis() wrap
+    SettleDetector wrapping(1000);
+    wrapping.update(50, false, 0xFFFFFF00UL);
+    TEST_ASSERT_TRUE(wrapping.update(50, false, 0x000002E8UL));
+}
@@ -0,0 +1,26 @@
+// Unit tests for the SignalK command table guards
+// Tests the centrally evaluated emergency stop, connection and trigger flags
+
+#include <unity.h>
+#include "services/SignalKCommandTable.h"
+
+void test_signalk_command_guards_block_motion_commands(void) {
+    const uint8_t motion = SKCommandGuard::NO_EMERGENCY_STOP | SKCommandGuard::CONNECTED;
+
+    TEST_ASSERT_TRUE(skCommandAllowed(motion, 1.0f, false, true));
+    TEST_ASSERT_FALSE(skCommandAllowed(motion, 1.0f, true, true));    // Emergency stop latched
+    TEST_ASSERT_FALSE(skCommandAllowed(motion, 1.0f, false, false));  // Connection not stable
+
+    // Self-clearing triggers only act on true
+    const uint8_t trigger = motion | SKCommandGuard::TRIGGER;
+    TEST_ASSERT_TRUE(skCommandAllowed(trigger, 1.0f, false, true));
+    TEST_ASSERT_FALSE(skCommandAllowed(trigger, 0.0f, false, true));
+}
+
+void test_signalk_emergency_stop_can_be_cleared_before_connection_is_stable(void) {
+    const uint8_t estop = SKCommandGuard::CONNECTED_OR_ESTOP;
+
+    TEST_ASSERT_FALSE(skCommandAllowed(estop, 1.0f, false, false));  // Startup: ignore
+    TEST_ASSERT_TRUE(skCommandAllowed(estop, 0.0f, true, false));    // Latched: may clear
+    TEST_ASSERT_TRUE(skCommandAllowed(estop, 1.0f, false, true));
+}
@@ -0,0 +1,35 @@
+// Unit tests for StaticArena
+// Tests placement in the arena, alignment and heap fallback when full
+
+#define APP_USE_STATIC_ARENA 1
+#include <unity.h>
+#include <cstdint>
+#include "util/StaticArena.h"
+
+namespace {
+    struct ArenaProbe {
+        ArenaProbe(int a, float b) : a(a), b(b) {}
+        int a;
+        float b;
+    };
+}
+
+void test_static_arena_places_aligned_objects_and_falls_back(void) {
+    StaticArena<arenaBytes<ArenaProbe>(2)> arena;
+    uint32_t overflows_before = ArenaStats::overflows;
+
+    ArenaProbe* first = arena.create<ArenaProbe>(1, 2.5f);
+    ArenaProbe* second = arena.create<ArenaProbe>(2, 3.5f);
+    TEST_ASSERT_EQUAL(1, first->a);
+    TEST_ASSERT_EQUAL_FLOAT(3.5f, second->b);
+    TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(first) % alignof(ArenaProbe));
+    TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(second) % alignof(ArenaProbe));
+    TEST_ASSERT_TRUE(arena.used() <= arena.capacity());
+    TEST_ASSERT_EQUAL_UINT32(overflows_before, ArenaStats::overflows);
+
+    // The compile-time size covers exactly what was counted: more goes to the heap
+    ArenaProbe* third = arena.create<ArenaProbe>(3, 4.5f);
+    TEST_ASSERT_EQUAL(3, third->a);
+    TEST_ASSERT_EQUAL_UINT32(overflows_before + 1, ArenaStats::overflows);
+    delete third;
+}
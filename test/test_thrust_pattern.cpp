@@ -0,0 +1,66 @@
+// Unit tests for ThrustPattern
+// Tests the pulse quantisation, the edge timing and when a new setpoint applies
+
+#include <unity.h>
+#include "util/ThrustPattern.h"
+
+void test_thrust_pattern_quantises_pulses(void) {
+    ThrustPattern pattern(ThrustPatternTiming{2000, 250, 300});
+
+    // 5 % = 100 ms: below half of the minimum pulse, off
+    pattern.set(0.05f, 0);
+    TEST_ASSERT_EQUAL_INT(0, pattern.direction());
+    TEST_ASSERT_EQUAL_INT(0, pattern.output(0));
+    TEST_ASSERT_EQUAL_UINT32(ThrustPattern::NO_EDGE, pattern.nextEdgeMs(0));
+
+    // 10 % = 200 ms: raised to the minimum pulse
+    pattern.set(-0.1f, 0);
+    TEST_ASSERT_EQUAL_INT(-1, pattern.direction());
+    TEST_ASSERT_EQUAL_UINT32(250, pattern.onMs());
+
+    // 90 % leaves a 200 ms gap, shorter than the minimum off: continuous
+    pattern.set(0.9f, 0);
+    TEST_ASSERT_EQUAL_UINT32(2000, pattern.onMs());
+    TEST_ASSERT_EQUAL_INT(1, pattern.output(1999));
+    TEST_ASSERT_EQUAL_UINT32(ThrustPattern::NO_EDGE, pattern.nextEdgeMs(1999));
+
+    // Out of range is clamped
+    pattern.set(-3.0f, 0);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, pattern.setpoint());
+    TEST_ASSERT_EQUAL_UINT32(2000, pattern.onMs());
+}
+
+void test_thrust_pattern_edges_and_setpoint_changes(void) {
+    ThrustPattern pattern(ThrustPatternTiming{2000, 250, 300});
+
+    // 40 %: 800 ms on, 1200 ms off, from the start of the command
+    pattern.set(0.4f, 1000);
+    TEST_ASSERT_EQUAL_INT(1, pattern.output(1000));
+    TEST_ASSERT_EQUAL_UINT32(800, pattern.nextEdgeMs(1000));
+    TEST_ASSERT_EQUAL_INT(1, pattern.output(1799));
+    TEST_ASSERT_EQUAL_INT(0, pattern.output(1800));
+    TEST_ASSERT_EQUAL_UINT32(1200, pattern.nextEdgeMs(1800));
+    TEST_ASSERT_EQUAL_INT(1, pattern.output(3000));
+
+    // A new magnitude waits for the next period: the running pulse is not cut
+    pattern.set(0.2f, 3100);
+    TEST_ASSERT_EQUAL_INT(1, pattern.output(3500));
+    TEST_ASSERT_EQUAL_INT(0, pattern.output(3800));
+    TEST_ASSERT_EQUAL_INT(1, pattern.output(5000));
+    TEST_ASSERT_EQUAL_INT(0, pattern.output(5400));
+
+    // A reversal applies at once and starts a new period
+    pattern.set(-0.5f, 5500);
+    TEST_ASSERT_EQUAL_INT(-1, pattern.output(5500));
+    TEST_ASSERT_EQUAL_UINT32(1000, pattern.nextEdgeMs(5500));
+
+    // So does a stop
+    pattern.set(0.0f, 5600);
+    TEST_ASSERT_EQUAL_INT(0, pattern.output(5600));
+    TEST_ASSERT_EQUAL_UINT32(ThrustPattern::NO_EDGE, pattern.nextEdgeMs(5600));
+
+    // Across the 32-bit millis() wrap
+    pattern.set(0.5f, 0xFFFFFF00UL);
+    TEST_ASSERT_EQUAL_INT(1, pattern.output(0x00000100UL));
+    TEST_ASSERT_EQUAL_INT(0, pattern.output(0x00000400UL));
+}
@@ -0,0 +1,59 @@
+// Unit tests for TraceBuffer and the trace frame layout
+// Tests drop-on-full ordering and the little-endian wire format read by tools/trace_decode.py
+
+#include <unity.h>
+#include <string.h>
+#include "util/TraceBuffer.h"
+
+void test_trace_buffer_keeps_order_and_drops_when_full(void) {
+    TraceBuffer<4> buffer;
+    TraceRecord record;
+    TraceRecord out[8];
+
+    for (uint32_t i = 0; i < 6; i++) {
+        record.timestamp_us = 1000 + i;
+        TEST_ASSERT_EQUAL(i < 4, buffer.record(record));
+    }
+    // Unlike EventLog the oldest records are kept: a replay needs them in order
+    TEST_ASSERT_EQUAL_UINT32(4, buffer.size());
+    TEST_ASSERT_EQUAL_UINT32(2, buffer.dropped());
+
+    TEST_ASSERT_EQUAL_UINT32(3, buffer.pop(out, 3));
+    TEST_ASSERT_EQUAL_UINT32(1000, out[0].timestamp_us);
+    TEST_ASSERT_EQUAL_UINT32(1002, out[2].timestamp_us);
+
+    // Space again after the pop
+    record.timestamp_us = 2000;
+    TEST_ASSERT_TRUE(buffer.record(record));
+    TEST_ASSERT_EQUAL_UINT32(2, buffer.pop(out, 8));
+    TEST_ASSERT_EQUAL_UINT32(1003, out[0].timestamp_us);
+    TEST_ASSERT_EQUAL_UINT32(2000, out[1].timestamp_us);
+    TEST_ASSERT_EQUAL_UINT32(0, buffer.pop(out, 8));
+
+    buffer.record(record);
+    buffer.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, buffer.size());
+    TEST_ASSERT_EQUAL_UINT32(0, buffer.dropped());  // New capture, new count
+}
+
+void test_trace_frame_layout_is_little_endian(void) {
+    TraceRecord records[2];
+    records[0].timestamp_us = 0x01020304;
+    records[0].event = static_cast<uint8_t>(TraceEvent::RELAY);
+    records[0].tag = 27;
+    records[0].arg = 0xFFFF;  // RelayOutput -1
+    records[0].a = 14;
+    records[0].b = 0xA1B2C3D4;
+    records[1].event = static_cast<uint8_t>(TraceEvent::PULSE);
+
+    uint8_t frame[traceFrameSize(2)];
+    TEST_ASSERT_EQUAL_UINT32(12 + 2 * 16, encodeTraceFrame(7, 0x100, records, 2, frame));
+
+    const uint8_t header[] = {0x42, 0x54, TRACE_FRAME_VERSION, 2, 7, 0, 0, 0, 0x00, 0x01, 0, 0};
+    TEST_ASSERT_EQUAL_MEMORY(header, frame, sizeof(header));
+
+    const uint8_t first[] = {0x04, 0x03, 0x02, 0x01, 3, 27, 0xFF, 0xFF,
+                             14, 0, 0, 0, 0xD4, 0xC3, 0xB2, 0xA1};
+    TEST_ASSERT_EQUAL_MEMORY(first, frame + TRACE_FRAME_HEADER_SIZE, sizeof(first));
+    TEST_ASSERT_EQUAL_UINT8(2, frame[TRACE_FRAME_HEADER_SIZE + TRACE_RECORD_SIZE + 4]);
+}
@@ -0,0 +1,61 @@
+// Unit tests for WakeEdgeRecovery
+// Tests the pulse edge lost while PCNT slept and the idle exit on a pulse wake
+
+#include <unity.h>
+#include "util/IdleTracker.h"
+#include "util/WakeEdgeRecovery.h"
+
+void test_wake_edge_recovery_restores_edge_lost_in_sleep(void) {
+    WakeEdgeRecovery recovery;
+    recovery.arm(100);
+    TEST_ASSERT_EQUAL_INT(0, recovery.take(100));
+
+    // Rising edge woke the CPU, the hardware count did not move: add it back once
+    recovery.wake(1);
+    TEST_ASSERT_EQUAL_INT(1, recovery.take(100));
+    TEST_ASSERT_EQUAL_INT(0, recovery.take(100));
+
+    // Chain in: signed by the direction level
+    recovery.arm(100);
+    recovery.wake(-1);
+    TEST_ASSERT_EQUAL_INT(-1, recovery.take(100));
+}
+
+void test_wake_edge_recovery_skips_edge_counted_awake(void) {
+    WakeEdgeRecovery recovery;
+    recovery.arm(100);
+
+    // CPU was awake: PCNT counted the edge itself
+    recovery.wake(1);
+    TEST_ASSERT_EQUAL_INT(0, recovery.take(101));
+    TEST_ASSERT_EQUAL_INT(0, recovery.take(101));
+}
+
+void test_wake_edge_recovery_creeping_chain_while_idle(void) {
+    // Chain creeps one pulse every 5 s at anchor; PCNT never counts in sleep
+    constexpr uint32_t ENTRY_MS = 3000;
+    IdleTracker tracker(ENTRY_MS);
+    WakeEdgeRecovery recovery;
+    const long hardware_total = 0;
+    long count = 0;
+
+    uint32_t now_ms = 0;
+    tracker.update(false, now_ms);
+    now_ms += ENTRY_MS;
+    TEST_ASSERT_TRUE(tracker.update(false, now_ms) == IdleTracker::Transition::ENTER_IDLE);
+
+    for (int pulse = 0; pulse < 20; pulse++) {
+        recovery.arm(hardware_total);
+        now_ms += 5000;
+        recovery.wake(1);
+
+        // The wake is activity: idle ends and the lost edge is counted
+        TEST_ASSERT_TRUE(tracker.update(true, now_ms) == IdleTracker::Transition::EXIT_IDLE);
+        count += recovery.take(hardware_total);
+
+        // Awake until the count has been quiet for the entry delay
+        TEST_ASSERT_TRUE(tracker.update(false, now_ms + ENTRY_MS - 1) == IdleTracker::Transition::NONE);
+        TEST_ASSERT_TRUE(tracker.update(false, now_ms + ENTRY_MS) == IdleTracker::Transition::ENTER_IDLE);
+    }
+    TEST_ASSERT_EQUAL_INT(20, count);
+}
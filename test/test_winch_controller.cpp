@@ -0,0 +1,74 @@
+// Unit tests for BasicWinchController and BasicHomeSensor
+// Tests the controllers instantiated on concrete, non-virtual drivers (static dispatch)
+// and the selected hardware profile
+
+#include <unity.h>
+#include "pin_config.h"
+#include "winch_controller.h"
+#include "home_sensor.h"
+
+namespace {
+// Plain driver types: no IMotor / ISensor base, like the final ESP32 drivers
+struct RecordingMotor {
+    int direction = 0;
+    int writes = 0;
+    void moveUp() { direction = 1; writes++; }
+    void moveDown() { direction = -1; writes++; }
+    void stop() { direction = 0; writes++; }
+    bool isActive() const { return direction != 0; }
+    bool isMovingUp() const { return direction > 0; }
+    bool isMovingDown() const { return direction < 0; }
+};
+
+struct LevelSensor {
+    bool active = false;
+    bool was_active = false;
+    bool isActive() const { return active; }
+    bool justActivated() { bool edge = active && !was_active; was_active = active; return edge; }
+    bool justDeactivated() { bool edge = !active && was_active; was_active = active; return edge; }
+};
+}  // namespace
+
+void test_winch_controller_static_dispatch_blocks_up_at_home(void) {
+    RecordingMotor motor;
+    LevelSensor sensor;
+    BasicWinchController<RecordingMotor, LevelSensor> winch(motor, sensor);
+    BasicHomeSensor<LevelSensor> home(sensor);
+
+    winch.moveUp();
+    TEST_ASSERT_TRUE(winch.isMovingUp());
+
+    sensor.active = true;
+    TEST_ASSERT_TRUE(home.isHome());
+    TEST_ASSERT_TRUE(home.justArrived());
+    winch.moveUp();  // Blocked at home: stopped instead
+    TEST_ASSERT_FALSE(winch.isActive());
+    TEST_ASSERT_EQUAL(2, motor.writes);
+
+    winch.moveDown();  // Deploying away from home is allowed
+    TEST_ASSERT_TRUE(winch.isMovingDown());
+    sensor.active = false;
+    TEST_ASSERT_TRUE(home.justLeft());
+}
+
+void test_hardware_profile_pins_distinct_and_timed(void) {
+    // Both relay pairs and the remote inputs must be distinct pins
+    const uint8_t pins[] = {PinConfig::WINCH_UP, PinConfig::WINCH_DOWN, PinConfig::BOW_PORT,
+                            PinConfig::BOW_STARBOARD, PinConfig::REMOTE_UP, PinConfig::REMOTE_DOWN,
+                            PinConfig::REMOTE_FUNC3, PinConfig::REMOTE_FUNC4, PinConfig::PULSE_INPUT,
+                            PinConfig::DIRECTION, PinConfig::ANCHOR_HOME, PinConfig::BOW_PWM};
+    const size_t count = sizeof(pins) / sizeof(pins[0]);
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = i + 1; j < count; j++) {
+            TEST_ASSERT_TRUE(pins[i] != pins[j]);
+        }
+    }
+
+    // A reversal always waits: the profile timing must hold a dead time
+    TEST_ASSERT_TRUE(PinConfig::WINCH_RELAY_TIMING.dead_time_ms > 0);
+    TEST_ASSERT_TRUE(PinConfig::BOW_RELAY_TIMING.dead_time_ms > 0);
+    TEST_ASSERT_TRUE(PinConfig::BOW_RELAY_TIMING.duty_budget_ms <= PinConfig::BOW_RELAY_TIMING.duty_window_ms);
+
+    // Thrust pulses never go below what the relay sequencer allows
+    TEST_ASSERT_TRUE(PinConfig::BOW_PULSE_TIMING.min_gap_ms >= PinConfig::BOW_RELAY_TIMING.min_off_ms);
+}
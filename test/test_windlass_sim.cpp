@@ -0,0 +1,62 @@
+// Control behaviour on the simulated windlass (bench/sim)
+// Manual commands through the command queue and the winch relay sequencer
+
+#include <unity.h>
+#include "sim/WindlassSim.h"
+#include "services/ControlCommand.h"
+
+namespace {
+    /// Run ms by ms; false if the relay was ever driven other than expected
+    bool relayHeld(WindlassSim& sim, RelayOutput expected, uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            sim.runMs(1);
+            if (sim.relays().driven() != expected) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void test_sim_repeated_manual_command_keeps_relay_on(void) {
+    WindlassSim sim;
+    TEST_ASSERT_TRUE(sim.submit({ControlCommandType::MANUAL_WINCH, -1.0f, CommandSource::SIGNALK}));
+    sim.runMs(500);
+    TEST_ASSERT_TRUE(sim.relays().driven() == RelayOutput::B);
+    const uint32_t start_edge_us = sim.relays().lastEdgeUs();
+
+    // Keep-alives and re-sends of the running direction
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(sim.submit({ControlCommandType::MANUAL_WINCH, -1.0f, CommandSource::SIGNALK}));
+        TEST_ASSERT_TRUE(relayHeld(sim, RelayOutput::B, 50));
+    }
+    TEST_ASSERT_EQUAL_UINT32(start_edge_us, sim.relays().lastEdgeUs());
+}
+
+void test_sim_manual_takeover_keeps_automatic_direction(void) {
+    WindlassSim sim;
+    sim.controller().setTargetLength(20.0f);
+    sim.controller().setEnabled(true);
+    sim.runMs(2000);
+    TEST_ASSERT_TRUE(sim.relays().driven() == RelayOutput::B);
+
+    // Manual DOWN while automatic mode deploys: automatic mode ends, the relay stays on
+    TEST_ASSERT_TRUE(sim.submit({ControlCommandType::MANUAL_WINCH, -1.0f, CommandSource::SIGNALK}));
+    TEST_ASSERT_TRUE(relayHeld(sim, RelayOutput::B, 500));
+    TEST_ASSERT_FALSE(sim.controller().isEnabled());
+}
+
+void test_sim_manual_takeover_reverses_automatic_direction(void) {
+    WindlassSim sim;
+    sim.controller().setTargetLength(20.0f);
+    sim.controller().setEnabled(true);
+    sim.runMs(2000);
+
+    // Manual UP while automatic mode deploys: stop, dead time, then retrieve
+    TEST_ASSERT_TRUE(sim.submit({ControlCommandType::MANUAL_WINCH, 1.0f, CommandSource::SIGNALK}));
+    sim.runMs(1);
+    TEST_ASSERT_TRUE(sim.relays().driven() == RelayOutput::OFF);
+    sim.runMs(1000);
+    TEST_ASSERT_TRUE(sim.relays().driven() == RelayOutput::A);
+    TEST_ASSERT_FALSE(sim.controller().isEnabled());
+}
@@ -0,0 +1,152 @@
+"""
+Request and decode a trace capture from the controller (TRACE_CAPTURE=1 builds).
+
+Sends "TRACE START" to the controller's trace port and repeats it as a
+keep-alive, then writes one JSON line per record (stdout or --output) for
+offline analysis and replay against the bench simulator. Ctrl-C sends
+"TRACE STOP"; the controller flushes what is still buffered.
+
+Frame and record layout: include/util/TraceBuffer.h.
+
+Usage:
+    python tools/trace_decode.py bow-controller.local > trace.jsonl
+    python tools/trace_decode.py 192.168.1.50 --raw capture.bin
+    python tools/trace_decode.py --file capture.bin
+"""
+import argparse
+import json
+import socket
+import struct
+import sys
+import time
+
+TRACE_PORT = 50212
+KEEP_ALIVE_S = 2.0
+FRAME_MAGIC = 0x5442
+FRAME_VERSION = 1
+HEADER = struct.Struct("<HBBII")
+RECORD = struct.Struct("<IBBHII")
+
+EVENTS = {1: "capture_start", 2: "pulse", 3: "relay", 4: "command", 5: "auto_decision"}
+COMMANDS = ["manual_winch", "bow_thruster", "auto_mode", "arm_target", "home", "reset_rode",
+            "emergency_stop", "stop_all", "arm_scope", "depth"]
+SOURCES = ["signalk", "remote", "local", "direct"]
+DECISIONS = ["deploy", "retrieve", "reached", "coast_stop", "scope_stop", "home_retrieve",
+             "home_reached"]
+RELAY_OUTPUTS = {0: "off", 1: "a", -1: "b"}
+
+
+def as_float(bits):
+    return struct.unpack("<f", struct.pack("<I", bits))[0]
+
+
+def as_int(bits):
+    return struct.unpack("<i", struct.pack("<I", bits))[0]
+
+
+def name(table, index):
+    return table[index] if 0 <= index < len(table) else index
+
+
+def decode_record(timestamp_us, event, tag, arg, a, b):
+    """Return a dict with the per-event fields of one record."""
+    out = {"t_us": timestamp_us, "event": EVENTS.get(event, event)}
+    if event == 1:
+        out["meters_per_pulse"] = as_float(a)
+    elif event == 2:
+        out["pulses"] = as_int(a)
+    elif event == 3:
+        signed = arg - 0x10000 if arg & 0x8000 else arg
+        out.update(pin_a=tag, pin_b=a, output=RELAY_OUTPUTS.get(signed, signed))
+    elif event == 4:
+        out.update(command=name(COMMANDS, tag), source=name(SOURCES, arg & 0xFF),
+                   channel=arg >> 8, value=as_float(a), queue_delay_us=b)
+    elif event == 5:
+        out.update(decision=name(DECISIONS, tag), rode_m=as_float(a), target_m=as_float(b))
+    else:
+        out.update(tag=tag, arg=arg, a=a, b=b)
+    return out
+
+
+class Decoder:
+    """Decodes frames and reports lost frames and records dropped on the controller."""
+
+    def __init__(self, write):
+        self.write = write
+        self.next_sequence = None
+        self.dropped = 0
+
+    def frame(self, data):
+        if len(data) < HEADER.size:
+            return
+        magic, version, count, sequence, dropped = HEADER.unpack_from(data)
+        if magic != FRAME_MAGIC or version != FRAME_VERSION:
+            print(f"Ignoring frame: magic {magic:#06x} version {version}", file=sys.stderr)
+            return
+        if len(data) < HEADER.size + count * RECORD.size:
+            print(f"Truncated frame {sequence}", file=sys.stderr)
+            return
+        if self.next_sequence is not None and sequence != self.next_sequence:
+            self.write({"event": "gap", "frames_lost": (sequence - self.next_sequence) & 0xFFFFFFFF})
+        if dropped != self.dropped:
+            self.write({"event": "gap", "records_dropped": (dropped - self.dropped) & 0xFFFFFFFF})
+        self.next_sequence = (sequence + 1) & 0xFFFFFFFF
+        self.dropped = dropped
+        for i in range(count):
+            self.write(decode_record(*RECORD.unpack_from(data, HEADER.size + i * RECORD.size)))
+
+
+def read_file(path, decoder):
+    """Decode a raw capture: each frame prefixed with its u16 little-endian length."""
+    with open(path, "rb") as handle:
+        while True:
+            prefix = handle.read(2)
+            if len(prefix) < 2:
+                return
+            decoder.frame(handle.read(struct.unpack("<H", prefix)[0]))
+
+
+def capture(host, decoder, raw):
+    address = (socket.gethostbyname(host), TRACE_PORT)
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.settimeout(0.2)
+    last_request = 0.0
+    try:
+        while True:
+            now = time.monotonic()
+            if now - last_request >= KEEP_ALIVE_S:
+                sock.sendto(b"TRACE START", address)
+                last_request = now
+            try:
+                data, _ = sock.recvfrom(2048)
+            except socket.timeout:
+                continue
+            if raw:
+                raw.write(struct.pack("<H", len(data)) + data)
+            decoder.frame(data)
+    except KeyboardInterrupt:
+        sock.sendto(b"TRACE STOP", address)
+        print("Capture stopped", file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("host", nargs="?", help="Controller address (live capture)")
+    parser.add_argument("--file", help="Decode a raw capture written with --raw")
+    parser.add_argument("--raw", help="Also save the received frames to this file")
+    parser.add_argument("--output", help="JSON lines output (default stdout)")
+    args = parser.parse_args()
+    if not args.host and not args.file:
+        parser.error("a controller host or --file is required")
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    decoder = Decoder(lambda record: print(json.dumps(record), file=out, flush=True))
+    if args.file:
+        read_file(args.file, decoder)
+    else:
+        with open(args.raw, "wb") if args.raw else open(sys.devnull, "wb") as raw:
+            capture(args.host, decoder, raw if args.raw else None)
+
+
+if __name__ == "__main__":
+    main()